@@ -1,3 +0,0 @@
-#include "metrics.h"
-
-uint64_t n64_metric_data[NUM_METRICS];
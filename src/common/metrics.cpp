@@ -0,0 +1,101 @@
+#include "metrics.h"
+
+#include <chrono>
+#include <cstring>
+#include <mutex>
+
+uint64_t n64_metric_data[NUM_METRICS];
+metric_histogram_t n64_histogram_data[NUM_HISTOGRAMS];
+
+const metric_info_t n64_metric_info[NUM_METRICS] = {
+#define X(id, name, kind, description) { name, METRIC_KIND_##kind, description },
+    N64_METRICS(X)
+#undef X
+};
+
+const histogram_info_t n64_histogram_info[NUM_HISTOGRAMS] = {
+#define X(id, name, description) { name, description },
+    N64_HISTOGRAMS(X)
+#undef X
+};
+
+// Everything here is written by the CPU thread at the end of each frame, and read by whoever's exporting metrics.
+static std::mutex history_mutex;
+static uint64_t totals[NUM_METRICS];
+static frame_metrics_t history[METRICS_HISTORY_FRAMES];
+static uint64_t frames_ended = 0;
+static uint64_t last_frame_end_ns = 0;
+
+uint64_t metrics_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t histogram_quantile(const metric_histogram_t* histogram, double quantile) {
+    if (histogram->count == 0) {
+        return 0;
+    }
+    uint64_t target = (uint64_t)(quantile * histogram->count);
+    if (target >= histogram->count) {
+        return histogram->max;
+    }
+    uint64_t seen = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += histogram->buckets[i];
+        if (seen > target) {
+            // The top of the bucket, but never more than anything actually recorded
+            uint64_t upper = i + 1 < HISTOGRAM_BUCKETS ? histogram_bucket_lower_bound(i + 1) - 1 : histogram->max;
+            return upper < histogram->max ? upper : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
+void metrics_end_frame() {
+    uint64_t now = metrics_now_ns();
+    uint64_t frame_time = last_frame_end_ns == 0 ? 0 : now - last_frame_end_ns;
+    last_frame_end_ns = now;
+    if (frame_time != 0) {
+        record_histogram(HISTOGRAM_FRAME_TIME, frame_time);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(history_mutex);
+        frame_metrics_t* frame = &history[frames_ended % METRICS_HISTORY_FRAMES];
+        frame->frame = frames_ended;
+        frame->frame_time_ns = frame_time;
+        memcpy(frame->values, n64_metric_data, sizeof(frame->values));
+        for (int i = 0; i < NUM_METRICS; i++) {
+            if (n64_metric_info[i].kind == METRIC_KIND_COUNTER) {
+                totals[i] += n64_metric_data[i];
+            } else {
+                totals[i] = n64_metric_data[i];
+            }
+        }
+        frames_ended++;
+    }
+
+    for (int i = 0; i < NUM_METRICS; i++) {
+        if (n64_metric_info[i].kind == METRIC_KIND_COUNTER) {
+            n64_metric_data[i] = 0;
+        }
+    }
+}
+
+void metrics_get_totals(uint64_t* values) {
+    std::lock_guard<std::mutex> lock(history_mutex);
+    memcpy(values, totals, sizeof(totals));
+}
+
+int metrics_get_history(frame_metrics_t* frames, int max_frames) {
+    std::lock_guard<std::mutex> lock(history_mutex);
+    uint64_t available = frames_ended < METRICS_HISTORY_FRAMES ? frames_ended : METRICS_HISTORY_FRAMES;
+    int count = max_frames < (int)available ? max_frames : (int)available;
+    for (int i = 0; i < count; i++) {
+        frames[i] = history[(frames_ended - count + i) % METRICS_HISTORY_FRAMES];
+    }
+    return count;
+}
+
+void metrics_get_histogram(histogram_t histogram, metric_histogram_t* out) {
+    memcpy(out, &n64_histogram_data[histogram], sizeof(metric_histogram_t));
+}
@@ -6,21 +6,47 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+
+// Counters count events during the current frame, and are added to their running totals when the frame ends.
+// Gauges are set to a value and keep it until they're set again.
+//   X(id, exported name, kind, description)
+#define N64_METRICS(X) \
+    X(METRIC_BLOCK_COMPILATION,            "block_compilations",         COUNTER, "Blocks compiled by the JIT") \
+    X(METRIC_BLOCK_CACHED,                 "cached_interpreter_blocks",  COUNTER, "Blocks predecoded for the cached interpreter") \
+    X(METRIC_BLOCK_PROMOTION,              "block_promotions",           COUNTER, "Cached interpreter blocks promoted to the JIT") \
+    X(METRIC_RSP_STEPS,                    "rsp_steps",                  COUNTER, "RSP instructions run") \
+    X(METRIC_AUDIOSTREAM_AVAILABLE,        "audiostream_available_bytes", GAUGE,  "Guest audio buffered for the host device") \
+    X(METRIC_SI_INTERRUPT,                 "si_interrupts",              COUNTER, "SI interrupts raised") \
+    X(METRIC_PI_INTERRUPT,                 "pi_interrupts",              COUNTER, "PI interrupts raised") \
+    X(METRIC_AI_INTERRUPT,                 "ai_interrupts",              COUNTER, "AI interrupts raised") \
+    X(METRIC_DP_INTERRUPT,                 "dp_interrupts",              COUNTER, "DP interrupts raised") \
+    X(METRIC_SP_INTERRUPT,                 "sp_interrupts",              COUNTER, "SP interrupts raised") \
+    X(METRIC_BLOCK_SYSCONFIG_MISS,         "block_sysconfig_misses",     COUNTER, "Block lookups that found a block compiled for another sysconfig") \
+    X(METRIC_CODE_INVALIDATION,            "code_invalidations",         COUNTER, "Pages of compiled code invalidated by writes") \
+    X(METRIC_NEW_JIT_BLOCK_LIST_ALLOCATED, "jit_block_list_allocations", COUNTER, "Block lists allocated for pages of code") \
+    X(METRIC_SOFTRDP_PIPELINE_HIT,         "softrdp_pipeline_hits",      COUNTER, "Software RDP primitives drawn with a cached pipeline") \
+    X(METRIC_SOFTRDP_PIPELINE_MISS,        "softrdp_pipeline_misses",    COUNTER, "Software RDP pipelines built") \
+    X(METRIC_CODECACHE_USED,               "codecache_used_bytes",       GAUGE,   "Bytes of the JIT code cache in use")
+
 typedef enum metric {
-    METRIC_BLOCK_COMPILATION = 0,
-    METRIC_RSP_STEPS,
-    METRIC_AUDIOSTREAM_AVAILABLE,
-    METRIC_SI_INTERRUPT,
-    METRIC_PI_INTERRUPT,
-    METRIC_AI_INTERRUPT,
-    METRIC_DP_INTERRUPT,
-    METRIC_SP_INTERRUPT,
-    METRIC_BLOCK_SYSCONFIG_MISS,
-    METRIC_CODE_INVALIDATION,
-    METRIC_NEW_JIT_BLOCK_LIST_ALLOCATED,
+#define X(id, name, kind, description) id,
+    N64_METRICS(X)
+#undef X
     NUM_METRICS
 } metric_t;
 
+typedef enum metric_kind {
+    METRIC_KIND_COUNTER,
+    METRIC_KIND_GAUGE
+} metric_kind_t;
+
+typedef struct metric_info {
+    const char* name;
+    metric_kind_t kind;
+    const char* description;
+} metric_info_t;
+
+extern const metric_info_t n64_metric_info[NUM_METRICS];
 extern uint64_t n64_metric_data[NUM_METRICS];
 
 INLINE void mark_metric(metric_t metric) {
@@ -39,12 +65,109 @@ INLINE void set_metric(metric_t metric, uint64_t value) {
     n64_metric_data[metric] = value;
 }
 
-INLINE void reset_all_metrics() {
-    for (int i = 0; i < NUM_METRICS; i++) {
-        n64_metric_data[i] = 0;
+// Durations in nanoseconds, kept for the whole run.
+#define N64_HISTOGRAMS(X) \
+    X(HISTOGRAM_BLOCK_COMPILE, "block_compile",     "Time to compile a block with the JIT") \
+    X(HISTOGRAM_RDP_LIST,      "rdp_list",          "Time the CPU thread spends on an RDP command list, including drawing it when the RDP isn't threaded") \
+    X(HISTOGRAM_AUDIO_FLUSH,   "audio_flush",       "Time to resample and hand a buffer of audio to the host device") \
+    X(HISTOGRAM_FRAME_TIME,    "frame_time",        "Wall clock time between the ends of two frames")
+
+typedef enum histogram {
+#define X(id, name, description) id,
+    N64_HISTOGRAMS(X)
+#undef X
+    NUM_HISTOGRAMS
+} histogram_t;
+
+// Log-linear buckets, like HdrHistogram: values under HISTOGRAM_SUB_BUCKETS get a bucket each, and every power of two above
+// that is split into HISTOGRAM_SUB_BUCKETS buckets, so a bucket's bounds are always within 1/16 of each other.
+// Anything from 2^HISTOGRAM_MAX_BITS ns (about 18 minutes) up goes in the last bucket.
+#define HISTOGRAM_SUB_BUCKET_BITS 4
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BUCKET_BITS)
+#define HISTOGRAM_MAX_BITS 40
+#define HISTOGRAM_BUCKETS ((HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BUCKET_BITS + 1) * HISTOGRAM_SUB_BUCKETS)
+
+// Each histogram is only recorded to by one thread at a time. Readers on other threads copy it without locking, so the copy
+// can be off by the one value being recorded.
+typedef struct metric_histogram {
+    uint64_t buckets[HISTOGRAM_BUCKETS];
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+} metric_histogram_t;
+
+typedef struct histogram_info {
+    const char* name;
+    const char* description;
+} histogram_info_t;
+
+extern const histogram_info_t n64_histogram_info[NUM_HISTOGRAMS];
+extern metric_histogram_t n64_histogram_data[NUM_HISTOGRAMS];
+
+INLINE int histogram_bucket(uint64_t value) {
+    if (value < HISTOGRAM_SUB_BUCKETS) {
+        return (int)value;
+    }
+    int msb = 63 - __builtin_clzll(value);
+    if (msb >= HISTOGRAM_MAX_BITS) {
+        return HISTOGRAM_BUCKETS - 1;
+    }
+    int shift = msb - HISTOGRAM_SUB_BUCKET_BITS;
+    return (shift + 1) * HISTOGRAM_SUB_BUCKETS + (int)((value >> shift) & (HISTOGRAM_SUB_BUCKETS - 1));
+}
+
+// Smallest value that lands in a bucket
+INLINE uint64_t histogram_bucket_lower_bound(int bucket) {
+    if (bucket < HISTOGRAM_SUB_BUCKETS) {
+        return bucket;
     }
+    int shift = bucket / HISTOGRAM_SUB_BUCKETS - 1;
+    return (uint64_t)(HISTOGRAM_SUB_BUCKETS + bucket % HISTOGRAM_SUB_BUCKETS) << shift;
 }
 
+INLINE void record_histogram(histogram_t histogram, uint64_t value) {
+    metric_histogram_t* h = &n64_histogram_data[histogram];
+    h->buckets[histogram_bucket(value)]++;
+    h->count++;
+    h->sum += value;
+    if (value > h->max) {
+        h->max = value;
+    }
+}
+
+// Monotonic clock in nanoseconds, for timing things into histograms
+uint64_t metrics_now_ns();
+
+INLINE uint64_t metric_timer_start() {
+    return metrics_now_ns();
+}
+
+INLINE void metric_timer_stop(histogram_t histogram, uint64_t start) {
+    record_histogram(histogram, metrics_now_ns() - start);
+}
+
+// Smallest value at least `quantile` (0 to 1) of the recorded values are below, to the precision of the buckets
+uint64_t histogram_quantile(const metric_histogram_t* histogram, double quantile);
+
+// How many frames of history are kept
+#define METRICS_HISTORY_FRAMES 600
+
+typedef struct frame_metrics {
+    uint64_t frame;
+    uint64_t frame_time_ns;
+    uint64_t values[NUM_METRICS];
+} frame_metrics_t;
+
+// Called once per frame: adds this frame's counters to the totals, records a snapshot in the history and starts a new frame.
+void metrics_end_frame();
+
+// Safe to call from any thread.
+// Running totals for counters, current values for gauges
+void metrics_get_totals(uint64_t* values);
+// Copies up to max_frames of the most recent frames, oldest first, and returns how many were copied
+int metrics_get_history(frame_metrics_t* frames, int max_frames);
+void metrics_get_histogram(histogram_t histogram, metric_histogram_t* out);
+
 #ifdef __cplusplus
 }
 #endif
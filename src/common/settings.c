@@ -204,9 +204,13 @@ void n64_settings_load_defaults() {
     n64_settings.controller[3].gamepad_enabled = false;
 
     n64_settings.scaling = 0;
+    n64_settings.double_buffer = true;
     n64_settings.volume = 1.0f;
+    n64_settings.audio_sink = AUDIO_SINK_SDL;
+    strcpy(n64_settings.audio_output_path, "dgb-n64-audio.wav");
     n64_settings.http_api_port = 0; // disabled
     strcpy(n64_settings.http_api_host, "127.0.0.1");
+    n64_settings.huge_pages = HUGE_PAGES_AUTO;
 }
 
 const char* joybus_to_str(n64_joybus_device_type_t joybus) {
@@ -236,6 +240,39 @@ n64_joybus_device_type_t str_to_joybus(const char* joybus) {
     return JOYBUS_NONE;
 }
 
+const char* audio_sink_to_str(n64_audio_sink_t sink) {
+    switch (sink) {
+        case AUDIO_SINK_UNKNOWN: return "UNKNOWN";
+        case AUDIO_SINK_SDL:     return "SDL";
+        case AUDIO_SINK_NULL:    return "NULL";
+        case AUDIO_SINK_WAV:     return "WAV";
+        case AUDIO_SINK_RAW:     return "RAW";
+    }
+}
+
+n64_audio_sink_t str_to_audio_sink(const char* sink) {
+    if (SDL_strcasecmp("SDL",  sink) == 0) return AUDIO_SINK_SDL;
+    if (SDL_strcasecmp("NULL", sink) == 0) return AUDIO_SINK_NULL;
+    if (SDL_strcasecmp("WAV",  sink) == 0) return AUDIO_SINK_WAV;
+    if (SDL_strcasecmp("RAW",  sink) == 0) return AUDIO_SINK_RAW;
+    return AUDIO_SINK_UNKNOWN;
+}
+
+const char* huge_pages_to_str(n64_huge_pages_t huge_pages) {
+    switch (huge_pages) {
+        case HUGE_PAGES_OFF:         return "OFF";
+        case HUGE_PAGES_TRANSPARENT: return "TRANSPARENT";
+        case HUGE_PAGES_AUTO:        return "AUTO";
+    }
+}
+
+bool str_to_huge_pages(const char* str, n64_huge_pages_t* huge_pages) {
+    if (SDL_strcasecmp("OFF",         str) == 0) { *huge_pages = HUGE_PAGES_OFF; return true; }
+    if (SDL_strcasecmp("TRANSPARENT", str) == 0) { *huge_pages = HUGE_PAGES_TRANSPARENT; return true; }
+    if (SDL_strcasecmp("AUTO",        str) == 0) { *huge_pages = HUGE_PAGES_AUTO; return true; }
+    return false;
+}
+
 #define CONFIG_TEXT(l, ...) do { if (fprintf(f, l, ##__VA_ARGS__) < 0) { return -1; }} while(0)
 #define CONFIG_LINE(l, ...) CONFIG_TEXT(l "\n", ##__VA_ARGS__)
 #define BOOL_TO_TEXT(x) ((x) ? "true" : "false")
@@ -274,10 +311,22 @@ int n64_settings_write(const char* path) {
     CONFIG_LINE("[graphics]");
     CONFIG_LINE("; Graphics upscaling. Valid values: 0, 2, 4, 8.");
     CONFIG_LINE("upscaling=%d", n64_settings.scaling);
+    CONFIG_LINE("; Alternate between two textures when scanning out with the software renderer. Valid values: 0, 1.");
+    CONFIG_LINE("double_buffer=%d", n64_settings.double_buffer);
 
     CONFIG_LINE("[audio]");
     CONFIG_LINE("; Volume. Valid values: 0.0 - 1.0.");
     CONFIG_LINE("volume=%f", n64_settings.volume);
+    CONFIG_LINE("; Where audio goes. Valid values: 'SDL', 'NULL', 'WAV', 'RAW'.");
+    CONFIG_LINE("; WAV and RAW write 16 bit stereo PCM at the game's own sample rate to output_path, without resampling.");
+    CONFIG_LINE("sink=%s", audio_sink_to_str(n64_settings.audio_sink));
+    CONFIG_LINE("output_path=%s", n64_settings.audio_output_path);
+
+    CONFIG_LINE("[memory]");
+    CONFIG_LINE("; Back RDRAM and the code caches with 2 MiB pages. Takes effect the next time the emulator starts.");
+    CONFIG_LINE("; Valid values: 'OFF', 'TRANSPARENT' (madvise for transparent huge pages),");
+    CONFIG_LINE("; 'AUTO' (reserved huge pages if the host has some, transparent huge pages if not). Linux only.");
+    CONFIG_LINE("huge_pages=%s", huge_pages_to_str(n64_settings.huge_pages));
 
     CONFIG_LINE("; Joybus devices/Controller ports. Configure what type of device is plugged in.");
     CONFIG_LINE("; Valid values: 'NONE', 'CONTROLLER', 'DANCEPAD', 'VRU', 'MOUSE', 'KEYBOARD', 'DENSHA'");
@@ -441,6 +490,8 @@ int handler(void* user, const char* section, const char* name, const char* value
         if (n64_settings.scaling != 0 && n64_settings.scaling != 2 && n64_settings.scaling != 4 && n64_settings.scaling != 8) {
             n64_settings.scaling = 0;
         }
+    } else if (MATCH("graphics", "double_buffer")) {
+        n64_settings.double_buffer = atoi(value) != 0;
     } else if (MATCH("audio", "volume")) {
         n64_settings.volume = atof(value);
         if (n64_settings.volume < 0.0f) {
@@ -448,6 +499,17 @@ int handler(void* user, const char* section, const char* name, const char* value
         } else if (n64_settings.volume > 1.0f) {
             n64_settings.volume = 1.0f;
         }
+    } else if (MATCH("audio", "sink")) {
+        n64_settings.audio_sink = str_to_audio_sink(value);
+        if (n64_settings.audio_sink == AUDIO_SINK_UNKNOWN) {
+            n64_settings.audio_sink = AUDIO_SINK_SDL;
+        }
+    } else if (MATCH("audio", "output_path")) {
+        strncpy(n64_settings.audio_output_path, value, 255);
+    } else if (MATCH("memory", "huge_pages")) {
+        if (!str_to_huge_pages(value, &n64_settings.huge_pages)) {
+            n64_settings.huge_pages = HUGE_PAGES_AUTO;
+        }
     } else if (MATCH("http", "port")) {
         n64_settings.http_api_port = atoi(value);
     } else if (MATCH("http", "host")) {
@@ -1,4 +1,7 @@
+#ifndef N64_SETTINGS_H
+#define N64_SETTINGS_H
 #include <frontend/device.h>
+#include <system/host_memory.h>
 #include <stdbool.h>
 #include <SDL_keycode.h>
 
@@ -34,13 +37,25 @@ typedef struct n64_controller_mapping {
     SDL_KeyCode keyboard_z[2];
 } n64_controller_mapping_t;
 
+typedef enum n64_audio_sink {
+    AUDIO_SINK_UNKNOWN,
+    AUDIO_SINK_SDL, // the host's audio device
+    AUDIO_SINK_NULL, // discard everything
+    AUDIO_SINK_WAV, // write guest rate PCM to a WAV file
+    AUDIO_SINK_RAW // write guest rate PCM to a file, with no header
+} n64_audio_sink_t;
+
 typedef struct n64_settings {
     n64_joybus_device_type_t controller_port[4];
     n64_controller_mapping_t controller[4];
     int scaling; // valid values: 0, 2, 4, 8
+    bool double_buffer; // software renderer only
     float volume; // valid values: 0.0 - 1.0
+    n64_audio_sink_t audio_sink;
+    char audio_output_path[256]; // WAV and RAW sinks only
     int http_api_port;
     char http_api_host[256];
+    n64_huge_pages_t huge_pages;
 } n64_settings_t;
 
 extern n64_settings_t n64_settings;
@@ -49,6 +64,16 @@ void n64_settings_init();
 // Rewrite the settings file with the current contents of n64_settings
 void n64_settings_save();
 
+const char* audio_sink_to_str(n64_audio_sink_t sink);
+// Case insensitive. Returns AUDIO_SINK_UNKNOWN if it doesn't name a sink
+n64_audio_sink_t str_to_audio_sink(const char* sink);
+
+const char* huge_pages_to_str(n64_huge_pages_t huge_pages);
+// Case insensitive. Returns false if it doesn't name a mode
+bool str_to_huge_pages(const char* str, n64_huge_pages_t* huge_pages);
+
 #ifdef __cplusplus
 }
 #endif
+
+#endif //N64_SETTINGS_H
@@ -0,0 +1,255 @@
+#include "trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <log.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Per thread, in bytes
+#define TRACE_RING_SIZE (4 << 20)
+#define TRACE_RING_MASK (TRACE_RING_SIZE - 1)
+#define TRACE_WRITER_INTERVAL std::chrono::milliseconds(5)
+
+u64 n64_trace_mask = 0;
+
+// Records are written as a byte stream and can wrap around the end of the ring, the writer copies them out the same way.
+struct trace_ring {
+    std::vector<u8> bytes = std::vector<u8>(TRACE_RING_SIZE);
+    // Advanced by the owning thread once a record is complete
+    std::atomic<u64> head{0};
+    // Advanced by the writer once it's written everything before it
+    std::atomic<u64> tail{0};
+    // Only written by the owning thread
+    std::atomic<u64> dropped{0};
+    u64 dropped_written = 0;
+    u32 thread;
+};
+
+static const char* event_names[NUM_TRACE_EVENTS] = {
+    "cpu_state",
+    "jit_sync_point",
+    "block_compiled",
+    "idle_loop",
+    "rdp_command",
+};
+
+// Rings outlive their threads and tracing sessions, a thread that's still emitting while tracing stops can't be left holding
+// a freed one.
+static std::mutex rings_mutex;
+static std::vector<trace_ring*> rings;
+static thread_local trace_ring* local_ring = nullptr;
+
+static struct {
+    FILE* file = nullptr;
+    bool lossless = false;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stop = false;
+} writer;
+
+INLINE u64 trace_timestamp() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+static u64 measure_ticks_per_second() {
+#if defined(__x86_64__) || defined(__i386__)
+    auto start_time = std::chrono::steady_clock::now();
+    u64 start_ticks = __rdtsc();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    u64 ticks = __rdtsc() - start_ticks;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    return (u64)(ticks / seconds);
+#else
+    return std::chrono::steady_clock::period::den / std::chrono::steady_clock::period::num;
+#endif
+}
+
+static trace_ring* register_thread() {
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    local_ring = new trace_ring;
+    local_ring->thread = rings.size();
+    rings.push_back(local_ring);
+    return local_ring;
+}
+
+INLINE void ring_copy(trace_ring* r, u64 position, const void* data, u32 size) {
+    u32 start = position & TRACE_RING_MASK;
+    u32 first = std::min(size, (u32)(TRACE_RING_SIZE - start));
+    memcpy(&r->bytes[start], data, first);
+    memcpy(&r->bytes[0], (const u8*)data + first, size - first);
+}
+
+void trace_emit(trace_event_t event, const void* payload, u32 size) {
+    trace_ring* r = local_ring;
+    if (unlikely(r == nullptr)) {
+        r = register_thread();
+    }
+
+    const u64 head = r->head.load(std::memory_order_relaxed);
+    const u64 needed = sizeof(trace_record_header_t) + size;
+    while (unlikely(head + needed - r->tail.load(std::memory_order_acquire) > TRACE_RING_SIZE)) {
+        if (!writer.lossless) {
+            r->dropped.store(r->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+        std::this_thread::yield();
+    }
+
+    trace_record_header_t header = { trace_timestamp(), (u32)event, size };
+    ring_copy(r, head, &header, sizeof(header));
+    ring_copy(r, head + sizeof(header), payload, size);
+    r->head.store(head + needed, std::memory_order_release);
+}
+
+static void drain_ring(trace_ring* r) {
+    const u64 head = r->head.load(std::memory_order_acquire);
+    const u64 tail = r->tail.load(std::memory_order_relaxed);
+    const u64 dropped = r->dropped.load(std::memory_order_relaxed);
+    if (head == tail && dropped == r->dropped_written) {
+        return;
+    }
+
+    trace_chunk_header_t chunk = { r->thread, (u32)(head - tail), dropped - r->dropped_written };
+    fwrite(&chunk, sizeof(chunk), 1, writer.file);
+    u32 start = tail & TRACE_RING_MASK;
+    u32 first = std::min(chunk.bytes, (u32)(TRACE_RING_SIZE - start));
+    fwrite(&r->bytes[start], 1, first, writer.file);
+    fwrite(&r->bytes[0], 1, chunk.bytes - first, writer.file);
+
+    r->dropped_written = dropped;
+    r->tail.store(head, std::memory_order_release);
+}
+
+static void drain_all_rings() {
+    std::lock_guard<std::mutex> lock(rings_mutex);
+    for (trace_ring* r : rings) {
+        drain_ring(r);
+    }
+}
+
+static void trace_writer_main() {
+    std::unique_lock<std::mutex> lock(writer.mutex);
+    while (!writer.stop) {
+        writer.wake.wait_for(lock, TRACE_WRITER_INTERVAL, [] { return writer.stop; });
+        lock.unlock();
+        drain_all_rings();
+        lock.lock();
+    }
+}
+
+bool trace_start(const char* path, u64 event_mask, bool lossless) {
+    if (writer.file != nullptr) {
+        logwarn("Already tracing");
+        return false;
+    }
+    writer.file = fopen(path, "wb");
+    if (writer.file == nullptr) {
+        return false;
+    }
+    setvbuf(writer.file, nullptr, _IOFBF, 1 << 20);
+
+    trace_file_header_t header = {};
+    memcpy(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_FILE_VERSION;
+    header.num_events = NUM_TRACE_EVENTS;
+    header.ticks_per_second = measure_ticks_per_second();
+    fwrite(&header, sizeof(header), 1, writer.file);
+
+    {
+        // Anything left over from an earlier session is skipped
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        for (trace_ring* r : rings) {
+            r->tail.store(r->head.load());
+            r->dropped_written = r->dropped.load();
+        }
+    }
+
+    writer.lossless = lossless;
+    writer.stop = false;
+    writer.thread = std::thread(trace_writer_main);
+    n64_trace_mask = event_mask;
+    logalways("Tracing to %s", path);
+    return true;
+}
+
+void trace_stop() {
+    if (writer.file == nullptr) {
+        return;
+    }
+    n64_trace_mask = 0;
+    {
+        std::lock_guard<std::mutex> lock(writer.mutex);
+        writer.stop = true;
+    }
+    writer.wake.notify_one();
+    writer.thread.join();
+
+    drain_all_rings();
+    u64 dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        for (trace_ring* r : rings) {
+            dropped += r->dropped.load();
+        }
+    }
+    if (dropped > 0) {
+        logwarn("Trace rings overflowed, %" PRIu64 " events were dropped", dropped);
+    }
+    fclose(writer.file);
+    writer.file = nullptr;
+}
+
+const char* trace_event_name(trace_event_t event) {
+    if (event >= NUM_TRACE_EVENTS) {
+        return "unknown";
+    }
+    return event_names[event];
+}
+
+bool trace_parse_event_list(const char* list, u64* mask) {
+    *mask = 0;
+    std::string names = list;
+    size_t start = 0;
+    while (start <= names.size()) {
+        size_t end = names.find(',', start);
+        if (end == std::string::npos) {
+            end = names.size();
+        }
+        std::string name = names.substr(start, end - start);
+        start = end + 1;
+
+        if (name.empty()) {
+            continue;
+        }
+        if (name == "all") {
+            *mask |= (1ULL << NUM_TRACE_EVENTS) - 1;
+            continue;
+        }
+        bool found = false;
+        for (int i = 0; i < NUM_TRACE_EVENTS; i++) {
+            if (name == event_names[i]) {
+                *mask |= TRACE_EVENT_MASK(i);
+                found = true;
+            }
+        }
+        if (!found) {
+            logwarn("Unknown trace event '%s'", name.c_str());
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,117 @@
+#ifndef N64_TRACE_H
+#define N64_TRACE_H
+
+// Binary event tracing. Every thread that emits gets its own lock free ring, and a writer thread drains them all into a
+// file in the background. Emitting copies a small fixed layout struct into the ring and never blocks or formats anything,
+// so it's cheap enough to leave on: a disabled event costs one load and a branch.
+//
+// File layout, all in host byte order:
+//   trace_file_header_t
+//   any number of: trace_chunk_header_t, followed by chunk.bytes bytes of records from that thread
+// Each record is a trace_record_header_t followed by record.size bytes of the event's payload struct.
+// src/tools/trace_decode.c reads it back.
+
+#include <stdbool.h>
+#include "util.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Ids are stored in trace files, so only add to the end
+typedef enum trace_event {
+    TRACE_EVENT_CPU_STATE,       // trace_cpu_state_t, before every instruction the interpreter runs
+    TRACE_EVENT_JIT_SYNC_POINT,  // trace_jit_sync_point_t, after every block the dynarec runs
+    TRACE_EVENT_BLOCK_COMPILED,  // trace_block_compiled_t
+    TRACE_EVENT_IDLE_LOOP,       // trace_idle_loop_t, a block replaced with idle_loop_replacement
+    TRACE_EVENT_RDP_COMMAND,     // trace_rdp_command_t, only the command's words are stored
+    NUM_TRACE_EVENTS
+} trace_event_t;
+
+typedef struct trace_cpu_state {
+    u64 pc;
+    u64 gpr[32];
+    u32 cp0_cause;
+    u32 mi_intr;
+} trace_cpu_state_t;
+
+typedef struct trace_jit_sync_point {
+    u64 pc;
+    u64 gpr[32];
+    s32 taken;
+    u32 padding;
+} trace_jit_sync_point_t;
+
+typedef struct trace_block_compiled {
+    u64 virtual_address;
+    u32 physical_address;
+    u32 guest_size;
+} trace_block_compiled_t;
+
+typedef struct trace_idle_loop {
+    u64 virtual_address;
+} trace_idle_loop_t;
+
+#define TRACE_RDP_COMMAND_MAX_WORDS 44
+typedef struct trace_rdp_command {
+    u32 length;
+    u32 words[TRACE_RDP_COMMAND_MAX_WORDS];
+} trace_rdp_command_t;
+
+#define TRACE_FILE_MAGIC "N64TRACE"
+#define TRACE_FILE_VERSION 1
+
+typedef struct trace_file_header {
+    char magic[8];
+    u32 version;
+    u32 num_events;
+    // Record timestamps are in these
+    u64 ticks_per_second;
+} trace_file_header_t;
+
+typedef struct trace_chunk_header {
+    // Threads are numbered in the order they first emitted an event
+    u32 thread;
+    u32 bytes;
+    // Records this thread couldn't fit in its ring since the last chunk
+    u64 dropped;
+} trace_chunk_header_t;
+
+typedef struct trace_record_header {
+    u64 timestamp;
+    u32 event;
+    u32 size;
+} trace_record_header_t;
+
+// One bit per trace_event_t. Only non zero while tracing
+extern u64 n64_trace_mask;
+
+#define TRACE_ENABLED(event) unlikely(n64_trace_mask & (1ULL << (event)))
+#define TRACE_EVENT_MASK(event) (1ULL << (event))
+// The events that fire at most a few thousand times a frame. Per instruction and per block state have to be asked for.
+#define TRACE_DEFAULT_EVENTS (TRACE_EVENT_MASK(TRACE_EVENT_BLOCK_COMPILED) | TRACE_EVENT_MASK(TRACE_EVENT_IDLE_LOOP) | TRACE_EVENT_MASK(TRACE_EVENT_RDP_COMMAND))
+
+// Emits a fixed size event built from the remaining arguments, e.g. TRACE(TRACE_EVENT_IDLE_LOOP, trace_idle_loop_t, address)
+#define TRACE(event, type, ...) do { \
+    if (TRACE_ENABLED(event)) { \
+        type trace_payload_ = { __VA_ARGS__ }; \
+        trace_emit(event, &trace_payload_, sizeof(trace_payload_)); \
+    } } while(0)
+
+// With lossless set, a thread that fills its ring waits for the writer to catch up instead of dropping events.
+// Returns false if the file can't be opened.
+bool trace_start(const char* path, u64 event_mask, bool lossless);
+// Writes out everything still in the rings and closes the file
+void trace_stop();
+// Only call when TRACE_ENABLED(event)
+void trace_emit(trace_event_t event, const void* payload, u32 size);
+
+const char* trace_event_name(trace_event_t event);
+// Comma separated event names, or "all". Returns false on an unknown name.
+bool trace_parse_event_list(const char* list, u64* mask);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //N64_TRACE_H
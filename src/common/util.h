@@ -6,12 +6,8 @@
 #include <stdio.h>
 
 #ifdef N64_HAVE_SSE
-#ifdef N64_USE_NEON
-#include <sse2neon.h>
-#else
 #include <emmintrin.h>
 #endif
-#endif
 
 typedef uint8_t u8;
 typedef uint16_t u16;
@@ -75,6 +71,13 @@ INLINE u32 npow2(u32 x) {
     return 1u << (32 - __builtin_clz(x - 1));
 }
 
+// Folds a value into a running 64 bit hash. Fast, not cryptographic: for spotting when two runs produce different output.
+INLINE u64 hash_mix(u64 hash, u64 value) {
+    hash ^= value * 0x9E3779B97F4A7C15ULL;
+    hash = (hash << 27) | (hash >> 37);
+    return hash * 0xC2B2AE3D27D4EB4FULL + 0x165667B19E3779F9ULL;
+}
+
 INLINE bool file_exists(const char* path) {
 #if !defined(N64_WIN) && !defined(__APPLE__)
     return access(path, F_OK) == 0;
@@ -1,6 +1,7 @@
 #include "cache.h"
 #include <system/n64system.h>
 #include <mem/mem_util.h>
+#include <rdp/fast_forward.h>
 
 void writeback_dcache(u64 vaddr, u32 paddr) {
     int cache_line = get_dcache_line_index(vaddr);
@@ -36,6 +37,7 @@ INLINE dcache_line_t* prep_dcache_line(u64 vaddr, u32 paddr) {
     if (!valid || !hit) {
         u32 line_start = get_dcache_line_start(paddr);
         if (paddr < N64_RDRAM_SIZE) {
+            check_fast_forward_read(line_start);
             for (int i = 0; i < 16; i++) {
                 line->data[i] = n64sys.mem.rdram[line_start + i];
             }
@@ -0,0 +1,37 @@
+#ifndef N64_BLOCK_CORPUS_H
+#define N64_BLOCK_CORPUS_H
+
+// Every block the JIT compiled during a run, as written by --capture-blocks. src/tools/jit_compile_bench.c replays them
+// through the compiler to measure how long compiling takes.
+//
+// File layout, all in host byte order:
+//   block_corpus_header_t
+//   any number of: block_corpus_record_t, followed by record.num_instructions u32 instruction words
+
+#include <util.h>
+
+#define BLOCK_CORPUS_MAGIC "N64BLKS"
+#define BLOCK_CORPUS_VERSION 1
+
+typedef struct block_corpus_header {
+    char magic[8];
+    u32 version;
+    u32 padding;
+    // From the ROM header, not null terminated
+    char image_name[20];
+    u32 padding2;
+} block_corpus_header_t;
+
+typedef struct block_corpus_record {
+    u64 virtual_address;
+    u32 physical_address;
+    u32 num_instructions;
+    u64 sysconfig;
+    // The CPU as the block was compiled. The compiler only looks at what affects code generation, the rest is there so a
+    // block can be run from the same state.
+    u64 gpr[32];
+    u32 cp0_status;
+    u32 fcr31;
+} block_corpus_record_t;
+
+#endif // N64_BLOCK_CORPUS_H
@@ -4,6 +4,8 @@
 
 #include <mem/n64bus.h>
 #include <metrics.h>
+#include <trace.h>
+#include <float_util.h>
 #include "dynarec_memory_management.h"
 #include "v2/v2_compiler.h"
 
@@ -11,6 +13,12 @@
 //#define DO_REPEATED_EXEC_DETECTION
 
 n64_dynarec_t n64dynarec;
+rdram_dirty_pages_t* rdram_dirty_pages = NULL;
+
+// Blocks run in the cached interpreter this many times before they're compiled.
+// Cold code (boot, menus, one-shot init) never pays the compile cost.
+#define DEFAULT_CACHED_INTERPRETER_THRESHOLD 32
+static int cached_interpreter_threshold = DEFAULT_CACHED_INTERPRETER_THRESHOLD;
 
 void update_sysconfig() {
     // handled by cp0_status_updated
@@ -26,42 +34,119 @@ int interpreter_fallback_until_no_branch() {
     return taken;
 }
 
+// Compiled code can't raise FPU exceptions. While the game has any enabled, run in the interpreter instead, in chunks
+// about the size of a block that don't end in a delay slot.
+static int interpreter_fallback_fpu_exceptions_enabled() {
+    int taken = 0;
+    do {
+        r4300i_step();
+        taken++;
+    } while (N64CPU.branch || (taken < MAX_BLOCK_LENGTH && N64CPU.fcr31.enable));
+    N64CPU.exception = false;
+    return taken;
+}
+
+// Compiled code doesn't track FPU exceptions, it leaves them in the host's sticky flags. Drop anything raised by C code
+// since the last block, and fold whatever the block raised into FCR31 once it's done. The interpreter does the same per op.
+// The block also runs in the guest's rounding mode, the host goes back to rounding to nearest afterwards.
+INLINE int run_compiled_block(n64_dynarec_block_t* block) {
+    host_fpu_enter_guest(N64CPU.fcr31.rounding_mode);
+    n64_guest_fpu_active = true;
+    int taken = block->run(&N64CPU);
+    n64_guest_fpu_active = false;
+    int raised = host_fpu_leave_guest();
+    if (unlikely(raised)) {
+        N64CPU.fcr31.flag |= host_fpu_flags_to_fcr31_bits(raised) & ~N64CPU.fcr31.enable;
+    }
+    return taken;
+}
+
+int run_cached_block(n64_dynarec_block_t* block, u32 physical_address) {
+    u32 outer_index = BLOCKCACHE_OUTER_INDEX(physical_address);
+    r4300i_predecoded_instruction_t* code = block->cached_code;
+    int len = block->cached_code_len;
+    u64 next_pc = block->virtual_address;
+
+    int taken = 0;
+    while (taken < len) {
+        N64CPU.prev_branch = N64CPU.branch;
+        N64CPU.branch = false;
+
+        N64CPU.prev_pc = N64CPU.pc;
+        N64CPU.pc = N64CPU.next_pc;
+        N64CPU.next_pc += 4;
+
+        code[taken].handler(code[taken].instruction);
+        taken++;
+        next_pc += 4;
+
+        // Stop on exceptions, skipped delay slots, and if the block overwrote its own page
+        if (unlikely(N64CPU.exception || N64CPU.pc != next_pc || n64dynarec.blockcache[outer_index] == NULL)) {
+            break;
+        }
+    }
+
+    // Block was cut off before the delay slot of its last branch
+    if (unlikely(N64CPU.branch && !N64CPU.exception)) {
+        taken += interpreter_fallback_until_no_branch();
+    }
+
+    N64CPU.exception = false;
+    return taken;
+}
+
 int missing_block_handler(u32 physical_address, n64_dynarec_block_t* block, n64_block_sysconfig_t current_sysconfig) {
     u32 outer_index = physical_address >> BLOCKCACHE_OUTER_SHIFT;
 
-    CODECACHE_ALLOW_WRITES();
+    // Promotions from the cached interpreter keep their place in the sysconfig list
+    bool promotion = block->cached_code != NULL;
 
     block->run = NULL;
+    block->cached_code = NULL;
+    block->cached_code_len = 0;
+    block->cached_run_count = 0;
     block->host_size = 0;
     block->guest_size = 0;
-    block->next = NULL;
+    if (!promotion) {
+        block->next = NULL;
+    }
     block->sysconfig = current_sysconfig;
     block->virtual_address = N64CPU.pc;
 
     bool* code_mask = n64dynarec.code_mask[outer_index];
 
+    if (!promotion && cached_interpreter_threshold > 0) {
+        mark_metric(METRIC_BLOCK_CACHED);
+        v3_build_cached_block(block, code_mask, N64CPU.pc, physical_address);
+        if (block->cached_code != NULL) {
+            return run_cached_block(block, physical_address);
+        }
+    } else {
 #ifdef N64_LOG_COMPILATIONS
-    printf("Compilin' new block at 0x%08" PRIX64 " / 0x%08" PRIX32 "\n", N64CPU.pc, physical_address);
+        printf("Compilin' new block at 0x%08" PRIX64 " / 0x%08" PRIX32 "\n", N64CPU.pc, physical_address);
 #endif
 
-    mark_metric(METRIC_BLOCK_COMPILATION);
-    v3_compile_new_block(block, code_mask, N64CPU.pc, physical_address);
-    CODECACHE_ALLOW_EXEC();
+        mark_metric(METRIC_BLOCK_COMPILATION);
+        u64 start = metric_timer_start();
+        CODECACHE_ALLOW_WRITES();
+        v3_compile_new_block(block, code_mask, N64CPU.pc, physical_address);
+        CODECACHE_ALLOW_EXEC();
+        metric_timer_stop(HISTOGRAM_BLOCK_COMPILE, start);
+    }
 
     if (block->run == NULL) {
        logfatal("Failed to compile block!");
     }
 
-    return block->run(&N64CPU);
+    return run_compiled_block(block);
 }
 
 INLINE n64_dynarec_block_t* find_matching_block(n64_dynarec_block_t* blocks, n64_block_sysconfig_t current_sysconfig, u64 virtual_address) {
     n64_dynarec_block_t* block_iter = blocks;
-    while (block_iter->run != NULL) {
+    while (is_valid_dynarec_block(block_iter)) {
         // make sure it matches the sysconfig and virtual address. If not, keep looking.
         if (block_iter->sysconfig.raw == current_sysconfig.raw && block_iter->virtual_address == virtual_address) {
             if (block_iter != blocks) {
-                CODECACHE_ALLOW_WRITES();
                 n64_dynarec_block_t temp = *blocks;
                 copy_dynarec_block(blocks, block_iter);
                 copy_dynarec_block(block_iter, &temp);
@@ -73,8 +158,7 @@ INLINE n64_dynarec_block_t* find_matching_block(n64_dynarec_block_t* blocks, n64
         }
         // Add a block to the end of the list
         if (block_iter->next == NULL) {
-            CODECACHE_ALLOW_WRITES();
-            block_iter->next = dynarec_bumpalloc_zero(sizeof(n64_dynarec_block_t));
+            block_iter->next = dynarec_metadata_alloc_zero(sizeof(n64_dynarec_block_t));
             return block_iter->next;
         }
         block_iter = block_iter->next;
@@ -92,17 +176,20 @@ INLINE n64_dynarec_block_t* block_at_address(n64_block_sysconfig_t current_sysco
 #ifdef N64_LOG_COMPILATIONS
         printf("Need a new block list for page 0x%05X (address 0x%08X virtual 0x%08X)\n", outer_index, physical_address, N64CPU.pc);
 #endif
-        CODECACHE_ALLOW_WRITES();
-        block_list = dynarec_bumpalloc_zero(BLOCKCACHE_INNER_SIZE * sizeof(n64_dynarec_block_t));
+        block_list = dynarec_metadata_alloc_zero(BLOCKCACHE_INNER_SIZE * sizeof(n64_dynarec_block_t));
         for (int i = 0; i < BLOCKCACHE_INNER_SIZE; i++) {
             block_list[i].run = NULL;
+            block_list[i].cached_code = NULL;
             block_list[i].next = NULL;
             block_list[i].host_size = 0;
             block_list[i].guest_size = 0;
             block_list[i].sysconfig.raw = 0;
         }
         n64dynarec.blockcache[outer_index] = block_list;
-        n64dynarec.code_mask[outer_index] = dynarec_bumpalloc_zero(BLOCKCACHE_INNER_SIZE * sizeof(bool));
+        // The interpreter may have already marked code in this page
+        if (n64dynarec.code_mask[outer_index] == NULL) {
+            n64dynarec.code_mask[outer_index] = dynarec_metadata_alloc_zero(BLOCKCACHE_INNER_SIZE * sizeof(bool));
+        }
     }
 
     u32 inner_index = BLOCKCACHE_INNER_INDEX(physical_address);
@@ -142,9 +229,44 @@ void do_repeated_exec_detection(u32 physical, n64_dynarec_block_t *block) {
 }
 #endif // DO_REPEATED_EXEC_DETECTION
 
+// Blocks are split so every breakpoint starts one, which lets them be checked here instead of in compiled code.
+// Stepping runs single instructions in the interpreter, and so does finishing a delay slot stepped into.
+static bool stepped_into_delay_slot = false;
+static int debugger_check_before_block() {
+    if (debugger_take_breakpoints_changed()) {
+        invalidate_dynarec_all_pages();
+    }
+    if (unlikely(maybe_breakpoint(N64CPU.pc) || debugger_step_pending())) {
+        check_breakpoint(N64CPU.pc);
+    }
+    debugger_wait_while_broken();
+
+    if (debugger_step_pending()) {
+        r4300i_step();
+        stepped_into_delay_slot = N64CPU.branch;
+        return 1;
+    } else if (stepped_into_delay_slot) {
+        stepped_into_delay_slot = false;
+        return interpreter_fallback_until_no_branch();
+    }
+    return 0;
+}
+
 int n64_dynarec_step() {
+    if (unlikely(n64sys.debugger_state.enabled)) {
+        int taken = debugger_check_before_block();
+        if (taken > 0) {
+            return taken * CYCLES_PER_INSTR;
+        }
+    }
+
     N64CPU.branch = false;
     N64CPU.prev_branch = false;
+
+    if (unlikely(N64CPU.fcr31.enable)) {
+        return interpreter_fallback_fpu_exceptions_enabled() * CYCLES_PER_INSTR;
+    }
+
     u32 physical;
     bool cached;
     if (!resolve_virtual_address(N64CPU.pc, BUS_LOAD, &cached, &physical)) {
@@ -157,32 +279,33 @@ int n64_dynarec_step() {
     n64_dynarec_block_t* block = block_at_address(n64dynarec.sysconfig, N64CPU.pc, physical);
 
     int taken;
-    if (block->run) {
+    if (block->cached_code) {
+        if (++block->cached_run_count >= cached_interpreter_threshold) {
+            mark_metric(METRIC_BLOCK_PROMOTION);
+            taken = missing_block_handler(physical, block, n64dynarec.sysconfig);
+        } else {
+            taken = run_cached_block(block, physical);
+        }
+    } else if (block->run) {
         #ifdef DO_REPEATED_EXEC_DETECTION
         do_repeated_exec_detection(physical, block);
         #endif
-        CODECACHE_ALLOW_EXEC();
-        taken = block->run(&N64CPU);
+        taken = run_compiled_block(block);
     } else {
         taken = missing_block_handler(physical, block, n64dynarec.sysconfig);
     }
 
-#ifdef N64_LOG_JIT_SYNC_POINTS
-    printf("JITSYNC %d %08X ", taken, N64CPU.pc);
-    for (int i = 0; i < 32; i++) {
-        printf("%016" PRIX64, N64CPU.gpr[i]);
-        if (i != 31) {
-            printf(" ");
-        }
+    if (TRACE_ENABLED(TRACE_EVENT_JIT_SYNC_POINT)) {
+        trace_jit_sync_point_t sync = { .pc = N64CPU.pc, .taken = taken };
+        memcpy(sync.gpr, N64CPU.gpr, sizeof(sync.gpr));
+        trace_emit(TRACE_EVENT_JIT_SYNC_POINT, &sync, sizeof(sync));
     }
-    printf("\n");
-#endif
     logdebug("Done running block - took %d cycles - pc is now 0x%016" PRIX64, taken, N64CPU.pc);
 
     return taken * CYCLES_PER_INSTR;
 }
 
-void n64_dynarec_init(u8* codecache, size_t codecache_size) {
+void n64_dynarec_init(u8* codecache, u8* codecache_writable, size_t codecache_size, u8* metadata, size_t metadata_size) {
 #ifdef N64_LOG_COMPILATIONS
     printf("Trying to malloc %ld bytes\n", sizeof(n64_dynarec_t));
 #endif
@@ -196,6 +319,10 @@ void n64_dynarec_init(u8* codecache, size_t codecache_size) {
     }
 
     n64dynarec.codecache = codecache;
+    n64dynarec.codecache_writable = codecache_writable;
+    n64dynarec.metadata = metadata;
+    n64dynarec.metadata_size = metadata_size;
+    n64dynarec.metadata_used = 0;
 
     v2_compiler_init();
 }
@@ -204,4 +331,17 @@ void invalidate_dynarec_all_pages() {
     for (int i = 0; i < BLOCKCACHE_OUTER_SIZE; i++) {
         n64dynarec.blockcache[i] = NULL;
     }
+    r4300i_predecode_invalidate_all();
+}
+
+void dynarec_set_cached_interpreter_threshold(int threshold) {
+    cached_interpreter_threshold = threshold;
+}
+
+void dynarec_mark_code(u32 physical_address) {
+    u32 outer_index = BLOCKCACHE_OUTER_INDEX(physical_address);
+    if (n64dynarec.code_mask[outer_index] == NULL) {
+        n64dynarec.code_mask[outer_index] = dynarec_metadata_alloc_zero(BLOCKCACHE_INNER_SIZE * sizeof(bool));
+    }
+    n64dynarec.code_mask[outer_index][BLOCKCACHE_INNER_INDEX(physical_address)] = true;
 }
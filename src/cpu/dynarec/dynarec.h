@@ -51,22 +51,40 @@ typedef struct n64_dynarec_block {
     size_t host_size;
     n64_block_sysconfig_t sysconfig;
     u64 virtual_address;
+    // Cached interpreter tier: if not NULL, the block hasn't been compiled yet and runs these instead of run.
+    r4300i_predecoded_instruction_t* cached_code;
+    int cached_code_len;
+    int cached_run_count;
     struct n64_dynarec_block* next; // for other sysconfigs
 } n64_dynarec_block_t;
 
+INLINE bool is_valid_dynarec_block(n64_dynarec_block_t* block) {
+    return block->run != NULL || block->cached_code != NULL;
+}
+
 INLINE void copy_dynarec_block(n64_dynarec_block_t* dest, n64_dynarec_block_t* src) {
     dest->run = src->run;
     dest->guest_size = src->guest_size;
     dest->host_size = src->host_size;
     dest->sysconfig = src->sysconfig;
     dest->virtual_address = src->virtual_address;
+    dest->cached_code = src->cached_code;
+    dest->cached_code_len = src->cached_code_len;
+    dest->cached_run_count = src->cached_run_count;
 }
 
 typedef struct n64_dynarec {
     int (*run_block)(u64 block_addr);
+    // Code is run from codecache and written through codecache_writable, another mapping of the same memory
     u8* codecache;
+    u8* codecache_writable;
     u64 codecache_size;
     u64 codecache_used;
+    // Block lists, code masks and cached interpreter blocks. Kept out of the code cache so dispatch never has to make
+    // executable memory writable.
+    u8* metadata;
+    u64 metadata_size;
+    u64 metadata_used;
 
     n64_block_sysconfig_t sysconfig;
 
@@ -82,6 +100,7 @@ INLINE void invalidate_dynarec_page_by_index(u32 outer_index) {
     mark_metric(METRIC_CODE_INVALIDATION);
     n64dynarec.blockcache[outer_index] = NULL;
     n64dynarec.code_mask[outer_index] = NULL;
+    r4300i_predecode_invalidate_page(outer_index);
 }
 
 INLINE bool is_code(u32 physical_address) {
@@ -89,7 +108,28 @@ INLINE bool is_code(u32 physical_address) {
     return code_mask != NULL && code_mask[BLOCKCACHE_INNER_INDEX(physical_address)];
 }
 
+// Every page of RDRAM written since the tracker was last cleared, for tools that compare two systems, e.g. dynarec_compare.
+// Nothing is tracked while rdram_dirty_pages is NULL.
+#define RDRAM_PAGES (N64_RDRAM_SIZE >> BLOCKCACHE_OUTER_SHIFT)
+typedef struct rdram_dirty_pages {
+    bool dirty[RDRAM_PAGES];
+    // In the order they were first written
+    u32 pages[RDRAM_PAGES];
+    int num_dirty;
+} rdram_dirty_pages_t;
+
+extern rdram_dirty_pages_t* rdram_dirty_pages;
+
+INLINE void mark_rdram_dirty(u32 physical_address) {
+    u32 page = BLOCKCACHE_OUTER_INDEX(physical_address);
+    if (unlikely(rdram_dirty_pages != NULL) && page < RDRAM_PAGES && !rdram_dirty_pages->dirty[page]) {
+        rdram_dirty_pages->dirty[page] = true;
+        rdram_dirty_pages->pages[rdram_dirty_pages->num_dirty++] = page;
+    }
+}
+
 INLINE void invalidate_dynarec_page(u32 physical_address) {
+    mark_rdram_dirty(physical_address);
     if (unlikely(is_code(physical_address))) {
         invalidate_dynarec_page_by_index(BLOCKCACHE_OUTER_INDEX(physical_address));
     }
@@ -98,9 +138,13 @@ INLINE void invalidate_dynarec_page(u32 physical_address) {
 // Helper function called by JIT
 int interpreter_fallback_until_no_branch();
 int n64_dynarec_step();
-void n64_dynarec_init(u8* codecache, size_t codecache_size);
+void n64_dynarec_init(u8* codecache, u8* codecache_writable, size_t codecache_size, u8* metadata, size_t metadata_size);
 void invalidate_dynarec_page(u32 physical_address);
 void invalidate_dynarec_all_pages();
+// Number of times a block runs in the cached interpreter before it's compiled. 0 compiles every block immediately.
+void dynarec_set_cached_interpreter_threshold(int threshold);
+// Mark an instruction as code, so writes to it invalidate the page it's in. Used by the interpreter's predecoder.
+void dynarec_mark_code(u32 physical_address);
 
 #ifdef __cplusplus
 }
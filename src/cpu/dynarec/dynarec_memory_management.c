@@ -3,13 +3,18 @@
 #include "dynarec.h"
 
 void flush_code_cache() {
-    // Just set the pointer back to the beginning, no need to clear the actual data.
+    // Just set the pointers back to the beginning, no need to clear the actual data.
+    // Blocks in the metadata point into the code cache, so they're always flushed together.
     n64dynarec.codecache_used = 0;
+    n64dynarec.metadata_used = 0;
 
     // However, the block cache needs to be fully invalidated.
+    // The code masks are metadata too, and the interpreter's predecoded pages rely on them for invalidation.
     for (int i = 0; i < BLOCKCACHE_OUTER_SIZE; i++) {
         n64dynarec.blockcache[i] = NULL;
+        n64dynarec.code_mask[i] = NULL;
     }
+    r4300i_predecode_invalidate_all();
 }
 
 void flush_rsp_code_cache() {
@@ -42,9 +47,19 @@ void* dynarec_bumpalloc_get_next_allocation_ptr() {
     return &n64dynarec.codecache[n64dynarec.codecache_used];
 }
 
-void* dynarec_bumpalloc_zero(size_t size) {
-    u8* ptr = dynarec_bumpalloc(size);
+void* dynarec_code_writable(void* code) {
+    return n64dynarec.codecache_writable + ((u8*)code - n64dynarec.codecache);
+}
 
+void* dynarec_metadata_alloc_zero(size_t size) {
+    // Keeps everything in it pointer aligned
+    size = (size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+    if (n64dynarec.metadata_used + size >= n64dynarec.metadata_size) {
+        flush_code_cache();
+    }
+
+    void* ptr = &n64dynarec.metadata[n64dynarec.metadata_used];
+    n64dynarec.metadata_used += size;
     memset(ptr, 0, size);
 
     return ptr;
@@ -70,3 +85,7 @@ void* rsp_dynarec_bumpalloc(size_t size) {
 void* rsp_dynarec_bumpalloc_get_next_allocation_ptr() {
     return &N64RSPDYNAREC->codecache[N64RSPDYNAREC->codecache_used];
 }
+
+void* rsp_dynarec_code_writable(void* code) {
+    return N64RSPDYNAREC->codecache_writable + ((u8*)code - N64RSPDYNAREC->codecache);
+}
@@ -7,12 +7,19 @@
 
 #include "dynarec.h"
 
+// Allocations in the code caches return the address code runs from. Write it through the address from
+// dynarec_code_writable/rsp_dynarec_code_writable, the code caches are only writable through a second mapping.
 void* dynarec_bumpalloc(size_t size);
 void* dynarec_bumpalloc_get_next_allocation_ptr();
-void* dynarec_bumpalloc_zero(size_t size);
+void* dynarec_code_writable(void* code);
 void* rsp_dynarec_bumpalloc_get_next_allocation_ptr();
 void* rsp_dynarec_bumpalloc(size_t size);
+void* rsp_dynarec_code_writable(void* code);
 
+// Everything the JIT keeps about blocks that isn't code. Always writable, never executable.
+void* dynarec_metadata_alloc_zero(size_t size);
+
+// Only needed around writing code: on macOS the code caches are a single MAP_JIT mapping, writable or executable per thread.
 #ifdef __APPLE__
 #define CODECACHE_ALLOW_WRITES() do { pthread_jit_write_protect_np(false); } while (0)
 #define CODECACHE_ALLOW_EXEC() do { pthread_jit_write_protect_np(true); } while (0)
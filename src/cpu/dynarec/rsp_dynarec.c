@@ -6,13 +6,11 @@
 #include "rsp_dynarec.h"
 #include "jit_rs.h"
 
-#ifdef N64_HAVE_SSE
-#ifdef N64_USE_NEON
-#include <sse2neon.h>
-#else
+#if defined(N64_HAVE_SSE)
 #include <emmintrin.h>
 #include <smmintrin.h>
-#endif
+#elif defined(N64_USE_NEON)
+#include <arm_neon.h>
 #endif
 
 #ifdef __APPLE__
@@ -50,7 +48,7 @@ void reset_rsp_dynarec_code_overlays(rsp_dynarec_t* dynarec) {
     }
 }
 
-rsp_dynarec_t* rsp_dynarec_init(u8* codecache, size_t codecache_size) {
+rsp_dynarec_t* rsp_dynarec_init(u8* codecache, u8* codecache_writable, size_t codecache_size) {
     rsp_dynarec_t* dynarec = calloc(1, sizeof(rsp_dynarec_t));
 
     dynarec->codecache_size = codecache_size;
@@ -59,6 +57,7 @@ rsp_dynarec_t* rsp_dynarec_init(u8* codecache, size_t codecache_size) {
     reset_rsp_dynarec_code_overlays(dynarec);
 
     dynarec->codecache = codecache;
+    dynarec->codecache_writable = codecache_writable;
 
     return dynarec;
 }
@@ -71,7 +70,7 @@ bool code_overlay_matches(int index) {
         return false;
     }
 
-#ifdef N64_HAVE_SSE
+#if defined(N64_HAVE_SSE)
 
     const s128* mask_arr = (s128*)overlay->code_mask;
     const s128* code_arr = (s128*)overlay->code;
@@ -87,6 +86,22 @@ bool code_overlay_matches(int index) {
         }
     }
 
+#elif defined(N64_USE_NEON)
+
+    const u32* mask_arr = overlay->code_mask;
+    const u32* code_arr = overlay->code;
+    const u32* imem_arr = (u32*)N64RSP.sp_imem;
+
+    for (int i = 0; i < RSP_BLOCKCACHE_SIZE; i += 4) {
+        const uint32x4_t mask = vld1q_u32(mask_arr + i);
+        const uint32x4_t code = vld1q_u32(code_arr + i);
+        const uint32x4_t imem = vld1q_u32(imem_arr + i);
+        // equivalent to if ((code ^ imem) & mask)
+        if (vmaxvq_u32(vandq_u32(veorq_u32(code, imem), mask)) != 0) {
+            return false;
+        }
+    }
+
 #else
 
     for (int i = 0; i < RSP_BLOCKCACHE_SIZE; i++) {
@@ -137,6 +152,5 @@ int rsp_dynarec_step() {
         N64RSPDYNAREC->dirty = false;
     }
 
-    CODECACHE_ALLOW_EXEC();
     return N64RSPDYNAREC->code_overlays[N64RSPDYNAREC->selected_code_overlay].blockcache[N64RSP.pc & 0x3FF].run(&N64RSP);
 }
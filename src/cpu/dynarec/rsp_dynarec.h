@@ -29,7 +29,9 @@ typedef struct rsp_code_overlay {
 } rsp_code_overlay_t;
 
 typedef struct rsp_dynarec {
+    // Code is run from codecache and written through codecache_writable, another mapping of the same memory
     u8* codecache;
+    u8* codecache_writable;
     u64 codecache_size;
     u64 codecache_used;
 
@@ -40,7 +42,7 @@ typedef struct rsp_dynarec {
 } rsp_dynarec_t;
 
 void reset_rsp_dynarec_code_overlays(rsp_dynarec_t* dynarec);
-rsp_dynarec_t* rsp_dynarec_init(u8* codecache, size_t codecache_size);
+rsp_dynarec_t* rsp_dynarec_init(u8* codecache, u8* codecache_writable, size_t codecache_size);
 int rsp_dynarec_step();
 int rsp_missing_block_handler();
 
@@ -131,8 +131,10 @@ INLINE dynarec_instruction_category_t cp1_instruction_category(mips_instruction_
             case COP_DMF:
             case COP_MT:
             case COP_DMT:
-            case COP_CT:
                 return NORMAL;
+            // May enable FPU exceptions, which compiled code doesn't raise. The next block checks for them.
+            case COP_CT:
+                return BLOCK_ENDER;
             case COP_BC:
                 switch (instr.r.rt) {
                     case COP_BC_BCT:
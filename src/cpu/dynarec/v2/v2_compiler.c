@@ -3,17 +3,18 @@
 #include "jit_rs.h"
 #include <dynarec/dynarec.h>
 #include <log.h>
+#include <trace.h>
 #include <mem/memory_logger.h>
 #include <mem/n64bus.h>
 #include <disassemble.h>
 #include <dynarec/dynarec_memory_management.h>
 #include <r4300i.h>
 #include <r4300i_register_access.h>
-#include <system/mprotect_utils.h>
 #include <mips_instructions.h>
 #include <system/scheduler.h>
 
 #include "instruction_category.h"
+#include "../block_corpus.h"
 
 //#define N64_LOG_COMPILATIONS
 
@@ -69,9 +70,17 @@ void fill_temp_code(u64 virtual_address, u32 physical_address, bool* code_mask)
             prev_instr_category = temp_code_category[i - 1];
         }
 
+        // End the block before a breakpoint so the breakpoint starts a block of its own, where the dynarec checks for it.
+        // Delay slots can't be split off from their branch, breakpoints on them only work in the interpreter.
+        u64 instr_virtual_address = virtual_address + (i << 2);
+        if (unlikely(n64sys.debugger_state.enabled) && i > 0 && !is_branch(prev_instr_category)
+                && maybe_breakpoint(instr_virtual_address) && is_breakpoint(instr_virtual_address)) {
+            break;
+        }
+
         code_mask[BLOCKCACHE_INNER_INDEX(instr_address)] = true;
 
-        temp_code[i].raw = n64_read_physical_word(instr_address);
+        temp_code[i].raw = n64_fetch_physical_word(instr_address);
         temp_code_category[i] = instr_category(temp_code[i]);
         temp_code_len++;
         instructions_left_in_block--;
@@ -115,7 +124,6 @@ void fill_temp_code(u64 virtual_address, u32 physical_address, bool* code_mask)
 
 #ifdef N64_LOG_COMPILATIONS
         static char buf[50];
-        u64 instr_virtual_address = virtual_address + (i << 2);
         disassemble(instr_virtual_address, temp_code[i].raw, buf, 50);
         printf("%d [%08X]=%08X %s\n", i, (u32)instr_virtual_address, temp_code[i].raw, buf);
 #endif
@@ -192,20 +200,98 @@ int idle_loop_replacement() {
     return ticks_to_skip;
 }
 
+bool replace_idle_loop(n64_dynarec_block_t* block, u64 virtual_address) {
+    if (detect_idle_loop(virtual_address)) {
+        TRACE(TRACE_EVENT_IDLE_LOOP, trace_idle_loop_t, virtual_address);
+        block->run = idle_loop_replacement;
+        block->guest_size = 0;
+        block->host_size = 0;
+        return true;
+    }
+    return false;
+}
+
+static FILE* block_capture_file = NULL;
+
+bool v2_start_block_capture(const char* path) {
+    if (block_capture_file != NULL) {
+        logwarn("Already capturing blocks");
+        return false;
+    }
+    block_capture_file = fopen(path, "wb");
+    if (block_capture_file == NULL) {
+        return false;
+    }
+    setvbuf(block_capture_file, NULL, _IOFBF, 1 << 20);
+
+    block_corpus_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BLOCK_CORPUS_MAGIC, sizeof(header.magic));
+    header.version = BLOCK_CORPUS_VERSION;
+    memcpy(header.image_name, n64sys.mem.rom.header.image_name, sizeof(header.image_name));
+    fwrite(&header, sizeof(header), 1, block_capture_file);
+    logalways("Capturing compiled blocks to %s", path);
+    return true;
+}
+
+void v2_stop_block_capture() {
+    if (block_capture_file != NULL) {
+        fclose(block_capture_file);
+        block_capture_file = NULL;
+    }
+}
+
+static void capture_block(u64 virtual_address, u32 physical_address) {
+    block_corpus_record_t record = {
+        .virtual_address = virtual_address,
+        .physical_address = physical_address,
+        .num_instructions = temp_code_len,
+        .sysconfig = n64dynarec.sysconfig.raw,
+        .cp0_status = N64CP0.status.raw,
+        .fcr31 = N64CPU.fcr31.raw
+    };
+    memcpy(record.gpr, N64CPU.gpr, sizeof(record.gpr));
+    fwrite(&record, sizeof(record), 1, block_capture_file);
+    fwrite(temp_code, sizeof(u32), temp_code_len, block_capture_file);
+}
+
 void v3_compile_new_block(
         n64_dynarec_block_t* block,
         bool* code_mask,
         u64 virtual_address,
         u32 physical_address) {
     fill_temp_code(virtual_address, physical_address, code_mask);
-    if (detect_idle_loop(virtual_address)) {
-        printf("Detected idle loop at %08X, replacing with idle_loop_replacement\n", (u32)virtual_address);
-        block->run = idle_loop_replacement;
-        block->guest_size = 0;
-        block->host_size = 0;
+    if (replace_idle_loop(block, virtual_address)) {
         return;
     }
+    if (unlikely(block_capture_file != NULL)) {
+        capture_block(virtual_address, physical_address);
+    }
     rs_jit_compile_new_block(block, (uint32_t*)temp_code, temp_code_len, virtual_address, physical_address, n64cpu_ptr);
+    TRACE(TRACE_EVENT_BLOCK_COMPILED, trace_block_compiled_t, virtual_address, physical_address, temp_code_len * 4);
+}
+
+void v3_build_cached_block(
+        n64_dynarec_block_t* block,
+        bool* code_mask,
+        u64 virtual_address,
+        u32 physical_address) {
+    fill_temp_code(virtual_address, physical_address, code_mask);
+    if (replace_idle_loop(block, virtual_address)) {
+        return;
+    }
+
+    r4300i_predecoded_instruction_t* cached_code = dynarec_metadata_alloc_zero(temp_code_len * sizeof(r4300i_predecoded_instruction_t));
+    for (int i = 0; i < temp_code_len; i++) {
+        cached_code[i].instruction = temp_code[i];
+        cached_code[i].handler = r4300i_instruction_decode(virtual_address + (i << 2), temp_code[i]);
+    }
+
+    block->cached_code = cached_code;
+    block->cached_code_len = temp_code_len;
+    block->cached_run_count = 0;
+    block->guest_size = temp_code_len * 4;
+    block->host_size = 0;
 }
 
 
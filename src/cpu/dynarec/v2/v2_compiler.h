@@ -24,5 +24,10 @@ void v2_compiler_init();
 void v2_set_idle_loop_detection_enabled(bool enabled);
 
 void v3_compile_new_block(n64_dynarec_block_t *block, bool *code_mask, u64 virtual_address, u32 physical_address);
+// Append every block compiled from now on to a corpus file, see block_corpus.h. Returns false if it can't be opened.
+bool v2_start_block_capture(const char* path);
+void v2_stop_block_capture();
+// Predecode the block for the cached interpreter instead of compiling it
+void v3_build_cached_block(n64_dynarec_block_t *block, bool *code_mask, u64 virtual_address, u32 physical_address);
 
 #endif // N64_V2_COMPILER_H
\ No newline at end of file
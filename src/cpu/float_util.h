@@ -2,6 +2,8 @@
 #define N64_FLOAT_UTIL_H
 
 #include <fenv.h>
+#include <math.h>
+#include "host_fpu.h"
 
 #define F_TO_U32(f) (*((u32*)(&(f))))
 #define D_TO_U64(d) (*((u64*)(&(d))))
@@ -27,29 +29,27 @@ INLINE bool is_qnan_d(double d) {
     return (v & 0x7FF8000000000000) == 0x7FF8000000000000;
 }
 
-INLINE int push_round_mode() {
-    int orig_round = fegetround();
-    switch (N64CPU.fcr31.rounding_mode) {
-        case R4300I_CP1_ROUND_NEAREST:
-            fesetround(FE_TONEAREST);
-            break;
-        case R4300I_CP1_ROUND_ZERO:
-            fesetround(FE_TOWARDZERO);
-            break;
-        case R4300I_CP1_ROUND_POSINF:
-            fesetround(FE_UPWARD);
-            break;
-        case R4300I_CP1_ROUND_NEGINF:
-            fesetround(FE_DOWNWARD);
-            break;
-        default:
-            logfatal("Unknown rounding mode %d", N64CPU.fcr31.rounding_mode);
+// Guest FPU work runs with the host rounding mode matching FCR31 (see guest_fpu_begin), so ROUND.fmt only needs to switch
+// it in the uncommon case that the game has changed it.
+INLINE double round_nearest_d(double d) {
+    if (likely(N64CPU.fcr31.rounding_mode == R4300I_CP1_ROUND_NEAREST)) {
+        return nearbyint(d);
     }
-    return orig_round;
+    host_fpu_set_rounding_mode(R4300I_CP1_ROUND_NEAREST);
+    double result = nearbyint(d);
+    host_fpu_set_rounding_mode(N64CPU.fcr31.rounding_mode);
+    return result;
 }
 
-#define PUSHROUND int orig_round = push_round_mode()
-#define POPROUND fesetround(orig_round)
+INLINE float round_nearest_f(float f) {
+    if (likely(N64CPU.fcr31.rounding_mode == R4300I_CP1_ROUND_NEAREST)) {
+        return nearbyintf(f);
+    }
+    host_fpu_set_rounding_mode(R4300I_CP1_ROUND_NEAREST);
+    float result = nearbyintf(f);
+    host_fpu_set_rounding_mode(N64CPU.fcr31.rounding_mode);
+    return result;
+}
 
 INLINE void set_cause_inexact_operation() {
     N64CPU.fcr31.cause_inexact_operation = true;
@@ -130,12 +130,57 @@ INLINE void set_cause_fpu_convert_raised(int raised) {
     set_cause_fpu_raised(raised);
 }
 
+// Neither tier computes IEEE flags itself, the host FPU raises them. Only flags raised by guest FPU ops may reach FCR31, so the
+// host flags are cleared before those ops run (one op in the interpreter, a whole block in the JIT) and taken right after.
+// Set the sticky flag bits for any that are pending.
+INLINE void fcr31_fold_host_flags() {
+    int raised = host_fpu_take_flags();
+    if (unlikely(raised)) {
+        N64CPU.fcr31.flag |= host_fpu_flags_to_fcr31_bits(raised) & ~N64CPU.fcr31.enable;
+    }
+}
+
+// Set while a compiled block runs. The block switches the host to the guest's rounding mode for its whole length, so
+// interpreter ops it calls into don't need to.
+extern bool n64_guest_fpu_active;
+
+// The host rounds to nearest everywhere else, the guest's mode only applies between these two.
+INLINE void guest_fpu_begin() {
+    if (n64_guest_fpu_active) {
+        // Earlier ops in the block may have raised flags, they're not this op's
+        fcr31_fold_host_flags();
+    } else {
+        host_fpu_enter_guest(N64CPU.fcr31.rounding_mode);
+    }
+}
+
+// Returns the FE_* flags raised since guest_fpu_begin
+INLINE int guest_fpu_end() {
+    if (n64_guest_fpu_active) {
+        return host_fpu_take_flags();
+    }
+    return host_fpu_leave_guest();
+}
+
+// Same as the JIT: sticky flags, unless one of them is enabled. Then it's the only thing in cause and the op traps.
+INLINE void fcr31_set_raised(int raised) {
+    if (likely(raised == 0)) {
+        return;
+    }
+    u32 bits = host_fpu_flags_to_fcr31_bits(raised);
+    if (unlikely(bits & N64CPU.fcr31.enable)) {
+        N64CPU.fcr31.cause = bits;
+    } else {
+        N64CPU.fcr31.flag |= bits;
+    }
+}
+
 #ifdef INSTANT_DMA
-#define fpu_op_check_except(op) do { op; } while(0)
-#define fpu_convert_check_except(op) do { op; } while(0)
+#define fpu_op_check_except(op) do { guest_fpu_begin(); op; fcr31_set_raised(guest_fpu_end()); check_fpu_exception(); } while(0)
+#define fpu_convert_check_except(op) do { guest_fpu_begin(); op; fcr31_set_raised(guest_fpu_end()); check_fpu_exception(); } while(0)
 #else
-#define fpu_op_check_except(op) do { PUSHROUND; feclearexcept(FE_ALL_EXCEPT); op; set_cause_fpu_raised(fetestexcept(FE_ALL_EXCEPT)); POPROUND; } while(0)
-#define fpu_convert_check_except(op) do { feclearexcept(FE_ALL_EXCEPT); op; set_cause_fpu_convert_raised(fetestexcept(FE_ALL_EXCEPT)); check_fpu_exception(); } while(0)
+#define fpu_op_check_except(op) do { guest_fpu_begin(); op; set_cause_fpu_raised(guest_fpu_end()); } while(0)
+#define fpu_convert_check_except(op) do { guest_fpu_begin(); op; set_cause_fpu_convert_raised(guest_fpu_end()); check_fpu_exception(); } while(0)
 #endif
 
 #endif //N64_FLOAT_UTIL_H
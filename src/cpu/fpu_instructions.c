@@ -282,7 +282,7 @@ void set_cause_cvt_l_d(double d) {
     float fs = get_fpu_register_float_fs(instruction.fr.fs); \
     float ft = get_fpu_register_float_ft(instruction.fr.ft); \
     float result;                                            \
-    result = (op);                                           \
+    fpu_op_check_except({ result = (op); });                 \
     set_fpu_register_float(instruction.fr.fd, result);       \
 } while(0)
 
@@ -291,7 +291,7 @@ void set_cause_cvt_l_d(double d) {
     double fs = get_fpu_register_double_fs(instruction.fr.fs); \
     double ft = get_fpu_register_double_ft(instruction.fr.ft); \
     double result;                                             \
-    result = (op);                                           \
+    fpu_op_check_except({ result = (op); });                   \
     set_fpu_register_double(instruction.fr.fd, result);        \
 } while(0)
 #else
@@ -320,6 +320,24 @@ void set_cause_cvt_l_d(double d) {
 } while(0)
 #endif
 
+bool n64_guest_fpu_active = false;
+
+void fcr31_updated(u32 fcr31) {
+    // Outside of a compiled block the new mode is picked up by the next guest FPU op
+    if (n64_guest_fpu_active) {
+        fcr31_t value = { .raw = fcr31 };
+        // The write replaced the flag bits, anything raised before it is stale.
+        host_fpu_enter_guest(value.rounding_mode);
+    }
+}
+
+u32 fcr31_collect_host_flags(u32 fcr31) {
+    fcr31_t value = { .raw = fcr31 };
+    int raised = host_fpu_take_flags();
+    value.flag |= host_fpu_flags_to_fcr31_bits(raised) & ~value.enable;
+    return value.raw;
+}
+
 MIPS_INSTR(mips_mfc1) {
     checkcp1_preservecause;
     s32 value = get_fpu_register_word_fr(instruction.fr.fs);
@@ -354,6 +372,7 @@ MIPS_INSTR(mips_cfc1) {
             value = N64CPU.fcr0.raw;
             break;
         case 31:
+            // Every FPU op already put its flags in FCR31, whatever the host has pending is from somewhere else
             value = N64CPU.fcr31.raw;
             break;
         default:
@@ -374,6 +393,7 @@ MIPS_INSTR(mips_ctc1) {
         case 31: {
             value &= 0x183ffff; // mask out bits held 0
             N64CPU.fcr31.raw = value;
+            fcr31_updated(value);
             check_fpu_exception();
             break;
         }
@@ -448,7 +468,7 @@ MIPS_INSTR(mips_cp_round_l_d) {
     double fs = get_fpu_register_double_fs(instruction.fr.fs);
     check_cvt_arg_l_d(fs);
     s64 result;
-    fpu_convert_check_except({ result = nearbyint(fs); });
+    fpu_convert_check_except({ result = round_nearest_d(fs); });
     check_round(result, fs);
     set_fpu_register_dword(instruction.fr.fd, result);
 }
@@ -468,7 +488,7 @@ MIPS_INSTR(mips_cp_round_l_s) {
     float fs = get_fpu_register_float_fs(instruction.fr.fs);
     check_cvt_arg_l_s(fs);
     s64 result;
-    fpu_convert_check_except({ result = nearbyintf(fs); });
+    fpu_convert_check_except({ result = round_nearest_f(fs); });
     check_round(result, fs);
     set_fpu_register_dword(instruction.fr.fd, result);
 }
@@ -488,7 +508,7 @@ MIPS_INSTR(mips_cp_round_w_d) {
     double fs = get_fpu_register_double_fs(instruction.fr.fs);
     check_cvt_arg_w_d(fs);
     s32 result;
-    fpu_convert_check_except({ result = nearbyint(fs); });
+    fpu_convert_check_except({ result = round_nearest_d(fs); });
     if (result != fs) {
         set_cause_inexact_operation();
     }
@@ -591,7 +611,7 @@ MIPS_INSTR(mips_cp_round_w_s) {
     float fs = get_fpu_register_float_fs(instruction.fr.fs);
     check_cvt_arg_w_s(fs);
     s32 result;
-    fpu_convert_check_except({ result = nearbyintf(fs); });
+    fpu_convert_check_except({ result = round_nearest_f(fs); });
     check_round(result, fs);
     set_fpu_register_word(instruction.fr.fd, result);
 }
@@ -635,9 +655,7 @@ MIPS_INSTR(mips_cp_cvt_l_s) {
     float fs = get_fpu_register_float_fs(instruction.fr.fs);
     check_cvt_arg_l_s(fs);
     s64 result;
-    PUSHROUND;
     fpu_convert_check_except({ result = rintf(fs); });
-    POPROUND;
     check_round(result, fs);
     set_fpu_register_dword(instruction.fr.fd, result);
 }
@@ -647,9 +665,7 @@ MIPS_INSTR(mips_cp_cvt_l_d) {
     double fs = get_fpu_register_double_fs(instruction.fr.fs);
     check_cvt_arg_l_d(fs);
     s64 result;
-    PUSHROUND;
     fpu_convert_check_except({ result = rint(fs); });
-    POPROUND;
     check_round(result, fs);
     set_fpu_register_dword(instruction.fr.fd, result);
 }
@@ -693,9 +709,7 @@ MIPS_INSTR(mips_cp_cvt_w_s) {
     float fs = get_fpu_register_float_fs(instruction.fr.fs);
     check_cvt_arg_w_s(fs);
     s32 result;
-    PUSHROUND;
     fpu_convert_check_except({ result = rintf(fs); });
-    POPROUND;
     check_round(result, fs);
     set_fpu_register_word(instruction.fr.fd, result);
 }
@@ -705,9 +719,7 @@ MIPS_INSTR(mips_cp_cvt_w_d) {
     double fs = get_fpu_register_double_fs(instruction.fr.fs);
     check_cvt_arg_w_d(fs);
     s32 result;
-    PUSHROUND;
     fpu_convert_check_except({ result = rint(fs); });
-    POPROUND;
     check_round(result, fs);
     set_fpu_register_word(instruction.fr.fd, result);
 }
@@ -0,0 +1,193 @@
+#ifndef N64_HOST_FPU_H
+#define N64_HOST_FPU_H
+
+// Direct access to the host FPU's rounding mode and exception flags.
+// The fenv.h functions also save and restore the x87 unit on x86_64, which the emulator never uses, and are several times slower
+// than reading and writing MXCSR / FPCR+FPSR. Flags are returned as FE_* bits so callers don't need to care about the host.
+//
+// Outside of guest FPU work the host rounds to nearest, like C code expects. host_fpu_enter_guest() and
+// host_fpu_leave_guest() switch to the guest's rounding mode and back.
+
+#include <fenv.h>
+#include <util.h>
+#include "r4300i.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <xmmintrin.h>
+
+#define MXCSR_FLAG_INVALID   (1 << 0)
+#define MXCSR_FLAG_DIVBYZERO (1 << 2)
+#define MXCSR_FLAG_OVERFLOW  (1 << 3)
+#define MXCSR_FLAG_UNDERFLOW (1 << 4)
+#define MXCSR_FLAG_INEXACT   (1 << 5)
+#define MXCSR_FLAG_MASK      0x3F
+#define MXCSR_ROUNDING_SHIFT 13
+#define MXCSR_ROUNDING_MASK  (3 << MXCSR_ROUNDING_SHIFT)
+
+INLINE int host_fpu_mxcsr_flags(u32 mxcsr) {
+    int flags = 0;
+    if (mxcsr & MXCSR_FLAG_INVALID) flags |= FE_INVALID;
+    if (mxcsr & MXCSR_FLAG_DIVBYZERO) flags |= FE_DIVBYZERO;
+    if (mxcsr & MXCSR_FLAG_OVERFLOW) flags |= FE_OVERFLOW;
+    if (mxcsr & MXCSR_FLAG_UNDERFLOW) flags |= FE_UNDERFLOW;
+    if (mxcsr & MXCSR_FLAG_INEXACT) flags |= FE_INEXACT;
+    return flags;
+}
+
+INLINE int host_fpu_get_flags() {
+    return host_fpu_mxcsr_flags(_mm_getcsr());
+}
+
+INLINE void host_fpu_clear_flags() {
+    _mm_setcsr(_mm_getcsr() & ~MXCSR_FLAG_MASK);
+}
+
+INLINE u32 host_fpu_mxcsr_rounding(int n64_rounding_mode) {
+    // MXCSR encodes nearest, down, up, zero
+    static const u32 mxcsr_rounding[4] = {
+            [R4300I_CP1_ROUND_NEAREST] = 0,
+            [R4300I_CP1_ROUND_ZERO]    = 3,
+            [R4300I_CP1_ROUND_POSINF]  = 2,
+            [R4300I_CP1_ROUND_NEGINF]  = 1
+    };
+    return mxcsr_rounding[n64_rounding_mode & 3] << MXCSR_ROUNDING_SHIFT;
+}
+
+INLINE void host_fpu_set_rounding_mode(int n64_rounding_mode) {
+    u32 mxcsr = _mm_getcsr() & ~MXCSR_ROUNDING_MASK;
+    _mm_setcsr(mxcsr | host_fpu_mxcsr_rounding(n64_rounding_mode));
+}
+
+// Both in a single write
+INLINE void host_fpu_enter_guest(int n64_rounding_mode) {
+    u32 mxcsr = _mm_getcsr() & ~(MXCSR_ROUNDING_MASK | MXCSR_FLAG_MASK);
+    _mm_setcsr(mxcsr | host_fpu_mxcsr_rounding(n64_rounding_mode));
+}
+
+INLINE int host_fpu_leave_guest() {
+    u32 mxcsr = _mm_getcsr();
+    _mm_setcsr(mxcsr & ~(MXCSR_ROUNDING_MASK | MXCSR_FLAG_MASK));
+    return host_fpu_mxcsr_flags(mxcsr);
+}
+
+#elif defined(__aarch64__)
+
+#define FPSR_FLAG_INVALID   (1 << 0)
+#define FPSR_FLAG_DIVBYZERO (1 << 1)
+#define FPSR_FLAG_OVERFLOW  (1 << 2)
+#define FPSR_FLAG_UNDERFLOW (1 << 3)
+#define FPSR_FLAG_INEXACT   (1 << 4)
+#define FPSR_FLAG_MASK      0x9F // Includes the input denormal flag
+#define FPCR_ROUNDING_SHIFT 22
+#define FPCR_ROUNDING_MASK  (3ULL << FPCR_ROUNDING_SHIFT)
+
+INLINE u64 host_fpu_read_fpsr() {
+    u64 fpsr;
+    __asm__ volatile("mrs %0, fpsr" : "=r"(fpsr) :: "memory");
+    return fpsr;
+}
+
+INLINE int host_fpu_fpsr_flags(u64 fpsr) {
+    int flags = 0;
+    if (fpsr & FPSR_FLAG_INVALID) flags |= FE_INVALID;
+    if (fpsr & FPSR_FLAG_DIVBYZERO) flags |= FE_DIVBYZERO;
+    if (fpsr & FPSR_FLAG_OVERFLOW) flags |= FE_OVERFLOW;
+    if (fpsr & FPSR_FLAG_UNDERFLOW) flags |= FE_UNDERFLOW;
+    if (fpsr & FPSR_FLAG_INEXACT) flags |= FE_INEXACT;
+    return flags;
+}
+
+INLINE int host_fpu_get_flags() {
+    return host_fpu_fpsr_flags(host_fpu_read_fpsr());
+}
+
+INLINE void host_fpu_clear_flags() {
+    u64 fpsr = host_fpu_read_fpsr() & ~(u64)FPSR_FLAG_MASK;
+    __asm__ volatile("msr fpsr, %0" :: "r"(fpsr) : "memory");
+}
+
+INLINE void host_fpu_set_rounding_mode(int n64_rounding_mode) {
+    // FPCR encodes nearest, up, down, zero
+    static const u64 fpcr_rounding[4] = {
+            [R4300I_CP1_ROUND_NEAREST] = 0,
+            [R4300I_CP1_ROUND_ZERO]    = 3,
+            [R4300I_CP1_ROUND_POSINF]  = 1,
+            [R4300I_CP1_ROUND_NEGINF]  = 2
+    };
+    u64 fpcr;
+    __asm__ volatile("mrs %0, fpcr" : "=r"(fpcr) :: "memory");
+    fpcr = (fpcr & ~FPCR_ROUNDING_MASK) | (fpcr_rounding[n64_rounding_mode & 3] << FPCR_ROUNDING_SHIFT);
+    __asm__ volatile("msr fpcr, %0" :: "r"(fpcr) : "memory");
+}
+
+INLINE void host_fpu_enter_guest(int n64_rounding_mode) {
+    host_fpu_set_rounding_mode(n64_rounding_mode);
+    host_fpu_clear_flags();
+}
+
+INLINE int host_fpu_leave_guest() {
+    u64 fpsr = host_fpu_read_fpsr();
+    __asm__ volatile("msr fpsr, %0" :: "r"(fpsr & ~(u64)FPSR_FLAG_MASK) : "memory");
+    host_fpu_set_rounding_mode(R4300I_CP1_ROUND_NEAREST);
+    return host_fpu_fpsr_flags(fpsr);
+}
+
+#else
+
+INLINE int host_fpu_get_flags() {
+    return fetestexcept(FE_ALL_EXCEPT);
+}
+
+INLINE void host_fpu_clear_flags() {
+    feclearexcept(FE_ALL_EXCEPT);
+}
+
+INLINE void host_fpu_set_rounding_mode(int n64_rounding_mode) {
+    static const int fe_rounding[4] = {
+            [R4300I_CP1_ROUND_NEAREST] = FE_TONEAREST,
+            [R4300I_CP1_ROUND_ZERO]    = FE_TOWARDZERO,
+            [R4300I_CP1_ROUND_POSINF]  = FE_UPWARD,
+            [R4300I_CP1_ROUND_NEGINF]  = FE_DOWNWARD
+    };
+    fesetround(fe_rounding[n64_rounding_mode & 3]);
+}
+
+INLINE void host_fpu_enter_guest(int n64_rounding_mode) {
+    host_fpu_set_rounding_mode(n64_rounding_mode);
+    host_fpu_clear_flags();
+}
+
+INLINE int host_fpu_leave_guest() {
+    int flags = host_fpu_get_flags();
+    host_fpu_clear_flags();
+    fesetround(FE_TONEAREST);
+    return flags;
+}
+
+#endif
+
+// Defined for every host above:
+// void host_fpu_enter_guest(int n64_rounding_mode): switch to the guest's rounding mode, with no flags raised
+// int host_fpu_leave_guest(): the flags raised since host_fpu_enter_guest, then back to rounding to nearest with none raised
+
+// Read and clear the host exception flags
+INLINE int host_fpu_take_flags() {
+    int flags = host_fpu_get_flags();
+    if (flags) {
+        host_fpu_clear_flags();
+    }
+    return flags;
+}
+
+// Convert FE_* bits to the layout of the flag, enable and cause fields of FCR31 (inexact, underflow, overflow, div by zero, invalid)
+INLINE u32 host_fpu_flags_to_fcr31_bits(int flags) {
+    u32 bits = 0;
+    if (flags & FE_INEXACT) bits |= 1 << 0;
+    if (flags & FE_UNDERFLOW) bits |= 1 << 1;
+    if (flags & FE_OVERFLOW) bits |= 1 << 2;
+    if (flags & FE_DIVBYZERO) bits |= 1 << 3;
+    if (flags & FE_INVALID) bits |= 1 << 4;
+    return bits;
+}
+
+#endif //N64_HOST_FPU_H
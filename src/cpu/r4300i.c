@@ -761,6 +761,46 @@ void on_tlb_exception(u64 address) {
     N64CP0.entry_hi.r = (address >> 62) & 0b11;
 }
 
+// Predecoded instructions for the interpreter, one lazily allocated page per 4KiB page of RDRAM.
+// Predecoded instructions are marked in the dynarec's code_mask, so writes to them drop the page just like compiled blocks.
+#define R4300I_PREDECODE_PAGES (N64_RDRAM_SIZE >> BLOCKCACHE_OUTER_SHIFT)
+static r4300i_predecoded_instruction_t* predecoded_pages[R4300I_PREDECODE_PAGES];
+
+void r4300i_predecode_invalidate_page(u32 outer_index) {
+    if (outer_index < R4300I_PREDECODE_PAGES && predecoded_pages[outer_index] != NULL) {
+        free(predecoded_pages[outer_index]);
+        predecoded_pages[outer_index] = NULL;
+    }
+}
+
+void r4300i_predecode_invalidate_all() {
+    for (int i = 0; i < R4300I_PREDECODE_PAGES; i++) {
+        r4300i_predecode_invalidate_page(i);
+    }
+}
+
+INLINE r4300i_predecoded_instruction_t* get_predecoded_instruction(u64 pc, u32 physical_pc) {
+    u32 outer_index = BLOCKCACHE_OUTER_INDEX(physical_pc);
+    u32 inner_index = BLOCKCACHE_INNER_INDEX(physical_pc);
+    r4300i_predecoded_instruction_t* page = predecoded_pages[outer_index];
+
+    if (unlikely(page == NULL || page[inner_index].handler == NULL)) {
+        // Marking the instruction as code can flush the code cache, which drops every predecoded page, so do it first.
+        dynarec_mark_code(physical_pc);
+
+        page = predecoded_pages[outer_index];
+        if (page == NULL) {
+            page = calloc(BLOCKCACHE_INNER_SIZE, sizeof(r4300i_predecoded_instruction_t));
+            predecoded_pages[outer_index] = page;
+        }
+
+        page[inner_index].instruction.raw = n64_fetch_physical_word(physical_pc);
+        page[inner_index].handler = r4300i_instruction_decode(pc, page[inner_index].instruction);
+    }
+
+    return &page[inner_index];
+}
+
 void r4300i_step() {
     N64CPU.prev_branch = N64CPU.branch;
     N64CPU.branch = false;
@@ -782,6 +822,7 @@ void r4300i_step() {
         return;
     }
     mips_instruction_t instruction;
+    mipsinstr_handler_t handler;
 
 #ifdef ENABLE_ICACHE
     if (cached) {
@@ -792,16 +833,24 @@ void r4300i_step() {
             u32 line_start = get_icache_line_start(physical_pc);
             for (int i = 0; i < 8; i++) {
                 u32 addr = line_start + i * 4;
-                N64CPU.icache[cache_line].data[i] = n64_read_physical_word(addr);
+                N64CPU.icache[cache_line].data[i] = n64_fetch_physical_word(addr);
             }
             N64CPU.icache[cache_line].valid = true;
             N64CPU.icache[cache_line].ptag = ptag;
         }
         instruction.raw = N64CPU.icache[cache_line].data[(physical_pc & 0x1F) >> 2];
     } else {
-#endif
-        instruction.raw = n64_read_physical_word(physical_pc);
-#ifdef ENABLE_ICACHE
+        instruction.raw = n64_fetch_physical_word(physical_pc);
+    }
+    handler = r4300i_instruction_decode(pc, instruction);
+#else
+    if (likely(physical_pc < N64_RDRAM_SIZE)) {
+        r4300i_predecoded_instruction_t* predecoded = get_predecoded_instruction(pc, physical_pc);
+        instruction = predecoded->instruction;
+        handler = predecoded->handler;
+    } else {
+        instruction.raw = n64_fetch_physical_word(physical_pc);
+        handler = r4300i_instruction_decode(pc, instruction);
     }
 #endif
 
@@ -809,7 +858,7 @@ void r4300i_step() {
     N64CPU.pc = N64CPU.next_pc;
     N64CPU.next_pc += 4;
 
-    r4300i_instruction_decode(pc, instruction)(instruction);
+    handler(instruction);
     N64CPU.exception = false; // only used in dynarec
 }
 
@@ -883,6 +932,27 @@ void cp0_status_updated() {
             || (N64CPU.cp0.supervisor_mode && N64CPU.cp0.status.sx)
                || (N64CPU.cp0.user_mode && N64CPU.cp0.status.ux);
     n64dynarec.sysconfig.fr = N64CP0.status.fr;
-    N64CP0.resolve_virtual_address = get_resolve_virtual_address_handler();
+    resolve_virtual_address_handler handler = get_resolve_virtual_address_handler();
+    if (handler != N64CP0.resolve_virtual_address) {
+        // Which regions are mapped and accessible depends on the mode, so translations can't be reused across modes.
+        softtlb_flush();
+        N64CP0.resolve_virtual_address = handler;
+    }
     r4300i_interrupt_update();
-}
\ No newline at end of file
+}
+
+u64 r4300i_hash_state(const r4300i_t* cpu) {
+    u64 hash = hash_mix(0, cpu->pc);
+    for (int i = 0; i < 32; i++) {
+        hash = hash_mix(hash, cpu->gpr[i]);
+        hash = hash_mix(hash, cpu->f[i].raw);
+    }
+    hash = hash_mix(hash, cpu->mult_lo);
+    hash = hash_mix(hash, cpu->mult_hi);
+    hash = hash_mix(hash, cpu->llbit);
+    hash = hash_mix(hash, cpu->fcr31.raw);
+#define HASH_CP0(reg) hash = hash_mix(hash, cpu->cp0.reg);
+    R4300I_VISIBLE_CP0_REGISTERS(HASH_CP0)
+#undef HASH_CP0
+    return hash;
+}
@@ -495,34 +495,32 @@ static inline u32 get_tlb_exception_code(tlb_error_t error, bus_access_t bus_acc
     }
 }
 
-// Set-associative cache for the TLB
-// todo - tune this value
-#define TLB_CACHE_ASSOCIATIVITY 4u
-#define TLB_CACHE_BLOCK_OFFSET_BITS 12
-// todo - tune this value
-#define TLB_CACHE_INDEX_BITS 15
-
-static_assert(TLB_CACHE_BLOCK_OFFSET_BITS + TLB_CACHE_INDEX_BITS <= 40, "block offset + index must not exceed 40 bits (check how VPN is calculated to see why)");
-
-// Derived TLB cache stuff
-#define TLB_CACHE_TAG_BITS ((64 - (TLB_CACHE_INDEX_BITS)) - (TLB_CACHE_BLOCK_OFFSET_BITS))
-// Getters for address components
-#define GET_TLB_CACHE_BLOCK_OFFSET(vaddr) ((vaddr) & (((u64)1 << (TLB_CACHE_BLOCK_OFFSET_BITS)) - 1))
-#define GET_TLB_CACHE_INDEX(vaddr) (((vaddr) >> (TLB_CACHE_BLOCK_OFFSET_BITS)) & (((u64)1 << TLB_CACHE_INDEX_BITS) - 1))
-#define GET_TLB_CACHE_TAG(vaddr) (((vaddr) >> ((TLB_CACHE_BLOCK_OFFSET_BITS) + (TLB_CACHE_INDEX_BITS))) & (((u64)1 << (TLB_CACHE_TAG_BITS)) - 1))
-#define GET_TLB_CACHE_BASE_ADDRESS(vaddr) ((vaddr) & ~(((u64)1 << TLB_CACHE_BLOCK_OFFSET_BITS) - 1))
-
-typedef struct tlb_cache_entry {
-    bool valid; // Is the TLB cache entry valid or do we need to fall back to the slow path?
-    bool hit; // Is the address a TLB hit?
-    int entry_num; // which tlb index did it match?
-    bool cached; // Should the icache/dcache be used?
-    u64 tag;
-    u32 base_address;
-    u8 asid;
+// Software TLB: a small direct-mapped table of translations for TLB-mapped pages.
+// Entries are filled lazily by tlb_probe(). TLBWI/TLBWR only clear the entries that the old and new TLB entries cover,
+// while a change of ASID drops all non-global entries. The JIT reads this table directly from generated code.
+#define SOFTTLB_PAGE_SHIFT 12
+#define SOFTTLB_INDEX_BITS 10
+#define SOFTTLB_SIZE (1 << SOFTTLB_INDEX_BITS)
+// Set in a tag to mark it valid, so that a zeroed table is an empty table. Page numbers never use this bit.
+#define SOFTTLB_TAG_VALID ((u64)1 << 63)
+
+#define GET_SOFTTLB_PAGE(vaddr) ((u64)(vaddr) >> SOFTTLB_PAGE_SHIFT)
+#define GET_SOFTTLB_TAG(vaddr) (GET_SOFTTLB_PAGE(vaddr) | SOFTTLB_TAG_VALID)
+#define GET_SOFTTLB_INDEX(vaddr) (GET_SOFTTLB_PAGE(vaddr) & (SOFTTLB_SIZE - 1))
+#define GET_SOFTTLB_PAGE_OFFSET(vaddr) ((vaddr) & ((1 << SOFTTLB_PAGE_SHIFT) - 1))
+
+typedef struct softtlb_entry {
+    u64 load_tag;  // Tag of the page this entry translates for loads, or 0 if invalid
+    u64 store_tag; // Same as load_tag, but only set if the page is writable (dirty)
+    u32 paddr;     // Physical address of the start of the page
+    bool cached;   // Should the icache/dcache be used?
     bool global;
-    bool dirty;
-} tlb_cache_entry_t;
+    u8 entry_num;  // Which TLB entry the page was translated by
+    u8 asid;
+    u64 unused;    // Pads the entry to a power of two, so the JIT can index the table with a shift
+} softtlb_entry_t;
+
+static_assert(sizeof(softtlb_entry_t) == 32, "softtlb_entry_t must be a power of two in size");
 
 typedef bool (*resolve_virtual_address_handler)(u64 vaddr, bus_access_t bus_access, bool* cached, u32* paddr);
 
@@ -558,7 +556,8 @@ typedef struct cp0 {
     tlb_entry_t    tlb[32];
     tlb_error_t tlb_error;
 
-    tlb_cache_entry_t tlb_cache[1 << TLB_CACHE_INDEX_BITS][TLB_CACHE_ASSOCIATIVITY];
+    softtlb_entry_t softtlb[SOFTTLB_SIZE];
+    u8 softtlb_asid; // ASID the non-global entries in softtlb were translated with
 
     bool kernel_mode;
     bool supervisor_mode;
@@ -571,6 +570,8 @@ typedef union fcr0 {
     u32 raw;
 } fcr0_t;
 
+#define FCR31_ENABLE_SHIFT 7
+#define FCR31_CAUSE_SHIFT 12
 #define FCR31_COMPARE_SHIFT 23
 #define FCR31_COMPARE_MASK (1 << (FCR31_COMPARE_SHIFT))
 
@@ -664,13 +665,37 @@ extern r4300i_t* n64cpu_ptr;
 
 typedef void(*mipsinstr_handler_t)(mips_instruction_t);
 
+typedef struct r4300i_predecoded_instruction {
+    mipsinstr_handler_t handler; // NULL if the instruction has not been decoded yet
+    mips_instruction_t instruction;
+} r4300i_predecoded_instruction_t;
+
 void on_tlb_exception(u64 address);
 void r4300i_step();
 void r4300i_handle_exception(u64 pc, u32 code, int coprocessor_error);
 mipsinstr_handler_t r4300i_instruction_decode(u64 pc, mips_instruction_t instr);
 void r4300i_interrupt_update();
 bool instruction_stable(mips_instruction_t instr);
+void r4300i_predecode_invalidate_page(u32 outer_index);
+void r4300i_predecode_invalidate_all();
 void cp0_status_updated();
+// Call after writing FCR31. Inside a compiled block this switches the host FPU to the new rounding mode for the rest of it.
+void fcr31_updated(u32 fcr31);
+// Fold the host FPU exception flags raised by JIT-compiled code into the flag bits of an FCR31 value.
+u32 fcr31_collect_host_flags(u32 fcr31);
+// Drop all software TLB entries translated by this TLB entry
+void softtlb_invalidate_entry(tlb_entry_t* tlb_entry);
+// Drop non-global software TLB entries if the ASID in EntryHi changed since they were translated
+void softtlb_asid_updated();
+void softtlb_flush();
+
+// The CP0 registers the game can see. The TLB and caches are only visible through their effects.
+#define R4300I_VISIBLE_CP0_REGISTERS(X) \
+    X(index) X(random) X(entry_lo0.raw) X(entry_lo1.raw) X(context.raw) X(page_mask.raw) X(wired) X(bad_vaddr) \
+    X(count) X(entry_hi.raw) X(compare) X(status.raw) X(cause.raw) X(EPC) X(PRId) X(config) X(lladdr) \
+    X(watch_lo.raw) X(watch_hi) X(x_context.raw) X(parity_error) X(cache_error) X(tag_lo.raw) X(tag_hi) X(error_epc)
+// Hash of every register the game can see, for spotting where two runs went different ways
+u64 r4300i_hash_state(const r4300i_t* cpu);
 
 extern const char* register_names[];
 extern const char* cp0_register_names[];
@@ -89,6 +89,7 @@ INLINE void set_cp0_register_word(u8 r, u32 value) {
             break;
         case R4300I_CP0_REG_ENTRYHI:
             N64CPU.cp0.entry_hi.raw = se_32_64(value) & CP0_ENTRY_HI_WRITE_MASK;
+            softtlb_asid_updated();
             break;
         case R4300I_CP0_REG_PAGEMASK:
             N64CPU.cp0.page_mask.raw = value & CP0_PAGEMASK_WRITE_MASK;
@@ -270,6 +271,7 @@ INLINE void set_cp0_register_dword(u8 r, u64 value) {
             logfatal("Writing CP0 register R4300I_CP0_REG_COUNT as dword!");
         case R4300I_CP0_REG_ENTRYHI:
             N64CPU.cp0.entry_hi.raw = value & CP0_ENTRY_HI_WRITE_MASK;
+            softtlb_asid_updated();
             break;
         case R4300I_CP0_REG_COMPARE:
             reschedule_compare_interrupt(0);
@@ -7,6 +7,7 @@
 #include <mem/addresses.h>
 #include <system/n64system.h>
 #include <rdp/rdp.h>
+#include <rdp/fast_forward.h>
 #include <mem/n64bus.h>
 #include <cpu/dynarec/dynarec.h>
 #include <mem/mem_util.h>
@@ -166,6 +167,7 @@ INLINE void rsp_dma_read() {
         u8* mem = (mem_addr_reg.imem ? N64RSP.sp_imem : N64RSP.sp_dmem);
         char imem_dmem = mem_addr_reg.imem ? 'i' : 'd';
         loginfo("RSP DMA READ! rdram[0x%08X] to %cmem[0x%03X] length %d / 0x%X", dram_address, imem_dmem, mem_address, length, length);
+        check_fast_forward_read_range(dram_address, length);
         for (int j = 0; j < length; j += 4) {
             u16 addr = (mem_address + j) & 0xFFF;
             u32 src = dram_address + j;
@@ -246,8 +248,9 @@ INLINE void rsp_dma_write() {
 
         // Invalidate all pages touched by the DMA
         // This is probably unnecessary, since why would someone be copying code from the RSP to the CPU and then executing it?
-        for (int j = 0; j < length; j += BLOCKCACHE_PAGE_SIZE) {
-            invalidate_dynarec_page(dram_address + j);
+        // Stepping by whole pages from an unaligned start could skip the last page, so step through the page indices instead
+        for (u32 page = BLOCKCACHE_OUTER_INDEX(dram_address); page <= BLOCKCACHE_OUTER_INDEX(dram_address + length - 1); page++) {
+            invalidate_dynarec_page(page << BLOCKCACHE_OUTER_SHIFT);
         }
 
         int skip = i == N64RSP.io.dma.count ? 0 : N64RSP.io.dma.skip;
@@ -1,121 +1,51 @@
 #include "rsp_vector_instructions.h"
 
-#ifdef N64_HAVE_SSE
-#ifdef N64_USE_NEON
-#include <sse2neon.h>
-#else
-#include <emmintrin.h>
-#include <immintrin.h>
-#endif
-#include <n64_rsp_bus.h>
-#endif
-
 #include <log.h>
 
 #include "rsp.h"
 #include "rsp_rom.h"
 #include "n64_rsp_bus.h"
+#include "rsp_vector_internal.h"
+#include "rsp_vector_simd.h"
+#include "rsp_vector_reference.h"
 
-#define defvs vu_reg_t* vs = &N64RSP.vu_regs[instruction.cp2_vec.vs]
-#define defvt vu_reg_t* vt = &N64RSP.vu_regs[instruction.cp2_vec.vt]
-#define defvd vu_reg_t* vd = &N64RSP.vu_regs[instruction.cp2_vec.vd]
 #define defvte vu_reg_t vte = get_vte(&N64RSP.vu_regs[instruction.cp2_vec.vt], instruction.cp2_vec.e)
-
-INLINE s16 clamp_signed(s64 value) {
-    if (value < -32768) return -32768;
-    if (value > 32767) return 32767;
-    return value;
-}
-
-#define clamp_unsigned(x) ((x) < 0 ? 0 : ((x) > 32767 ? 65535 : x))
-
-INLINE bool is_sign_extension(s16 high, s16 low) {
-    if (high == 0) {
-        return (low & 0x8000) == 0;
-    } else if (high == -1) {
-        return (low & 0x8000) == 0x8000;
-    }
-    return false;
-}
-
-#ifndef N64_HAVE_SSE
-INLINE vu_reg_t broadcast(vu_reg_t* vt, int lane0, int lane1, int lane2, int lane3, int lane4, int lane5, int lane6, int lane7) {
-    vu_reg_t vte;
-    vte.elements[VU_ELEM_INDEX(0)] = vt->elements[VU_ELEM_INDEX(lane0)];
-    vte.elements[VU_ELEM_INDEX(1)] = vt->elements[VU_ELEM_INDEX(lane1)];
-    vte.elements[VU_ELEM_INDEX(2)] = vt->elements[VU_ELEM_INDEX(lane2)];
-    vte.elements[VU_ELEM_INDEX(3)] = vt->elements[VU_ELEM_INDEX(lane3)];
-    vte.elements[VU_ELEM_INDEX(4)] = vt->elements[VU_ELEM_INDEX(lane4)];
-    vte.elements[VU_ELEM_INDEX(5)] = vt->elements[VU_ELEM_INDEX(lane5)];
-    vte.elements[VU_ELEM_INDEX(6)] = vt->elements[VU_ELEM_INDEX(lane6)];
-    vte.elements[VU_ELEM_INDEX(7)] = vt->elements[VU_ELEM_INDEX(lane7)];
-    return vte;
-}
+#define defvtevec vu_vec_t vte = get_vte_vec(&N64RSP.vu_regs[instruction.cp2_vec.vt], instruction.cp2_vec.e)
+
+#ifndef N64_BIG_ENDIAN
+// Byte shuffles for each element specifier. Lanes are stored in reverse order, so lane 0 is in bytes 14 and 15.
+static const u8 vte_shuffle[16][16] = {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},       // whole vector
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},       // whole vector
+        {2, 3, 2, 3, 6, 7, 6, 7, 10, 11, 10, 11, 14, 15, 14, 15},     // 0q
+        {0, 1, 0, 1, 4, 5, 4, 5, 8, 9, 8, 9, 12, 13, 12, 13},         // 1q
+        {6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15},     // 0h
+        {4, 5, 4, 5, 4, 5, 4, 5, 12, 13, 12, 13, 12, 13, 12, 13},     // 1h
+        {2, 3, 2, 3, 2, 3, 2, 3, 10, 11, 10, 11, 10, 11, 10, 11},     // 2h
+        {0, 1, 0, 1, 0, 1, 0, 1, 8, 9, 8, 9, 8, 9, 8, 9},             // 3h
+        {14, 15, 14, 15, 14, 15, 14, 15, 14, 15, 14, 15, 14, 15, 14, 15}, // 0
+        {12, 13, 12, 13, 12, 13, 12, 13, 12, 13, 12, 13, 12, 13, 12, 13}, // 1
+        {10, 11, 10, 11, 10, 11, 10, 11, 10, 11, 10, 11, 10, 11, 10, 11}, // 2
+        {8, 9, 8, 9, 8, 9, 8, 9, 8, 9, 8, 9, 8, 9, 8, 9},             // 3
+        {6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7, 6, 7},             // 4
+        {4, 5, 4, 5, 4, 5, 4, 5, 4, 5, 4, 5, 4, 5, 4, 5},             // 5
+        {2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3},             // 6
+        {0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1},             // 7
+};
 #endif
 
-INLINE vu_reg_t get_vte(vu_reg_t* vt, u8 e) {
-    vu_reg_t vte;
-    switch(e) {
-        case 0 ... 1:
-            return *vt;
-        case 2:
-#ifdef N64_HAVE_SSE
-            vte.single = _mm_shufflehi_epi16(_mm_shufflelo_epi16(vt->single, 0b11110101), 0b11110101);
-#else
-            vte = broadcast(vt, 0, 0, 2, 2, 4, 4, 6, 6);
-#endif
-            break;
-        case 3:
-#ifdef N64_HAVE_SSE
-            vte.single = _mm_shufflehi_epi16(_mm_shufflelo_epi16(vt->single, 0b10100000), 0b10100000);
-#else
-            vte = broadcast(vt, 1, 1, 3, 3, 5, 5, 7, 7);
-#endif
-            break;
-        case 4:
-#ifdef N64_HAVE_SSE
-            vte.single = _mm_shufflehi_epi16(_mm_shufflelo_epi16(vt->single, 0b11111111), 0b11111111);
-#else
-            vte = broadcast(vt, 0, 0, 0, 0, 4, 4, 4, 4);
-#endif
-            break;
-        case 5:
-#ifdef N64_HAVE_SSE
-            vte.single = _mm_shufflehi_epi16(_mm_shufflelo_epi16(vt->single, 0b10101010), 0b10101010);
-#else
-            vte = broadcast(vt, 1, 1, 1, 1, 5, 5, 5, 5);
-#endif
-            break;
-        case 6:
-#ifdef N64_HAVE_SSE
-            vte.single = _mm_shufflehi_epi16(_mm_shufflelo_epi16(vt->single, 0b01010101), 0b01010101);
-#else
-            vte = broadcast(vt, 2, 2, 2, 2, 6, 6, 6, 6);
-#endif
-            break;
-        case 7:
-#ifdef N64_HAVE_SSE
-            vte.single = _mm_shufflehi_epi16(_mm_shufflelo_epi16(vt->single, 0b00000000), 0b00000000);
+INLINE vu_vec_t get_vte_vec(vu_reg_t* vt, u8 e) {
+#ifdef N64_BIG_ENDIAN
+    vu_reg_t vte = get_vte_reference(vt, e);
+    return vu_load(&vte);
 #else
-            vte = broadcast(vt, 3, 3, 3, 3, 7, 7, 7, 7);
-#endif
-            break;
-        case 8 ... 15: {
-            int index = VU_ELEM_INDEX(e - 8);
-#ifdef N64_HAVE_SSE
-            vte.single = _mm_set1_epi16(vt->elements[index]);
-#else
-            for (int i = 0; i < 8; i++) {
-                u16 val = vt->elements[index];
-                vte.elements[i] = val;
-            }
+    return vu_shuffle_bytes(vu_load(vt), vte_shuffle[e & 0xF]);
 #endif
-            break;
-        }
-        default:
-            logfatal("vte where e > 15");
-    }
+}
 
+INLINE vu_reg_t get_vte(vu_reg_t* vt, u8 e) {
+    vu_reg_t vte;
+    vu_store(&vte, get_vte_vec(vt, e));
     return vte;
 }
 
@@ -651,280 +581,233 @@ RSP_VECTOR_INSTR(rsp_vec_vabs) {
     logdebug("rsp_vec_vabs");
     defvs;
     defvd;
-    defvte;
+    defvtevec;
 
-#ifdef N64_HAVE_SSE
-    // check if each element is zero
-    __m128i vs_is_zero = _mm_cmpeq_epi16(vs->single, N64RSP.zero);
-
-    // arithmetic shift right by 15 (effectively sets each bit of the number to the sign bit)
-    __m128i vs_is_negative = _mm_srai_epi16(vs->single, 15);
-    // (!vs_is_zero) & vte
-    // for each vte element, outputs zero if the corresponding vs element is zero, or else outputs the regular vte element.
-    __m128i temp = _mm_andnot_si128(vs_is_zero, vte.single);
-
-    // xor each element of the temp var with whether the vs element is negative
-    // If the vs element is negative, flip all the bits. Otherwise, do nothing.
-    temp = _mm_xor_si128(temp, vs_is_negative);
-    // acc.l = temp[element] - (is_negative[element] ? 0xFFFF : 0)
-    N64RSP.acc.l.single = _mm_sub_epi16(temp, vs_is_negative);
-
-    // only difference here is that this a _signed_ subtraction
-    // handle the special case where vte.elements[i] == 0x8000
-    // acc.l = temp[element] - (is_negative[element] ? -1 : 0)
-    vd->single = _mm_subs_epi16(temp, vs_is_negative);
-#else
-    for (int i = 0; i < 8; i++) {
-        if (vs->signed_elements[i] < 0) {
-            if (unlikely(vte.elements[i] == 0x8000)) {
-                vd->elements[i] = 0x7FFF;
-                N64RSP.acc.l.elements[i] = 0x8000;
-            } else {
-                vd->elements[i] = -vte.signed_elements[i];
-                N64RSP.acc.l.elements[i] = -vte.signed_elements[i];
-            }
-        } else if (vs->elements[i] == 0) {
-            vd->elements[i] = 0x0000;
-            N64RSP.acc.l.elements[i] = 0x0000;
-        } else {
-            vd->elements[i] = vte.elements[i];
-            N64RSP.acc.l.elements[i] = vte.elements[i];
-        }
-    }
-#endif
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t is_negative = vu_sign(s);
+    // zero out vte where vs is zero, then negate it where vs is negative: (x ^ -1) - -1 == -x
+    vu_vec_t temp = vu_xor(vu_bic(vte, vu_eq(s, vu_zero())), is_negative);
+    vu_store(&N64RSP.acc.l, vu_sub(temp, is_negative));
+    // saturating subtract handles the special case of vte == 0x8000
+    vu_store(vd, vu_subs(temp, is_negative));
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vadd) {
     logdebug("rsp_vec_vadd");
     defvs;
     defvd;
-    defvte;
+    defvtevec;
 
-    for (int i = 0; i < 8; i++) {
-        s16 vs_element = vs->signed_elements[i];
-        s16 vte_element = vte.signed_elements[i];
-        s32 result = vs_element + vte_element + (N64RSP.vco.l.elements[i] != 0);
-        N64RSP.acc.l.elements[i] = result;
-        vd->elements[i] = clamp_signed(result);
-        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
-        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
-    }
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t carry = vu_load(&N64RSP.vco.l);
+    vu_store(&N64RSP.acc.l, vu_sub(vu_add(s, vte), carry));
+    // Add the carry to the smaller operand first so that saturation only happens once
+    vu_vec_t min = vu_subs(vu_min(s, vte), carry);
+    vu_store(vd, vu_adds(min, vu_max(s, vte)));
+    vu_store(&N64RSP.vco.l, vu_zero());
+    vu_store(&N64RSP.vco.h, vu_zero());
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vaddc) {
     logdebug("rsp_vec_vaddc");
     defvs;
     defvd;
-    defvte;
+    defvtevec;
 
-    for (int i = 0; i < 8; i++) {
-        u16 vs_element = vs->elements[i];
-        u16 vte_element = vte.elements[i];
-        u32 result = vs_element + vte_element;
-        N64RSP.acc.l.elements[i] = result & 0xFFFF;
-        vd->elements[i] = result & 0xFFFF;
-        N64RSP.vco.l.elements[i] = FLAGREG_BOOL((result >> 16) & 1);
-        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
-    }
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t sum = vu_add(s, vte);
+    vu_store(&N64RSP.acc.l, sum);
+    vu_store(vd, sum);
+    vu_store(&N64RSP.vco.l, vu_ltu(sum, s));
+    vu_store(&N64RSP.vco.h, vu_zero());
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vand) {
     logdebug("rsp_vec_vand");
     defvs;
     defvd;
-    defvte;
+    defvtevec;
 
-    for (int i = 0; i < 8; i++) {
-        u16 result = vte.elements[i] & vs->elements[i];
-        vd->elements[i] = result;
-        N64RSP.acc.l.elements[i] = result;
-    }
+    vu_vec_t result = vu_and(vte, vu_load(vs));
+    vu_store(vd, result);
+    vu_store(&N64RSP.acc.l, result);
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vch) {
     logdebug("rsp_vec_vch");
     defvs;
     defvd;
-    defvte;
-
-    for (int i = 0; i < 8; i++) {
-        s16 vs_element = vs->signed_elements[i];
-        s16 vte_element = vte.signed_elements[i];
-
-        if ((vs_element ^ vte_element) < 0) {
-            s16 result = vs_element + vte_element;
-
-            N64RSP.acc.l.signed_elements[i] = (result <= 0 ? -vte_element : vs_element);
-            N64RSP.vcc.l.elements[i] = FLAGREG_BOOL(result <= 0);
-            N64RSP.vcc.h.elements[i] = FLAGREG_BOOL(vte_element < 0);
-            N64RSP.vco.l.elements[i] = FLAGREG_BOOL(1);
-            N64RSP.vco.h.elements[i] = FLAGREG_BOOL(result != 0 && (u16)vs_element != ((u16)vte_element ^ 0xFFFF));
-            N64RSP.vce.elements[i]   = FLAGREG_BOOL(result == -1);
-        } else {
-            s16 result = vs_element - vte_element;
-
-            N64RSP.acc.l.elements[i] = (result >= 0 ? vte_element : vs_element);
-            N64RSP.vcc.l.elements[i] = FLAGREG_BOOL(vte_element < 0);
-            N64RSP.vcc.h.elements[i] = FLAGREG_BOOL(result >= 0);
-            N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
-            N64RSP.vco.h.elements[i] = FLAGREG_BOOL(result != 0 && (u16)vs_element != ((u16)vte_element ^ 0xFFFF));
-            N64RSP.vce.elements[i]   = FLAGREG_BOOL(0);
-        }
-
-        vd->elements[i] = N64RSP.acc.l.elements[i];
-    }
+    defvtevec;
+
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t zero = vu_zero();
+    vu_vec_t sign_different = vu_sign(vu_xor(s, vte));
+    vu_vec_t vte_negative = vu_sign(vte);
+
+    // Different signs: compare vs against -vte
+    vu_vec_t sum = vu_add(s, vte);
+    vu_vec_t sum_le_zero = vu_not(vu_gt(sum, zero));
+    // Same signs: compare vs against vte
+    vu_vec_t diff = vu_sub(s, vte);
+    vu_vec_t diff_ge_zero = vu_not(vu_sign(diff));
+
+    vu_vec_t result = vu_sel(sign_different, sum, diff);
+    vu_vec_t acc = vu_sel(sign_different,
+                          vu_sel(sum_le_zero, vu_sub(zero, vte), s),
+                          vu_sel(diff_ge_zero, vte, s));
+
+    vu_store(&N64RSP.acc.l, acc);
+    vu_store(&N64RSP.vcc.l, vu_sel(sign_different, sum_le_zero, vte_negative));
+    vu_store(&N64RSP.vcc.h, vu_sel(sign_different, vte_negative, diff_ge_zero));
+    vu_store(&N64RSP.vco.l, sign_different);
+    vu_store(&N64RSP.vco.h, vu_bic(vu_not(vu_eq(result, zero)), vu_eq(s, vu_not(vte))));
+    vu_store(&N64RSP.vce, vu_and(sign_different, vu_eq(sum, vu_set1(0xFFFF))));
+    vu_store(vd, acc);
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vcl) {
     logdebug("rsp_vec_vcl");
     defvs;
     defvd;
-    defvte;
-    for (int i = 0; i < 8; i++) {
-        u16 vs_element = vs->elements[i];
-        u16 vte_element = vte.elements[i];
-
-        if(N64RSP.vco.l.elements[i]) {
-            if(N64RSP.vco.h.elements[i]) {
-                N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] ? -vte_element : vs_element;
-            } else {
-                u16 clamped_sum = vs_element + vte_element;
-                bool overflow = (vs_element + vte_element) != clamped_sum;
-                if(N64RSP.vce.elements[i]) {
-                    N64RSP.vcc.l.elements[i] = FLAGREG_BOOL(!clamped_sum || !overflow);
-                    N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] ? -vte_element : vs_element;
-                } else {
-                    N64RSP.vcc.l.elements[i] = FLAGREG_BOOL(!clamped_sum && !overflow);
-                    N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] ? -vte_element : vs_element;
-                }
-            }
-        } else {
-            if(N64RSP.vco.h.elements[i]) {
-                N64RSP.acc.l.elements[i] = N64RSP.vcc.h.elements[i] ? vte_element : vs_element;
-            } else {
-                N64RSP.vcc.h.elements[i] = FLAGREG_BOOL((s32)vs_element - (s32)vte_element >= 0);
-                N64RSP.acc.l.elements[i] = N64RSP.vcc.h.elements[i] ? vte_element : vs_element;
-            }
-        }
-    }
-
-    memset(&N64RSP.vco.l, 0, sizeof(vu_reg_t));
-    memset(&N64RSP.vco.h, 0, sizeof(vu_reg_t));
-    memset(&N64RSP.vce, 0, sizeof(vu_reg_t));
-    memcpy(vd, &N64RSP.acc.l, sizeof(vu_reg_t));
+    defvtevec;
+
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t zero = vu_zero();
+    vu_vec_t vco_l = vu_load(&N64RSP.vco.l);
+    vu_vec_t vco_h = vu_load(&N64RSP.vco.h);
+    vu_vec_t vce = vu_load(&N64RSP.vce);
+
+    // vco.l && !vco.h: compare against -vte using the unsigned sum
+    vu_vec_t sum = vu_add(s, vte);
+    vu_vec_t overflow = vu_ltu(sum, s);
+    vu_vec_t sum_zero = vu_eq(sum, zero);
+    vu_vec_t le = vu_sel(vce, vu_or(sum_zero, vu_not(overflow)), vu_bic(sum_zero, overflow));
+    vu_vec_t vcc_l = vu_sel(vu_bic(vco_l, vco_h), le, vu_load(&N64RSP.vcc.l));
+
+    // !vco.l && !vco.h: unsigned vs >= vte
+    vu_vec_t ge = vu_not(vu_ltu(s, vte));
+    vu_vec_t vcc_h = vu_sel(vu_not(vu_or(vco_l, vco_h)), ge, vu_load(&N64RSP.vcc.h));
+
+    vu_vec_t acc = vu_sel(vco_l,
+                          vu_sel(vcc_l, vu_sub(zero, vte), s),
+                          vu_sel(vcc_h, vte, s));
+
+    vu_store(&N64RSP.vcc.l, vcc_l);
+    vu_store(&N64RSP.vcc.h, vcc_h);
+    vu_store(&N64RSP.acc.l, acc);
+    vu_store(&N64RSP.vco.l, zero);
+    vu_store(&N64RSP.vco.h, zero);
+    vu_store(&N64RSP.vce, zero);
+    vu_store(vd, acc);
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vcr) {
     logdebug("rsp_vec_vcr");
     defvs;
     defvd;
-    defvte;
-
-    for (int i = 0; i < 8; i++) {
-        u16 vs_element = vs->elements[i];
-        u16 vte_element = vte.elements[i];
+    defvtevec;
 
-        bool sign_different = (0x8000 & (vs_element ^ vte_element)) == 0x8000;
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t zero = vu_zero();
+    vu_vec_t sign_different = vu_sign(vu_xor(s, vte));
 
-        // If vte and vs have different signs, make this negative vte
-        u16 vt_abs = sign_different ? ~vte_element : vte_element;
+    // If vte and vs have different signs, make this negative vte (one's complement)
+    vu_vec_t vt_abs = vu_xor(vte, sign_different);
 
-        // Compare using one's complement
-        bool gte = (s16)vte_element <= (s16)(sign_different ? 0xFFFF : vs_element);
-        bool lte = (((sign_different ? vs_element : 0) + vte_element) & 0x8000) == 0x8000;
+    vu_vec_t gte = vu_not(vu_gt(vte, vu_or(s, sign_different)));
+    vu_vec_t lte = vu_sign(vu_add(vu_and(s, sign_different), vte));
 
-        // If the sign is different, check LTE, otherwise, check GTE.
-        bool check = sign_different ? lte : gte;
-        u16 result = check ? vt_abs : vs_element;
+    vu_vec_t result = vu_sel(vu_sel(sign_different, lte, gte), vt_abs, s);
 
-        N64RSP.acc.l.elements[i] = result;
-        vd->elements[i] = result;
-
-        N64RSP.vcc.h.elements[i] = FLAGREG_BOOL(gte);
-        N64RSP.vcc.l.elements[i] = FLAGREG_BOOL(lte);
-
-        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
-        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
-        N64RSP.vce.elements[i] = FLAGREG_BOOL(0);
-
-    }
+    vu_store(&N64RSP.acc.l, result);
+    vu_store(vd, result);
+    vu_store(&N64RSP.vcc.h, gte);
+    vu_store(&N64RSP.vcc.l, lte);
+    vu_store(&N64RSP.vco.l, zero);
+    vu_store(&N64RSP.vco.h, zero);
+    vu_store(&N64RSP.vce, zero);
 }
 
 RSP_VECTOR_INSTR(rsp_vec_veq) {
     logdebug("rsp_vec_veq");
     defvs;
     defvd;
-    defvte;
+    defvtevec;
 
-    for (int i = 0; i < 8; i++) {
-        N64RSP.vcc.l.elements[i] = FLAGREG_BOOL((N64RSP.vco.h.elements[i] == 0) && (vs->elements[i] == vte.elements[i]));
-        N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] != 0 ? vs->elements[i] : vte.elements[i];
-        vd->elements[i] = N64RSP.acc.l.elements[i];
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t vco_h = vu_load(&N64RSP.vco.h);
+    vu_vec_t eql = vu_eq(s, vte);
+    vu_vec_t vcc_l = vu_bic(eql, vco_h);
+    vu_vec_t result = vu_sel(vcc_l, s, vte);
 
-        N64RSP.vcc.h.elements[i] = FLAGREG_BOOL(0);
-        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
-        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
-    }
+    vu_store(&N64RSP.vcc.l, vcc_l);
+    vu_store(&N64RSP.acc.l, result);
+    vu_store(vd, result);
+    vu_store(&N64RSP.vcc.h, vu_zero());
+    vu_store(&N64RSP.vco.h, vu_zero());
+    vu_store(&N64RSP.vco.l, vu_zero());
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vge) {
     logdebug("rsp_vec_vge");
     defvs;
     defvd;
-    defvte;
+    defvtevec;
 
-    for (int i = 0; i < 8; i++) {
-        bool eql = vs->signed_elements[i] == vte.signed_elements[i];
-        bool neg = !(N64RSP.vco.l.elements[i] != 0 && N64RSP.vco.h.elements[i] != 0) && eql;
-
-        N64RSP.vcc.l.elements[i] = FLAGREG_BOOL(neg || (vs->signed_elements[i] > vte.signed_elements[i]));
-        N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] != 0 ? vs->elements[i] : vte.elements[i];
-        vd->elements[i] = N64RSP.acc.l.elements[i];
-        N64RSP.vcc.h.elements[i] = FLAGREG_BOOL(0);
-        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
-        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t vco_l = vu_load(&N64RSP.vco.l);
+    vu_vec_t vco_h = vu_load(&N64RSP.vco.h);
+    vu_vec_t eql = vu_eq(s, vte);
+    vu_vec_t vcc_l = vu_or(vu_bic(eql, vu_and(vco_l, vco_h)), vu_gt(s, vte));
+    vu_vec_t result = vu_sel(vcc_l, s, vte);
 
-    }
+    vu_store(&N64RSP.vcc.l, vcc_l);
+    vu_store(&N64RSP.acc.l, result);
+    vu_store(vd, result);
+    vu_store(&N64RSP.vcc.h, vu_zero());
+    vu_store(&N64RSP.vco.h, vu_zero());
+    vu_store(&N64RSP.vco.l, vu_zero());
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vlt) {
     logdebug("rsp_vec_vlt");
     defvs;
     defvd;
-    defvte;
+    defvtevec;
 
-    for (int i = 0; i < 8; i++) {
-        bool eql = vs->elements[i] == vte.elements[i];
-        bool neg = N64RSP.vco.h.elements[i] != 0 && N64RSP.vco.l.elements[i] != 0 && eql;
-        N64RSP.vcc.l.elements[i] = FLAGREG_BOOL(neg || (vs->signed_elements[i] < vte.signed_elements[i]));
-        N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] != 0 ? vs->elements[i] : vte.elements[i];
-        vd->elements[i] = N64RSP.acc.l.elements[i];
-        N64RSP.vcc.h.elements[i] = FLAGREG_BOOL(0);
-        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
-        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
-    }
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t vco_l = vu_load(&N64RSP.vco.l);
+    vu_vec_t vco_h = vu_load(&N64RSP.vco.h);
+    vu_vec_t eql = vu_eq(s, vte);
+    vu_vec_t vcc_l = vu_or(vu_and(vu_and(vco_l, vco_h), eql), vu_lt(s, vte));
+    vu_vec_t result = vu_sel(vcc_l, s, vte);
+
+    vu_store(&N64RSP.vcc.l, vcc_l);
+    vu_store(&N64RSP.acc.l, result);
+    vu_store(vd, result);
+    vu_store(&N64RSP.vcc.h, vu_zero());
+    vu_store(&N64RSP.vco.h, vu_zero());
+    vu_store(&N64RSP.vco.l, vu_zero());
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vmacf) {
     logdebug("rsp_vec_vmacf");
     defvs;
     defvd;
-    defvte;
-    for (int e = 0; e < 8; e++) {
-        s16 multiplicand1 = vte.elements[e];
-        s16 multiplicand2 = vs->elements[e];
-        s32 prod = multiplicand1 * multiplicand2;
-
-        s64 acc_delta = prod;
-        acc_delta *= 2;
-        s64 acc = get_rsp_accumulator(e) + acc_delta;
-        set_rsp_accumulator(e, acc);
-        acc = get_rsp_accumulator(e);
-
-        s16 result = clamp_signed(acc >> 16);
-
-        vd->elements[e] = result;
-    }
+    defvtevec;
+
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t lo = vu_mullo(s, vte);
+    vu_vec_t hi = vu_mulhi(s, vte);
+    vu_vec_t acc_h = vu_load(&N64RSP.acc.h);
+    vu_vec_t acc_m = vu_load(&N64RSP.acc.m);
+    vu_vec_t acc_l = vu_load(&N64RSP.acc.l);
+    // Add vs * vte * 2
+    vu_acc_add(&acc_h, &acc_m, &acc_l, vu_sign(hi), vu_or(vu_shl1(hi), vu_bit15(lo)), vu_shl1(lo));
+    vu_store(&N64RSP.acc.h, acc_h);
+    vu_store(&N64RSP.acc.m, acc_m);
+    vu_store(&N64RSP.acc.l, acc_l);
+    vu_store(vd, vu_clamp_signed_acc(acc_h, acc_m));
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vmacq) {
@@ -948,189 +831,99 @@ RSP_VECTOR_INSTR(rsp_vec_vmacu) {
     logdebug("rsp_vec_vmacu");
     defvs;
     defvd;
-    defvte;
-    for (int e = 0; e < 8; e++) {
-        s16 multiplicand1 = vte.elements[e];
-        s16 multiplicand2 = vs->elements[e];
-        s32 prod = multiplicand1 * multiplicand2;
-
-        s64 acc_delta = prod;
-        acc_delta *= 2;
-        s64 acc = get_rsp_accumulator(e) + acc_delta;
-        set_rsp_accumulator(e, acc);
-        acc = get_rsp_accumulator(e);
-
-        u16 result = clamp_unsigned(acc >> 16);
-
-        vd->elements[e] = result;
-    }
+    defvtevec;
+
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t lo = vu_mullo(s, vte);
+    vu_vec_t hi = vu_mulhi(s, vte);
+    vu_vec_t acc_h = vu_load(&N64RSP.acc.h);
+    vu_vec_t acc_m = vu_load(&N64RSP.acc.m);
+    vu_vec_t acc_l = vu_load(&N64RSP.acc.l);
+    // Add vs * vte * 2
+    vu_acc_add(&acc_h, &acc_m, &acc_l, vu_sign(hi), vu_or(vu_shl1(hi), vu_bit15(lo)), vu_shl1(lo));
+    vu_store(&N64RSP.acc.h, acc_h);
+    vu_store(&N64RSP.acc.m, acc_m);
+    vu_store(&N64RSP.acc.l, acc_l);
+    vu_store(vd, vu_clamp_unsigned_acc(acc_h, acc_m));
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vmadh) {
     logdebug("rsp_vec_vmadh");
     defvs;
     defvd;
-    defvte;
-#ifdef N64_HAVE_SSE
-    s128 lo, hi, omask;
-    lo                 = _mm_mullo_epi16(vs->single, vte.single);
-    hi                 = _mm_mulhi_epi16(vs->single, vte.single);
-    omask              = _mm_adds_epu16(N64RSP.acc.m.single, lo);
-    N64RSP.acc.m.single  = _mm_add_epi16(N64RSP.acc.m.single, lo);
-    omask              = _mm_cmpeq_epi16(N64RSP.acc.m.single, omask);
-    omask              = _mm_cmpeq_epi16(omask, N64RSP.zero);
-    hi                 = _mm_sub_epi16(hi, omask);
-    N64RSP.acc.h.single  = _mm_add_epi16(N64RSP.acc.h.single, hi);
-    lo                 = _mm_unpacklo_epi16(N64RSP.acc.m.single, N64RSP.acc.h.single);
-    hi                 = _mm_unpackhi_epi16(N64RSP.acc.m.single, N64RSP.acc.h.single);
-    vd->single         = _mm_packs_epi32(lo, hi);
-#else
-    for (int e = 0; e < 8; e++) {
-        s16 multiplicand1 = vte.elements[e];
-        s16 multiplicand2 = vs->elements[e];
-        s32 prod = multiplicand1 * multiplicand2;
-        u32 uprod = prod;
-
-        u64 acc_delta = (u64)uprod << 16;
-        s64 acc = get_rsp_accumulator(e) + acc_delta;
-        set_rsp_accumulator(e, acc);
-        acc = get_rsp_accumulator(e);
-
-        s16 result = clamp_signed(acc >> 16);
-
-        vd->elements[e] = result;
-    }
-#endif
+    defvtevec;
+
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t lo = vu_mullo(s, vte);
+    vu_vec_t hi = vu_mulhi(s, vte);
+    vu_vec_t acc_h = vu_load(&N64RSP.acc.h);
+    vu_vec_t acc_m = vu_load(&N64RSP.acc.m);
+    vu_vec_t acc_l = vu_load(&N64RSP.acc.l);
+    // Add vs * vte << 16
+    vu_acc_add(&acc_h, &acc_m, &acc_l, hi, lo, vu_zero());
+    vu_store(&N64RSP.acc.h, acc_h);
+    vu_store(&N64RSP.acc.m, acc_m);
+    vu_store(&N64RSP.acc.l, acc_l);
+    vu_store(vd, vu_clamp_signed_acc(acc_h, acc_m));
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vmadl) {
     logdebug("rsp_vec_vmadl");
     defvs;
     defvd;
-    defvte;
-    for (int e = 0; e < 8; e++) {
-        u64 multiplicand1 = vte.elements[e];
-        u64 multiplicand2 = vs->elements[e];
-        u64 prod = multiplicand1 * multiplicand2;
-
-        u64 acc_delta = prod >> 16;
-        u64 acc = get_rsp_accumulator(e) + acc_delta;
-
-        set_rsp_accumulator(e, acc);
-        u16 result;
-        if (is_sign_extension(N64RSP.acc.h.signed_elements[e], N64RSP.acc.m.signed_elements[e])) {
-            result = N64RSP.acc.l.elements[e];
-        } else if (N64RSP.acc.h.signed_elements[e] < 0) {
-            result = 0;
-        } else {
-            result = 0xFFFF;
-        }
+    defvtevec;
 
-        vd->elements[e] = result;
-    }
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t zero = vu_zero();
+    vu_vec_t acc_h = vu_load(&N64RSP.acc.h);
+    vu_vec_t acc_m = vu_load(&N64RSP.acc.m);
+    vu_vec_t acc_l = vu_load(&N64RSP.acc.l);
+    // Add (vs * vte) >> 16, unsigned
+    vu_acc_add(&acc_h, &acc_m, &acc_l, zero, zero, vu_mulhiu(s, vte));
+    vu_store(&N64RSP.acc.h, acc_h);
+    vu_store(&N64RSP.acc.m, acc_m);
+    vu_store(&N64RSP.acc.l, acc_l);
+    vu_store(vd, vu_clamp_low_acc(acc_h, acc_m, acc_l));
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vmadm) {
     logdebug("rsp_vec_vmadm");
     defvs;
     defvd;
-    defvte;
-#ifdef N64_HAVE_SSE
-    s128 lo, hi, sign, vta, omask;
-    lo                 = _mm_mullo_epi16(vs->single, vte.single);
-    hi                 = _mm_mulhi_epu16(vs->single, vte.single);
-    sign               = _mm_srai_epi16(vs->single, 15);
-    vta                = _mm_and_si128(vte.single, sign);
-    hi                 = _mm_sub_epi16(hi, vta);
-    omask              = _mm_adds_epu16(N64RSP.acc.l.single, lo);
-    N64RSP.acc.l.single  = _mm_add_epi16(N64RSP.acc.l.single, lo);
-    omask              = _mm_cmpeq_epi16(N64RSP.acc.l.single, omask);
-    omask              = _mm_cmpeq_epi16(omask, N64RSP.zero);
-    hi                 = _mm_sub_epi16(hi, omask);
-    omask              = _mm_adds_epu16(N64RSP.acc.m.single, hi);
-    N64RSP.acc.m.single  = _mm_add_epi16(N64RSP.acc.m.single, hi);
-    omask              = _mm_cmpeq_epi16(N64RSP.acc.m.single, omask);
-    omask              = _mm_cmpeq_epi16(omask, N64RSP.zero);
-    hi                 = _mm_srai_epi16(hi, 15);
-    N64RSP.acc.h.single  = _mm_add_epi16(N64RSP.acc.h.single, hi);
-    N64RSP.acc.h.single  = _mm_sub_epi16(N64RSP.acc.h.single, omask);
-    lo                 = _mm_unpacklo_epi16(N64RSP.acc.m.single, N64RSP.acc.h.single);
-    hi                 = _mm_unpackhi_epi16(N64RSP.acc.m.single, N64RSP.acc.h.single);
-    vd->single         = _mm_packs_epi32(lo, hi);
-#else
-    for (int e = 0; e < 8; e++) {
-        u16 multiplicand1 = vte.elements[e];
-        s16 multiplicand2 = vs->elements[e];
-        s32 prod = multiplicand1 * multiplicand2;
-
-        s64 acc_delta = prod;
-        s64 acc = get_rsp_accumulator(e);
-        acc += acc_delta;
-        set_rsp_accumulator(e, acc);
-        acc = get_rsp_accumulator(e);
-
-        s16 result = clamp_signed(acc >> 16);
-
-        vd->elements[e] = result;
-    }
-#endif
+    defvtevec;
+
+    vu_vec_t s = vu_load(vs);
+    // signed vs * unsigned vte
+    vu_vec_t lo = vu_mullo(s, vte);
+    vu_vec_t hi = vu_sub(vu_mulhiu(s, vte), vu_and(vte, vu_sign(s)));
+    vu_vec_t acc_h = vu_load(&N64RSP.acc.h);
+    vu_vec_t acc_m = vu_load(&N64RSP.acc.m);
+    vu_vec_t acc_l = vu_load(&N64RSP.acc.l);
+    vu_acc_add(&acc_h, &acc_m, &acc_l, vu_sign(hi), hi, lo);
+    vu_store(&N64RSP.acc.h, acc_h);
+    vu_store(&N64RSP.acc.m, acc_m);
+    vu_store(&N64RSP.acc.l, acc_l);
+    vu_store(vd, vu_clamp_signed_acc(acc_h, acc_m));
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vmadn) {
     logdebug("rsp_vec_vmadn");
     defvs;
     defvd;
-    defvte;
-#ifdef N64_HAVE_SSE
-    s128 lo, hi, sign, vsa, omask, nhi, nmd, shi, smd, cmask, cval;
-    lo                 = _mm_mullo_epi16(vs->single, vte.single);
-    hi                 = _mm_mulhi_epu16(vs->single, vte.single);
-    sign               = _mm_srai_epi16(vte.single, 15);
-    vsa                = _mm_and_si128(vs->single, sign);
-    hi                 = _mm_sub_epi16(hi, vsa);
-    omask              = _mm_adds_epu16(N64RSP.acc.l.single, lo);
-    N64RSP.acc.l.single  = _mm_add_epi16(N64RSP.acc.l.single, lo);
-    omask              = _mm_cmpeq_epi16(N64RSP.acc.l.single, omask);
-    omask              = _mm_cmpeq_epi16(omask, N64RSP.zero);
-    hi                 = _mm_sub_epi16(hi, omask);
-    omask              = _mm_adds_epu16(N64RSP.acc.m.single, hi);
-    N64RSP.acc.m.single  = _mm_add_epi16(N64RSP.acc.m.single, hi);
-    omask              = _mm_cmpeq_epi16(N64RSP.acc.m.single, omask);
-    omask              = _mm_cmpeq_epi16(omask, N64RSP.zero);
-    hi                 = _mm_srai_epi16(hi, 15);
-    N64RSP.acc.h.single  = _mm_add_epi16(N64RSP.acc.h.single, hi);
-    N64RSP.acc.h.single  = _mm_sub_epi16(N64RSP.acc.h.single, omask);
-    nhi                = _mm_srai_epi16(N64RSP.acc.h.single, 15);
-    nmd                = _mm_srai_epi16(N64RSP.acc.m.single, 15);
-    shi                = _mm_cmpeq_epi16(nhi, N64RSP.acc.h.single);
-    smd                = _mm_cmpeq_epi16(nhi, nmd);
-    cmask              = _mm_and_si128(smd, shi);
-    cval               = _mm_cmpeq_epi16(nhi, N64RSP.zero);
-    vd->single         = _mm_blendv_epi8(cval, N64RSP.acc.l.single, cmask);
-#else
-    for (int e = 0; e < 8; e++) {
-        s16 multiplicand1 = vte.elements[e];
-        u16 multiplicand2 = vs->elements[e];
-        s32 prod = multiplicand1 * multiplicand2;
-
-        s64 acc_delta = prod;
-        s64 acc = get_rsp_accumulator(e) + acc_delta;
-
-        set_rsp_accumulator(e, acc);
-
-        u16 result;
-
-        if (is_sign_extension(N64RSP.acc.h.signed_elements[e], N64RSP.acc.m.signed_elements[e])) {
-            result = N64RSP.acc.l.elements[e];
-        } else if (N64RSP.acc.h.signed_elements[e] < 0) {
-            result = 0;
-        } else {
-            result = 0xFFFF;
-        }
-
-        vd->elements[e] = result;
-    }
-#endif
+    defvtevec;
+
+    vu_vec_t s = vu_load(vs);
+    // unsigned vs * signed vte
+    vu_vec_t lo = vu_mullo(s, vte);
+    vu_vec_t hi = vu_sub(vu_mulhiu(s, vte), vu_and(s, vu_sign(vte)));
+    vu_vec_t acc_h = vu_load(&N64RSP.acc.h);
+    vu_vec_t acc_m = vu_load(&N64RSP.acc.m);
+    vu_vec_t acc_l = vu_load(&N64RSP.acc.l);
+    vu_acc_add(&acc_h, &acc_m, &acc_l, vu_sign(hi), hi, lo);
+    vu_store(&N64RSP.acc.h, acc_h);
+    vu_store(&N64RSP.acc.m, acc_m);
+    vu_store(&N64RSP.acc.l, acc_l);
+    vu_store(vd, vu_clamp_low_acc(acc_h, acc_m, acc_l));
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vmov) {
@@ -1160,143 +953,104 @@ RSP_VECTOR_INSTR(rsp_vec_vmov) {
     u8 de = instruction.cp2_vec.vs & 7;
 
     u16 vte_elem = vte.elements[VU_ELEM_INDEX(se)];
-#ifdef N64_HAVE_SSE
     vd->elements[VU_ELEM_INDEX(de)] = vte_elem;
     N64RSP.acc.l = vte;
-#else
-    vd->elements[VU_ELEM_INDEX(de)] = vte_elem;
-    for (int i = 0; i < 8; i++) {
-        N64RSP.acc.l.elements[i] = vte.elements[i];
-    }
-#endif
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vmrg) {
     logdebug("rsp_vec_vmrg");
     defvs;
     defvd;
-    defvte;
-
-    for (int i = 0; i < 8; i++) {
-        N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] != 0 ? vs->elements[i] : vte.elements[i];
-        vd->elements[i] = N64RSP.acc.l.elements[i];
+    defvtevec;
 
-        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
-        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
-    }
+    vu_vec_t result = vu_sel(vu_load(&N64RSP.vcc.l), vu_load(vs), vte);
+    vu_store(&N64RSP.acc.l, result);
+    vu_store(vd, result);
+    vu_store(&N64RSP.vco.l, vu_zero());
+    vu_store(&N64RSP.vco.h, vu_zero());
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vmudh) {
     logdebug("rsp_vec_vmudh");
     defvs;
     defvd;
-    defvte;
-    for (int e = 0; e < 8; e++) {
-        s16 multiplicand1 = vte.elements[e];
-        s16 multiplicand2 = vs->elements[e];
-        s32 prod = multiplicand1 * multiplicand2;
-
-        s64 acc = (s64)prod;
+    defvtevec;
 
-        s16 result = clamp_signed(acc);
-
-        acc <<= 16;
-        set_rsp_accumulator(e, acc);
-
-        vd->elements[e] = result;
-    }
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t lo = vu_mullo(s, vte);
+    vu_vec_t hi = vu_mulhi(s, vte);
+    vu_store(&N64RSP.acc.h, hi);
+    vu_store(&N64RSP.acc.m, lo);
+    vu_store(&N64RSP.acc.l, vu_zero());
+    vu_store(vd, vu_packs(lo, hi));
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vmudl) {
     logdebug("rsp_vec_vmudl");
     defvs;
     defvd;
-    defvte;
-    for (int e = 0; e < 8; e++) {
-        u64 multiplicand1 = vte.elements[e];
-        u64 multiplicand2 = vs->elements[e];
-        u64 prod = multiplicand1 * multiplicand2;
-
-        u64 acc = prod >> 16;
-
-        set_rsp_accumulator(e, acc);
-        u16 result;
-        if (is_sign_extension(N64RSP.acc.h.signed_elements[e], N64RSP.acc.m.signed_elements[e])) {
-            result = N64RSP.acc.l.elements[e];
-        } else if (N64RSP.acc.h.signed_elements[e] < 0) {
-            result = 0;
-        } else {
-            result = 0xFFFF;
-        }
+    defvtevec;
 
-        vd->elements[e] = result;
-    }
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t result = vu_mulhiu(s, vte);
+    vu_store(&N64RSP.acc.h, vu_zero());
+    vu_store(&N64RSP.acc.m, vu_zero());
+    vu_store(&N64RSP.acc.l, result);
+    vu_store(vd, result);
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vmudm) {
     logdebug("rsp_vec_vmudm");
     defvs;
     defvd;
-    defvte;
-    for (int e = 0; e < 8; e++) {
-        u16 multiplicand1 = vte.elements[e];
-        s16 multiplicand2 = vs->elements[e];
-        s32 prod = multiplicand1 * multiplicand2;
-
-        s64 acc = prod;
-
-        s16 result = clamp_signed(acc >> 16);
+    defvtevec;
 
-        set_rsp_accumulator(e, acc);
-        vd->elements[e] = result;
-    }
+    vu_vec_t s = vu_load(vs);
+    // signed vs * unsigned vte
+    vu_vec_t hi = vu_sub(vu_mulhiu(s, vte), vu_and(vte, vu_sign(s)));
+    vu_store(&N64RSP.acc.h, vu_sign(hi));
+    vu_store(&N64RSP.acc.m, hi);
+    vu_store(&N64RSP.acc.l, vu_mullo(s, vte));
+    vu_store(vd, hi);
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vmudn) {
     logdebug("rsp_vec_vmudn");
     defvs;
     defvd;
-    defvte;
-    for (int e = 0; e < 8; e++) {
-        s16 multiplicand1 = vte.elements[e];
-        u16 multiplicand2 = vs->elements[e];
-        s32 prod = multiplicand1 * multiplicand2;
-
-        s64 acc = prod;
-
-        set_rsp_accumulator(e, acc);
+    defvtevec;
 
-        u16 result;
-        if (is_sign_extension(N64RSP.acc.h.signed_elements[e], N64RSP.acc.m.signed_elements[e])) {
-            result = N64RSP.acc.l.elements[e];
-        } else if (N64RSP.acc.h.signed_elements[e] < 0) {
-            result = 0;
-        } else {
-            result = 0xFFFF;
-        }
-
-        vd->elements[e] = result;
-    }
+    vu_vec_t s = vu_load(vs);
+    // unsigned vs * signed vte
+    vu_vec_t lo = vu_mullo(s, vte);
+    vu_vec_t hi = vu_sub(vu_mulhiu(s, vte), vu_and(s, vu_sign(vte)));
+    vu_store(&N64RSP.acc.h, vu_sign(hi));
+    vu_store(&N64RSP.acc.m, hi);
+    vu_store(&N64RSP.acc.l, lo);
+    // The accumulator is always a sign extension of the low bits here
+    vu_store(vd, lo);
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vmulf) {
     logdebug("rsp_vec_vmulf");
     defvs;
     defvd;
-    defvte;
-    for (int e = 0; e < 8; e++) {
-        s16 multiplicand1 = vte.elements[e];
-        s16 multiplicand2 = vs->elements[e];
-        s32 prod = multiplicand1 * multiplicand2;
-
-        s64 acc = prod;
-        acc = (acc * 2) + 0x8000;
-
-        set_rsp_accumulator(e, acc);
-
-        s16 result = clamp_signed(acc >> 16);
-        vd->elements[e] = result;
-    }
+    defvtevec;
+
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t lo = vu_mullo(s, vte);
+    vu_vec_t hi = vu_mulhi(s, vte);
+    vu_vec_t acc_l = vu_add(vu_shl1(lo), vu_set1(0x8000));
+    // Bit shifted out of the low half by doubling, plus the carry from adding the rounding constant
+    vu_vec_t acc_m = vu_add(vu_shl1(hi), vu_add(vu_bit15(lo), vu_bit15(vu_shl1(lo))));
+    vu_vec_t negative = vu_sign(acc_m);
+    // 0x8000 * 0x8000 is the only product that overflows into the sign bit
+    vu_vec_t overflow = vu_and(vu_eq(s, vte), negative);
+    vu_vec_t acc_h = vu_bic(negative, overflow);
+    vu_store(&N64RSP.acc.h, acc_h);
+    vu_store(&N64RSP.acc.m, acc_m);
+    vu_store(&N64RSP.acc.l, acc_l);
+    vu_store(vd, vu_add(acc_m, overflow));
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vmulq) {
@@ -1322,49 +1076,53 @@ RSP_VECTOR_INSTR(rsp_vec_vmulu) {
     logdebug("rsp_vec_vmulu");
     defvs;
     defvd;
-    defvte;
-    for (int e = 0; e < 8; e++) {
-        s16 multiplicand1 = vte.elements[e];
-        s16 multiplicand2 = vs->elements[e];
-        s32 prod = multiplicand1 * multiplicand2;
-
-        s64 acc = prod;
-        acc = (acc * 2) + 0x8000;
-
-        u16 result = clamp_unsigned(acc >> 16);
-
-        set_rsp_accumulator(e, acc);
-        vd->elements[e] = result;
-    }
+    defvtevec;
+
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t lo = vu_mullo(s, vte);
+    vu_vec_t hi = vu_mulhi(s, vte);
+    vu_vec_t acc_l = vu_add(vu_shl1(lo), vu_set1(0x8000));
+    // Bit shifted out of the low half by doubling, plus the carry from adding the rounding constant
+    vu_vec_t acc_m = vu_add(vu_shl1(hi), vu_add(vu_bit15(lo), vu_bit15(vu_shl1(lo))));
+    vu_vec_t negative = vu_sign(acc_m);
+    // 0x8000 * 0x8000 is the only product that overflows into the sign bit
+    vu_vec_t overflow = vu_and(vu_eq(s, vte), negative);
+    vu_vec_t acc_h = vu_bic(negative, overflow);
+    vu_store(&N64RSP.acc.h, acc_h);
+    vu_store(&N64RSP.acc.m, acc_m);
+    vu_store(&N64RSP.acc.l, acc_l);
+    vu_store(vd, vu_or(vu_bic(acc_m, acc_h), overflow));
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vnand) {
     logdebug("rsp_vec_vnand");
     defvs;
     defvd;
-    defvte;
-    for (int i = 0; i < 8; i++) {
-        u16 result = ~(vte.elements[i] & vs->elements[i]);
-        vd->elements[i] = result;
-        N64RSP.acc.l.elements[i] = result;
-    }
+    defvtevec;
+
+    vu_vec_t result = vu_not(vu_and(vte, vu_load(vs)));
+    vu_store(vd, result);
+    vu_store(&N64RSP.acc.l, result);
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vne) {
     logdebug("rsp_vec_vne");
     defvs;
     defvd;
-    defvte;
+    defvtevec;
 
-    for (int i = 0; i < 8; i++) {
-        N64RSP.vcc.l.elements[i] = FLAGREG_BOOL((N64RSP.vco.h.elements[i] != 0) || (vs->elements[i] != vte.elements[i]));
-        N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] != 0 ? vs->elements[i] : vte.elements[i];
-        vd->elements[i] = N64RSP.acc.l.elements[i];
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t vco_h = vu_load(&N64RSP.vco.h);
+    vu_vec_t eql = vu_eq(s, vte);
+    vu_vec_t vcc_l = vu_or(vco_h, vu_not(eql));
+    vu_vec_t result = vu_sel(vcc_l, s, vte);
 
-        N64RSP.vcc.h.elements[i] = FLAGREG_BOOL(0);
-        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
-        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
-    }
+    vu_store(&N64RSP.vcc.l, vcc_l);
+    vu_store(&N64RSP.acc.l, result);
+    vu_store(vd, result);
+    vu_store(&N64RSP.vcc.h, vu_zero());
+    vu_store(&N64RSP.vco.h, vu_zero());
+    vu_store(&N64RSP.vco.l, vu_zero());
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vnop) {}
@@ -1373,36 +1131,33 @@ RSP_VECTOR_INSTR(rsp_vec_vnor) {
     logdebug("rsp_vec_vnor");
     defvs;
     defvd;
-    defvte;
-    for (int i = 0; i < 8; i++) {
-        u16 result = ~(vte.elements[i] | vs->elements[i]);
-        vd->elements[i] = result;
-        N64RSP.acc.l.elements[i] = result;
-    }
+    defvtevec;
+
+    vu_vec_t result = vu_not(vu_or(vte, vu_load(vs)));
+    vu_store(vd, result);
+    vu_store(&N64RSP.acc.l, result);
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vnxor) {
     logdebug("rsp_vec_vnxor");
     defvs;
     defvd;
-    defvte;
-    for (int i = 0; i < 8; i++) {
-        u16 result = ~(vte.elements[i] ^ vs->elements[i]);
-        vd->elements[i] = result;
-        N64RSP.acc.l.elements[i] = result;
-    }
+    defvtevec;
+
+    vu_vec_t result = vu_not(vu_xor(vte, vu_load(vs)));
+    vu_store(vd, result);
+    vu_store(&N64RSP.acc.l, result);
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vor) {
     logdebug("rsp_vec_vor");
     defvs;
     defvd;
-    defvte;
-    for (int i = 0; i < 8; i++) {
-        u16 result = vte.elements[i] | vs->elements[i];
-        vd->elements[i] = result;
-        N64RSP.acc.l.elements[i] = result;
-    }
+    defvtevec;
+
+    vu_vec_t result = vu_or(vte, vu_load(vs));
+    vu_store(vd, result);
+    vu_store(&N64RSP.acc.l, result);
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vrcp) {
@@ -1418,13 +1173,7 @@ RSP_VECTOR_INSTR(rsp_vec_vrcp) {
     vd->elements[VU_ELEM_INDEX(de)] = result & 0xFFFF;
     N64RSP.divout = (result >> 16) & 0xFFFF;
     N64RSP.divin_loaded = false;
-#ifdef N64_HAVE_SSE
-    N64RSP.acc.l.single = vte.single;
-#else
-    for (int i = 0; i < 8; i++) {
-        N64RSP.acc.l.elements[i] = vte.elements[i];
-    }
-#endif
+    N64RSP.acc.l = vte;
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vrcpl) {
@@ -1444,13 +1193,7 @@ RSP_VECTOR_INSTR(rsp_vec_vrcpl) {
     N64RSP.divout = (result >> 16) & 0xFFFF;
     N64RSP.divin = 0;
     N64RSP.divin_loaded = false;
-#ifdef N64_HAVE_SSE
-    N64RSP.acc.l.single = vte.single;
-#else
-    for (int i = 0; i < 8; i++) {
-        N64RSP.acc.l.elements[i] = vte.elements[i];
-    }
-#endif
+    N64RSP.acc.l = vte;
     vd->elements[VU_ELEM_INDEX(de)] = result & 0xFFFF;
 }
 
@@ -1537,13 +1280,7 @@ RSP_VECTOR_INSTR(rsp_vec_vrsq) {
     N64RSP.divout = (result >> 16) & 0xFFFF;
     N64RSP.divin_loaded = false;
 
-#ifdef N64_HAVE_SSE
-    N64RSP.acc.l.single = vte.single;
-#else
-    for (int i = 0; i < 8; i++) {
-        N64RSP.acc.l.elements[i] = vte.elements[i];
-    }
-#endif
+    N64RSP.acc.l = vte;
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vrcph_vrsqh) {
@@ -1554,13 +1291,7 @@ RSP_VECTOR_INSTR(rsp_vec_vrcph_vrsqh) {
     u8 e  = instruction.cp2_vec.e & 7;
     u8 de = instruction.cp2_vec.vs & 7;
 
-#ifdef N64_HAVE_SSE
-    N64RSP.acc.l.single = vte.single;
-#else
-    for (int i = 0; i < 8; i++) {
-        N64RSP.acc.l.elements[i] = vte.elements[i];
-    }
-#endif
+    N64RSP.acc.l = vte;
     N64RSP.divin_loaded = true;
     N64RSP.divin = vt->elements[VU_ELEM_INDEX(e)];
     vd->elements[VU_ELEM_INDEX(de)] = N64RSP.divout;
@@ -1583,13 +1314,7 @@ RSP_VECTOR_INSTR(rsp_vec_vrsql) {
     N64RSP.divout = (result >> 16) & 0xFFFF;
     N64RSP.divin_loaded = false;
 
-#ifdef N64_HAVE_SSE
-    N64RSP.acc.l.single = vte.single;
-#else
-    for (int i = 0; i < 8; i++) {
-        N64RSP.acc.l.elements[i] = vte.elements[i];
-    }
-#endif
+    N64RSP.acc.l = vte;
     vd->elements[VU_ELEM_INDEX(de)] = result & 0xFFFF;
 }
 
@@ -1598,31 +1323,13 @@ RSP_VECTOR_INSTR(rsp_vec_vsar) {
     defvd;
     switch (instruction.cp2_vec.e) {
         case 0x8:
-#ifdef N64_HAVE_SSE
-            vd->single = N64RSP.acc.h.single;
-#else
-            for (int i = 0; i < 8; i++) {
-                vd->elements[i] = N64RSP.acc.h.elements[i];
-            }
-#endif
+            *vd = N64RSP.acc.h;
             break;
         case 0x9:
-#ifdef N64_HAVE_SSE
-            vd->single = N64RSP.acc.m.single;
-#else
-            for (int i = 0; i < 8; i++) {
-                vd->elements[i] = N64RSP.acc.m.elements[i];
-            }
-#endif
+            *vd = N64RSP.acc.m;
             break;
         case 0xA:
-#ifdef N64_HAVE_SSE
-            vd->single = N64RSP.acc.l.single;
-#else
-            for (int i = 0; i < 8; i++) {
-                vd->elements[i] = N64RSP.acc.l.elements[i];
-            }
-#endif
+            *vd = N64RSP.acc.l;
             break;
         default: // Not actually sure what the default behavior is here
             for (int i = 0; i < 8; i++) {
@@ -1636,54 +1343,52 @@ RSP_VECTOR_INSTR(rsp_vec_vsub) {
     logdebug("rsp_vec_vsub");
     defvs;
     defvd;
-    defvte;
+    defvtevec;
 
-    for (int i = 0; i < 8; i++) {
-        s32 result = vs->signed_elements[i] - vte.signed_elements[i] - (N64RSP.vco.l.elements[i] != 0);
-        N64RSP.acc.l.signed_elements[i] = result;
-        vd->signed_elements[i] = clamp_signed(result);
-        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
-        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
-    }
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t carry = vu_load(&N64RSP.vco.l);
+    // Carries are all ones, so subtracting them adds one
+    vu_vec_t unsat_diff = vu_sub(vte, carry);
+    vu_vec_t sat_diff = vu_subs(vte, carry);
+    vu_store(&N64RSP.acc.l, vu_sub(s, unsat_diff));
+    // If vte + carry saturated, the result is one lower than vs - sat_diff
+    vu_vec_t overflow = vu_gt(sat_diff, unsat_diff);
+    vu_store(vd, vu_adds(vu_subs(s, sat_diff), overflow));
+    vu_store(&N64RSP.vco.l, vu_zero());
+    vu_store(&N64RSP.vco.h, vu_zero());
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vsubc) {
     logdebug("rsp_vec_vsubc");
     defvs;
     defvd;
-    defvte;
+    defvtevec;
 
-    for (int i = 0; i < 8; i++) {
-        u32 result = vs->elements[i] - vte.elements[i];
-        u16 hresult = result & 0xFFFF;
-        bool carry = (result >> 16) & 1;
-
-        vd->elements[i] = hresult;
-        N64RSP.acc.l.elements[i] = hresult;
-        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(carry);
-        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(result != 0); // not hresult, but I bet that'd also work
-    }
+    vu_vec_t s = vu_load(vs);
+    vu_vec_t diff = vu_sub(s, vte);
+    vu_store(vd, diff);
+    vu_store(&N64RSP.acc.l, diff);
+    vu_store(&N64RSP.vco.l, vu_ltu(s, vte));
+    vu_store(&N64RSP.vco.h, vu_not(vu_eq(s, vte)));
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vxor) {
     logdebug("rsp_vec_vxor");
     defvs;
-    defvte;
     defvd;
-    for (int i = 0; i < 8; i++) {
-        u16 result = vte.elements[i] ^ vs->elements[i];
-        vd->elements[i] = result;
-        N64RSP.acc.l.elements[i] = result;
-    }
+    defvtevec;
+
+    vu_vec_t result = vu_xor(vte, vu_load(vs));
+    vu_store(vd, result);
+    vu_store(&N64RSP.acc.l, result);
 }
 
 RSP_VECTOR_INSTR(rsp_vec_vzero) {
     logdebug("rsp_vec_vzero");
     defvs;
-    defvte;
+    defvtevec;
     defvd;
-    for (int i = 0; i < 8; i++) {
-        N64RSP.acc.l.elements[i] = vte.elements[i] + vs->elements[i];
-    }
-    memset(vd, 0, sizeof(vu_reg_t));
+
+    vu_store(&N64RSP.acc.l, vu_add(vte, vu_load(vs)));
+    vu_store(vd, vu_zero());
 }
@@ -0,0 +1,29 @@
+#ifndef N64_RSP_VECTOR_INTERNAL_H
+#define N64_RSP_VECTOR_INTERNAL_H
+
+// Helpers shared by the vector unit implementation and its scalar reference
+
+#include "rsp.h"
+
+#define defvs vu_reg_t* vs = &N64RSP.vu_regs[instruction.cp2_vec.vs]
+#define defvt vu_reg_t* vt = &N64RSP.vu_regs[instruction.cp2_vec.vt]
+#define defvd vu_reg_t* vd = &N64RSP.vu_regs[instruction.cp2_vec.vd]
+
+INLINE s16 clamp_signed(s64 value) {
+    if (value < -32768) return -32768;
+    if (value > 32767) return 32767;
+    return value;
+}
+
+#define clamp_unsigned(x) ((x) < 0 ? 0 : ((x) > 32767 ? 65535 : x))
+
+INLINE bool is_sign_extension(s16 high, s16 low) {
+    if (high == 0) {
+        return (low & 0x8000) == 0;
+    } else if (high == -1) {
+        return (low & 0x8000) == 0x8000;
+    }
+    return false;
+}
+
+#endif //N64_RSP_VECTOR_INTERNAL_H
@@ -0,0 +1,670 @@
+// Scalar reference implementations of the RSP vector instructions that have SIMD implementations in rsp_vector_instructions.c.
+// These are straightforward per-element loops, and are only used to check the SIMD versions (see tests/test_rsp_vector_simd.c)
+
+#include "rsp_vector_reference.h"
+
+#include <string.h>
+#include <log.h>
+
+#include "rsp_vector_internal.h"
+
+#define defvte vu_reg_t vte = get_vte_reference(&N64RSP.vu_regs[instruction.cp2_vec.vt], instruction.cp2_vec.e)
+
+INLINE vu_reg_t broadcast(vu_reg_t* vt, int lane0, int lane1, int lane2, int lane3, int lane4, int lane5, int lane6, int lane7) {
+    vu_reg_t vte;
+    vte.elements[VU_ELEM_INDEX(0)] = vt->elements[VU_ELEM_INDEX(lane0)];
+    vte.elements[VU_ELEM_INDEX(1)] = vt->elements[VU_ELEM_INDEX(lane1)];
+    vte.elements[VU_ELEM_INDEX(2)] = vt->elements[VU_ELEM_INDEX(lane2)];
+    vte.elements[VU_ELEM_INDEX(3)] = vt->elements[VU_ELEM_INDEX(lane3)];
+    vte.elements[VU_ELEM_INDEX(4)] = vt->elements[VU_ELEM_INDEX(lane4)];
+    vte.elements[VU_ELEM_INDEX(5)] = vt->elements[VU_ELEM_INDEX(lane5)];
+    vte.elements[VU_ELEM_INDEX(6)] = vt->elements[VU_ELEM_INDEX(lane6)];
+    vte.elements[VU_ELEM_INDEX(7)] = vt->elements[VU_ELEM_INDEX(lane7)];
+    return vte;
+}
+
+vu_reg_t get_vte_reference(vu_reg_t* vt, u8 e) {
+    switch(e) {
+        case 0 ... 1:
+            return *vt;
+        case 2:
+            return broadcast(vt, 0, 0, 2, 2, 4, 4, 6, 6);
+        case 3:
+            return broadcast(vt, 1, 1, 3, 3, 5, 5, 7, 7);
+        case 4:
+            return broadcast(vt, 0, 0, 0, 0, 4, 4, 4, 4);
+        case 5:
+            return broadcast(vt, 1, 1, 1, 1, 5, 5, 5, 5);
+        case 6:
+            return broadcast(vt, 2, 2, 2, 2, 6, 6, 6, 6);
+        case 7:
+            return broadcast(vt, 3, 3, 3, 3, 7, 7, 7, 7);
+        case 8 ... 15: {
+            vu_reg_t vte;
+            int index = VU_ELEM_INDEX(e - 8);
+            for (int i = 0; i < 8; i++) {
+                vte.elements[i] = vt->elements[index];
+            }
+            return vte;
+        }
+        default:
+            logfatal("vte where e > 15");
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vabs_reference) {
+    defvs;
+    defvd;
+    defvte;
+
+    for (int i = 0; i < 8; i++) {
+        if (vs->signed_elements[i] < 0) {
+            if (unlikely(vte.elements[i] == 0x8000)) {
+                vd->elements[i] = 0x7FFF;
+                N64RSP.acc.l.elements[i] = 0x8000;
+            } else {
+                vd->elements[i] = -vte.signed_elements[i];
+                N64RSP.acc.l.elements[i] = -vte.signed_elements[i];
+            }
+        } else if (vs->elements[i] == 0) {
+            vd->elements[i] = 0x0000;
+            N64RSP.acc.l.elements[i] = 0x0000;
+        } else {
+            vd->elements[i] = vte.elements[i];
+            N64RSP.acc.l.elements[i] = vte.elements[i];
+        }
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vadd_reference) {
+    defvs;
+    defvd;
+    defvte;
+
+    for (int i = 0; i < 8; i++) {
+        s16 vs_element = vs->signed_elements[i];
+        s16 vte_element = vte.signed_elements[i];
+        s32 result = vs_element + vte_element + (N64RSP.vco.l.elements[i] != 0);
+        N64RSP.acc.l.elements[i] = result;
+        vd->elements[i] = clamp_signed(result);
+        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
+        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vaddc_reference) {
+    defvs;
+    defvd;
+    defvte;
+
+    for (int i = 0; i < 8; i++) {
+        u16 vs_element = vs->elements[i];
+        u16 vte_element = vte.elements[i];
+        u32 result = vs_element + vte_element;
+        N64RSP.acc.l.elements[i] = result & 0xFFFF;
+        vd->elements[i] = result & 0xFFFF;
+        N64RSP.vco.l.elements[i] = FLAGREG_BOOL((result >> 16) & 1);
+        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vand_reference) {
+    defvs;
+    defvd;
+    defvte;
+
+    for (int i = 0; i < 8; i++) {
+        u16 result = vte.elements[i] & vs->elements[i];
+        vd->elements[i] = result;
+        N64RSP.acc.l.elements[i] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vch_reference) {
+    defvs;
+    defvd;
+    defvte;
+
+    for (int i = 0; i < 8; i++) {
+        s16 vs_element = vs->signed_elements[i];
+        s16 vte_element = vte.signed_elements[i];
+
+        if ((vs_element ^ vte_element) < 0) {
+            s16 result = vs_element + vte_element;
+
+            N64RSP.acc.l.signed_elements[i] = (result <= 0 ? -vte_element : vs_element);
+            N64RSP.vcc.l.elements[i] = FLAGREG_BOOL(result <= 0);
+            N64RSP.vcc.h.elements[i] = FLAGREG_BOOL(vte_element < 0);
+            N64RSP.vco.l.elements[i] = FLAGREG_BOOL(1);
+            N64RSP.vco.h.elements[i] = FLAGREG_BOOL(result != 0 && (u16)vs_element != ((u16)vte_element ^ 0xFFFF));
+            N64RSP.vce.elements[i]   = FLAGREG_BOOL(result == -1);
+        } else {
+            s16 result = vs_element - vte_element;
+
+            N64RSP.acc.l.elements[i] = (result >= 0 ? vte_element : vs_element);
+            N64RSP.vcc.l.elements[i] = FLAGREG_BOOL(vte_element < 0);
+            N64RSP.vcc.h.elements[i] = FLAGREG_BOOL(result >= 0);
+            N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
+            N64RSP.vco.h.elements[i] = FLAGREG_BOOL(result != 0 && (u16)vs_element != ((u16)vte_element ^ 0xFFFF));
+            N64RSP.vce.elements[i]   = FLAGREG_BOOL(0);
+        }
+
+        vd->elements[i] = N64RSP.acc.l.elements[i];
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vcl_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int i = 0; i < 8; i++) {
+        u16 vs_element = vs->elements[i];
+        u16 vte_element = vte.elements[i];
+
+        if(N64RSP.vco.l.elements[i]) {
+            if(N64RSP.vco.h.elements[i]) {
+                N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] ? -vte_element : vs_element;
+            } else {
+                u16 clamped_sum = vs_element + vte_element;
+                bool overflow = (vs_element + vte_element) != clamped_sum;
+                if(N64RSP.vce.elements[i]) {
+                    N64RSP.vcc.l.elements[i] = FLAGREG_BOOL(!clamped_sum || !overflow);
+                    N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] ? -vte_element : vs_element;
+                } else {
+                    N64RSP.vcc.l.elements[i] = FLAGREG_BOOL(!clamped_sum && !overflow);
+                    N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] ? -vte_element : vs_element;
+                }
+            }
+        } else {
+            if(N64RSP.vco.h.elements[i]) {
+                N64RSP.acc.l.elements[i] = N64RSP.vcc.h.elements[i] ? vte_element : vs_element;
+            } else {
+                N64RSP.vcc.h.elements[i] = FLAGREG_BOOL((s32)vs_element - (s32)vte_element >= 0);
+                N64RSP.acc.l.elements[i] = N64RSP.vcc.h.elements[i] ? vte_element : vs_element;
+            }
+        }
+    }
+
+    memset(&N64RSP.vco.l, 0, sizeof(vu_reg_t));
+    memset(&N64RSP.vco.h, 0, sizeof(vu_reg_t));
+    memset(&N64RSP.vce, 0, sizeof(vu_reg_t));
+    memcpy(vd, &N64RSP.acc.l, sizeof(vu_reg_t));
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vcr_reference) {
+    defvs;
+    defvd;
+    defvte;
+
+    for (int i = 0; i < 8; i++) {
+        u16 vs_element = vs->elements[i];
+        u16 vte_element = vte.elements[i];
+
+        bool sign_different = (0x8000 & (vs_element ^ vte_element)) == 0x8000;
+
+        // If vte and vs have different signs, make this negative vte
+        u16 vt_abs = sign_different ? ~vte_element : vte_element;
+
+        // Compare using one's complement
+        bool gte = (s16)vte_element <= (s16)(sign_different ? 0xFFFF : vs_element);
+        bool lte = (((sign_different ? vs_element : 0) + vte_element) & 0x8000) == 0x8000;
+
+        // If the sign is different, check LTE, otherwise, check GTE.
+        bool check = sign_different ? lte : gte;
+        u16 result = check ? vt_abs : vs_element;
+
+        N64RSP.acc.l.elements[i] = result;
+        vd->elements[i] = result;
+
+        N64RSP.vcc.h.elements[i] = FLAGREG_BOOL(gte);
+        N64RSP.vcc.l.elements[i] = FLAGREG_BOOL(lte);
+
+        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
+        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
+        N64RSP.vce.elements[i] = FLAGREG_BOOL(0);
+
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_veq_reference) {
+    defvs;
+    defvd;
+    defvte;
+
+    for (int i = 0; i < 8; i++) {
+        N64RSP.vcc.l.elements[i] = FLAGREG_BOOL((N64RSP.vco.h.elements[i] == 0) && (vs->elements[i] == vte.elements[i]));
+        N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] != 0 ? vs->elements[i] : vte.elements[i];
+        vd->elements[i] = N64RSP.acc.l.elements[i];
+
+        N64RSP.vcc.h.elements[i] = FLAGREG_BOOL(0);
+        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
+        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vge_reference) {
+    defvs;
+    defvd;
+    defvte;
+
+    for (int i = 0; i < 8; i++) {
+        bool eql = vs->signed_elements[i] == vte.signed_elements[i];
+        bool neg = !(N64RSP.vco.l.elements[i] != 0 && N64RSP.vco.h.elements[i] != 0) && eql;
+
+        N64RSP.vcc.l.elements[i] = FLAGREG_BOOL(neg || (vs->signed_elements[i] > vte.signed_elements[i]));
+        N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] != 0 ? vs->elements[i] : vte.elements[i];
+        vd->elements[i] = N64RSP.acc.l.elements[i];
+        N64RSP.vcc.h.elements[i] = FLAGREG_BOOL(0);
+        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
+        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
+
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vlt_reference) {
+    defvs;
+    defvd;
+    defvte;
+
+    for (int i = 0; i < 8; i++) {
+        bool eql = vs->elements[i] == vte.elements[i];
+        bool neg = N64RSP.vco.h.elements[i] != 0 && N64RSP.vco.l.elements[i] != 0 && eql;
+        N64RSP.vcc.l.elements[i] = FLAGREG_BOOL(neg || (vs->signed_elements[i] < vte.signed_elements[i]));
+        N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] != 0 ? vs->elements[i] : vte.elements[i];
+        vd->elements[i] = N64RSP.acc.l.elements[i];
+        N64RSP.vcc.h.elements[i] = FLAGREG_BOOL(0);
+        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
+        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vmacf_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int e = 0; e < 8; e++) {
+        s16 multiplicand1 = vte.elements[e];
+        s16 multiplicand2 = vs->elements[e];
+        s32 prod = multiplicand1 * multiplicand2;
+
+        s64 acc_delta = prod;
+        acc_delta *= 2;
+        s64 acc = get_rsp_accumulator(e) + acc_delta;
+        set_rsp_accumulator(e, acc);
+        acc = get_rsp_accumulator(e);
+
+        s16 result = clamp_signed(acc >> 16);
+
+        vd->elements[e] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vmacu_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int e = 0; e < 8; e++) {
+        s16 multiplicand1 = vte.elements[e];
+        s16 multiplicand2 = vs->elements[e];
+        s32 prod = multiplicand1 * multiplicand2;
+
+        s64 acc_delta = prod;
+        acc_delta *= 2;
+        s64 acc = get_rsp_accumulator(e) + acc_delta;
+        set_rsp_accumulator(e, acc);
+        acc = get_rsp_accumulator(e);
+
+        u16 result = clamp_unsigned(acc >> 16);
+
+        vd->elements[e] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vmadh_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int e = 0; e < 8; e++) {
+        s16 multiplicand1 = vte.elements[e];
+        s16 multiplicand2 = vs->elements[e];
+        s32 prod = multiplicand1 * multiplicand2;
+        u32 uprod = prod;
+
+        u64 acc_delta = (u64)uprod << 16;
+        s64 acc = get_rsp_accumulator(e) + acc_delta;
+        set_rsp_accumulator(e, acc);
+        acc = get_rsp_accumulator(e);
+
+        s16 result = clamp_signed(acc >> 16);
+
+        vd->elements[e] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vmadl_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int e = 0; e < 8; e++) {
+        u64 multiplicand1 = vte.elements[e];
+        u64 multiplicand2 = vs->elements[e];
+        u64 prod = multiplicand1 * multiplicand2;
+
+        u64 acc_delta = prod >> 16;
+        u64 acc = get_rsp_accumulator(e) + acc_delta;
+
+        set_rsp_accumulator(e, acc);
+        u16 result;
+        if (is_sign_extension(N64RSP.acc.h.signed_elements[e], N64RSP.acc.m.signed_elements[e])) {
+            result = N64RSP.acc.l.elements[e];
+        } else if (N64RSP.acc.h.signed_elements[e] < 0) {
+            result = 0;
+        } else {
+            result = 0xFFFF;
+        }
+
+        vd->elements[e] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vmadm_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int e = 0; e < 8; e++) {
+        u16 multiplicand1 = vte.elements[e];
+        s16 multiplicand2 = vs->elements[e];
+        s32 prod = multiplicand1 * multiplicand2;
+
+        s64 acc_delta = prod;
+        s64 acc = get_rsp_accumulator(e);
+        acc += acc_delta;
+        set_rsp_accumulator(e, acc);
+        acc = get_rsp_accumulator(e);
+
+        s16 result = clamp_signed(acc >> 16);
+
+        vd->elements[e] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vmadn_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int e = 0; e < 8; e++) {
+        s16 multiplicand1 = vte.elements[e];
+        u16 multiplicand2 = vs->elements[e];
+        s32 prod = multiplicand1 * multiplicand2;
+
+        s64 acc_delta = prod;
+        s64 acc = get_rsp_accumulator(e) + acc_delta;
+
+        set_rsp_accumulator(e, acc);
+
+        u16 result;
+
+        if (is_sign_extension(N64RSP.acc.h.signed_elements[e], N64RSP.acc.m.signed_elements[e])) {
+            result = N64RSP.acc.l.elements[e];
+        } else if (N64RSP.acc.h.signed_elements[e] < 0) {
+            result = 0;
+        } else {
+            result = 0xFFFF;
+        }
+
+        vd->elements[e] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vmrg_reference) {
+    defvs;
+    defvd;
+    defvte;
+
+    for (int i = 0; i < 8; i++) {
+        N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] != 0 ? vs->elements[i] : vte.elements[i];
+        vd->elements[i] = N64RSP.acc.l.elements[i];
+
+        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
+        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vmudh_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int e = 0; e < 8; e++) {
+        s16 multiplicand1 = vte.elements[e];
+        s16 multiplicand2 = vs->elements[e];
+        s32 prod = multiplicand1 * multiplicand2;
+
+        s64 acc = (s64)prod;
+
+        s16 result = clamp_signed(acc);
+
+        acc <<= 16;
+        set_rsp_accumulator(e, acc);
+
+        vd->elements[e] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vmudl_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int e = 0; e < 8; e++) {
+        u64 multiplicand1 = vte.elements[e];
+        u64 multiplicand2 = vs->elements[e];
+        u64 prod = multiplicand1 * multiplicand2;
+
+        u64 acc = prod >> 16;
+
+        set_rsp_accumulator(e, acc);
+        u16 result;
+        if (is_sign_extension(N64RSP.acc.h.signed_elements[e], N64RSP.acc.m.signed_elements[e])) {
+            result = N64RSP.acc.l.elements[e];
+        } else if (N64RSP.acc.h.signed_elements[e] < 0) {
+            result = 0;
+        } else {
+            result = 0xFFFF;
+        }
+
+        vd->elements[e] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vmudm_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int e = 0; e < 8; e++) {
+        u16 multiplicand1 = vte.elements[e];
+        s16 multiplicand2 = vs->elements[e];
+        s32 prod = multiplicand1 * multiplicand2;
+
+        s64 acc = prod;
+
+        s16 result = clamp_signed(acc >> 16);
+
+        set_rsp_accumulator(e, acc);
+        vd->elements[e] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vmudn_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int e = 0; e < 8; e++) {
+        s16 multiplicand1 = vte.elements[e];
+        u16 multiplicand2 = vs->elements[e];
+        s32 prod = multiplicand1 * multiplicand2;
+
+        s64 acc = prod;
+
+        set_rsp_accumulator(e, acc);
+
+        u16 result;
+        if (is_sign_extension(N64RSP.acc.h.signed_elements[e], N64RSP.acc.m.signed_elements[e])) {
+            result = N64RSP.acc.l.elements[e];
+        } else if (N64RSP.acc.h.signed_elements[e] < 0) {
+            result = 0;
+        } else {
+            result = 0xFFFF;
+        }
+
+        vd->elements[e] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vmulf_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int e = 0; e < 8; e++) {
+        s16 multiplicand1 = vte.elements[e];
+        s16 multiplicand2 = vs->elements[e];
+        s32 prod = multiplicand1 * multiplicand2;
+
+        s64 acc = prod;
+        acc = (acc * 2) + 0x8000;
+
+        set_rsp_accumulator(e, acc);
+
+        s16 result = clamp_signed(acc >> 16);
+        vd->elements[e] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vmulu_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int e = 0; e < 8; e++) {
+        s16 multiplicand1 = vte.elements[e];
+        s16 multiplicand2 = vs->elements[e];
+        s32 prod = multiplicand1 * multiplicand2;
+
+        s64 acc = prod;
+        acc = (acc * 2) + 0x8000;
+
+        u16 result = clamp_unsigned(acc >> 16);
+
+        set_rsp_accumulator(e, acc);
+        vd->elements[e] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vnand_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int i = 0; i < 8; i++) {
+        u16 result = ~(vte.elements[i] & vs->elements[i]);
+        vd->elements[i] = result;
+        N64RSP.acc.l.elements[i] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vne_reference) {
+    defvs;
+    defvd;
+    defvte;
+
+    for (int i = 0; i < 8; i++) {
+        N64RSP.vcc.l.elements[i] = FLAGREG_BOOL((N64RSP.vco.h.elements[i] != 0) || (vs->elements[i] != vte.elements[i]));
+        N64RSP.acc.l.elements[i] = N64RSP.vcc.l.elements[i] != 0 ? vs->elements[i] : vte.elements[i];
+        vd->elements[i] = N64RSP.acc.l.elements[i];
+
+        N64RSP.vcc.h.elements[i] = FLAGREG_BOOL(0);
+        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
+        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vnor_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int i = 0; i < 8; i++) {
+        u16 result = ~(vte.elements[i] | vs->elements[i]);
+        vd->elements[i] = result;
+        N64RSP.acc.l.elements[i] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vnxor_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int i = 0; i < 8; i++) {
+        u16 result = ~(vte.elements[i] ^ vs->elements[i]);
+        vd->elements[i] = result;
+        N64RSP.acc.l.elements[i] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vor_reference) {
+    defvs;
+    defvd;
+    defvte;
+    for (int i = 0; i < 8; i++) {
+        u16 result = vte.elements[i] | vs->elements[i];
+        vd->elements[i] = result;
+        N64RSP.acc.l.elements[i] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vsub_reference) {
+    defvs;
+    defvd;
+    defvte;
+
+    for (int i = 0; i < 8; i++) {
+        s32 result = vs->signed_elements[i] - vte.signed_elements[i] - (N64RSP.vco.l.elements[i] != 0);
+        N64RSP.acc.l.signed_elements[i] = result;
+        vd->signed_elements[i] = clamp_signed(result);
+        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(0);
+        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(0);
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vsubc_reference) {
+    defvs;
+    defvd;
+    defvte;
+
+    for (int i = 0; i < 8; i++) {
+        u32 result = vs->elements[i] - vte.elements[i];
+        u16 hresult = result & 0xFFFF;
+        bool carry = (result >> 16) & 1;
+
+        vd->elements[i] = hresult;
+        N64RSP.acc.l.elements[i] = hresult;
+        N64RSP.vco.l.elements[i] = FLAGREG_BOOL(carry);
+        N64RSP.vco.h.elements[i] = FLAGREG_BOOL(result != 0); // not hresult, but I bet that'd also work
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vxor_reference) {
+    defvs;
+    defvte;
+    defvd;
+    for (int i = 0; i < 8; i++) {
+        u16 result = vte.elements[i] ^ vs->elements[i];
+        vd->elements[i] = result;
+        N64RSP.acc.l.elements[i] = result;
+    }
+}
+
+RSP_VECTOR_INSTR(rsp_vec_vzero_reference) {
+    defvs;
+    defvte;
+    defvd;
+    for (int i = 0; i < 8; i++) {
+        N64RSP.acc.l.elements[i] = vte.elements[i] + vs->elements[i];
+    }
+    memset(vd, 0, sizeof(vu_reg_t));
+}
@@ -0,0 +1,42 @@
+#ifndef N64_RSP_VECTOR_REFERENCE_H
+#define N64_RSP_VECTOR_REFERENCE_H
+
+#include "rsp_vector_instructions.h"
+
+// Scalar versions of the vector instructions with SIMD implementations, for differential testing.
+vu_reg_t get_vte_reference(vu_reg_t* vt, u8 e);
+
+RSP_VECTOR_INSTR(rsp_vec_vabs_reference);
+RSP_VECTOR_INSTR(rsp_vec_vadd_reference);
+RSP_VECTOR_INSTR(rsp_vec_vaddc_reference);
+RSP_VECTOR_INSTR(rsp_vec_vand_reference);
+RSP_VECTOR_INSTR(rsp_vec_vch_reference);
+RSP_VECTOR_INSTR(rsp_vec_vcl_reference);
+RSP_VECTOR_INSTR(rsp_vec_vcr_reference);
+RSP_VECTOR_INSTR(rsp_vec_veq_reference);
+RSP_VECTOR_INSTR(rsp_vec_vge_reference);
+RSP_VECTOR_INSTR(rsp_vec_vlt_reference);
+RSP_VECTOR_INSTR(rsp_vec_vmacf_reference);
+RSP_VECTOR_INSTR(rsp_vec_vmacu_reference);
+RSP_VECTOR_INSTR(rsp_vec_vmadh_reference);
+RSP_VECTOR_INSTR(rsp_vec_vmadl_reference);
+RSP_VECTOR_INSTR(rsp_vec_vmadm_reference);
+RSP_VECTOR_INSTR(rsp_vec_vmadn_reference);
+RSP_VECTOR_INSTR(rsp_vec_vmrg_reference);
+RSP_VECTOR_INSTR(rsp_vec_vmudh_reference);
+RSP_VECTOR_INSTR(rsp_vec_vmudl_reference);
+RSP_VECTOR_INSTR(rsp_vec_vmudm_reference);
+RSP_VECTOR_INSTR(rsp_vec_vmudn_reference);
+RSP_VECTOR_INSTR(rsp_vec_vmulf_reference);
+RSP_VECTOR_INSTR(rsp_vec_vmulu_reference);
+RSP_VECTOR_INSTR(rsp_vec_vnand_reference);
+RSP_VECTOR_INSTR(rsp_vec_vne_reference);
+RSP_VECTOR_INSTR(rsp_vec_vnor_reference);
+RSP_VECTOR_INSTR(rsp_vec_vnxor_reference);
+RSP_VECTOR_INSTR(rsp_vec_vor_reference);
+RSP_VECTOR_INSTR(rsp_vec_vsub_reference);
+RSP_VECTOR_INSTR(rsp_vec_vsubc_reference);
+RSP_VECTOR_INSTR(rsp_vec_vxor_reference);
+RSP_VECTOR_INSTR(rsp_vec_vzero_reference);
+
+#endif //N64_RSP_VECTOR_REFERENCE_H
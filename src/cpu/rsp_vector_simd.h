@@ -0,0 +1,268 @@
+#ifndef N64_RSP_VECTOR_SIMD_H
+#define N64_RSP_VECTOR_SIMD_H
+
+// Small portable layer over the 8x16-bit vector operations the RSP vector unit needs.
+// The backend is selected at build time:
+//  - N64_HAVE_SSE:  SSE4.1 / SSSE3 intrinsics (x86_64)
+//  - N64_USE_NEON:  native NEON intrinsics (AArch64)
+//  - otherwise:     GCC/Clang vector extensions
+// All operations are lane-wise on 16 bit lanes, and masks are 0x0000 / 0xFFFF per lane, the same as the flag registers.
+// Only the byte shuffle depends on lane order, and the tables passed to it are built for little endian hosts.
+
+#include <string.h>
+#include <util.h>
+#include "rsp_types.h"
+
+#if defined(N64_HAVE_SSE)
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <smmintrin.h>
+typedef __m128i vu_vec_t;
+#elif defined(N64_USE_NEON)
+#include <arm_neon.h>
+typedef int16x8_t vu_vec_t;
+#else
+typedef s16 vu_vec_t __attribute__((__vector_size__(16)));
+typedef u16 vu_uvec_t __attribute__((__vector_size__(16)));
+typedef s32 vu_wide_t __attribute__((__vector_size__(32)));
+typedef u32 vu_uwide_t __attribute__((__vector_size__(32)));
+#endif
+
+#if defined(N64_HAVE_SSE)
+
+INLINE vu_vec_t vu_load(const vu_reg_t* reg) { return reg->single; }
+INLINE void vu_store(vu_reg_t* reg, vu_vec_t v) { reg->single = v; }
+INLINE vu_vec_t vu_zero() { return _mm_setzero_si128(); }
+INLINE vu_vec_t vu_set1(u16 value) { return _mm_set1_epi16((s16)value); }
+
+INLINE vu_vec_t vu_add(vu_vec_t a, vu_vec_t b) { return _mm_add_epi16(a, b); }
+INLINE vu_vec_t vu_sub(vu_vec_t a, vu_vec_t b) { return _mm_sub_epi16(a, b); }
+INLINE vu_vec_t vu_adds(vu_vec_t a, vu_vec_t b) { return _mm_adds_epi16(a, b); }
+INLINE vu_vec_t vu_subs(vu_vec_t a, vu_vec_t b) { return _mm_subs_epi16(a, b); }
+INLINE vu_vec_t vu_min(vu_vec_t a, vu_vec_t b) { return _mm_min_epi16(a, b); }
+INLINE vu_vec_t vu_max(vu_vec_t a, vu_vec_t b) { return _mm_max_epi16(a, b); }
+
+INLINE vu_vec_t vu_and(vu_vec_t a, vu_vec_t b) { return _mm_and_si128(a, b); }
+INLINE vu_vec_t vu_or(vu_vec_t a, vu_vec_t b) { return _mm_or_si128(a, b); }
+INLINE vu_vec_t vu_xor(vu_vec_t a, vu_vec_t b) { return _mm_xor_si128(a, b); }
+// a & ~b
+INLINE vu_vec_t vu_bic(vu_vec_t a, vu_vec_t b) { return _mm_andnot_si128(b, a); }
+INLINE vu_vec_t vu_not(vu_vec_t a) { return _mm_xor_si128(a, _mm_cmpeq_epi16(a, a)); }
+
+INLINE vu_vec_t vu_eq(vu_vec_t a, vu_vec_t b) { return _mm_cmpeq_epi16(a, b); }
+INLINE vu_vec_t vu_gt(vu_vec_t a, vu_vec_t b) { return _mm_cmpgt_epi16(a, b); }
+INLINE vu_vec_t vu_lt(vu_vec_t a, vu_vec_t b) { return _mm_cmplt_epi16(a, b); }
+// unsigned a < b
+INLINE vu_vec_t vu_ltu(vu_vec_t a, vu_vec_t b) {
+    const vu_vec_t bias = _mm_set1_epi16((s16)0x8000);
+    return _mm_cmplt_epi16(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+}
+// mask ? a : b
+INLINE vu_vec_t vu_sel(vu_vec_t mask, vu_vec_t a, vu_vec_t b) { return _mm_blendv_epi8(b, a, mask); }
+
+// All ones if negative, zero otherwise
+INLINE vu_vec_t vu_sign(vu_vec_t a) { return _mm_srai_epi16(a, 15); }
+// 1 if negative, zero otherwise
+INLINE vu_vec_t vu_bit15(vu_vec_t a) { return _mm_srli_epi16(a, 15); }
+INLINE vu_vec_t vu_shl1(vu_vec_t a) { return _mm_slli_epi16(a, 1); }
+
+INLINE vu_vec_t vu_mullo(vu_vec_t a, vu_vec_t b) { return _mm_mullo_epi16(a, b); }
+INLINE vu_vec_t vu_mulhi(vu_vec_t a, vu_vec_t b) { return _mm_mulhi_epi16(a, b); }
+INLINE vu_vec_t vu_mulhiu(vu_vec_t a, vu_vec_t b) { return _mm_mulhi_epu16(a, b); }
+
+// Saturate the 32 bit values (hi << 16) | lo to signed 16 bits
+INLINE vu_vec_t vu_packs(vu_vec_t lo, vu_vec_t hi) {
+    return _mm_packs_epi32(_mm_unpacklo_epi16(lo, hi), _mm_unpackhi_epi16(lo, hi));
+}
+
+INLINE vu_vec_t vu_shuffle_bytes(vu_vec_t a, const u8* table) {
+    return _mm_shuffle_epi8(a, _mm_loadu_si128((const __m128i*)table));
+}
+
+#elif defined(N64_USE_NEON)
+
+INLINE vu_vec_t vu_load(const vu_reg_t* reg) { return vld1q_s16(reg->signed_elements); }
+INLINE void vu_store(vu_reg_t* reg, vu_vec_t v) { vst1q_s16(reg->signed_elements, v); }
+INLINE vu_vec_t vu_zero() { return vdupq_n_s16(0); }
+INLINE vu_vec_t vu_set1(u16 value) { return vdupq_n_s16((s16)value); }
+
+INLINE vu_vec_t vu_add(vu_vec_t a, vu_vec_t b) { return vaddq_s16(a, b); }
+INLINE vu_vec_t vu_sub(vu_vec_t a, vu_vec_t b) { return vsubq_s16(a, b); }
+INLINE vu_vec_t vu_adds(vu_vec_t a, vu_vec_t b) { return vqaddq_s16(a, b); }
+INLINE vu_vec_t vu_subs(vu_vec_t a, vu_vec_t b) { return vqsubq_s16(a, b); }
+INLINE vu_vec_t vu_min(vu_vec_t a, vu_vec_t b) { return vminq_s16(a, b); }
+INLINE vu_vec_t vu_max(vu_vec_t a, vu_vec_t b) { return vmaxq_s16(a, b); }
+
+INLINE vu_vec_t vu_and(vu_vec_t a, vu_vec_t b) { return vandq_s16(a, b); }
+INLINE vu_vec_t vu_or(vu_vec_t a, vu_vec_t b) { return vorrq_s16(a, b); }
+INLINE vu_vec_t vu_xor(vu_vec_t a, vu_vec_t b) { return veorq_s16(a, b); }
+// a & ~b
+INLINE vu_vec_t vu_bic(vu_vec_t a, vu_vec_t b) { return vbicq_s16(a, b); }
+INLINE vu_vec_t vu_not(vu_vec_t a) { return vmvnq_s16(a); }
+
+INLINE vu_vec_t vu_eq(vu_vec_t a, vu_vec_t b) { return vreinterpretq_s16_u16(vceqq_s16(a, b)); }
+INLINE vu_vec_t vu_gt(vu_vec_t a, vu_vec_t b) { return vreinterpretq_s16_u16(vcgtq_s16(a, b)); }
+INLINE vu_vec_t vu_lt(vu_vec_t a, vu_vec_t b) { return vreinterpretq_s16_u16(vcltq_s16(a, b)); }
+// unsigned a < b
+INLINE vu_vec_t vu_ltu(vu_vec_t a, vu_vec_t b) {
+    return vreinterpretq_s16_u16(vcltq_u16(vreinterpretq_u16_s16(a), vreinterpretq_u16_s16(b)));
+}
+// mask ? a : b
+INLINE vu_vec_t vu_sel(vu_vec_t mask, vu_vec_t a, vu_vec_t b) { return vbslq_s16(vreinterpretq_u16_s16(mask), a, b); }
+
+// All ones if negative, zero otherwise
+INLINE vu_vec_t vu_sign(vu_vec_t a) { return vshrq_n_s16(a, 15); }
+// 1 if negative, zero otherwise
+INLINE vu_vec_t vu_bit15(vu_vec_t a) { return vreinterpretq_s16_u16(vshrq_n_u16(vreinterpretq_u16_s16(a), 15)); }
+INLINE vu_vec_t vu_shl1(vu_vec_t a) { return vshlq_n_s16(a, 1); }
+
+INLINE vu_vec_t vu_mullo(vu_vec_t a, vu_vec_t b) { return vmulq_s16(a, b); }
+INLINE vu_vec_t vu_mulhi(vu_vec_t a, vu_vec_t b) {
+    int32x4_t lo = vmull_s16(vget_low_s16(a), vget_low_s16(b));
+    int32x4_t hi = vmull_high_s16(a, b);
+    return vuzp2q_s16(vreinterpretq_s16_s32(lo), vreinterpretq_s16_s32(hi));
+}
+INLINE vu_vec_t vu_mulhiu(vu_vec_t a, vu_vec_t b) {
+    uint16x8_t ua = vreinterpretq_u16_s16(a);
+    uint16x8_t ub = vreinterpretq_u16_s16(b);
+    uint32x4_t lo = vmull_u16(vget_low_u16(ua), vget_low_u16(ub));
+    uint32x4_t hi = vmull_high_u16(ua, ub);
+    return vreinterpretq_s16_u16(vuzp2q_u16(vreinterpretq_u16_u32(lo), vreinterpretq_u16_u32(hi)));
+}
+
+// Saturate the 32 bit values (hi << 16) | lo to signed 16 bits
+INLINE vu_vec_t vu_packs(vu_vec_t lo, vu_vec_t hi) {
+    int32x4_t wide_lo = vreinterpretq_s32_s16(vzip1q_s16(lo, hi));
+    int32x4_t wide_hi = vreinterpretq_s32_s16(vzip2q_s16(lo, hi));
+    return vqmovn_high_s32(vqmovn_s32(wide_lo), wide_hi);
+}
+
+INLINE vu_vec_t vu_shuffle_bytes(vu_vec_t a, const u8* table) {
+    return vreinterpretq_s16_u8(vqtbl1q_u8(vreinterpretq_u8_s16(a), vld1q_u8(table)));
+}
+
+#else
+
+INLINE vu_vec_t vu_load(const vu_reg_t* reg) { return (vu_vec_t)reg->single; }
+INLINE void vu_store(vu_reg_t* reg, vu_vec_t v) { reg->single = (s128)v; }
+INLINE vu_vec_t vu_zero() { return (vu_vec_t){0, 0, 0, 0, 0, 0, 0, 0}; }
+INLINE vu_vec_t vu_set1(u16 value) {
+    s16 v = (s16)value;
+    return (vu_vec_t){v, v, v, v, v, v, v, v};
+}
+
+// Arithmetic is done on unsigned lanes so that wrapping is well defined
+INLINE vu_vec_t vu_add(vu_vec_t a, vu_vec_t b) { return (vu_vec_t)((vu_uvec_t)a + (vu_uvec_t)b); }
+INLINE vu_vec_t vu_sub(vu_vec_t a, vu_vec_t b) { return (vu_vec_t)((vu_uvec_t)a - (vu_uvec_t)b); }
+
+INLINE vu_vec_t vu_narrow_saturate(vu_wide_t wide) {
+    const vu_wide_t min = {-32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768};
+    const vu_wide_t max = {32767, 32767, 32767, 32767, 32767, 32767, 32767, 32767};
+    vu_wide_t below = wide < min;
+    vu_wide_t above = wide > max;
+    wide = (below & min) | (~below & wide);
+    wide = (above & max) | (~above & wide);
+    return __builtin_convertvector(wide, vu_vec_t);
+}
+
+INLINE vu_vec_t vu_adds(vu_vec_t a, vu_vec_t b) {
+    return vu_narrow_saturate(__builtin_convertvector(a, vu_wide_t) + __builtin_convertvector(b, vu_wide_t));
+}
+INLINE vu_vec_t vu_subs(vu_vec_t a, vu_vec_t b) {
+    return vu_narrow_saturate(__builtin_convertvector(a, vu_wide_t) - __builtin_convertvector(b, vu_wide_t));
+}
+INLINE vu_vec_t vu_min(vu_vec_t a, vu_vec_t b) {
+    vu_vec_t mask = (vu_vec_t)(a < b);
+    return (mask & a) | (~mask & b);
+}
+INLINE vu_vec_t vu_max(vu_vec_t a, vu_vec_t b) {
+    vu_vec_t mask = (vu_vec_t)(a > b);
+    return (mask & a) | (~mask & b);
+}
+
+INLINE vu_vec_t vu_and(vu_vec_t a, vu_vec_t b) { return a & b; }
+INLINE vu_vec_t vu_or(vu_vec_t a, vu_vec_t b) { return a | b; }
+INLINE vu_vec_t vu_xor(vu_vec_t a, vu_vec_t b) { return a ^ b; }
+// a & ~b
+INLINE vu_vec_t vu_bic(vu_vec_t a, vu_vec_t b) { return a & ~b; }
+INLINE vu_vec_t vu_not(vu_vec_t a) { return ~a; }
+
+INLINE vu_vec_t vu_eq(vu_vec_t a, vu_vec_t b) { return (vu_vec_t)(a == b); }
+INLINE vu_vec_t vu_gt(vu_vec_t a, vu_vec_t b) { return (vu_vec_t)(a > b); }
+INLINE vu_vec_t vu_lt(vu_vec_t a, vu_vec_t b) { return (vu_vec_t)(a < b); }
+// unsigned a < b
+INLINE vu_vec_t vu_ltu(vu_vec_t a, vu_vec_t b) { return (vu_vec_t)((vu_uvec_t)a < (vu_uvec_t)b); }
+// mask ? a : b
+INLINE vu_vec_t vu_sel(vu_vec_t mask, vu_vec_t a, vu_vec_t b) { return (mask & a) | (~mask & b); }
+
+// All ones if negative, zero otherwise
+INLINE vu_vec_t vu_sign(vu_vec_t a) { return a >> 15; }
+// 1 if negative, zero otherwise
+INLINE vu_vec_t vu_bit15(vu_vec_t a) { return (vu_vec_t)((vu_uvec_t)a >> 15); }
+INLINE vu_vec_t vu_shl1(vu_vec_t a) { return (vu_vec_t)((vu_uvec_t)a << 1); }
+
+INLINE vu_vec_t vu_mullo(vu_vec_t a, vu_vec_t b) { return (vu_vec_t)((vu_uvec_t)a * (vu_uvec_t)b); }
+INLINE vu_vec_t vu_mulhi(vu_vec_t a, vu_vec_t b) {
+    vu_wide_t product = __builtin_convertvector(a, vu_wide_t) * __builtin_convertvector(b, vu_wide_t);
+    return __builtin_convertvector(product >> 16, vu_vec_t);
+}
+INLINE vu_vec_t vu_mulhiu(vu_vec_t a, vu_vec_t b) {
+    vu_uwide_t product = __builtin_convertvector((vu_uvec_t)a, vu_uwide_t) * __builtin_convertvector((vu_uvec_t)b, vu_uwide_t);
+    return (vu_vec_t)__builtin_convertvector(product >> 16, vu_uvec_t);
+}
+
+// Saturate the 32 bit values (hi << 16) | lo to signed 16 bits
+INLINE vu_vec_t vu_packs(vu_vec_t lo, vu_vec_t hi) {
+    vu_uwide_t wide = (__builtin_convertvector((vu_uvec_t)hi, vu_uwide_t) << 16) | __builtin_convertvector((vu_uvec_t)lo, vu_uwide_t);
+    return vu_narrow_saturate((vu_wide_t)wide);
+}
+
+INLINE vu_vec_t vu_shuffle_bytes(vu_vec_t a, const u8* table) {
+    u8 in[16], out[16];
+    memcpy(in, &a, sizeof(in));
+    for (int i = 0; i < 16; i++) {
+        out[i] = in[table[i]];
+    }
+    memcpy(&a, out, sizeof(out));
+    return a;
+}
+
+#endif
+
+// The accumulator is 48 bits per lane, split into three 16 bit vectors. Add (h << 32) | (m << 16) | l to it.
+INLINE void vu_acc_add(vu_vec_t* acc_h, vu_vec_t* acc_m, vu_vec_t* acc_l, vu_vec_t h, vu_vec_t m, vu_vec_t l) {
+    vu_vec_t sum_l = vu_add(*acc_l, l);
+    vu_vec_t carry_l = vu_ltu(sum_l, l);
+
+    vu_vec_t sum_m = vu_add(*acc_m, m);
+    vu_vec_t carry_m = vu_ltu(sum_m, m);
+    // Carries are all ones, so subtracting them adds one
+    sum_m = vu_sub(sum_m, carry_l);
+    carry_m = vu_or(carry_m, vu_and(carry_l, vu_eq(sum_m, vu_zero())));
+
+    *acc_l = sum_l;
+    *acc_m = sum_m;
+    *acc_h = vu_sub(vu_add(*acc_h, h), carry_m);
+}
+
+// Clamp the accumulator bits 16-47 to a signed 16 bit value
+INLINE vu_vec_t vu_clamp_signed_acc(vu_vec_t acc_h, vu_vec_t acc_m) {
+    return vu_packs(acc_m, acc_h);
+}
+
+// Clamp the accumulator bits 16-47 to an unsigned 16 bit value (negative -> 0, > 0x7FFF -> 0xFFFF)
+INLINE vu_vec_t vu_clamp_unsigned_acc(vu_vec_t acc_h, vu_vec_t acc_m) {
+    vu_vec_t negative = vu_sign(acc_h);
+    vu_vec_t overflow = vu_bic(vu_or(vu_not(vu_eq(acc_h, vu_zero())), vu_sign(acc_m)), negative);
+    return vu_bic(vu_or(acc_m, overflow), negative);
+}
+
+// Accumulator bits 0-15 if bits 16-47 are a sign extension of them, otherwise clamped to 0 or 0xFFFF
+INLINE vu_vec_t vu_clamp_low_acc(vu_vec_t acc_h, vu_vec_t acc_m, vu_vec_t acc_l) {
+    vu_vec_t high_sign = vu_sign(acc_h);
+    vu_vec_t is_sign_extension = vu_and(vu_eq(high_sign, acc_h), vu_eq(high_sign, vu_sign(acc_m)));
+    vu_vec_t clamped = vu_eq(high_sign, vu_zero());
+    return vu_sel(is_sign_extension, acc_l, clamped);
+}
+
+#endif //N64_RSP_VECTOR_SIMD_H
@@ -42,6 +42,7 @@ void do_tlbr() {
     N64CP0.entry_lo0.g = entry.global;
     N64CP0.entry_lo1.g = entry.global;
     N64CP0.page_mask.raw = entry.page_mask.raw;
+    softtlb_asid_updated();
 }
 
 void do_tlbwi(int index) {
@@ -61,7 +62,7 @@ void do_tlbwi(int index) {
         logfatal("TLBWI to TLB index %d", index);
     }
     // Clear old entry
-    clear_tlb_cache(N64CP0.tlb[index]);
+    softtlb_invalidate_entry(&N64CP0.tlb[index]);
     N64CP0.tlb[index].entry_hi.raw  = N64CP0.entry_hi.raw;
     N64CP0.tlb[index].entry_hi.vpn2 &= ~page_mask.mask;
     // Note: different masks than the Cop0 registers for entry_lo0 and 1, so another mask is needed here
@@ -74,7 +75,7 @@ void do_tlbwi(int index) {
     N64CP0.tlb[index].initialized = true;
 
     // Clear new entry
-    clear_tlb_cache(N64CP0.tlb[index]);
+    softtlb_invalidate_entry(&N64CP0.tlb[index]);
 }
 
 MIPS_INSTR(mips_tlbr) {
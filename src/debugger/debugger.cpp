@@ -1,40 +1,151 @@
 #include "debugger.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 extern "C" {
 #include <mem/n64bus.h>
 }
 
+std::mutex debugger_mutex;
 std::unordered_map<u64, Breakpoint> breakpoints;
+std::map<u32, Watchpoint> watchpoints;
 // The debugger was just stepped - we should break on the next instruction
-bool break_for_step = false;
+std::atomic<bool> break_for_step = false;
+static std::atomic<bool> breakpoints_changed = false;
+
+u32 n64_breakpoint_filter[1 << BREAKPOINT_FILTER_BITS];
+u8* n64_watched_pages = nullptr;
+// Stays allocated once there's been a watchpoint, the CPU thread can still be looking at it when the last one is cleared
+static u8* watched_pages = nullptr;
+
+// Call with debugger_mutex held
+static void erase_breakpoint(u64 address) {
+    if (breakpoints.erase(address) != 0) {
+        n64_breakpoint_filter[BREAKPOINT_FILTER_INDEX(address)]--;
+        breakpoints_changed = true;
+    }
+}
 
 bool check_breakpoint(u64 address) {
-    bool hit = breakpoints.find(address) != breakpoints.end() || break_for_step;
+    std::lock_guard<std::mutex> lock(debugger_mutex);
+    auto breakpoint = breakpoints.find(address);
+    bool hit = breakpoint != breakpoints.end() || break_for_step;
     if (hit) {
         n64sys.debugger_state.broken = true;
-        if (breakpoints.find(address) != breakpoints.end() && breakpoints[address].temporary) {
-            breakpoints.erase(address);
+        if (breakpoint != breakpoints.end() && breakpoint->second.temporary) {
+            erase_breakpoint(address);
         }
         break_for_step = false;
     }
     return hit;
 }
 
+bool is_breakpoint(u64 address) {
+    std::lock_guard<std::mutex> lock(debugger_mutex);
+    return breakpoints.find(address) != breakpoints.end();
+}
+
+bool debugger_take_breakpoints_changed() {
+    return breakpoints_changed.exchange(false);
+}
+
+bool debugger_step_pending() {
+    return break_for_step;
+}
+
+void debugger_wait_while_broken() {
+    while (n64sys.debugger_state.broken) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        debugger_tick();
+    }
+}
+
 void debugger_step() {
     break_for_step = true;
     n64sys.debugger_state.broken = false;
 }
 
 void n64_debug_set_breakpoint(u64 address) {
+    std::lock_guard<std::mutex> lock(debugger_mutex);
+    if (breakpoints.find(address) == breakpoints.end()) {
+        n64_breakpoint_filter[BREAKPOINT_FILTER_INDEX(address)]++;
+        breakpoints_changed = true;
+    }
     breakpoints[address] = {address, false};
 }
 
 void n64_debug_clear_breakpoint(u64 address) {
-    breakpoints.erase(address);
+    std::lock_guard<std::mutex> lock(debugger_mutex);
+    erase_breakpoint(address);
+}
+
+// Call with debugger_mutex held
+static void update_watched_pages() {
+    if (watchpoints.empty()) {
+        n64_watched_pages = nullptr;
+        return;
+    }
+    if (watched_pages == nullptr) {
+        watched_pages = new u8[WATCH_PAGES];
+    }
+    memset(watched_pages, 0, WATCH_PAGES);
+    for (const auto& [physical, watchpoint] : watchpoints) {
+        u8 mask = (watchpoint.on_read ? WATCH_READ : 0) | (watchpoint.on_write ? WATCH_WRITE : 0);
+        for (u32 page = physical >> WATCH_PAGE_SHIFT; page <= (physical + watchpoint.length - 1) >> WATCH_PAGE_SHIFT && page < WATCH_PAGES; page++) {
+            watched_pages[page] |= mask;
+        }
+    }
+    n64_watched_pages = watched_pages;
+}
+
+bool n64_debug_set_watchpoint(u64 address, u32 length, bool on_read, bool on_write) {
+    u32 physical;
+    bool cached;
+    if (length == 0 || !resolve_virtual_address(address, BUS_LOAD, &cached, &physical)) {
+        return false;
+    }
+    physical &= 0x1FFFFFFF;
+    std::lock_guard<std::mutex> lock(debugger_mutex);
+    watchpoints[physical] = {address, physical, length, on_read, on_write};
+    update_watched_pages();
+    return true;
+}
+
+void n64_debug_clear_watchpoint(u64 address) {
+    std::lock_guard<std::mutex> lock(debugger_mutex);
+    for (auto it = watchpoints.begin(); it != watchpoints.end(); it++) {
+        if (it->second.address == address) {
+            watchpoints.erase(it);
+            break;
+        }
+    }
+    update_watched_pages();
+}
+
+// Breaks before the next instruction in the interpreter, and after the block doing the access in the JIT
+void debugger_watchpoint_access(u32 physical_address, int size, bool write) {
+    physical_address &= 0x1FFFFFFF;
+    std::lock_guard<std::mutex> lock(debugger_mutex);
+    for (auto it = watchpoints.begin(); it != watchpoints.end() && it->first < physical_address + size; it++) {
+        const Watchpoint& watchpoint = it->second;
+        if ((write ? watchpoint.on_write : watchpoint.on_read) && physical_address < watchpoint.physical + watchpoint.length) {
+            logalways("Watchpoint at %016" PRIX64 " hit: %d byte %s of %08X by PC %016" PRIX64,
+                      watchpoint.address, size, write ? "write" : "read", physical_address, N64CPU.pc);
+            n64sys.debugger_state.broken = true;
+            return;
+        }
+    }
 }
 
 void debugger_init() {
+    std::lock_guard<std::mutex> lock(debugger_mutex);
     breakpoints.clear();
+    watchpoints.clear();
+    memset(n64_breakpoint_filter, 0, sizeof(n64_breakpoint_filter));
+    update_watched_pages();
+    breakpoints_changed = true;
 }
 
 void debugger_tick() {
@@ -11,5 +11,41 @@ bool check_breakpoint(u64 address);
 void debugger_cleanup();
 void n64_debug_set_breakpoint(u64 address);
 void n64_debug_clear_breakpoint(u64 address);
+// Blocks until the debugger continues or steps
+void debugger_wait_while_broken();
+
+// Breakpoints per virtual page (hashed), so the JIT only looks breakpoints up in pages that have some
+#define BREAKPOINT_FILTER_BITS 12
+#define BREAKPOINT_FILTER_INDEX(vaddr) (((vaddr) >> 12) & ((1 << BREAKPOINT_FILTER_BITS) - 1))
+extern u32 n64_breakpoint_filter[1 << BREAKPOINT_FILTER_BITS];
+
+INLINE bool maybe_breakpoint(u64 address) {
+    return n64_breakpoint_filter[BREAKPOINT_FILTER_INDEX(address)] != 0;
+}
+
+bool is_breakpoint(u64 address);
+// True if breakpoints were set or cleared since the last call, and code compiled around the old ones has to go
+bool debugger_take_breakpoints_changed();
+// True if the debugger asked to run a single instruction
+bool debugger_step_pending();
+
+// Watched physical pages, so memory accesses only look watchpoints up in pages that have some. NULL while there are none.
+#define WATCH_READ 1
+#define WATCH_WRITE 2
+#define WATCH_PAGE_SHIFT 12
+#define WATCH_PAGES (0x20000000 >> WATCH_PAGE_SHIFT)
+extern u8* n64_watched_pages;
+
+void debugger_watchpoint_access(u32 physical_address, int size, bool write);
+
+INLINE void check_watchpoint(u32 physical_address, int size, bool write) {
+    if (unlikely(n64_watched_pages != NULL) && (n64_watched_pages[(physical_address & 0x1FFFFFFF) >> WATCH_PAGE_SHIFT] & (write ? WATCH_WRITE : WATCH_READ))) {
+        debugger_watchpoint_access(physical_address, size, write);
+    }
+}
+
+// Returns false if the address doesn't translate to a physical one
+bool n64_debug_set_watchpoint(u64 address, u32 length, bool on_read, bool on_write);
+void n64_debug_clear_watchpoint(u64 address);
 
 #endif //N64_DEBUGGER_H
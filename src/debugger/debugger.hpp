@@ -1,5 +1,7 @@
 #ifndef N64_DEBUGGER_HPP
 #define N64_DEBUGGER_HPP
+#include <map>
+#include <mutex>
 #include <unordered_map>
 extern "C" {
 #include <util.h>
@@ -14,6 +16,19 @@ struct Breakpoint {
     }
 };
 
+struct Watchpoint {
+    // As it was set
+    u64 address;
+    u32 physical;
+    u32 length;
+    bool on_read;
+    bool on_write;
+};
+
+// Breakpoints and watchpoints are set from the HTTP API's threads, hold this to look at them
+extern std::mutex debugger_mutex;
 extern std::unordered_map<u64, Breakpoint> breakpoints;
+// By physical address
+extern std::map<u32, Watchpoint> watchpoints;
 
-#endif
\ No newline at end of file
+#endif
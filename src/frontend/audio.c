@@ -1,48 +1,90 @@
 #include "audio.h"
+#include "audio_file.h"
 #include "render.h"
+#include <SDL.h>
 #include <SDL_audio.h>
+#include <stdatomic.h>
 #include <metrics.h>
 #include <samplerate.h>
-#include <fifo.h>
 #include <settings.h>
 #include <rdp/parallel_rdp_wrapper.h>
 
+#if defined(N64_HAVE_SSE)
+#include <emmintrin.h>
+#elif defined(N64_USE_NEON)
+#include <arm_neon.h>
+#endif
+
 static_assert(sizeof(float) == 4, "float must be 32 bits");
 #define S16_TO_F32(x) ((float)(x) / (float)32768)
 
 #define HOST_SAMPLE_RATE 48000
 #define HOST_SAMPLE_FORMAT AUDIO_F32SYS
 #define HOST_SAMPLE_SIZE sizeof(float)
-//#define HOST_BUFFER_SIZE ((HOST_SAMPLE_RATE) / 2)
-#define HOST_BUFFER_SIZE 32768
-
-#define GUEST_SAMPLE_SIZE sizeof(float)
-
-// Variable, controlled by the game
-unsigned guest_sample_rate = HOST_SAMPLE_RATE;
-
-// output_sample_rate / input_sample_rate
-double resample_ratio = 1;
-
 
 #define FRAMES_PER_REQUEST 1024
 #define AUDIO_CHANNELS 2
-#define GUEST_BUFFER_SIZE ((FRAMES_PER_REQUEST) * (AUDIO_CHANNELS))
+
+// The emulation thread only copies the guest's frames into a ring, as the words it reads from RDRAM (left channel in the upper
+// half). Conversion and resampling happen on the audio thread, as it pulls frames out.
+#define GUEST_RING_FRAMES 16384
+#define GUEST_RING_MASK (GUEST_RING_FRAMES - 1)
+static u32 guest_ring[GUEST_RING_FRAMES];
+static _Atomic u64 guest_frames_written = 0;
+static _Atomic u64 guest_frames_read = 0;
+
+// Dynamic rate control: the audio thread nudges the resampling ratio to keep this much audio buffered.
+// The emulation thread never waits for audio, the frame limiter paces it, so the two clocks drift apart slowly and the ratio
+// follows. The proportional term reacts to the fill level, and the integral term soaks up any steady difference between the
+// rate the game set and the rate the frames really arrive at.
+#define GUEST_BUFFER_TARGET_MS 80
+#define RATE_CONTROL_PROPORTIONAL 0.005
+#define RATE_CONTROL_INTEGRAL 0.0002
+#define RATE_CONTROL_MAX_INTEGRAL 0.05
+
+// Sample rate changes, tagged with the frame they take effect at so the audio thread applies them at the right point in the stream
+#define RATE_CHANGE_QUEUE_SIZE 16
+typedef struct rate_change {
+    u64 at_frame;
+    int rate;
+} rate_change_t;
+static rate_change_t rate_changes[RATE_CHANGE_QUEUE_SIZE];
+static _Atomic u32 rate_changes_written = 0;
+static _Atomic u32 rate_changes_read = 0;
+
+// Variable, controlled by the game. Written by the emulation thread
+unsigned guest_sample_rate = HOST_SAMPLE_RATE;
 
 SDL_AudioSpec audio_spec;
 SDL_AudioSpec request;
 SDL_AudioDeviceID audio_dev;
 
-float guest_sample_buffer[GUEST_BUFFER_SIZE];
+static bool audio_initialized = false;
+static n64_audio_sink_t audio_sink = AUDIO_SINK_UNKNOWN;
+static const char* audio_output_path = NULL;
 
-// Much larger than needed
-#define TEMP_RESAMPLED_BUFFER_SIZE HOST_SAMPLE_RATE
-#define TEMP_RESAMPLED_BUFFER_FRAMES (HOST_SAMPLE_RATE / AUDIO_CHANNELS)
-float temp_resampled_buffer[TEMP_RESAMPLED_BUFFER_SIZE];
-unsigned idx_guest_sample_buffer = 0;
-struct fifo* host_sample_buffer;
+// Everything the game sends to the AI, hashed on the emulation thread before it reaches the sink, so it doesn't depend on the
+// sink or on host timing. Rate changes are mixed in with a bit above the frame's 32 set, so they can't look like a frame.
+static bool audio_hash_enabled = false;
+static u64 audio_hash = 0;
+static u64 audio_hash_frames = 0;
 
+// Only touched by the audio thread
 SRC_STATE* resampler;
+// output_sample_rate / input_sample_rate, as set by the game and with rate control applied
+static double base_resample_ratio = 1;
+static double resample_ratio = 1;
+static double rate_control_integral = 0;
+static int current_guest_rate = HOST_SAMPLE_RATE;
+
+// Written by the audio thread for the metrics window
+static _Atomic int stats_buffered_frames = 0;
+static _Atomic int stats_target_frames = 0;
+static _Atomic s32 stats_drift_ppm = 0;
+#define GUEST_CHUNK_FRAMES 1024
+static float guest_chunk[GUEST_CHUNK_FRAMES * AUDIO_CHANNELS];
+static int guest_chunk_frames = 0;
+static int guest_chunk_position = 0;
 
 // Read by the audio thread, written by the UI thread
 float n64_get_volume() {
@@ -58,31 +100,157 @@ void n64_set_volume(float volume) {
     n64_settings.volume = volume;
 }
 
+// Each guest frame is a word with the left sample in the upper half and the right sample in the lower half
+static void convert_guest_frames(float* out, const u32* in, int frames) {
+    int i = 0;
+#if defined(N64_HAVE_SSE)
+    const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+    for (; i + 4 <= frames; i += 4, out += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i*)&in[i]);
+        __m128i left = _mm_srai_epi32(v, 16);
+        __m128i right = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+        _mm_storeu_ps(out, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi32(left, right)), scale));
+        _mm_storeu_ps(out + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi32(left, right)), scale));
+    }
+#elif defined(N64_USE_NEON)
+    for (; i + 4 <= frames; i += 4, out += 8) {
+        int32x4_t v = vreinterpretq_s32_u32(vld1q_u32(&in[i]));
+        int32x4x2_t interleaved = vzipq_s32(vshrq_n_s32(v, 16), vshrq_n_s32(vshlq_n_s32(v, 16), 16));
+        vst1q_f32(out, vmulq_n_f32(vcvtq_f32_s32(interleaved.val[0]), 1.0f / 32768.0f));
+        vst1q_f32(out + 4, vmulq_n_f32(vcvtq_f32_s32(interleaved.val[1]), 1.0f / 32768.0f));
+    }
+#endif
+    for (; i < frames; i++, out += 2) {
+        out[0] = S16_TO_F32((s16)(in[i] >> 16));
+        out[1] = S16_TO_F32((s16)in[i]);
+    }
+}
+
+static void apply_rate_change(int rate) {
+    current_guest_rate = rate;
+    base_resample_ratio = ((double)HOST_SAMPLE_RATE) / ((double)rate);
+}
+
+static void update_rate_control() {
+    int buffered = (int)(atomic_load(&guest_frames_written) - atomic_load(&guest_frames_read)) + (guest_chunk_frames - guest_chunk_position);
+    int target = MIN(GUEST_RING_FRAMES / 2, current_guest_rate * GUEST_BUFFER_TARGET_MS / 1000);
+
+    // Positive when running low: stretch what's left by producing more output per input frame
+    double error = (double)(target - buffered) / (double)target;
+    error = MAX(-1.0, MIN(1.0, error));
+
+    rate_control_integral += RATE_CONTROL_INTEGRAL * error;
+    rate_control_integral = MAX(-RATE_CONTROL_MAX_INTEGRAL, MIN(RATE_CONTROL_MAX_INTEGRAL, rate_control_integral));
+
+    double adjustment = RATE_CONTROL_PROPORTIONAL * error + rate_control_integral;
+    resample_ratio = base_resample_ratio * (1.0 + adjustment);
+
+    atomic_store(&stats_buffered_frames, buffered);
+    atomic_store(&stats_target_frames, target);
+    atomic_store(&stats_drift_ppm, (s32)(adjustment * 1e6));
+}
+
+void audio_get_rate_control_stats(int* buffered_frames, int* target_frames, int* drift_ppm) {
+    *buffered_frames = atomic_load(&stats_buffered_frames);
+    *target_frames = atomic_load(&stats_target_frames);
+    *drift_ppm = atomic_load(&stats_drift_ppm);
+}
+
+// Converts the next chunk of guest frames, stopping early at a pending rate change. Returns false if there aren't any.
+static bool refill_guest_chunk() {
+    u64 read = atomic_load_explicit(&guest_frames_read, memory_order_relaxed);
+    u64 available = atomic_load_explicit(&guest_frames_written, memory_order_acquire) - read;
+
+    u32 change_index = atomic_load_explicit(&rate_changes_read, memory_order_relaxed);
+    while (change_index != atomic_load_explicit(&rate_changes_written, memory_order_acquire)) {
+        const rate_change_t* change = &rate_changes[change_index % RATE_CHANGE_QUEUE_SIZE];
+        if (change->at_frame > read) {
+            available = MIN(available, change->at_frame - read);
+            break;
+        }
+        apply_rate_change(change->rate);
+        atomic_store_explicit(&rate_changes_read, ++change_index, memory_order_release);
+    }
+
+    int frames = (int)MIN(available, GUEST_CHUNK_FRAMES);
+    if (frames == 0) {
+        return false;
+    }
+
+    u32 start = read & GUEST_RING_MASK;
+    int first = MIN(frames, GUEST_RING_FRAMES - (int)start);
+    convert_guest_frames(guest_chunk, &guest_ring[start], first);
+    convert_guest_frames(&guest_chunk[first * AUDIO_CHANNELS], guest_ring, frames - first);
+    guest_chunk_frames = frames;
+    guest_chunk_position = 0;
+
+    atomic_store_explicit(&guest_frames_read, read + frames, memory_order_release);
+    return true;
+}
+
 void audio_callback(void* userdata, Uint8* stream, int length) {
-    int avail = fifo_read_available(host_sample_buffer);
-    set_metric(METRIC_AUDIOSTREAM_AVAILABLE, avail);
+    float* out = (float*)stream;
+    const long frames_requested = length / (HOST_SAMPLE_SIZE * AUDIO_CHANNELS);
+    long frames_out = 0;
+    u64 start = metric_timer_start();
+
+    set_metric(METRIC_AUDIOSTREAM_AVAILABLE, (atomic_load(&guest_frames_written) - atomic_load(&guest_frames_read)) * sizeof(u32));
+    update_rate_control();
 
-    int to_read = MIN(length, avail);
-    fifo_read(host_sample_buffer, stream, to_read);
+    while (frames_out < frames_requested) {
+        if (guest_chunk_position == guest_chunk_frames && !refill_guest_chunk()) {
+            break;
+        }
+
+        SRC_DATA resampler_data = { 0 };
+        resampler_data.data_in = &guest_chunk[guest_chunk_position * AUDIO_CHANNELS];
+        resampler_data.input_frames = guest_chunk_frames - guest_chunk_position;
+        resampler_data.data_out = &out[frames_out * AUDIO_CHANNELS];
+        resampler_data.output_frames = frames_requested - frames_out;
+        resampler_data.src_ratio = resample_ratio;
+        resampler_data.end_of_input = false;
+
+        int error = src_process(resampler, &resampler_data);
+        if (error != 0) {
+            logalways("Error resampling! %s", src_strerror(error));
+            break;
+        }
+        guest_chunk_position += resampler_data.input_frames_used;
+        frames_out += resampler_data.output_frames_gen;
+
+        if (resampler_data.input_frames_used == 0 && resampler_data.output_frames_gen == 0) {
+            break;
+        }
+    }
 
-    if (avail < length) {
-        memset(stream + avail, 0, length - avail);
+    // Underrun
+    if (frames_out < frames_requested) {
+        memset(&out[frames_out * AUDIO_CHANNELS], 0, (frames_requested - frames_out) * AUDIO_CHANNELS * HOST_SAMPLE_SIZE);
     }
 
     float volume = n64_settings.volume;
     if (volume != 1.0f) {
-        float* samples = (float*)stream;
-        int num_samples = to_read / HOST_SAMPLE_SIZE;
-        for (int i = 0; i < num_samples; i++) {
-            samples[i] *= volume;
+        long num_samples = frames_out * AUDIO_CHANNELS;
+        for (long i = 0; i < num_samples; i++) {
+            out[i] *= volume;
         }
     }
+    metric_timer_stop(HISTOGRAM_AUDIO_FLUSH, start);
 }
 
-void audio_init() {
-    memset(temp_resampled_buffer, 0, TEMP_RESAMPLED_BUFFER_SIZE * HOST_SAMPLE_SIZE);
-    host_sample_buffer = fifo_create(HOST_BUFFER_SIZE);
-    adjust_audio_sample_rate(HOST_SAMPLE_RATE);
+static bool audio_init_sdl() {
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+        logwarn("Failed to initialize SDL audio: %s", SDL_GetError());
+        return false;
+    }
+
+    int src_error = 0;
+    resampler = src_new(SRC_SINC_MEDIUM_QUALITY, AUDIO_CHANNELS, &src_error);
+    if (resampler == NULL) {
+        logfatal("Failed to initialize libsamplerate! Error: %d", src_error);
+    }
+    apply_rate_change(guest_sample_rate);
+
     memset(&request, 0, sizeof(request));
 
     request.freq = HOST_SAMPLE_RATE;
@@ -93,79 +261,192 @@ void audio_init() {
     request.userdata = NULL;
 
     audio_dev = SDL_OpenAudioDevice(NULL, 0, &request, &audio_spec, 0);
-    unimplemented(request.format != audio_spec.format, "Request format != got");
-    unimplemented(request.freq != audio_spec.freq, "Request freq %d != got freq %d", request.freq, audio_spec.freq);
-
     if (audio_dev == 0) {
-        logfatal("Failed to initialize SDL audio: %s", SDL_GetError());
+        logwarn("Failed to open an audio device: %s", SDL_GetError());
+        return false;
     }
+    unimplemented(request.format != audio_spec.format, "Request format != got");
+    unimplemented(request.freq != audio_spec.freq, "Request freq %d != got freq %d", request.freq, audio_spec.freq);
 
     SDL_PauseAudioDevice(audio_dev, false);
+    return true;
+}
 
-    int src_error = 0;
-    resampler = src_new(SRC_SINC_MEDIUM_QUALITY, AUDIO_CHANNELS, &src_error);
-    if (resampler == NULL) {
-        logfatal("Failed to initialize libsamplerate! Error: %d", src_error);
-    }
+void audio_select_sink(n64_audio_sink_t sink, const char* output_path) {
+    audio_sink = sink;
+    audio_output_path = output_path;
 }
 
-void flush_guest_buffer() {
-    if (idx_guest_sample_buffer == 0) {
-        return;
+void audio_enable_hash() {
+    audio_hash_enabled = true;
+}
+
+void audio_init() {
+    if (audio_sink == AUDIO_SINK_UNKNOWN) {
+        audio_sink = n64_settings.audio_sink;
+    }
+    if (audio_output_path == NULL) {
+        audio_output_path = n64_settings.audio_output_path;
     }
 
-    SRC_DATA resampler_data = { 0 };
-    resampler_data.data_in = guest_sample_buffer;
-    resampler_data.input_frames = idx_guest_sample_buffer / AUDIO_CHANNELS;
-    resampler_data.data_out = temp_resampled_buffer;
-    resampler_data.output_frames = TEMP_RESAMPLED_BUFFER_FRAMES;
-    resampler_data.src_ratio = resample_ratio;
-    resampler_data.end_of_input = false;
-
-    int error = src_process(resampler, &resampler_data);
-    if (error != 0) {
-        logalways("Error resampling! %s", src_strerror(error));
-    } else {
-        loginfo("Input frames: %ld Input frames used: %ld Output frames: %ld", resampler_data.input_frames, resampler_data.input_frames_used, resampler_data.output_frames_gen);
-
-        long buf_size = resampler_data.output_frames_gen * AUDIO_CHANNELS * HOST_SAMPLE_SIZE;
-        // Bytes remaining to be written to the FIFO
-        long bytes_remaining = buf_size;
-        long buf_idx = 0;
-        while (bytes_remaining > 0) {
-            long chunk_size = MIN(FRAMES_PER_REQUEST * AUDIO_CHANNELS * HOST_SAMPLE_SIZE, bytes_remaining);
-            int fifo_write_avail = fifo_write_remaining(host_sample_buffer);
-            bool full = fifo_write_avail < chunk_size;
-            bool sync_to_audio_enabled = !is_framerate_unlocked();
-            if (sync_to_audio_enabled && full) {
-                continue;
+    switch (audio_sink) {
+        case AUDIO_SINK_UNKNOWN:
+        case AUDIO_SINK_SDL:
+            audio_sink = AUDIO_SINK_SDL;
+            if (!audio_init_sdl()) {
+                // No device, which is normal on a headless machine. Keep running without sound.
+                logwarn("Continuing without audio");
+                audio_sink = AUDIO_SINK_NULL;
             }
-            if (!full) {
-                fifo_write(host_sample_buffer, ((u8*)temp_resampled_buffer) + buf_idx, chunk_size);
+            break;
+        case AUDIO_SINK_NULL:
+            break;
+        case AUDIO_SINK_WAV:
+        case AUDIO_SINK_RAW:
+            if (!audio_file_open(audio_output_path, audio_sink == AUDIO_SINK_WAV)) {
+                logfatal("Failed to open %s for writing audio", audio_output_path);
             }
-            buf_idx += chunk_size;
-            bytes_remaining -= chunk_size;
-        }
+            audio_file_set_sample_rate(guest_sample_rate);
+            break;
     }
 
-    idx_guest_sample_buffer = 0;
+    audio_initialized = true;
 }
 
-void adjust_audio_sample_rate(int sample_rate) {
-    // Flush first so all samples already pushed are resampled at the old rate
-    flush_guest_buffer();
+void audio_cleanup() {
+    if (!audio_initialized) {
+        return;
+    }
+    switch (audio_sink) {
+        case AUDIO_SINK_SDL:
+            SDL_CloseAudioDevice(audio_dev);
+            break;
+        case AUDIO_SINK_WAV:
+        case AUDIO_SINK_RAW:
+            audio_file_close();
+            break;
+        case AUDIO_SINK_UNKNOWN:
+        case AUDIO_SINK_NULL:
+            break;
+    }
+    if (audio_hash_enabled) {
+        logalways("Audio hash: %016" PRIx64 " (%" PRIu64 " frames)", audio_hash, audio_hash_frames);
+    }
+    audio_initialized = false;
+}
+
+u64 audio_get_hash() {
+    return audio_hash;
+}
 
+void adjust_audio_sample_rate(int sample_rate) {
     guest_sample_rate = sample_rate;
-    resample_ratio = ((double)HOST_SAMPLE_RATE) / ((double)guest_sample_rate);
-    logalways("Adjusting guest sample rate. Host rate: %d Guest rate: %d Ratio: %f", HOST_SAMPLE_RATE, guest_sample_rate, resample_ratio);
+    logalways("Adjusting guest sample rate. Host rate: %d Guest rate: %d Ratio: %f", HOST_SAMPLE_RATE, guest_sample_rate,
+              ((double)HOST_SAMPLE_RATE) / ((double)guest_sample_rate));
+    if (!audio_initialized) {
+        // audio_init picks up guest_sample_rate
+        return;
+    }
+    if (audio_hash_enabled) {
+        audio_hash = hash_mix(audio_hash, (1ULL << 32) | (u32)sample_rate);
+    }
+
+    switch (audio_sink) {
+        case AUDIO_SINK_SDL:
+            break;
+        case AUDIO_SINK_WAV:
+        case AUDIO_SINK_RAW:
+            audio_file_set_sample_rate(sample_rate);
+            return;
+        case AUDIO_SINK_UNKNOWN:
+        case AUDIO_SINK_NULL:
+            return;
+    }
+
+    u32 written = atomic_load_explicit(&rate_changes_written, memory_order_relaxed);
+    if (written - atomic_load_explicit(&rate_changes_read, memory_order_acquire) == RATE_CHANGE_QUEUE_SIZE) {
+        // Only happens when nothing is pulling audio out, so there's nobody to hear it
+        logwarn("Too many pending sample rate changes, dropping one");
+        return;
+    }
+    rate_change_t* change = &rate_changes[written % RATE_CHANGE_QUEUE_SIZE];
+    change->at_frame = atomic_load_explicit(&guest_frames_written, memory_order_relaxed);
+    change->rate = sample_rate;
+    atomic_store_explicit(&rate_changes_written, written + 1, memory_order_release);
+}
+
+// How many frames can be written now. Anything that doesn't fit is dropped, which only happens when nothing is pulling audio
+// out, or the framerate is unlocked and the game is producing it faster than it's played.
+// Buffering is capped at twice the rate control target, so latency stays bounded either way.
+static int guest_ring_reserve(int frames) {
+    u64 written = atomic_load_explicit(&guest_frames_written, memory_order_relaxed);
+    u64 limit = MIN(GUEST_RING_FRAMES, 2 * (guest_sample_rate * GUEST_BUFFER_TARGET_MS / 1000));
+    u64 buffered = written - atomic_load_explicit(&guest_frames_read, memory_order_acquire);
+    return buffered >= limit ? 0 : (int)MIN((u64)frames, limit - buffered);
+}
+
+static void guest_ring_publish(int frames) {
+    atomic_fetch_add_explicit(&guest_frames_written, frames, memory_order_release);
+}
+
+void audio_push_frames(const u32* frames, int count) {
+    if (!audio_initialized) {
+        return;
+    }
+    if (audio_hash_enabled) {
+        for (int i = 0; i < count; i++) {
+            audio_hash = hash_mix(audio_hash, frames[i]);
+        }
+        audio_hash_frames += count;
+    }
+
+    switch (audio_sink) {
+        case AUDIO_SINK_SDL: {
+            int reserved = guest_ring_reserve(count);
+            u32 start = atomic_load_explicit(&guest_frames_written, memory_order_relaxed) & GUEST_RING_MASK;
+            int first = MIN(reserved, GUEST_RING_FRAMES - (int)start);
+            memcpy(&guest_ring[start], frames, first * sizeof(u32));
+            memcpy(guest_ring, &frames[first], (reserved - first) * sizeof(u32));
+            guest_ring_publish(reserved);
+            break;
+        }
+        case AUDIO_SINK_WAV:
+        case AUDIO_SINK_RAW:
+            audio_file_write_frames(frames, count);
+            break;
+        case AUDIO_SINK_UNKNOWN:
+        case AUDIO_SINK_NULL:
+            break;
+    }
 }
 
-void audio_push_sample(s16 left, s16 right) {
-    if (idx_guest_sample_buffer + 2 > GUEST_BUFFER_SIZE) {
-        // resample and push to host buffer
-        flush_guest_buffer();
+void audio_push_silence(int count) {
+    if (!audio_initialized) {
+        return;
+    }
+    if (audio_hash_enabled) {
+        for (int i = 0; i < count; i++) {
+            audio_hash = hash_mix(audio_hash, 0);
+        }
+        audio_hash_frames += count;
     }
 
-    guest_sample_buffer[idx_guest_sample_buffer++] = S16_TO_F32(left);
-    guest_sample_buffer[idx_guest_sample_buffer++] = S16_TO_F32(right);
+    switch (audio_sink) {
+        case AUDIO_SINK_SDL: {
+            int reserved = guest_ring_reserve(count);
+            u32 start = atomic_load_explicit(&guest_frames_written, memory_order_relaxed) & GUEST_RING_MASK;
+            int first = MIN(reserved, GUEST_RING_FRAMES - (int)start);
+            memset(&guest_ring[start], 0, first * sizeof(u32));
+            memset(guest_ring, 0, (reserved - first) * sizeof(u32));
+            guest_ring_publish(reserved);
+            break;
+        }
+        case AUDIO_SINK_WAV:
+        case AUDIO_SINK_RAW:
+            audio_file_write_silence(count);
+            break;
+        case AUDIO_SINK_UNKNOWN:
+        case AUDIO_SINK_NULL:
+            break;
+    }
 }
@@ -6,9 +6,20 @@ extern "C" {
 #endif
 
 #include <system/n64system.h>
+#include <settings.h>
 void adjust_audio_sample_rate(int sample_rate);
-void audio_push_sample(s16 left, s16 right);
+// Frames are words as they are in RDRAM, with the left sample in the upper half
+void audio_push_frames(const u32* frames, int count);
+void audio_push_silence(int count);
+// Frames waiting to be played, the level rate control aims for, and how far it's currently adjusting the resampling ratio
+void audio_get_rate_control_stats(int* buffered_frames, int* target_frames, int* drift_ppm);
+// Overrides the sink from the settings file. Call before audio_init
+void audio_select_sink(n64_audio_sink_t sink, const char* output_path);
+// Hash every frame the game sends, whichever sink it goes to. Logged on cleanup
+void audio_enable_hash();
 void audio_init();
+void audio_cleanup();
+u64 audio_get_hash();
 
 // Volume, in the range [0.0, 1.0]
 float n64_get_volume();
@@ -0,0 +1,136 @@
+#include "audio_file.h"
+#include <log.h>
+#include <string.h>
+
+#define WAV_HEADER_SIZE 44
+#define FILE_CHANNELS 2
+#define FILE_BYTES_PER_FRAME (FILE_CHANNELS * sizeof(s16))
+#define FILE_CHUNK_FRAMES 1024
+
+static FILE* audio_file = NULL;
+static bool audio_file_is_wav = false;
+static u64 frames_written = 0;
+// The rate the game was using when the first frame was written. A WAV file can only have one, so it's what goes in the header.
+static int file_sample_rate = 0;
+static int current_sample_rate = 0;
+static bool warned_rate_change = false;
+
+INLINE void put_le16(u8* out, u16 value) {
+    out[0] = value & 0xFF;
+    out[1] = value >> 8;
+}
+
+INLINE void put_le32(u8* out, u32 value) {
+    put_le16(out, value & 0xFFFF);
+    put_le16(out + 2, value >> 16);
+}
+
+static void write_wav_header() {
+    u8 header[WAV_HEADER_SIZE];
+    // Both sizes are capped, a WAV file can't be larger than 4GB anyway
+    u64 data_size = MIN(frames_written * FILE_BYTES_PER_FRAME, 0xFFFFFFFFULL - (WAV_HEADER_SIZE - 8));
+    memcpy(&header[0], "RIFF", 4);
+    put_le32(&header[4], (u32)data_size + WAV_HEADER_SIZE - 8);
+    memcpy(&header[8], "WAVE", 4);
+
+    memcpy(&header[12], "fmt ", 4);
+    put_le32(&header[16], 16);
+    put_le16(&header[20], 1); // PCM
+    put_le16(&header[22], FILE_CHANNELS);
+    put_le32(&header[24], file_sample_rate);
+    put_le32(&header[28], file_sample_rate * FILE_BYTES_PER_FRAME);
+    put_le16(&header[32], FILE_BYTES_PER_FRAME);
+    put_le16(&header[34], 16);
+
+    memcpy(&header[36], "data", 4);
+    put_le32(&header[40], (u32)data_size);
+
+    fseek(audio_file, 0, SEEK_SET);
+    if (fwrite(header, 1, WAV_HEADER_SIZE, audio_file) != WAV_HEADER_SIZE) {
+        logwarn("Failed to write the WAV header");
+    }
+}
+
+bool audio_file_open(const char* path, bool wav) {
+    audio_file = fopen(path, "wb");
+    if (audio_file == NULL) {
+        return false;
+    }
+    audio_file_is_wav = wav;
+    frames_written = 0;
+    file_sample_rate = 0;
+    warned_rate_change = false;
+    if (wav) {
+        // Placeholder, rewritten with the real sizes on close
+        write_wav_header();
+    }
+    logalways("Writing %s audio to %s", wav ? "WAV" : "raw", path);
+    return true;
+}
+
+void audio_file_set_sample_rate(int sample_rate) {
+    current_sample_rate = sample_rate;
+    if (file_sample_rate == 0 || sample_rate == file_sample_rate) {
+        return;
+    }
+    if (audio_file_is_wav) {
+        if (!warned_rate_change) {
+            logwarn("The game changed its sample rate from %d to %d after audio started. The WAV header only has room for one, "
+                    "so the rest of the file will play at the wrong speed. The raw sink logs every change instead.",
+                    file_sample_rate, sample_rate);
+            warned_rate_change = true;
+        }
+    } else {
+        logalways("Raw audio: %d Hz from frame %" PRIu64, sample_rate, frames_written);
+    }
+}
+
+static void write_samples(const u8* samples, int frames) {
+    if (file_sample_rate == 0) {
+        file_sample_rate = current_sample_rate;
+        if (!audio_file_is_wav) {
+            logalways("Raw audio: %d Hz from frame 0", file_sample_rate);
+        }
+    }
+    if (fwrite(samples, FILE_BYTES_PER_FRAME, frames, audio_file) != (size_t)frames) {
+        logfatal("Failed to write audio to file");
+    }
+    frames_written += frames;
+}
+
+void audio_file_write_frames(const u32* frames, int count) {
+    u8 samples[FILE_CHUNK_FRAMES * FILE_BYTES_PER_FRAME];
+    while (count > 0) {
+        int chunk = MIN(count, FILE_CHUNK_FRAMES);
+        for (int i = 0; i < chunk; i++) {
+            put_le16(&samples[i * FILE_BYTES_PER_FRAME], frames[i] >> 16);
+            put_le16(&samples[i * FILE_BYTES_PER_FRAME + 2], frames[i] & 0xFFFF);
+        }
+        write_samples(samples, chunk);
+        frames += chunk;
+        count -= chunk;
+    }
+}
+
+void audio_file_write_silence(int count) {
+    static const u8 silence[FILE_CHUNK_FRAMES * FILE_BYTES_PER_FRAME] = { 0 };
+    while (count > 0) {
+        int chunk = MIN(count, FILE_CHUNK_FRAMES);
+        write_samples(silence, chunk);
+        count -= chunk;
+    }
+}
+
+void audio_file_close() {
+    if (audio_file == NULL) {
+        return;
+    }
+    if (audio_file_is_wav) {
+        if (file_sample_rate == 0) {
+            file_sample_rate = current_sample_rate;
+        }
+        write_wav_header();
+    }
+    fclose(audio_file);
+    audio_file = NULL;
+}
@@ -0,0 +1,27 @@
+#ifndef N64_AUDIO_FILE_H
+#define N64_AUDIO_FILE_H
+
+// Writes guest audio straight to a file as 16 bit little endian stereo PCM, at the game's own sample rate.
+// Nothing is resampled, so the output only depends on what the game produced, not on the host.
+
+#include <stdbool.h>
+#include <util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// With a WAV header if wav is set, otherwise just the samples
+bool audio_file_open(const char* path, bool wav);
+void audio_file_set_sample_rate(int sample_rate);
+// Frames are words as they are in RDRAM, with the left sample in the upper half
+void audio_file_write_frames(const u32* frames, int count);
+void audio_file_write_silence(int count);
+// Fills in the WAV header's sizes, then closes the file
+void audio_file_close();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //N64_AUDIO_FILE_H
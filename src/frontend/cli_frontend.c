@@ -8,11 +8,17 @@
 #include <mem/pif.h>
 #include <rdp/rdp.h>
 #include <rdp/parallel_rdp_wrapper.h>
+#include <rdp/fast_forward.h>
 #include <frontend/tas_movie.h>
+#include <frontend/replay.h>
 #include <signal.h>
 #include <imgui/imgui_ui.h>
 #include <settings.h>
+#include <trace.h>
 #include <frontend/render.h>
+#include <frontend/audio.h>
+#include <cpu/dynarec/dynarec.h>
+#include <cpu/dynarec/v2/v2_compiler.h>
 #include "frontend.h"
 
 void usage(cflags_t* flags) {
@@ -56,9 +62,7 @@ int main(int argc, char** argv) {
     bool debug = false;
 #ifdef N64_DEBUG_MODE
 #ifndef N64_WIN
-    char description[111];
-    snprintf(description, sizeof(description), "Enable debug mode. Starts halted and listens on port defined in dgb-n64.ini for connections. NOTE: implies -i!");
-    cflags_add_bool(flags, 'd', "debug", &debug, description);
+    cflags_add_bool(flags, 'd', "debug", &debug, "Enable debug mode. Starts halted and listens on port defined in dgb-n64.ini for connections.");
 #endif
 #endif
 
@@ -68,8 +72,23 @@ int main(int argc, char** argv) {
     bool record_tas_movie = false;
     cflags_add_bool(flags, 'r', "record", &record_tas_movie, "Record movie instead of playing. -m must also be specified when this option is used!");
 
+    const char* replay_path = NULL;
+    cflags_add_string(flags, '\0', "replay", &replay_path, "Play back a replay recorded with --record-replay. Quits with an error at the first desync");
+
+    const char* record_replay_path = NULL;
+    cflags_add_string(flags, '\0', "record-replay", &record_replay_path, "Record a replay: inputs, plus state hashes to check playback against");
+
+    int replay_rdram_hash_interval = REPLAY_DEFAULT_RDRAM_HASH_INTERVAL;
+    cflags_add_int(flags, '\0', "replay-rdram-hash-interval", &replay_rdram_hash_interval, "Frames between RDRAM hashes when recording a replay (default 60). The CPU is hashed every frame");
+
     bool exit_on_movie_end = false;
-    cflags_add_bool(flags, '\0', "exit-on-movie-end", &exit_on_movie_end, "Quit once the movie loaded with -m runs out of inputs");
+    cflags_add_bool(flags, '\0', "exit-on-movie-end", &exit_on_movie_end, "Quit once the movie loaded with -m, or the replay, runs out of inputs");
+
+    bool fast_forward = false;
+    cflags_add_bool(flags, '\0', "fast-forward", &fast_forward, "Run as fast as possible without showing frames, or drawing the ones nothing reads back. Stops when the movie or replay ends");
+
+    int fast_forward_frames = 0;
+    cflags_add_int(flags, '\0', "fast-forward-frames", &fast_forward_frames, "Fast forward for this many frames");
 
     bool unlock_framerate = false;
     cflags_add_bool(flags, '\0', "unlock-framerate", &unlock_framerate, "Start with the framerate unlocked, running as fast as possible");
@@ -77,6 +96,36 @@ int main(int argc, char** argv) {
     const char* pif_rom_path = NULL;
     cflags_add_string(flags, 'p', "pif", &pif_rom_path, "Load PIF ROM");
 
+    int jit_threshold = -1;
+    cflags_add_int(flags, '\0', "jit-threshold", &jit_threshold, "Number of times a block runs in the cached interpreter before it's compiled. 0 compiles every block immediately");
+
+    int softrdp_threads = 0;
+    cflags_add_int(flags, '\0', "softrdp-threads", &softrdp_threads, "Number of threads the software mode RDP rasterizes on. Defaults to the number of cores, up to 8");
+
+    bool rdp_thread = false;
+    cflags_add_bool(flags, '\0', "rdp-thread", &rdp_thread, "Process RDP commands on their own thread");
+
+    const char* audio_sink = NULL;
+    cflags_add_string(flags, '\0', "audio-sink", &audio_sink, "Where audio goes: sdl, null, wav or raw. Overrides dgb-n64.ini");
+
+    const char* audio_output_path = NULL;
+    cflags_add_string(flags, '\0', "audio-output", &audio_output_path, "File the wav and raw audio sinks write to");
+
+    bool audio_hash = false;
+    cflags_add_bool(flags, '\0', "audio-hash", &audio_hash, "Hash all audio the game produces and log it on exit");
+
+    const char* trace_path = NULL;
+    cflags_add_string(flags, '\0', "trace", &trace_path, "Write a binary event trace to this file. Read it with trace_decode");
+
+    const char* trace_events = NULL;
+    cflags_add_string(flags, '\0', "trace-events", &trace_events, "Comma separated events to trace, or 'all'. Defaults to block_compiled,idle_loop,rdp_command");
+
+    bool trace_lossless = false;
+    cflags_add_bool(flags, '\0', "trace-lossless", &trace_lossless, "Wait for the trace writer when it falls behind, instead of dropping events");
+
+    const char* capture_blocks_path = NULL;
+    cflags_add_string(flags, '\0', "capture-blocks", &capture_blocks_path, "Write every block the JIT compiles to this file. Benchmark compiling them with jit_compile_bench");
+
     #ifdef __linux__
     bool perf_map = false;
     cflags_add_bool(flags, '\0', "perf-map", &perf_map, "Write a perf map file to /tmp for profiling JIT code");
@@ -90,6 +139,10 @@ int main(int argc, char** argv) {
     }
     #endif
 
+    if (replay_path != NULL && record_replay_path != NULL) {
+        usage(flags);
+        logdie("Can't play back and record a replay at once.");
+    }
     if (record_tas_movie && tas_movie_path == NULL) {
         usage(flags);
         logdie("Must specify tas movie path (with -m) when recording a tas movie.");
@@ -100,16 +153,36 @@ int main(int argc, char** argv) {
     }
 
     log_set_verbosity(verbose->count);
+
+    if (audio_sink != NULL || audio_output_path != NULL) {
+        n64_audio_sink_t sink = n64_settings.audio_sink;
+        if (audio_sink != NULL) {
+            sink = str_to_audio_sink(audio_sink);
+            if (sink == AUDIO_SINK_UNKNOWN) {
+                usage(flags);
+                logdie("Unknown audio sink '%s'", audio_sink);
+            }
+        }
+        audio_select_sink(sink, audio_output_path != NULL ? audio_output_path : n64_settings.audio_output_path);
+    }
+    if (audio_hash) {
+        audio_enable_hash();
+    }
+    if (trace_path != NULL) {
+        u64 trace_mask = TRACE_DEFAULT_EVENTS;
+        if (trace_events != NULL && !trace_parse_event_list(trace_events, &trace_mask)) {
+            usage(flags);
+            logdie("Invalid --trace-events");
+        }
+        if (!trace_start(trace_path, trace_mask, trace_lossless)) {
+            logdie("Failed to open %s for tracing", trace_path);
+        }
+    }
 #ifdef N64_DEBUG_MODE
     // In debug builds, always log at least warnings.
     if (log_get_verbosity() < LOG_VERBOSITY_WARN) {
         log_set_verbosity(LOG_VERBOSITY_WARN);
     }
-    // if debug mode is enabled, force the interpreter
-    if (debug && !interpreter) {
-        logwarn("Debug mode enabled, forcing the use of the interpreter!");
-        interpreter = true;
-    }
 #endif
     if (software_mode) {
         const char* rom_path = NULL;
@@ -118,6 +191,9 @@ int main(int argc, char** argv) {
         }
         init_n64system(rom_path, true, debug, SOFTWARE_VIDEO_TYPE, interpreter);
         softrdp_init(&n64sys.softrdp_state, (u8 *) &n64sys.mem.rdram);
+        if (softrdp_threads > 0) {
+            softrdp_set_threads(&n64sys.softrdp_state, softrdp_threads);
+        }
     } else {
         const char* rom_path = NULL;
         if (flags->argc >= 1) {
@@ -128,9 +204,21 @@ int main(int argc, char** argv) {
         load_imgui_ui();
         register_imgui_event_handler(imgui_handle_event);
     }
+    if (rdp_thread) {
+        rdp_start_thread();
+    }
+    if (jit_threshold >= 0) {
+        dynarec_set_cached_interpreter_threshold(jit_threshold);
+    }
+    if (capture_blocks_path != NULL && !v2_start_block_capture(capture_blocks_path)) {
+        logdie("Failed to open %s for capturing blocks", capture_blocks_path);
+    }
     if (unlock_framerate) {
         set_framerate_unlocked(true);
     }
+    if (fast_forward || fast_forward_frames > 0) {
+        fast_forward_start(fast_forward_frames > 0 ? (u32)fast_forward_frames : 0);
+    }
     if (tas_movie_path != NULL) {
         if (record_tas_movie) {
             start_tas_recording(tas_movie_path);
@@ -139,6 +227,12 @@ int main(int argc, char** argv) {
             tas_movie_set_exit_on_end(exit_on_movie_end);
         }
     }
+    if (record_replay_path != NULL) {
+        replay_start_recording(record_replay_path, replay_rdram_hash_interval > 0 ? (u32)replay_rdram_hash_interval : 0);
+    } else if (replay_path != NULL) {
+        replay_start_playback(replay_path);
+        replay_set_exit_on_end(exit_on_movie_end);
+    }
     if (pif_rom_path) {
         load_pif_rom(pif_rom_path);
     } else if (file_exists(PIF_ROM_PATH)) {
@@ -167,4 +261,5 @@ int main(int argc, char** argv) {
     }
     n64_system_loop();
     n64_system_cleanup();
+    return replay_stop() ? 0 : 1;
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "device.h"
 #include "tas_movie.h"
+#include "replay.h"
 
 #include <stdbool.h>
 #include <math.h>
@@ -273,6 +274,9 @@ bool device_read_buttons_for_pif(int pif_channel, u8* res) {
                     tas_record_inputs(&joybus_devices[pif_channel].controller);
                 }
             }
+            if (replay_active()) {
+                replay_controller_poll(pif_channel, res);
+            }
             break;
         case JOYBUS_DANCEPAD:
             logfatal("read buttons from JOYBUS_DANCEPAD");
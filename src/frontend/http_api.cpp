@@ -2,12 +2,20 @@
 
 // TODO: support as much of this as possible: https://github.com/skylersaleh/SkyEmu/blob/dev/docs/HTTP_CONTROL_SERVER.md
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <format>
+#include <mutex>
+#include <vector>
 
 extern "C" {
     #include <common/settings.h>
     #include <mem/n64bus.h>
+    #include <mem/mem_util.h>
+    #include <interface/vi_capture.h>
+    #include <metrics.h>
 }
 #include <debugger/debugger.hpp>
 
@@ -64,6 +72,173 @@ u64 parse_address(std::string s_address) {
     return address;
 }
 
+// Largest range /memory will return in one request
+#define MEMORY_READ_MAX (16 * 1024 * 1024)
+// Smallest TLB page, so every address in one of these translates the same way
+#define MEMORY_READ_PAGE_SIZE 4096
+
+// Copies RDRAM out in the CPU's byte order. RDRAM is stored as host endian words.
+static void read_rdram(u8* dst, u32 physical, u32 length) {
+    const u8* rdram = n64sys.mem.rdram;
+    u32 i = 0;
+    for (; i < length && ((physical + i) & 3) != 0; i++) {
+        dst[i] = rdram[BYTE_ADDRESS(physical + i)];
+    }
+    for (; i + 4 <= length; i += 4) {
+        u32 word;
+        memcpy(&word, &rdram[physical + i], sizeof(word));
+        word = htobe32(word);
+        memcpy(&dst[i], &word, sizeof(word));
+    }
+    for (; i < length; i++) {
+        dst[i] = rdram[BYTE_ADDRESS(physical + i)];
+    }
+}
+
+// Frames for /framebuffer are captured on the emulator thread when a frame ends, and only while a request is waiting for one,
+// so they're never torn by the game drawing the next frame.
+static struct {
+    std::mutex mutex;
+    std::condition_variable new_frame;
+    std::atomic<int> waiting{0};
+    u64 sequence = 0;
+    bool blank = true;
+    vi_capture_t capture = {};
+} framebuffer;
+
+#define FRAMEBUFFER_WAIT std::chrono::milliseconds(100)
+
+void http_api_on_frame() {
+    if (framebuffer.waiting.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(framebuffer.mutex);
+    framebuffer.blank = !vi_capture_frame(&framebuffer.capture, false);
+    framebuffer.sequence++;
+    framebuffer.new_frame.notify_all();
+}
+
+struct captured_frame {
+    u64 sequence = 0;
+    int width = 0;
+    int height = 0;
+    std::vector<u8> rgba;
+};
+
+// Waits for the first frame after `after` ends. Returns false if none did in time, i.e. the emulator is paused.
+static bool wait_for_frame(u64 after, captured_frame& frame) {
+    framebuffer.waiting++;
+    std::unique_lock<std::mutex> lock(framebuffer.mutex);
+    bool arrived = framebuffer.new_frame.wait_for(lock, FRAMEBUFFER_WAIT, [after] { return framebuffer.sequence > after; });
+    framebuffer.waiting--;
+    if (arrived) {
+        frame.sequence = framebuffer.sequence;
+        frame.width = framebuffer.blank ? 0 : framebuffer.capture.width;
+        frame.height = framebuffer.blank ? 0 : framebuffer.capture.height;
+        frame.rgba.assign(framebuffer.capture.rgba, framebuffer.capture.rgba + frame.width * frame.height * 4);
+    }
+    return arrived;
+}
+
+static u64 current_frame_sequence() {
+    std::lock_guard<std::mutex> lock(framebuffer.mutex);
+    return framebuffer.sequence;
+}
+
+// Prometheus buckets are one per power of two, from about a microsecond to about a minute. JSON gets every bucket.
+#define PROMETHEUS_FIRST_BUCKET_BITS 10
+#define PROMETHEUS_LAST_BUCKET_BITS 36
+
+static std::string metrics_prometheus() {
+    std::string out;
+
+    u64 totals[NUM_METRICS];
+    metrics_get_totals(totals);
+    for (int i = 0; i < NUM_METRICS; i++) {
+        const metric_info_t& info = n64_metric_info[i];
+        bool counter = info.kind == METRIC_KIND_COUNTER;
+        std::string name = std::format("n64_{}{}", info.name, counter ? "_total" : "");
+        out += std::format("# HELP {} {}\n", name, info.description);
+        out += std::format("# TYPE {} {}\n", name, counter ? "counter" : "gauge");
+        out += std::format("{} {}\n", name, totals[i]);
+    }
+
+    metric_histogram_t histogram;
+    for (int i = 0; i < NUM_HISTOGRAMS; i++) {
+        const histogram_info_t& info = n64_histogram_info[i];
+        metrics_get_histogram((histogram_t)i, &histogram);
+        std::string name = std::format("n64_{}_seconds", info.name);
+        out += std::format("# HELP {} {}\n", name, info.description);
+        out += std::format("# TYPE {} histogram\n", name);
+
+        u64 cumulative = 0;
+        int bucket = 0;
+        for (int bits = PROMETHEUS_FIRST_BUCKET_BITS; bits <= PROMETHEUS_LAST_BUCKET_BITS; bits++) {
+            int end = histogram_bucket(1ull << bits);
+            for (; bucket < end; bucket++) {
+                cumulative += histogram.buckets[bucket];
+            }
+            out += std::format("{}_bucket{{le=\"{:g}\"}} {}\n", name, (double)(1ull << bits) / 1e9, cumulative);
+        }
+        out += std::format("{}_bucket{{le=\"+Inf\"}} {}\n", name, histogram.count);
+        out += std::format("{}_sum {:g}\n", name, (double)histogram.sum / 1e9);
+        out += std::format("{}_count {}\n", name, histogram.count);
+    }
+
+    return out;
+}
+
+static json metrics_json(int max_frames) {
+    json result;
+
+    u64 totals[NUM_METRICS];
+    metrics_get_totals(totals);
+    result["counters"] = json::object();
+    result["gauges"] = json::object();
+    for (int i = 0; i < NUM_METRICS; i++) {
+        const metric_info_t& info = n64_metric_info[i];
+        result[info.kind == METRIC_KIND_COUNTER ? "counters" : "gauges"][info.name] = totals[i];
+    }
+
+    result["histograms"] = json::object();
+    metric_histogram_t histogram;
+    for (int i = 0; i < NUM_HISTOGRAMS; i++) {
+        metrics_get_histogram((histogram_t)i, &histogram);
+        json h;
+        h["count"] = histogram.count;
+        h["sum_ns"] = histogram.sum;
+        h["max_ns"] = histogram.max;
+        h["mean_ns"] = histogram.count == 0 ? 0 : histogram.sum / histogram.count;
+        h["p50_ns"] = histogram_quantile(&histogram, 0.50);
+        h["p90_ns"] = histogram_quantile(&histogram, 0.90);
+        h["p99_ns"] = histogram_quantile(&histogram, 0.99);
+        h["p999_ns"] = histogram_quantile(&histogram, 0.999);
+        // [lowest value in the bucket, count], empty buckets left out
+        h["buckets"] = json::array();
+        for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+            if (histogram.buckets[bucket] != 0) {
+                h["buckets"].push_back({ histogram_bucket_lower_bound(bucket), histogram.buckets[bucket] });
+            }
+        }
+        result["histograms"][n64_histogram_info[i].name] = h;
+    }
+
+    std::vector<frame_metrics_t> frames(std::min(max_frames, METRICS_HISTORY_FRAMES));
+    int num_frames = metrics_get_history(frames.data(), (int)frames.size());
+    result["history"] = json::array();
+    for (int i = 0; i < num_frames; i++) {
+        json frame;
+        frame["frame"] = frames[i].frame;
+        frame["frame_time_ns"] = frames[i].frame_time_ns;
+        for (int metric = 0; metric < NUM_METRICS; metric++) {
+            frame[n64_metric_info[metric].name] = frames[i].values[metric];
+        }
+        result["history"].push_back(frame);
+    }
+
+    return result;
+}
+
 void http_api_init() {
     logalways("http_api_init listening on: %s:%d\n", n64_settings.http_api_host, n64_settings.http_api_port);
 
@@ -137,6 +312,7 @@ void http_api_init() {
 
     auto get_breakpoints = [&](const httplib::Request& req, httplib::Response& res) {
         json result = json::array({});
+        std::lock_guard<std::mutex> lock(debugger_mutex);
         for (const auto& [ address, breakpoint ] : breakpoints) {
             if (!breakpoint.temporary) {
                 json bp;
@@ -171,6 +347,55 @@ void http_api_init() {
         }
     });
 
+    auto get_watchpoints = [&](const httplib::Request& req, httplib::Response& res) {
+        json result = json::array({});
+        std::lock_guard<std::mutex> lock(debugger_mutex);
+        for (const auto& [ physical, watchpoint ] : watchpoints) {
+            json wp;
+            wp["address"] = std::format("{:016X}", watchpoint.address);
+            wp["physical"] = std::format("{:08X}", watchpoint.physical);
+            wp["length"] = watchpoint.length;
+            wp["read"] = watchpoint.on_read;
+            wp["write"] = watchpoint.on_write;
+            result.push_back(wp);
+        }
+        res.set_content(result.dump(), "application/json");
+    };
+
+    svr.Get("/watchpoints", get_watchpoints);
+
+    // set takes ?length= (default 4) and ?type= r, w or rw (default w)
+    svr.Get("/watchpoints/:operation/:address", [&](const httplib::Request& req, httplib::Response& res) {
+        std::string operation = req.path_params.at("operation");
+        u64 address = parse_address(req.path_params.at("address"));
+
+        if (operation == "set") {
+            u32 length = 4;
+            if (req.has_param("length")) {
+                try {
+                    length = std::stoul(req.get_param_value("length"), nullptr, 0);
+                } catch (std::exception&) {
+                    HTTP_ERROR("Invalid length", BadRequest_400);
+                }
+            }
+            std::string type = req.has_param("type") ? req.get_param_value("type") : "w";
+            if (type != "r" && type != "w" && type != "rw") {
+                HTTP_ERROR(std::string("Invalid type: ") + type, BadRequest_400);
+            }
+            if (!n64_debug_set_watchpoint(address, length, type.find('r') != std::string::npos, type.find('w') != std::string::npos)) {
+                HTTP_ERROR("Failed to resolve virtual address", BadRequest_400);
+            }
+            logalways("%s", std::format("Set watchpoint at {:016X}", address).c_str());
+            get_watchpoints(req, res);
+        } else if (operation == "clear") {
+            n64_debug_clear_watchpoint(address);
+            logalways("%s", std::format("Cleared watchpoint at {:016X}", address).c_str());
+            get_watchpoints(req, res);
+        } else {
+            HTTP_ERROR(std::string("Invalid operation: ") + operation, BadRequest_400);
+        }
+    });
+
     svr.Get("/control/break", [&](const httplib::Request& req, httplib::Response& res) {
         n64sys.debugger_state.broken = true;
         HTTP_OK;
@@ -198,6 +423,162 @@ void http_api_init() {
         HTTP_OK;
     });
 
+    svr.Get("/metrics", [&](const httplib::Request& req, httplib::Response& res) {
+        res.set_content(metrics_prometheus(), "text/plain; version=0.0.4");
+    });
+
+    svr.Get("/metrics/json", [&](const httplib::Request& req, httplib::Response& res) {
+        int frames = METRICS_HISTORY_FRAMES;
+        if (req.has_param("frames")) {
+            try {
+                frames = std::stoi(req.get_param_value("frames"));
+            } catch (std::exception&) {
+                HTTP_ERROR("Invalid frame count", BadRequest_400);
+            }
+            if (frames < 0) {
+                HTTP_ERROR("Invalid frame count", BadRequest_400);
+            }
+        }
+        res.set_content(metrics_json(frames).dump(), "application/json");
+    });
+
+    // Raw bytes in the CPU's byte order. ?address= is virtual unless ?physical=1, translated once per page.
+    svr.Get("/memory", [&](const httplib::Request& req, httplib::Response& res) {
+        if (!req.has_param("address") || !req.has_param("length")) {
+            HTTP_ERROR("address and length are required", BadRequest_400);
+        }
+        bool physical = req.has_param("physical") && req.get_param_value("physical") == "1";
+        u64 address;
+        u64 length;
+        try {
+            address = physical ? std::stoull(req.get_param_value("address"), nullptr, 16) : parse_address(req.get_param_value("address"));
+            length = std::stoull(req.get_param_value("length"), nullptr, 0); // autodetect base
+        } catch (std::exception&) {
+            HTTP_ERROR("Invalid address or length", BadRequest_400);
+        }
+        if (length > MEMORY_READ_MAX) {
+            HTTP_ERROR(std::format("Can't read more than {} bytes at once", MEMORY_READ_MAX), PayloadTooLarge_413);
+        }
+        if (physical && address + length > 0x100000000ull) {
+            HTTP_ERROR("Physical range past the end of the address space", BadRequest_400);
+        }
+
+        std::string result(length, '\0');
+        u64 offset = 0;
+        while (offset < length) {
+            u64 vaddr = address + offset;
+            u32 chunk = std::min(length - offset, MEMORY_READ_PAGE_SIZE - (vaddr & (MEMORY_READ_PAGE_SIZE - 1)));
+            u32 paddr;
+            bool cached;
+            if (physical) {
+                paddr = vaddr;
+            } else if (!resolve_virtual_address(vaddr, BUS_LOAD, &cached, &paddr)) {
+                HTTP_ERROR(std::format("Failed to resolve virtual address {:016X}", vaddr), BadRequest_400);
+            }
+
+            u8* dst = (u8*)&result[offset];
+            if ((u64)paddr + chunk <= N64_RDRAM_SIZE) {
+                read_rdram(dst, paddr, chunk);
+            } else {
+                for (u32 i = 0; i < chunk; i++) {
+                    if (!debugger_read_physical_byte(paddr + i, &dst[i])) {
+                        HTTP_ERROR(std::format("Failed to read physical address {:08X}", paddr + i), BadRequest_400);
+                    }
+                }
+            }
+            offset += chunk;
+        }
+        res.set_content(std::move(result), "application/octet-stream");
+    });
+
+    // Sent straight out of RDRAM without a copy, so it's in the host's byte order rather than the CPU's: each 32 bit word is
+    // host endian. Use /memory for the CPU's view. The emulator keeps running while this is sent.
+    svr.Get("/rdram", [&](const httplib::Request& req, httplib::Response& res) {
+        u64 offset = 0;
+        u64 length = N64_RDRAM_SIZE;
+        try {
+            if (req.has_param("offset")) {
+                offset = std::stoull(req.get_param_value("offset"), nullptr, 0);
+            }
+            if (req.has_param("length")) {
+                length = std::stoull(req.get_param_value("length"), nullptr, 0);
+            } else if (offset < N64_RDRAM_SIZE) {
+                length = N64_RDRAM_SIZE - offset;
+            }
+        } catch (std::exception&) {
+            HTTP_ERROR("Invalid offset or length", BadRequest_400);
+        }
+        if (offset > N64_RDRAM_SIZE || length > N64_RDRAM_SIZE - offset) {
+            HTTP_ERROR("Range past the end of RDRAM", RangeNotSatisfiable_416);
+        }
+#ifdef N64_BIG_ENDIAN
+        res.set_header("X-N64-Word-Order", "big");
+#else
+        res.set_header("X-N64-Word-Order", "little");
+#endif
+        res.set_content_provider(length, "application/octet-stream", [offset](size_t sent, size_t remaining, httplib::DataSink& sink) {
+            return sink.write((const char*)&n64sys.mem.rdram[offset + sent], remaining);
+        });
+    });
+
+    // RGBA, one byte per channel. One frame with its size in X-Width and X-Height, or with ?frames=N, the next N frames
+    // streamed back to back, each one a little endian u32 width and height followed by the pixels (0x0 if the VI is blanked).
+    svr.Get("/framebuffer", [&](const httplib::Request& req, httplib::Response& res) {
+        int frames = 0;
+        if (req.has_param("frames")) {
+            try {
+                frames = std::stoi(req.get_param_value("frames"));
+            } catch (std::exception&) {
+                HTTP_ERROR("Invalid frame count", BadRequest_400);
+            }
+            if (frames <= 0) {
+                HTTP_ERROR("Invalid frame count", BadRequest_400);
+            }
+        }
+
+        if (frames == 0) {
+            captured_frame frame;
+            if (!wait_for_frame(current_frame_sequence(), frame)) {
+                // Paused, so nothing will change under us
+                if (vi_capture_size(&frame.width, &frame.height)) {
+                    frame.rgba.resize(frame.width * frame.height * 4);
+                    vi_capture_convert(frame.rgba.data(), frame.width * 4, frame.width, frame.height, false);
+                }
+            }
+            if (frame.width == 0) {
+                HTTP_ERROR("VI is blanked", ServiceUnavailable_503);
+            }
+            res.set_header("X-Width", std::to_string(frame.width));
+            res.set_header("X-Height", std::to_string(frame.height));
+            res.set_content((const char*)frame.rgba.data(), frame.rgba.size(), "application/octet-stream");
+            return;
+        }
+
+        auto last_sequence = std::make_shared<u64>(current_frame_sequence());
+        auto remaining = std::make_shared<int>(frames);
+        res.set_chunked_content_provider("application/octet-stream", [last_sequence, remaining](size_t sent, httplib::DataSink& sink) {
+            captured_frame frame;
+            while (!wait_for_frame(*last_sequence, frame)) {
+                if (!sink.is_writable()) {
+                    return false;
+                }
+            }
+            *last_sequence = frame.sequence;
+            u8 header[8];
+            for (int i = 0; i < 4; i++) {
+                header[i] = (u8)(frame.width >> (i * 8));
+                header[4 + i] = (u8)(frame.height >> (i * 8));
+            }
+            if (!sink.write((const char*)header, sizeof(header)) || !sink.write((const char*)frame.rgba.data(), frame.rgba.size())) {
+                return false;
+            }
+            if (--*remaining == 0) {
+                sink.done();
+            }
+            return true;
+        });
+    });
+
     t = std::thread(http_server_thread);
 }
 
@@ -206,4 +587,6 @@ void http_api_stop() {
     if (t.joinable()) {
         t.join();
     }
+    std::lock_guard<std::mutex> lock(framebuffer.mutex);
+    vi_capture_free(&framebuffer.capture);
 }
\ No newline at end of file
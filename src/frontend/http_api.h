@@ -6,6 +6,8 @@ extern "C" {
 
 void http_api_init();
 void http_api_stop();
+// Called by the emulator thread at the end of every frame
+void http_api_on_frame();
 
 #ifdef __cplusplus
 }
@@ -14,7 +14,9 @@
 
 #include <volk.h>
 #include <rdp/parallel_rdp_wrapper.h>
+#include <rdp/fast_forward.h>
 #include <settings.h>
+#include <interface/vi_capture.h>
 
 // prior to 2.0.10, this was anonymous enum
 #if SDL_COMPILEDVERSION <  SDL_VERSIONNUM(2, 0, 10)
@@ -25,8 +27,6 @@ int SCREEN_SCALE = 2;
 static SDL_GLContext gl_context;
 SDL_Window* window = NULL;
 static SDL_Renderer* renderer = NULL;
-static SDL_Texture* texture = NULL;
-static u8 pixel_buffer[640 * 480 * 4]; // should be the largest needed
 static n64_video_type_t n64_video_type = UNKNOWN_VIDEO_TYPE;
 
 u32 fps_interval = 1000; // 1000ms = 1 second
@@ -82,7 +82,8 @@ void video_init_software() {
 }
 
 void render_init(n64_video_type_t video_type) {
-    uint32_t flags = SDL_INIT_AUDIO;
+    // Audio is initialized by the SDL sink, only if it's used
+    uint32_t flags = 0;
     if (video_type != QT_VULKAN_VIDEO_TYPE) {
         flags |= SDL_INIT_VIDEO;
     }
@@ -135,55 +136,49 @@ void render_init(n64_video_type_t video_type) {
     }
 }
 
-static u32 last_vi_type = 0;
-static u32 vi_height = 0;
-static u32 vi_width = 0;
-
-INLINE void pre_scanout(SDL_PixelFormatEnum pixel_format) {
-    float y_scale = (float)n64sys.vi.yscale.scale / 1024.0;
-    float x_scale = (float)n64sys.vi.xscale.scale / 1024.0;
-
-    int new_height = ceilf((float)((n64sys.vi.vstart.end - n64sys.vi.vstart.start) >> 1) * y_scale);
-    int new_width  = ceilf((float)((n64sys.vi.hstart.end - n64sys.vi.hstart.start) >> 0) * x_scale);
-
-    bool should_recreate_texture = false;
-
-    should_recreate_texture |= new_height != vi_height;
-    should_recreate_texture |= new_width != vi_width;
-
-    should_recreate_texture |= last_vi_type != n64sys.vi.status.type;
-
-    if (should_recreate_texture) {
-        last_vi_type = n64sys.vi.status.type;
-        vi_height = new_height;
-        vi_width = new_width;
-        if (texture != NULL) {
-            SDL_DestroyTexture(texture);
-        }
-        texture = SDL_CreateTexture(renderer, pixel_format, SDL_TEXTUREACCESS_STREAMING, vi_width, vi_height);
+// With double buffering, frames alternate between two streaming textures, so the one being written was last drawn two
+// frames ago and the driver doesn't have to wait for the GPU to finish reading it.
+typedef struct scanout_texture {
+    SDL_Texture* texture;
+    int width;
+    int height;
+} scanout_texture_t;
+
+static scanout_texture_t scanout_textures[2];
+static int scanout_index = 0;
+
+static void vi_scanout() {
+    int width, height;
+    if (!vi_capture_size(&width, &height)) {
+        SDL_RenderClear(renderer);
+        return;
     }
 
-}
+    if (n64_settings.double_buffer) {
+        scanout_index ^= 1;
+    } else {
+        scanout_index = 0;
+    }
+    scanout_texture_t* target = &scanout_textures[scanout_index];
 
-static void vi_scanout_16bit() {
-    pre_scanout(SDL_PIXELFORMAT_RGBA5551);
-    const int rdram_offset = n64sys.vi.vi_origin & (N64_RDRAM_SIZE - 1);
-    for (int y = 0; y < vi_height; y++) {
-        int yofs = (y * vi_width * 2);
-        for (int x = 0; x < vi_width; x += 2) {
-            memcpy(&pixel_buffer[yofs + x * 2 + 2], &n64sys.mem.rdram[rdram_offset + yofs + x * 2 + 0], sizeof(u16));
-            memcpy(&pixel_buffer[yofs + x * 2 + 0], &n64sys.mem.rdram[rdram_offset + yofs + x * 2 + 2], sizeof(u16));
+    if (target->width != width || target->height != height) {
+        target->width = width;
+        target->height = height;
+        if (target->texture != NULL) {
+            SDL_DestroyTexture(target->texture);
         }
+        target->texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, width, height);
     }
-    SDL_UpdateTexture(texture, NULL, &pixel_buffer, vi_width * 2);
-    SDL_RenderCopy(renderer, texture, NULL, NULL);
-}
 
-static void vi_scanout_32bit() {
-    pre_scanout(SDL_PIXELFORMAT_RGBA8888);
-    int rdram_offset = n64sys.vi.vi_origin & (N64_RDRAM_SIZE - 1);
-    SDL_UpdateTexture(texture, NULL, &n64sys.mem.rdram[rdram_offset], vi_width * 4);
-    SDL_RenderCopy(renderer, texture, NULL, NULL);
+    // Convert straight into the texture's staging memory rather than through a separate buffer
+    void* pixels;
+    int pitch;
+    if (SDL_LockTexture(target->texture, NULL, &pixels, &pitch) != 0) {
+        logfatal("Failed to lock scanout texture: %s", SDL_GetError());
+    }
+    vi_capture_convert(pixels, pitch, width, height, false);
+    SDL_UnlockTexture(target->texture);
+    SDL_RenderCopy(renderer, target->texture, NULL, NULL);
 }
 
 void render_screen_software() {
@@ -196,10 +191,8 @@ void render_screen_software() {
         case VI_TYPE_RESERVED:
             logfatal("VI_TYPE_RESERVED");
         case VI_TYPE_16BIT:
-            vi_scanout_16bit();
-            break;
         case VI_TYPE_32BIT:
-            vi_scanout_32bit();
+            vi_scanout();
             break;
         default:
             logfatal("Unknown VI type: %d", n64sys.vi.status.type);
@@ -239,6 +232,35 @@ void n64_render_screen() {
     }
 }
 
+// Deadlines are absolute, so the error from each sleep doesn't accumulate
+#define FRAME_LIMITER_MAX_FRAMES_BEHIND 3
+static u64 next_frame_deadline = 0;
+
+void frame_limiter_wait() {
+    if (is_framerate_unlocked() || fast_forward_active() || n64sys.target_fps == 0) {
+        next_frame_deadline = 0;
+        return;
+    }
+
+    const u64 frequency = SDL_GetPerformanceFrequency();
+    const u64 frame_ticks = frequency / n64sys.target_fps;
+    const u64 now = SDL_GetPerformanceCounter();
+
+    if (next_frame_deadline == 0 || now > next_frame_deadline + frame_ticks * FRAME_LIMITER_MAX_FRAMES_BEHIND) {
+        // First frame, or too far behind to catch up
+        next_frame_deadline = now + frame_ticks;
+        return;
+    }
+
+    if (now < next_frame_deadline) {
+        u32 ms = (next_frame_deadline - now) * 1000 / frequency;
+        if (ms > 0) {
+            SDL_Delay(ms);
+        }
+    }
+    next_frame_deadline += frame_ticks;
+}
+
 bool is_framerate_unlocked() {
     switch (n64_video_type) {
         case VULKAN_VIDEO_TYPE:
@@ -15,6 +15,8 @@ void render_init(n64_video_type_t video_type);
 void n64_render_screen();
 bool is_framerate_unlocked();
 void set_framerate_unlocked(bool unlocked);
+// Sleeps until it's time for the next frame, unless the framerate is unlocked or fast forward is on. Emulation is paced here, not by audio.
+void frame_limiter_wait();
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,366 @@
+#include "replay.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL.h>
+#include <log.h>
+#include <system/n64system.h>
+#include <system/scheduler.h>
+#include <mem/backup.h>
+#include <rdp/fast_forward.h>
+#include <rdp/rdp.h>
+
+#define REPLAY_MAGIC "N64RPLAY"
+#define REPLAY_VERSION 3
+#define MEMPAK_SIZE 0x8000
+
+typedef struct replay_header {
+    char magic[8];
+    u32 version;
+    // Frames between RDRAM hashes, the CPU is hashed every frame
+    u32 rdram_hash_interval;
+    u32 rom_crc1;
+    u32 rom_crc2;
+    char rom_name[20];
+    u8 interpreter;
+    // Whether fast forward was on from the start, and for how many frames (0 for all of them). Reads of images fast
+    // forward didn't draw get stale data, so the replay only plays back the same with fast forward set up the same way.
+    u8 fast_forward;
+    u8 reserved[2];
+    // The cartridge save follows the header, then the controller pak
+    u32 save_size;
+    u32 mempak_size;
+    u32 fast_forward_frames;
+} PACKED replay_header_t;
+
+_Static_assert(sizeof(replay_header_t) == 60, "Incorrect size for replay_header_t!");
+
+// The rest of the file is records, in the order they happened
+typedef enum replay_record_type {
+    REPLAY_RECORD_INPUT = 1,
+    REPLAY_RECORD_FRAME = 2
+} replay_record_type_t;
+
+typedef struct replay_input {
+    u8 type;
+    u8 channel;
+    u8 buttons[4];
+    u64 cycles;
+} PACKED replay_input_t;
+
+_Static_assert(sizeof(replay_input_t) == 14, "Incorrect size for replay_input_t!");
+
+typedef struct replay_frame {
+    u8 type;
+    u32 frame;
+    u64 cycles;
+    u64 cpu_hash;
+    // 0 in frames that don't hash RDRAM
+    u64 rdram_hash;
+} PACKED replay_frame_t;
+
+_Static_assert(sizeof(replay_frame_t) == 29, "Incorrect size for replay_frame_t!");
+
+static struct {
+    FILE* recording;
+    u8* playback;
+    size_t playback_size;
+    size_t playback_offset;
+
+    u32 rdram_hash_interval;
+    u32 frame;
+    u64 start_cycles;
+    u64 start_ticks;
+    bool exit_on_end;
+    bool desynced;
+} replay;
+
+static u64 hash_rdram() {
+    const u64* words = (const u64*)n64sys.mem.rdram;
+    u64 hash = 0;
+    for (size_t i = 0; i < N64_RDRAM_SIZE / sizeof(u64); i++) {
+        hash = hash_mix(hash, words[i]);
+    }
+    return hash;
+}
+
+INLINE u64 replay_cycles() {
+    return n64scheduler.scheduler_ticks - replay.start_cycles;
+}
+
+static void begin(u32 rdram_hash_interval) {
+    // The replay decides what the save starts as, and nothing it does may change the one on the disk
+    detach_backup(&n64sys.mem);
+    replay.rdram_hash_interval = rdram_hash_interval;
+    replay.frame = 0;
+    replay.start_cycles = n64scheduler.scheduler_ticks;
+    replay.start_ticks = SDL_GetPerformanceCounter();
+    replay.desynced = false;
+}
+
+void replay_start_recording(const char* path, u32 rdram_hash_interval) {
+    if (n64sys.mem.rom.rom == NULL) {
+        logdie("Must load a ROM at launch when recording a replay.");
+    }
+    if (rdram_hash_interval == 0) {
+        logdie("The RDRAM hash interval must be at least 1 frame");
+    }
+    replay.recording = fopen(path, "wb");
+    if (replay.recording == NULL) {
+        logfatal("Failed to open %s for recording a replay", path);
+    }
+
+    replay_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, REPLAY_MAGIC, sizeof(header.magic));
+    header.version = REPLAY_VERSION;
+    header.rdram_hash_interval = rdram_hash_interval;
+    header.rom_crc1 = n64sys.mem.rom.header.crc1;
+    header.rom_crc2 = n64sys.mem.rom.header.crc2;
+    memcpy(header.rom_name, n64sys.mem.rom.header.image_name, sizeof(header.rom_name));
+    header.interpreter = n64sys.use_interpreter;
+    header.fast_forward = fast_forward_active();
+    header.fast_forward_frames = fast_forward_frames_left();
+    header.save_size = n64sys.mem.save_size;
+    header.mempak_size = MEMPAK_SIZE;
+
+    // The game might not touch the controller pak until later, load it now to have it from the start
+    init_mempak(&n64sys.mem, n64sys.rom_path);
+    begin(rdram_hash_interval);
+    fwrite(&header, sizeof(header), 1, replay.recording);
+    if (header.save_size > 0) {
+        fwrite(n64sys.mem.save_data, header.save_size, 1, replay.recording);
+    }
+    fwrite(n64sys.mem.mempak_data, header.mempak_size, 1, replay.recording);
+    logalways("Recording a replay to %s", path);
+}
+
+void replay_start_playback(const char* path) {
+    if (n64sys.mem.rom.rom == NULL) {
+        logdie("Must load a ROM at launch when playing a replay.");
+    }
+    FILE* fp = fopen(path, "rb");
+    if (fp == NULL) {
+        logfatal("Error opening the replay %s", path);
+    }
+    fseek(fp, 0, SEEK_END);
+    size_t size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    u8* buf = malloc(size);
+    if (buf == NULL) {
+        logfatal("Failed to allocate %zu bytes for the replay", size);
+    }
+    checked_fread(buf, size, 1, fp);
+    fclose(fp);
+
+    replay_header_t header;
+    if (size < sizeof(header)) {
+        logdie("%s is too small to be a replay", path);
+    }
+    memcpy(&header, buf, sizeof(header));
+    if (memcmp(header.magic, REPLAY_MAGIC, sizeof(header.magic)) != 0) {
+        logdie("%s isn't a replay", path);
+    }
+    if (header.version != REPLAY_VERSION) {
+        logdie("%s is a version %u replay, only version %d is supported", path, header.version, REPLAY_VERSION);
+    }
+    if (header.rom_crc1 != n64sys.mem.rom.header.crc1 || header.rom_crc2 != n64sys.mem.rom.header.crc2) {
+        logdie("%s was recorded with a different ROM (%.20s, CRC %08X %08X)", path, header.rom_name, header.rom_crc1, header.rom_crc2);
+    }
+    if (header.save_size != n64sys.mem.save_size || size < sizeof(header) + header.save_size) {
+        logdie("%s has %u bytes of save data, the ROM needs %zu", path, header.save_size, n64sys.mem.save_size);
+    }
+    if (header.mempak_size != MEMPAK_SIZE || size < sizeof(header) + header.save_size + header.mempak_size) {
+        logdie("%s has a %u byte controller pak, it should be %d bytes", path, header.mempak_size, MEMPAK_SIZE);
+    }
+    if (header.rdram_hash_interval == 0) {
+        logdie("%s has an RDRAM hash interval of 0", path);
+    }
+    if (header.fast_forward != fast_forward_active() || header.fast_forward_frames != fast_forward_frames_left()) {
+        if (!header.fast_forward) {
+            logdie("%s was recorded without fast forward, it'd desync fast forwarding", path);
+        } else if (header.fast_forward_frames > 0) {
+            logdie("%s was recorded fast forwarding %u frames, play it back with --fast-forward-frames %u", path,
+                   header.fast_forward_frames, header.fast_forward_frames);
+        } else {
+            logdie("%s was recorded fast forwarding, play it back with --fast-forward", path);
+        }
+    }
+    if (header.interpreter != n64sys.use_interpreter) {
+        logwarn("%s was recorded with the %s, it'll desync on the %s", path,
+                header.interpreter ? "interpreter" : "JIT", n64sys.use_interpreter ? "interpreter" : "JIT");
+    }
+
+    init_mempak(&n64sys.mem, n64sys.rom_path);
+    begin(header.rdram_hash_interval);
+    if (header.save_size > 0) {
+        memcpy(n64sys.mem.save_data, buf + sizeof(header), header.save_size);
+    }
+    memcpy(n64sys.mem.mempak_data, buf + sizeof(header) + header.save_size, header.mempak_size);
+    replay.playback = buf;
+    replay.playback_size = size;
+    replay.playback_offset = sizeof(header) + header.save_size + header.mempak_size;
+    logalways("Playing back the replay %s", path);
+}
+
+void replay_set_exit_on_end(bool enabled) {
+    replay.exit_on_end = enabled;
+}
+
+bool replay_active() {
+    return replay.recording != NULL || replay.playback != NULL;
+}
+
+static void end_playback() {
+    free(replay.playback);
+    replay.playback = NULL;
+}
+
+static void playback_finished() {
+    double seconds = (double)(SDL_GetPerformanceCounter() - replay.start_ticks) / (double)SDL_GetPerformanceFrequency();
+    logalways("Replay finished: %u frames, %" PRIu64 " cycles in %.2f seconds (%.1f frames per second)",
+              replay.frame, replay_cycles(), seconds, seconds > 0 ? replay.frame / seconds : 0);
+    end_playback();
+    // Fast forwarding through a replay is for getting to where it ends
+    if (fast_forward_active()) {
+        fast_forward_stop();
+    }
+    if (replay.exit_on_end) {
+        n64_request_quit();
+    }
+}
+
+static void desync(const char* format, ...) {
+    char message[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    logalways("Replay desynced in frame %u: %s", replay.frame, message);
+    replay.desynced = true;
+    end_playback();
+    n64_request_quit();
+}
+
+// The type of the next record, 0 at the end of the replay. A record cut off at the end, from a recording that didn't get
+// to finish, is the end too.
+static u8 next_record_type() {
+    if (replay.playback_offset >= replay.playback_size) {
+        return 0;
+    }
+    u8 type = replay.playback[replay.playback_offset];
+    size_t size;
+    switch (type) {
+        case REPLAY_RECORD_INPUT:
+            size = sizeof(replay_input_t);
+            break;
+        case REPLAY_RECORD_FRAME:
+            size = sizeof(replay_frame_t);
+            break;
+        default:
+            logwarn("Unknown record type %d in the replay, stopping there", type);
+            return 0;
+    }
+    if (replay.playback_offset + size > replay.playback_size) {
+        logwarn("The replay ends in the middle of a record");
+        return 0;
+    }
+    return type;
+}
+
+void replay_controller_poll(int pif_channel, u8* buttons) {
+    if (replay.recording != NULL) {
+        replay_input_t input;
+        input.type = REPLAY_RECORD_INPUT;
+        input.channel = pif_channel;
+        memcpy(input.buttons, buttons, sizeof(input.buttons));
+        input.cycles = replay_cycles();
+        fwrite(&input, sizeof(input), 1, replay.recording);
+    } else if (replay.playback != NULL) {
+        u8 type = next_record_type();
+        if (type == 0) {
+            playback_finished();
+            return;
+        }
+        if (type != REPLAY_RECORD_INPUT) {
+            desync("the game read controller %d at cycle %" PRIu64 ", the recording got to the end of the frame first",
+                   pif_channel, replay_cycles());
+            return;
+        }
+        replay_input_t input;
+        memcpy(&input, &replay.playback[replay.playback_offset], sizeof(input));
+        replay.playback_offset += sizeof(input);
+        if (input.channel != pif_channel || input.cycles != replay_cycles()) {
+            desync("the game read controller %d at cycle %" PRIu64 ", the recording read controller %d at cycle %" PRIu64,
+                   pif_channel, replay_cycles(), input.channel, input.cycles);
+            return;
+        }
+        memcpy(buttons, input.buttons, sizeof(input.buttons));
+    }
+}
+
+void replay_end_frame() {
+    if (!replay_active()) {
+        return;
+    }
+    replay_frame_t frame;
+    frame.type = REPLAY_RECORD_FRAME;
+    frame.frame = replay.frame;
+    frame.cycles = replay_cycles();
+    frame.cpu_hash = r4300i_hash_state(&N64CPU);
+    // Fast forward leaves images undrawn, but playback is fast forwarded the same way, so RDRAM still matches
+    bool hash_rdram_now = replay.frame % replay.rdram_hash_interval == 0;
+    if (hash_rdram_now) {
+        // The RDP thread or the GPU can still be writing RDRAM, how far they've got isn't the same from one run to the next
+        rdp_sync_rdram();
+    }
+    frame.rdram_hash = hash_rdram_now ? hash_rdram() : 0;
+
+    if (replay.recording != NULL) {
+        fwrite(&frame, sizeof(frame), 1, replay.recording);
+        // A crash still leaves everything up to here
+        fflush(replay.recording);
+    } else {
+        u8 type = next_record_type();
+        if (type == 0) {
+            playback_finished();
+            return;
+        }
+        if (type != REPLAY_RECORD_FRAME) {
+            desync("the frame ended at cycle %" PRIu64 ", the recording read a controller first", frame.cycles);
+            return;
+        }
+        replay_frame_t recorded;
+        memcpy(&recorded, &replay.playback[replay.playback_offset], sizeof(recorded));
+        replay.playback_offset += sizeof(recorded);
+        if (recorded.frame != frame.frame) {
+            desync("the recording is at frame %u", recorded.frame);
+            return;
+        }
+        if (recorded.cycles != frame.cycles) {
+            desync("the frame ended at cycle %" PRIu64 ", in the recording at cycle %" PRIu64, frame.cycles, recorded.cycles);
+            return;
+        }
+        if (recorded.cpu_hash != frame.cpu_hash) {
+            desync("the CPU state hashes to %016" PRIX64 ", in the recording to %016" PRIX64, frame.cpu_hash, recorded.cpu_hash);
+            return;
+        }
+        if (hash_rdram_now && recorded.rdram_hash != frame.rdram_hash) {
+            desync("RDRAM hashes to %016" PRIX64 ", in the recording to %016" PRIX64, frame.rdram_hash, recorded.rdram_hash);
+            return;
+        }
+    }
+    replay.frame++;
+}
+
+bool replay_stop() {
+    if (replay.recording != NULL) {
+        fclose(replay.recording);
+        replay.recording = NULL;
+        logalways("Recorded %u frames", replay.frame);
+    }
+    end_playback();
+    return !replay.desynced;
+}
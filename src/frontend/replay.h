@@ -0,0 +1,30 @@
+#ifndef N64_REPLAY_H
+#define N64_REPLAY_H
+
+// Replays in our own format. Next to the inputs they record when the game read them, in emulated cycles, and a hash of the
+// CPU state at the end of every frame with one of RDRAM every so often. Playback checks all of that as it goes, and stops at
+// the first difference saying which frame it was in.
+//
+// A replay starts at power on from the cartridge save and controller pak it carries. Nothing the game saves while recording
+// or playing one back reaches the disk. Play a replay back with the same CPU mode (interpreter or JIT) it was recorded with,
+// the two don't take the same number of cycles. The same goes for fast forward: a replay recorded without it can't be played
+// back with it, or the other way around, the game reads back images that only one of them drew.
+
+#include <stdbool.h>
+#include <util.h>
+
+#define REPLAY_DEFAULT_RDRAM_HASH_INTERVAL 60
+
+// Both are called at power on: after the ROM is loaded, before the PIF ROM runs
+void replay_start_recording(const char* path, u32 rdram_hash_interval);
+void replay_start_playback(const char* path);
+void replay_set_exit_on_end(bool enabled);
+bool replay_active();
+// buttons is the 4 bytes the game is about to get for a controller. Recorded, or replaced with the recorded ones.
+void replay_controller_poll(int pif_channel, u8* buttons);
+// Call once per frame
+void replay_end_frame();
+// Finishes off a recording. False if playback desynced.
+bool replay_stop();
+
+#endif //N64_REPLAY_H
@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include <log.h>
 #include <system/n64system.h>
+#include <rdp/fast_forward.h>
 #include <stddef.h>
 #include "tas_movie.h"
 
@@ -168,6 +169,10 @@ bool tas_movie_loaded() {
 n64_controller_t tas_next_inputs() {
     if (loaded_tas_movie_index + sizeof(tas_movie_controller_data_t) > loaded_tas_movie_size) {
         loaded_tas_movie = NULL;
+        // Fast forwarding through a movie is for getting to where it ends
+        if (fast_forward_active()) {
+            fast_forward_stop();
+        }
         if (exit_on_movie_end) {
             logalways("TAS movie complete, exiting.");
             n64_request_quit();
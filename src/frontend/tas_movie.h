@@ -11,4 +11,7 @@ void tas_movie_set_exit_on_end(bool enabled);
 void start_tas_recording(const char* movie_path);
 bool tas_movie_recording();
 void tas_record_inputs(n64_controller_t* inputs);
+// Offset of the next inputs in the loaded movie. Tools that run two systems from one movie, e.g. dynarec_compare, keep
+// one for each.
+extern uint32_t loaded_tas_movie_index;
 #endif //N64_TAS_MOVIE_H
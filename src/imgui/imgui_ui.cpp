@@ -50,6 +50,16 @@ struct RingBuffer {
         return max_;
     }
 
+    T min() {
+        T min_ = 0;
+        for (int i = 0; i < METRICS_HISTORY_ITEMS; i++) {
+            if (data[i] < min_) {
+                min_ = data[i];
+            }
+        }
+        return min_;
+    }
+
     void add_point(T point) {
         data[offset++] = point;
         offset %= METRICS_HISTORY_ITEMS;
@@ -64,6 +74,7 @@ RingBuffer<ImU64> code_invalidations;
 RingBuffer<ImU64> jit_block_list_allocations;
 RingBuffer<ImU64> codecache_bytes_used;
 RingBuffer<ImU64> audiostream_bytes_available;
+RingBuffer<int> audio_drift;
 RingBuffer<ImU64> si_interrupts;
 RingBuffer<ImU64> pi_interrupts;
 RingBuffer<ImU64> ai_interrupts;
@@ -212,6 +223,7 @@ void render_metrics_window() {
     }
 
     ImGui::Text("Block compilations this frame: %" PRId64, get_metric(METRIC_BLOCK_COMPILATION));
+    ImGui::Text("Cached interpreter blocks this frame: %" PRId64 " (%" PRId64 " promoted to the JIT)", get_metric(METRIC_BLOCK_CACHED), get_metric(METRIC_BLOCK_PROMOTION));
     ImPlot::SetNextAxisLimits(ImAxis_Y1, 0, block_compilations.max(), ImGuiCond_Always);
     ImPlot::SetNextAxisLimits(ImAxis_X1, 0, METRICS_HISTORY_ITEMS, ImGuiCond_Always);
     if (ImPlot::BeginPlot("Block Compilations Per Frame")) {
@@ -234,6 +246,8 @@ void render_metrics_window() {
         ImPlot::EndPlot();
     }
 
+    ImGui::Text("Software RDP pipeline lookups this frame: %" PRId64 " hits, %" PRId64 " misses", get_metric(METRIC_SOFTRDP_PIPELINE_HIT), get_metric(METRIC_SOFTRDP_PIPELINE_MISS));
+
     ImPlot::SetNextAxisLimits(ImAxis_Y1, 0, n64dynarec.codecache_size, ImGuiCond_Always);
     ImPlot::SetNextAxisLimits(ImAxis_X1, 0, METRICS_HISTORY_ITEMS, ImGuiCond_Always);
     if (ImPlot::BeginPlot("Codecache bytes used")) {
@@ -242,6 +256,12 @@ void render_metrics_window() {
     }
 
     ImGui::Text("Audio stream bytes available: %" PRId64, get_metric(METRIC_AUDIOSTREAM_AVAILABLE));
+    int audio_buffered_frames, audio_target_frames, audio_drift_ppm;
+    audio_get_rate_control_stats(&audio_buffered_frames, &audio_target_frames, &audio_drift_ppm);
+    audio_drift.add_point(audio_drift_ppm);
+    ImGui::Text("Audio buffer: %d / %d frames (%.0f%%), resampling ratio drift: %+d ppm",
+                audio_buffered_frames, audio_target_frames,
+                audio_target_frames ? 100.0 * audio_buffered_frames / audio_target_frames : 0.0, audio_drift_ppm);
     ImPlot::SetNextAxisLimits(ImAxis_Y1, 0, audiostream_bytes_available.max(), ImGuiCond_Always);
     ImPlot::SetNextAxisLimits(ImAxis_X1, 0, METRICS_HISTORY_ITEMS, ImGuiCond_Always);
     if (ImPlot::BeginPlot("Audio Stream Bytes Available")) {
@@ -249,6 +269,13 @@ void render_metrics_window() {
         ImPlot::EndPlot();
     }
 
+    ImPlot::SetNextAxisLimits(ImAxis_Y1, audio_drift.min(), audio_drift.max(), ImGuiCond_Always);
+    ImPlot::SetNextAxisLimits(ImAxis_X1, 0, METRICS_HISTORY_ITEMS, ImGuiCond_Always);
+    if (ImPlot::BeginPlot("Audio Resampling Ratio Drift")) {
+        ImPlot::PlotLine("Drift (ppm)", audio_drift.data, METRICS_HISTORY_ITEMS, 1, 0, flags, audio_drift.offset);
+        ImPlot::EndPlot();
+    }
+
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
 
     int interruptsMax = MAX(MAX(MAX(MAX(si_interrupts.max(), pi_interrupts.max()), ai_interrupts.max()), dp_interrupts.max()), sp_interrupts.max());
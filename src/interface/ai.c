@@ -69,38 +69,48 @@ u32 read_word_aireg(u32 address) {
     }
 }
 
-INLINE void sample() {
-    if (n64sys.ai.dma_count == 0) {
-        audio_push_sample(0, 0);
-        return;
-    }
+// Consumes a number of DAC samples at once, a run of contiguous words at a time.
+// A run ends at the end of the current DMA, or where the low 13 bits of the address wrap. That's the only place the carry
+// can be set, so it's applied at the start of a run exactly where it would have been applied sample by sample.
+static void ai_consume_samples(int samples) {
+    while (samples > 0) {
+        if (n64sys.ai.dma_count == 0) {
+            audio_push_silence(samples);
+            return;
+        }
+
+        u32 address_hi = ((n64sys.ai.dma_address[0] >> 13) + n64sys.ai.dma_address_carry) & 0x7ff;
+        u32 address = (address_hi << 13) | n64sys.ai.dma_address[0] & 0x1fff;
+        u32 address_lo = address & 0x1fff;
 
-    u32 address_hi = ((n64sys.ai.dma_address[0] >> 13) + n64sys.ai.dma_address_carry) & 0x7ff;
-    n64sys.ai.dma_address[0] = (address_hi << 13) | n64sys.ai.dma_address[0] & 0x1fff;
-    u32 data = RDRAM_WORD(n64sys.ai.dma_address[0]);
+        int run = MIN(samples, n64sys.ai.dma_length[0] >> 2);
+        run = MIN(run, (0x2000 - address_lo) >> 2);
 
-    s16 left  = data >> 16;
-    s16 right = data >> 0;
-    audio_push_sample(left, right);
+        // RDRAM is made of whole 8KiB blocks, so a run never wraps around the end of it
+        audio_push_frames((const u32*)&n64sys.mem.rdram[WORD_ADDRESS(address) & (N64_RDRAM_SIZE - 1)], run);
 
-    u32 address_lo = (n64sys.ai.dma_address[0] + 4) & 0x1fff;
-    n64sys.ai.dma_address[0] = (n64sys.ai.dma_address[0] & ~0x1fff) | address_lo;
-    n64sys.ai.dma_address_carry = (address_lo == 0);
-    n64sys.ai.dma_length[0] -= 4;
+        address_lo = (address_lo + run * 4) & 0x1fff;
+        n64sys.ai.dma_address[0] = (address & ~0x1fff) | address_lo;
+        n64sys.ai.dma_address_carry = (address_lo == 0);
+        n64sys.ai.dma_length[0] -= run * 4;
+        samples -= run;
 
-    if(!n64sys.ai.dma_length[0]) {
-        interrupt_raise(INTERRUPT_AI);
-        if(--n64sys.ai.dma_count > 0) { // If we have another DMA pending, start on that one.
-            n64sys.ai.dma_address[0] = n64sys.ai.dma_address[1];
-            n64sys.ai.dma_length[0]  = n64sys.ai.dma_length[1];
+        if(!n64sys.ai.dma_length[0]) {
+            interrupt_raise(INTERRUPT_AI);
+            if(--n64sys.ai.dma_count > 0) { // If we have another DMA pending, start on that one.
+                n64sys.ai.dma_address[0] = n64sys.ai.dma_address[1];
+                n64sys.ai.dma_length[0]  = n64sys.ai.dma_length[1];
+            }
         }
     }
 }
 
 void ai_step(int cycles) {
     n64sys.ai.cycles += cycles;
-    while (n64sys.ai.cycles > n64sys.ai.dac.period) {
-        sample();
-        n64sys.ai.cycles -= n64sys.ai.dac.period;
+    if (n64sys.ai.cycles > n64sys.ai.dac.period) {
+        // Same number of samples as taking one at a time until at most a period is left over
+        int samples = (n64sys.ai.cycles - 1) / n64sys.ai.dac.period;
+        n64sys.ai.cycles -= samples * n64sys.ai.dac.period;
+        ai_consume_samples(samples);
     }
-}
\ No newline at end of file
+}
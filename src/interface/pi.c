@@ -6,6 +6,7 @@
 #include <mem/backup.h>
 #include <dynarec/dynarec.h>
 #include <timing.h>
+#include <rdp/fast_forward.h>
 #include "pi.h"
 
 u32 read_word_pireg(u32 address) {
@@ -135,6 +136,7 @@ void write_word_pireg(u32 address, u32 value) {
 
             logdebug("DMA requested at PC 0x%016" PRIX64 " from 0x%08X to 0x%08X (DRAM to CART), with a length of %d", N64CPU.pc, dram_addr, cart_addr, length);
 
+            check_fast_forward_read_range(dram_addr, length);
             // TODO: takes 9 cycles per byte to run in reality
             for (int i = 0; i < length; i++) {
                 u8 b = RDRAM_BYTE(dram_addr + i);
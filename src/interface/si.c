@@ -4,6 +4,7 @@
 #include <mem/mem_util.h>
 #include <system/scheduler.h>
 #include <timing.h>
+#include <dynarec/dynarec.h>
 #include "si.h"
 
 void pif_to_dram(u32 pif_address, u32 dram_address) {
@@ -15,6 +16,7 @@ void pif_to_dram(u32 pif_address, u32 dram_address) {
     for (int i = 0; i < 64; i++) {
         u8 value = n64sys.mem.pif_ram[i];
         RDRAM_BYTE(dram_address + i) = value;
+        mark_rdram_dirty(dram_address + i);
     }
 }
 
@@ -0,0 +1,204 @@
+#include "vi_capture.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <log.h>
+#include <system/n64system.h>
+#include <mem/mem_util.h>
+
+#if defined(N64_HAVE_SSE)
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#elif defined(N64_USE_NEON)
+#include <arm_neon.h>
+#endif
+
+// The SIMD paths work on whole host words of RDRAM, so they depend on the little endian word layout
+#if !defined(N64_BIG_ENDIAN) && (defined(N64_HAVE_SSE) || defined(N64_USE_NEON))
+#define VI_CAPTURE_SIMD
+#endif
+
+#define RDRAM_MASK (N64_RDRAM_SIZE - 1)
+
+INLINE u8 expand_5_to_8(u16 value) {
+    return (value << 3) | (value >> 2);
+}
+
+// Scalar versions handle the ends of rows, and rows that are unaligned or wrap around the end of RDRAM
+INLINE void convert_16bit_scalar(u8* out, u32 address, int pixels) {
+    for (int x = 0; x < pixels; x++, address += 2, out += 4) {
+        u16 pixel = n64sys.mem.rdram[BYTE_ADDRESS(address & RDRAM_MASK)] << 8 | n64sys.mem.rdram[BYTE_ADDRESS((address + 1) & RDRAM_MASK)];
+        out[0] = expand_5_to_8((pixel >> 11) & 0x1F);
+        out[1] = expand_5_to_8((pixel >> 6) & 0x1F);
+        out[2] = expand_5_to_8((pixel >> 1) & 0x1F);
+        out[3] = 0xFF;
+    }
+}
+
+INLINE void convert_32bit_scalar(u8* out, u32 address, int pixels) {
+    for (int x = 0; x < pixels; x++, address += 4, out += 4) {
+        out[0] = n64sys.mem.rdram[BYTE_ADDRESS((address + 0) & RDRAM_MASK)];
+        out[1] = n64sys.mem.rdram[BYTE_ADDRESS((address + 1) & RDRAM_MASK)];
+        out[2] = n64sys.mem.rdram[BYTE_ADDRESS((address + 2) & RDRAM_MASK)];
+        out[3] = 0xFF;
+    }
+}
+
+static void convert_16bit_row(u8* out, u32 address, int pixels) {
+    int x = 0;
+#ifdef VI_CAPTURE_SIMD
+    if ((address & 3) == 0 && address + pixels * 2 <= N64_RDRAM_SIZE) {
+        const u8* in = &n64sys.mem.rdram[address];
+#if defined(N64_HAVE_SSE)
+        const __m128i mask5 = _mm_set1_epi16(0x1F);
+        const __m128i alpha = _mm_set1_epi16((s16)0xFF00);
+        for (; x + 8 <= pixels; x += 8, in += 16, out += 32) {
+            __m128i v = _mm_loadu_si128((const __m128i*)in);
+            // Two pixels per host word, with the first one in the upper half
+            v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+            __m128i r = _mm_and_si128(_mm_srli_epi16(v, 11), mask5);
+            __m128i g = _mm_and_si128(_mm_srli_epi16(v, 6), mask5);
+            __m128i b = _mm_and_si128(_mm_srli_epi16(v, 1), mask5);
+            r = _mm_or_si128(_mm_slli_epi16(r, 3), _mm_srli_epi16(r, 2));
+            g = _mm_or_si128(_mm_slli_epi16(g, 3), _mm_srli_epi16(g, 2));
+            b = _mm_or_si128(_mm_slli_epi16(b, 3), _mm_srli_epi16(b, 2));
+            __m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+            __m128i ba = _mm_or_si128(b, alpha);
+            _mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi16(rg, ba));
+            _mm_storeu_si128((__m128i*)(out + 16), _mm_unpackhi_epi16(rg, ba));
+        }
+#elif defined(N64_USE_NEON)
+        const uint16x8_t mask5 = vdupq_n_u16(0x1F);
+        for (; x + 8 <= pixels; x += 8, in += 16, out += 32) {
+            // Two pixels per host word, with the first one in the upper half
+            uint16x8_t v = vrev32q_u16(vld1q_u16((const uint16_t*)in));
+            uint16x8_t r = vandq_u16(vshrq_n_u16(v, 11), mask5);
+            uint16x8_t g = vandq_u16(vshrq_n_u16(v, 6), mask5);
+            uint16x8_t b = vandq_u16(vshrq_n_u16(v, 1), mask5);
+            uint8x8x4_t rgba;
+            rgba.val[0] = vmovn_u16(vorrq_u16(vshlq_n_u16(r, 3), vshrq_n_u16(r, 2)));
+            rgba.val[1] = vmovn_u16(vorrq_u16(vshlq_n_u16(g, 3), vshrq_n_u16(g, 2)));
+            rgba.val[2] = vmovn_u16(vorrq_u16(vshlq_n_u16(b, 3), vshrq_n_u16(b, 2)));
+            rgba.val[3] = vdup_n_u8(0xFF);
+            vst4_u8(out, rgba);
+        }
+#endif
+    }
+#endif
+    convert_16bit_scalar(out, address + x * 2, pixels - x);
+}
+
+static void convert_32bit_row(u8* out, u32 address, int pixels) {
+    int x = 0;
+#ifdef VI_CAPTURE_SIMD
+    if ((address & 3) == 0 && address + pixels * 4 <= N64_RDRAM_SIZE) {
+        const u8* in = &n64sys.mem.rdram[address];
+#if defined(N64_HAVE_SSE)
+        const __m128i byteswap = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+        const __m128i alpha = _mm_set1_epi32((s32)0xFF000000);
+        for (; x + 4 <= pixels; x += 4, in += 16, out += 16) {
+            __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)in), byteswap);
+            _mm_storeu_si128((__m128i*)out, _mm_or_si128(v, alpha));
+        }
+#elif defined(N64_USE_NEON)
+        const uint32x4_t alpha = vdupq_n_u32(0xFF000000);
+        for (; x + 4 <= pixels; x += 4, in += 16, out += 16) {
+            uint32x4_t v = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in)));
+            vst1q_u8(out, vreinterpretq_u8_u32(vorrq_u32(v, alpha)));
+        }
+#endif
+    }
+#endif
+    convert_32bit_scalar(out, address + x * 4, pixels - x);
+}
+
+// Rows are always a whole number of pixels, so a multiple of 4 bytes
+static u64 hash_row(u64 hash, const u8* row, size_t bytes) {
+    size_t i = 0;
+    for (; i + 8 <= bytes; i += 8) {
+        u64 value;
+        memcpy(&value, &row[i], sizeof(u64));
+        hash = hash_mix(hash, value);
+    }
+    if (i < bytes) {
+        u32 value;
+        memcpy(&value, &row[i], sizeof(u32));
+        hash = hash_mix(hash, value);
+    }
+    return hash;
+}
+
+bool vi_capture_size(int* width, int* height) {
+    int type = n64sys.vi.status.type;
+    if (type != VI_TYPE_16BIT && type != VI_TYPE_32BIT) {
+        return false;
+    }
+
+    int display_width = (int)n64sys.vi.hstart.end - (int)n64sys.vi.hstart.start;
+    int display_height = ((int)n64sys.vi.vstart.end - (int)n64sys.vi.vstart.start) >> 1;
+    if (display_width <= 0 || display_height <= 0) {
+        return false;
+    }
+
+    // Scales are 2.10 fixed point, round up the same way the frontend always has
+    *width = (display_width * n64sys.vi.xscale.scale + 1023) >> 10;
+    *height = (display_height * n64sys.vi.yscale.scale + 1023) >> 10;
+    return *width > 0 && *height > 0;
+}
+
+u64 vi_capture_convert(u8* pixels, int pitch, int width, int height, bool compute_hash) {
+    const int type = n64sys.vi.status.type;
+    const int bytes_per_pixel = type == VI_TYPE_16BIT ? 2 : 4;
+    const u32 stride = (n64sys.vi.vi_width != 0 ? n64sys.vi.vi_width : width) * bytes_per_pixel;
+    const u32 origin = n64sys.vi.vi_origin & RDRAM_MASK;
+
+    u64 hash = hash_mix(hash_mix(0, width), height);
+    for (int y = 0; y < height; y++) {
+        u8* out = &pixels[(size_t)y * pitch];
+        u32 address = (origin + y * stride) & RDRAM_MASK;
+        if (type == VI_TYPE_16BIT) {
+            convert_16bit_row(out, address, width);
+        } else {
+            convert_32bit_row(out, address, width);
+        }
+        // Hash each row while it's still in cache
+        if (compute_hash) {
+            hash = hash_row(hash, out, (size_t)width * 4);
+        }
+    }
+    return compute_hash ? hash : 0;
+}
+
+bool vi_capture_frame(vi_capture_t* capture, bool compute_hash) {
+    int width, height;
+    if (!vi_capture_size(&width, &height)) {
+        capture->width = 0;
+        capture->height = 0;
+        return false;
+    }
+
+    size_t needed = (size_t)width * height * 4;
+    if (capture->capacity < needed) {
+        capture->rgba = realloc(capture->rgba, needed);
+        if (capture->rgba == NULL) {
+            logfatal("Failed to allocate %zu bytes for a VI capture", needed);
+        }
+        capture->capacity = needed;
+    }
+    capture->width = width;
+    capture->height = height;
+
+    u64 hash = vi_capture_convert(capture->rgba, width * 4, width, height, compute_hash);
+    if (compute_hash) {
+        capture->hash = hash;
+    }
+    return true;
+}
+
+void vi_capture_free(vi_capture_t* capture) {
+    free(capture->rgba);
+    capture->rgba = NULL;
+    capture->capacity = 0;
+    capture->width = 0;
+    capture->height = 0;
+}
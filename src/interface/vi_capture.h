@@ -0,0 +1,31 @@
+#ifndef N64_VI_CAPTURE_H
+#define N64_VI_CAPTURE_H
+
+// Converts what the VI is currently scanning out into an RGBA buffer (one byte per channel, in that order).
+// Reads straight from RDRAM and needs no window or GPU, so it works headless. The capture is at framebuffer resolution:
+// hstart/vstart and the x/y scale give the size, vi_width the stride. Alpha is always 0xFF, the VI doesn't output coverage.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <util.h>
+
+typedef struct vi_capture {
+    int width;
+    int height;
+    u8* rgba;
+    size_t capacity;
+    // Only updated by vi_capture_frame when hashing was requested
+    u64 hash;
+} vi_capture_t;
+
+// Returns false if the VI is blanked, leaving the capture empty
+bool vi_capture_frame(vi_capture_t* capture, bool compute_hash);
+void vi_capture_free(vi_capture_t* capture);
+
+// For callers that own the destination, e.g. a locked streaming texture.
+// vi_capture_size returns false if the VI is blanked. vi_capture_convert writes width * 4 bytes to each of the height rows,
+// pitch bytes apart, and returns the hash of the frame (0 if compute_hash is false).
+bool vi_capture_size(int* width, int* height);
+u64 vi_capture_convert(u8* pixels, int pitch, int width, int height, bool compute_hash);
+
+#endif //N64_VI_CAPTURE_H
@@ -6,6 +6,7 @@
 #![allow(unnecessary_transmutes)]
 
 use std::mem;
+use std::time::Instant;
 
 use dgbir::{
     compiler::{compile, compile_vec},
@@ -43,7 +44,8 @@ pub unsafe extern "C" fn rs_jit_compile_new_block(
     info!("{}", func);
 
     let alloc = dynarec_bumpalloc(code.len());
-    std::ptr::copy_nonoverlapping(code.as_ptr(), alloc as *mut u8, code.len());
+    let writable = dynarec_code_writable(alloc);
+    std::ptr::copy_nonoverlapping(code.as_ptr(), writable as *mut u8, code.len());
     flush_icache(unsafe { std::slice::from_raw_parts(alloc as *const u8, code.len()) });
 
     let f: unsafe extern "C" fn(*mut r4300i) -> i32 = mem::transmute(alloc);
@@ -74,6 +76,46 @@ pub unsafe extern "C" fn rs_jit_compile_and_run_block_for_test(
     return f(cpu as *const r4300i as *mut r4300i);
 }
 
+/// Filled in by rs_jit_compile_block_for_benchmark
+#[repr(C)]
+pub struct JitCompileStats {
+    /// Parsing the MIPS code and translating it to IR
+    pub frontend_ns: u64,
+    /// Optimizing the IR, register allocation and emitting host code
+    pub backend_ns: u64,
+    pub host_bytes: u64,
+    /// Lines in the IR's text form: one per instruction, plus one per block
+    pub ir_lines: u64,
+}
+
+/// Compiles a block the same way rs_jit_compile_new_block does and times it, but doesn't install the code.
+#[no_mangle]
+pub unsafe extern "C" fn rs_jit_compile_block_for_benchmark(
+    instructions: *mut u32,
+    num_instructions: usize,
+    virtual_address: u64,
+    physical_address: u32,
+    cpu: &r4300i_t,
+    stats: &mut JitCompileStats,
+) {
+    let safe_code = std::slice::from_raw_parts(instructions, num_instructions);
+    let start = Instant::now();
+    let parsed = mips_parser::parse(safe_code, virtual_address, physical_address);
+    let mut func = to_ir(parsed, cpu);
+    let frontend_done = Instant::now();
+    // Counted before compiling, which rewrites the IR
+    let ir_text = format!("{}", func);
+    let backend_start = Instant::now();
+    let baseaddr = dynarec_bumpalloc_get_next_allocation_ptr() as usize;
+    let compiled = compile_vec(&mut func, baseaddr);
+    let backend_done = Instant::now();
+
+    stats.frontend_ns = (frontend_done - start).as_nanos() as u64;
+    stats.backend_ns = (backend_done - backend_start).as_nanos() as u64;
+    stats.host_bytes = compiled.code.len() as u64;
+    stats.ir_lines = ir_text.lines().count() as u64;
+}
+
 #[no_mangle]
 pub unsafe extern "C" fn rs_jit_dump_ir(
     instructions: *mut u32,
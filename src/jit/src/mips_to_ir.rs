@@ -1,4 +1,4 @@
-use std::mem::offset_of;
+use std::mem::{offset_of, size_of};
 
 use derive_builder::Builder;
 use dgbir::external_fn;
@@ -10,24 +10,26 @@ use log::warn;
 
 use crate::{
     bus_access, bus_access_BUS_LOAD, bus_access_BUS_STORE, cp0_status_updated, do_tlbp, do_tlbr,
-    do_tlbwi, interpreter_fallback_until_no_branch,
+    do_tlbwi, fcr31_collect_host_flags, fcr31_updated, interpreter_fallback_until_no_branch,
     mips_parser::{
         BranchCondition, BranchInfo, MipsInstructionBitfield, MipsOpcode, ParsedMipsInstruction,
     },
     n64_read_physical_byte, n64_read_physical_dword, n64_read_physical_half,
     n64_read_physical_word, n64_write_physical_byte, n64_write_physical_dword,
     n64_write_physical_half, n64_write_physical_word, n64cpu_ptr, r4300i_handle_exception,
-    r4300i_t, reschedule_compare_interrupt, CP0_ENTRY_HI_WRITE_MASK, CP0_PAGEMASK_WRITE_MASK,
-    CP0_STATUS_WRITE_MASK, EXCEPTION_COPROCESSOR_UNUSABLE, FCR31_COMPARE_MASK, FCR31_COMPARE_SHIFT,
-    R4300I_CP0_REG_21, R4300I_CP0_REG_22, R4300I_CP0_REG_23, R4300I_CP0_REG_24, R4300I_CP0_REG_25,
-    R4300I_CP0_REG_31, R4300I_CP0_REG_7, R4300I_CP0_REG_BADVADDR, R4300I_CP0_REG_CACHEER,
-    R4300I_CP0_REG_CAUSE, R4300I_CP0_REG_COMPARE, R4300I_CP0_REG_CONFIG, R4300I_CP0_REG_CONTEXT,
-    R4300I_CP0_REG_COUNT, R4300I_CP0_REG_ENTRYHI, R4300I_CP0_REG_ENTRYLO0, R4300I_CP0_REG_ENTRYLO1,
-    R4300I_CP0_REG_EPC, R4300I_CP0_REG_ERR_EPC, R4300I_CP0_REG_INDEX, R4300I_CP0_REG_LLADDR,
-    R4300I_CP0_REG_PAGEMASK, R4300I_CP0_REG_PARITYER, R4300I_CP0_REG_PRID, R4300I_CP0_REG_RANDOM,
-    R4300I_CP0_REG_STATUS, R4300I_CP0_REG_TAGHI, R4300I_CP0_REG_TAGLO, R4300I_CP0_REG_WATCHHI,
-    R4300I_CP0_REG_WATCHLO, R4300I_CP0_REG_WIRED, R4300I_CP0_REG_XCONTEXT, STATUS_CU1_MASK,
-    STATUS_ERL_MASK, STATUS_EXL_MASK,
+    r4300i_t, reschedule_compare_interrupt, softtlb_asid_updated, softtlb_entry_t,
+    CP0_ENTRY_HI_WRITE_MASK, CP0_PAGEMASK_WRITE_MASK, CP0_STATUS_WRITE_MASK,
+    EXCEPTION_COPROCESSOR_UNUSABLE, EXCEPTION_FLOATING_POINT, FCR31_CAUSE_SHIFT,
+    FCR31_COMPARE_MASK, FCR31_COMPARE_SHIFT, FCR31_ENABLE_SHIFT, R4300I_CP0_REG_21,
+    R4300I_CP0_REG_22, R4300I_CP0_REG_23, R4300I_CP0_REG_24, R4300I_CP0_REG_25, R4300I_CP0_REG_31,
+    R4300I_CP0_REG_7, R4300I_CP0_REG_BADVADDR, R4300I_CP0_REG_CACHEER, R4300I_CP0_REG_CAUSE,
+    R4300I_CP0_REG_COMPARE, R4300I_CP0_REG_CONFIG, R4300I_CP0_REG_CONTEXT, R4300I_CP0_REG_COUNT,
+    R4300I_CP0_REG_ENTRYHI, R4300I_CP0_REG_ENTRYLO0, R4300I_CP0_REG_ENTRYLO1, R4300I_CP0_REG_EPC,
+    R4300I_CP0_REG_ERR_EPC, R4300I_CP0_REG_INDEX, R4300I_CP0_REG_LLADDR, R4300I_CP0_REG_PAGEMASK,
+    R4300I_CP0_REG_PARITYER, R4300I_CP0_REG_PRID, R4300I_CP0_REG_RANDOM, R4300I_CP0_REG_STATUS,
+    R4300I_CP0_REG_TAGHI, R4300I_CP0_REG_TAGLO, R4300I_CP0_REG_WATCHHI, R4300I_CP0_REG_WATCHLO,
+    R4300I_CP0_REG_WIRED, R4300I_CP0_REG_XCONTEXT, SOFTTLB_PAGE_SHIFT, SOFTTLB_SIZE,
+    STATUS_CU1_MASK, STATUS_ERL_MASK, STATUS_EXL_MASK,
 };
 
 #[derive(Builder)]
@@ -561,6 +563,7 @@ impl GuestRegisterManager {
                     offset_of!(r4300i_t, cp0.entry_hi.raw),
                     masked_value.val(),
                 );
+                block.call_function(external_fn!(softtlb_asid_updated()), &[]);
             }
             R4300I_CP0_REG_STATUS => {
                 let status_mask = const_u32(CP0_STATUS_WRITE_MASK);
@@ -842,6 +845,9 @@ impl GuestRegisterManager {
     }
 }
 
+/// Bit set in every valid software TLB tag. Mirrors SOFTTLB_TAG_VALID, which bindgen can't evaluate.
+const SOFTTLB_TAG_VALID: u64 = 1 << 63;
+
 fn get_paddr_for_loadstore(
     cpu: &r4300i_t,
     guest_regs: &mut GuestRegisterManager,
@@ -853,6 +859,59 @@ fn get_paddr_for_loadstore(
     let base = guest_regs.get_gpr(block, instr.rs());
     let virtual_address = block.add(DataType::U64, base, const_s16(instr.s_imm()));
 
+    // Fast path: look the page up in the software TLB directly
+    let entry_size = size_of::<softtlb_entry_t>();
+    assert!(entry_size.is_power_of_two());
+    let tag_offset = offset_of!(r4300i_t, cp0.softtlb)
+        + if bus_access == bus_access_BUS_STORE {
+            offset_of!(softtlb_entry_t, store_tag)
+        } else {
+            offset_of!(softtlb_entry_t, load_tag)
+        };
+    let paddr_offset = offset_of!(r4300i_t, cp0.softtlb) + offset_of!(softtlb_entry_t, paddr);
+
+    let page = block.right_shift(
+        DataType::U64,
+        virtual_address.val(),
+        const_u16(SOFTTLB_PAGE_SHIFT as u16),
+    );
+    let index = block.and(
+        DataType::U64,
+        page.val(),
+        const_u64((SOFTTLB_SIZE - 1) as u64),
+    );
+    let entry_offset = block.left_shift(
+        DataType::U64,
+        index.val(),
+        const_u16(entry_size.trailing_zeros() as u16),
+    );
+    let entry_ptr = block.add(DataType::Ptr, guest_regs.cpu_address, entry_offset.val());
+    let tag = block.or(DataType::U64, page.val(), const_u64(SOFTTLB_TAG_VALID));
+    let entry_tag = block.load_ptr(DataType::U64, entry_ptr.val(), tag_offset);
+    let hit = block.compare(
+        DataType::U64,
+        entry_tag.val(),
+        CompareType::Equal,
+        tag.val(),
+    );
+
+    let resolved_block = func.new_block(vec![DataType::U32]);
+
+    let mut hit_block = func.new_block(vec![]);
+    let page_paddr = hit_block.load_ptr(DataType::U32, entry_ptr.val(), paddr_offset);
+    let vaddr_u32 = hit_block.convert(DataType::U32, virtual_address.val());
+    let page_offset = hit_block.and(
+        DataType::U32,
+        vaddr_u32.val(),
+        const_u32((1 << SOFTTLB_PAGE_SHIFT) - 1),
+    );
+    let hit_paddr = hit_block.or(DataType::U32, page_paddr.val(), page_offset.val());
+    hit_block.jump(resolved_block.call(vec![hit_paddr.val()]));
+
+    // Slow path: unmapped regions, software TLB misses and TLB exceptions
+    let mut miss_block = func.new_block(vec![]);
+    block.branch(hit.val(), hit_block.call(vec![]), miss_block.call(vec![]));
+
     static mut physical: u32 = 0;
     static mut cached: bool = false;
 
@@ -865,7 +924,7 @@ fn get_paddr_for_loadstore(
         panic!("Failed to resolve virtual address 0x{:016X}", vaddr);
     }
 
-    let success = block.call_function(
+    let success = miss_block.call_function(
         resolve_virtual,
         &[
             virtual_address.val(),
@@ -879,15 +938,18 @@ fn get_paddr_for_loadstore(
     on_fail_block.call_function(external_fn!(on_fail(_)), &[virtual_address.val()]);
     on_fail_block.ret(None);
 
-    let on_success_block = func.new_block(vec![]);
-    block.branch(
+    let mut on_success_block = func.new_block(vec![]);
+    miss_block.branch(
         success.val(),
         on_success_block.call(vec![]),
         on_fail_block.call(vec![]),
     );
-    *block = on_success_block;
+    let miss_paddr = on_success_block.load_ptr(DataType::U32, physical_ptr, 0);
+    on_success_block.jump(resolved_block.call(vec![miss_paddr.val()]));
+
+    *block = resolved_block;
 
-    return block.load_ptr(DataType::U32, physical_ptr, 0).val();
+    return block.input(0);
 }
 
 fn set_pc(
@@ -958,6 +1020,49 @@ fn checkcp1(
     *block = cp1_enabled_block;
 }
 
+// Compiled FPU ops never raise the exception, blocks don't run while any are enabled (see n64_dynarec_step). Writing
+// FCR31 still can, if it sets a cause bit that's also enabled. Unimplemented operation is always enabled.
+fn check_fpu_exception(
+    func: &IRFunction,
+    block: &mut IRBlockHandle,
+    vaddr: u64,
+    cycles: i32,
+    guest_regs: &mut GuestRegisterManager,
+    fcr31: InputSlot,
+) {
+    let cause = block.right_shift(DataType::U32, fcr31, const_u32(FCR31_CAUSE_SHIFT));
+    let enable = block.right_shift(DataType::U32, fcr31, const_u32(FCR31_ENABLE_SHIFT));
+    let enable = block.or(DataType::U32, enable.val(), const_u32(1 << 5));
+    let pending = block.and(DataType::U32, cause.val(), enable.val());
+    let pending = block.and(DataType::U32, pending.val(), const_u32(0x3F));
+    let is_pending = block.compare(
+        DataType::U32,
+        pending.val(),
+        CompareType::NotEqual,
+        const_u32(0),
+    );
+
+    let mut exception_block = func.new_block(vec![]);
+    guest_regs.flush_all(&mut exception_block, false);
+    exception_block.call_function(
+        external_fn!(r4300i_handle_exception(_, _, _)),
+        &[
+            const_u64(vaddr),
+            const_u32(EXCEPTION_FLOATING_POINT),
+            const_u32(0),
+        ],
+    );
+    exception_block.ret(Some(const_s32(cycles + 1)));
+
+    let no_exception_block = func.new_block(vec![]);
+    block.branch(
+        is_pending.val(),
+        exception_block.call(vec![]),
+        no_exception_block.call(vec![]),
+    );
+    *block = no_exception_block;
+}
+
 fn do_branch(
     link: bool,
     likely: bool,
@@ -1732,7 +1837,15 @@ pub fn to_ir_ctx(
                             .load_ptr(DataType::S32, cpu_address, offset_of!(r4300i_t, fcr0.raw))
                             .val()
                     }
-                    31 => guest_regs.get_fcr31(&mut block),
+                    31 => {
+                        // FPU ops in compiled code leave their exceptions in the host flags, only collect them when FCR31 is read.
+                        // The flags were cleared when the block was entered, so everything pending is from this block.
+                        let fcr31 = guest_regs.get_fcr31(&mut block);
+                        let collected = block
+                            .call_function(external_fn!(fcr31_collect_host_flags(_)), &[fcr31]);
+                        guest_regs.set_fcr31(collected.val());
+                        collected.val()
+                    }
                     _ => {
                         todo!("This instruction is only defined when fs == 0 or fs == 31! (Throw an exception?)");
                     }
@@ -1802,7 +1915,16 @@ pub fn to_ir_ctx(
                         let mask = const_u32(0x183ffff);
                         let masked = block.and(DataType::U32, value, mask);
                         guest_regs.set_fcr31(masked.val());
-                        warn!("TODO: check_fpu_exception();");
+                        // Switch the host rounding mode to match for the rest of the block
+                        block.call_function(external_fn!(fcr31_updated(_)), &[masked.val()]);
+                        check_fpu_exception(
+                            &func,
+                            &mut block,
+                            vaddr,
+                            cycles,
+                            &mut guest_regs,
+                            masked.val(),
+                        );
                     }
                     _ => {
                         todo!("This instruction is only defined when fs == 0 or fs == 31! (Throw an exception?)");
@@ -103,7 +103,8 @@ pub extern "C" fn rs_jit_compile_new_rsp_block(
 
     unsafe {
         let alloc = rsp_dynarec_bumpalloc(code.len());
-        std::ptr::copy_nonoverlapping(code.as_ptr(), alloc as *mut u8, code.len());
+        let writable = rsp_dynarec_code_writable(alloc);
+        std::ptr::copy_nonoverlapping(code.as_ptr(), writable as *mut u8, code.len());
         flush_icache(std::slice::from_raw_parts(alloc as *const u8, code.len()));
         let f: unsafe extern "C" fn(*mut rsp) -> i32 = mem::transmute(alloc);
 
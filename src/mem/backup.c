@@ -1,9 +1,19 @@
 #include "backup.h"
+#include "backup_writer.h"
 #include <limits.h>
+#ifndef N64_WIN
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #define SAVE_DATA_DEBOUNCE_FRAMES 60
 #define MEMPAK_SIZE 32768
 
+// Nothing is persisted once this is set, see detach_backup
+static bool backup_detached = false;
+
 u32 sram_read_word() {
     return 0xFFFFFFFF;
 }
@@ -279,6 +289,56 @@ void create_empty_file(size_t save_size, const char* save_path, u8 initial_value
     }
 }
 
+static size_t get_file_size(FILE* f) {
+    fseek(f, 0, SEEK_END);
+    size_t size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    return size;
+}
+
+#ifndef N64_WIN
+// Puts the last snapshot the writer made back in place of a save file that's the wrong size
+static bool restore_snapshot(const char* path, size_t save_size) {
+    char snapshot_path[PATH_MAX + 4];
+    snprintf(snapshot_path, sizeof(snapshot_path), "%s.bak", path);
+    FILE* f = fopen(snapshot_path, "rb");
+    if (f == NULL) {
+        return false;
+    }
+    if (get_file_size(f) != save_size) {
+        fclose(f);
+        return false;
+    }
+    u8* data = malloc(save_size);
+    checked_fread(data, save_size, 1, f);
+    fclose(f);
+
+    f = fopen(path, "wb");
+    fwrite(data, 1, save_size, f);
+    fclose(f);
+    free(data);
+    logwarn("%s was the wrong size, restored it from %s", path, snapshot_path);
+    return true;
+}
+
+// The game writes straight into the file's pages, the backup writer gets them onto the disk.
+// A shadow system never persists anything, it gets a private copy so it can't write into the real system's save. Neither
+// do detached backups.
+static u8* map_backup_file(const char* path, size_t save_size) {
+    int fd = open(path, O_RDWR);
+    if (fd < 0) {
+        logfatal("Failed to open %s: %s", path, strerror(errno));
+    }
+    bool private_copy = n64sys.shadow || backup_detached;
+    u8* data = mmap(NULL, save_size, PROT_READ | PROT_WRITE, private_copy ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        logfatal("Failed to map %s: %s", path, strerror(errno));
+    }
+    return data;
+}
+#endif
+
 u8* load_backup_file(const char *rom_path, const char *suffix, size_t save_size, char *path, u8 initial_value) {
     size_t save_path_len = strlen(rom_path) + strlen(suffix);
     u8* save_data;
@@ -295,16 +355,23 @@ u8* load_backup_file(const char *rom_path, const char *suffix, size_t save_size,
             f = fopen(path, "rb");
         }
 
-        fseek(f, 0, SEEK_END);
-        size_t actual_size = ftell(f);
-        fseek(f, 0, SEEK_SET);
+        size_t actual_size = get_file_size(f);
 
+#ifndef N64_WIN
+        fclose(f);
+        if (actual_size != save_size && !restore_snapshot(path, save_size)) {
+            logfatal("Corrupted save file: wrong size!");
+        }
+        save_data = map_backup_file(path, save_size);
+#else
         if (actual_size != save_size) {
             logfatal("Corrupted save file: wrong size!");
         }
 
         save_data = malloc(actual_size);
         checked_fread(save_data, actual_size, 1, f);
+        fclose(f);
+#endif
     }
 
     return save_data;
@@ -329,15 +396,20 @@ void init_mempak(n64_mem_t* mem, const char* rom_path) {
 }
 
 void persist(bool* dirty, int* debounce_counter, size_t size, const char* file_path, u8* data, const char* name) {
-    if (*dirty) {
+    if (backup_detached) {
+        *dirty = false;
+        *debounce_counter = -1;
+    } else if (*dirty) {
         *dirty = false;
         *debounce_counter = SAVE_DATA_DEBOUNCE_FRAMES;
     } else if (*debounce_counter >= 0) {
         if ((*debounce_counter)-- == 0) {
-            FILE* f = fopen(file_path, "wb");
-            fwrite(data, 1, size, f);
-            fclose(f);
-            logalways("Persisted %s data to disk", name);
+#ifndef N64_WIN
+            u8* mapping = data;
+#else
+            u8* mapping = NULL;
+#endif
+            backup_writer_persist(file_path, name, data, size, mapping);
         }
     }
 }
@@ -373,4 +445,44 @@ void force_persist_backup() {
     if (should_persist) {
         persist_backup();
     }
-}
\ No newline at end of file
+    backup_writer_flush();
+}
+
+void close_backup(n64_mem_t* mem) {
+    force_persist_backup();
+    if (mem->save_data != NULL) {
+#ifndef N64_WIN
+        munmap(mem->save_data, mem->save_size);
+#else
+        free(mem->save_data);
+#endif
+        mem->save_data = NULL;
+    }
+    if (mem->mempak_data != NULL) {
+#ifndef N64_WIN
+        munmap(mem->mempak_data, MEMPAK_SIZE);
+#else
+        free(mem->mempak_data);
+#endif
+        mem->mempak_data = NULL;
+    }
+}
+
+void detach_backup(n64_mem_t* mem) {
+    if (backup_detached) {
+        return;
+    }
+    force_persist_backup();
+    backup_detached = true;
+#ifndef N64_WIN
+    // Swap the shared mappings for private ones of the same files
+    if (mem->save_data != NULL) {
+        munmap(mem->save_data, mem->save_size);
+        mem->save_data = map_backup_file(mem->save_file_path, mem->save_size);
+    }
+    if (mem->mempak_data != NULL) {
+        munmap(mem->mempak_data, MEMPAK_SIZE);
+        mem->mempak_data = map_backup_file(mem->mempak_file_path, MEMPAK_SIZE);
+    }
+#endif
+}
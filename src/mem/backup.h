@@ -14,6 +14,12 @@ void init_savedata(n64_mem_t* mem, const char* rom_path);
 void init_mempak(n64_mem_t* mem, const char* rom_path);
 
 void persist_backup();
+// Persists anything still waiting for the debounce, and waits for it to be on the disk
 void force_persist_backup();
+// Persists, then unmaps the save data and mempak
+void close_backup(n64_mem_t* mem);
+// Persists what's pending, then stops the save data and mempak from ever reaching the disk again. The game keeps reading and
+// writing them as usual. For replays, which mustn't change the save they'd start from the next time.
+void detach_backup(n64_mem_t* mem);
 
 #endif //N64_BACKUP_H
@@ -0,0 +1,140 @@
+#include "backup_writer.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <log.h>
+
+#ifndef N64_WIN
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+struct backup_job {
+    std::string name;
+    std::vector<u8> data;
+    u8* mapping;
+};
+
+static struct {
+    std::thread thread;
+    std::mutex mutex;
+    // Signalled when there's a job or the thread should stop
+    std::condition_variable wake;
+    // Signalled when the thread runs out of jobs
+    std::condition_variable idle;
+    // By path
+    std::map<std::string, backup_job> pending;
+    bool busy = false;
+    bool stop = false;
+} writer;
+
+#ifndef N64_WIN
+// The rename itself is only durable once the directory it's in is synced
+static void sync_parent_directory(const std::filesystem::path& path) {
+    std::filesystem::path parent = path.parent_path();
+    int fd = open(parent.empty() ? "." : parent.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+}
+#endif
+
+static bool write_snapshot(const std::string& path, const backup_job& job) {
+#ifndef N64_WIN
+    if (job.mapping != nullptr && msync(job.mapping, job.data.size(), MS_SYNC) != 0) {
+        logwarn("Failed to sync %s data to %s: %s", job.name.c_str(), path.c_str(), strerror(errno));
+    }
+    const std::string snapshot_path = path + ".bak";
+#else
+    const std::string& snapshot_path = path;
+#endif
+    const std::string temp_path = snapshot_path + ".tmp";
+
+    FILE* f = fopen(temp_path.c_str(), "wb");
+    if (f == nullptr) {
+        logwarn("Failed to open %s to save %s data", temp_path.c_str(), job.name.c_str());
+        return false;
+    }
+    bool ok = fwrite(job.data.data(), 1, job.data.size(), f) == job.data.size() && fflush(f) == 0;
+#ifndef N64_WIN
+    ok = ok && fsync(fileno(f)) == 0;
+#endif
+    fclose(f);
+    if (!ok) {
+        logwarn("Failed to write %s data to %s", job.name.c_str(), temp_path.c_str());
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp_path, snapshot_path, error);
+    if (error) {
+        logwarn("Failed to replace %s: %s", snapshot_path.c_str(), error.message().c_str());
+        return false;
+    }
+#ifndef N64_WIN
+    sync_parent_directory(snapshot_path);
+#endif
+    return true;
+}
+
+static void backup_writer_main() {
+    std::unique_lock<std::mutex> lock(writer.mutex);
+    while (true) {
+        writer.wake.wait(lock, [] { return writer.stop || !writer.pending.empty(); });
+        if (writer.pending.empty()) {
+            break;
+        }
+        auto job = writer.pending.extract(writer.pending.begin());
+        writer.busy = true;
+        lock.unlock();
+
+        if (write_snapshot(job.key(), job.mapped())) {
+            logalways("Persisted %s data to disk", job.mapped().name.c_str());
+        }
+
+        lock.lock();
+        writer.busy = false;
+        if (writer.pending.empty()) {
+            writer.idle.notify_all();
+        }
+    }
+}
+
+void backup_writer_persist(const char* path, const char* name, const u8* data, size_t size, u8* mapping) {
+    {
+        std::lock_guard<std::mutex> lock(writer.mutex);
+        writer.pending[path] = {name, std::vector<u8>(data, data + size), mapping};
+        if (!writer.thread.joinable()) {
+            writer.stop = false;
+            writer.thread = std::thread(backup_writer_main);
+        }
+    }
+    writer.wake.notify_one();
+}
+
+void backup_writer_flush() {
+    std::unique_lock<std::mutex> lock(writer.mutex);
+    writer.idle.wait(lock, [] { return writer.pending.empty() && !writer.busy; });
+}
+
+void backup_writer_stop() {
+    {
+        std::lock_guard<std::mutex> lock(writer.mutex);
+        if (!writer.thread.joinable()) {
+            return;
+        }
+        writer.stop = true;
+    }
+    writer.wake.notify_one();
+    // Drains whatever's pending before it exits
+    writer.thread.join();
+}
@@ -0,0 +1,32 @@
+#ifndef N64_BACKUP_WRITER_H
+#define N64_BACKUP_WRITER_H
+
+// Gets save data onto the disk from a background thread, so the CPU thread never waits on file I/O.
+//
+// On POSIX the save files are mapped MAP_SHARED and the game writes straight into the page cache, which already survives
+// the emulator crashing. Persisting msyncs the mapping, then writes a copy taken while the game wasn't writing to
+// <path>.bak through a temporary file and a rename, so there's always one complete save on the disk even if the machine
+// goes down in the middle of a write-back.
+// Without mmap (Windows) the copy is written over <path> the same way instead.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Copies data right away, the rest happens on the writer thread. mapping is msynced first if it isn't NULL.
+// A file that's still waiting from an earlier call only gets written once, with the newest copy.
+void backup_writer_persist(const char* path, const char* name, const u8* data, size_t size, u8* mapping);
+// Blocks until everything passed to backup_writer_persist so far is on the disk
+void backup_writer_flush();
+// Flushes and stops the thread, it starts again the next time something's persisted
+void backup_writer_stop();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //N64_BACKUP_WRITER_H
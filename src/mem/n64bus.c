@@ -6,6 +6,7 @@
 #include <mem/memory_logger.h>
 #include <n64_rsp_bus.h>
 #include <rdp/rdp.h>
+#include <rdp/fast_forward.h>
 #include <cpu/dynarec/dynarec.h>
 #include <rsp.h>
 #include <interface/si.h>
@@ -114,83 +115,84 @@ bool tlb_probe_slow(u64 vaddr, bus_access_t bus_access, bool* cached, u32* paddr
     return true;
 }
 
-bool tlb_probe_from_cache_entry(tlb_cache_entry_t* entry, u64 vaddr, bus_access_t bus_access, bool* cached, u32* paddr, int* entry_number) {
-    if (!entry->hit || (bus_access == BUS_STORE && !entry->dirty)) {
-        // Fall back to slow path for misses (for now?)
-        bool hit = tlb_probe_slow(vaddr, bus_access, cached, NULL, NULL, NULL);
-        if (hit) {
-            logfatal("Vaddr %016" PRIX64 " missed when it should have hit!\n", vaddr);
+bool tlb_probe(u64 vaddr, bus_access_t bus_access, bool* cached, u32* paddr, int* entry_number) {
+    softtlb_entry_t* entry = &N64CP0.softtlb[GET_SOFTTLB_INDEX(vaddr)];
+    u64 tag = GET_SOFTTLB_TAG(vaddr);
+
+    if ((bus_access == BUS_STORE ? entry->store_tag : entry->load_tag) == tag) {
+        if (paddr) {
+            *paddr = entry->paddr | GET_SOFTTLB_PAGE_OFFSET(vaddr);
         }
-        return hit;
+        if (entry_number) {
+            *entry_number = entry->entry_num;
+        }
+        *cached = entry->cached;
+        return true;
+    }
+
+    // Not in the software TLB, fall back to searching the real one.
+    int entry_number_slow;
+    u32 paddr_slow;
+    bool dirty;
+
+    if (!tlb_probe_slow(vaddr, bus_access, cached, &paddr_slow, &entry_number_slow, &dirty)) {
+        return false;
     }
 
     if (paddr) {
-        u32 resolved = entry->base_address + GET_TLB_CACHE_BLOCK_OFFSET(vaddr);
-        *paddr = resolved;
+        *paddr = paddr_slow;
     }
     if (entry_number) {
-        *entry_number = entry->entry_num;
+        *entry_number = entry_number_slow;
     }
 
-    *cached = entry->cached;
+    entry->load_tag = tag;
+    entry->store_tag = dirty ? tag : 0;
+    entry->paddr = paddr_slow & ~((1 << SOFTTLB_PAGE_SHIFT) - 1);
+    entry->cached = *cached;
+    entry->global = N64CP0.tlb[entry_number_slow].global;
+    entry->entry_num = entry_number_slow;
+    entry->asid = N64CP0.entry_hi.asid;
 
-    return entry->hit;
+    return true;
 }
 
-bool tlb_probe(u64 vaddr, bus_access_t bus_access, bool* cached, u32* paddr, int* entry_number) {
-    u64 index = GET_TLB_CACHE_INDEX(vaddr);
-    u64 tag = GET_TLB_CACHE_TAG(vaddr);
-    u64 base_address = GET_TLB_CACHE_BASE_ADDRESS(vaddr);
-    u8 asid = N64CP0.entry_hi.asid;
-
-    bool any_invalid = false;
+void softtlb_invalidate_entry(tlb_entry_t* tlb_entry) {
+    if (!tlb_entry->initialized) {
+        return;
+    }
 
-    tlb_cache_entry_t* entries = N64CP0.tlb_cache[index];
+    u64 entry_vpn = get_vpn(tlb_entry->entry_hi.raw, tlb_entry->page_mask.raw);
 
-    for (int i = 0; i < TLB_CACHE_ASSOCIATIVITY; i++) {
-        if (entries[i].valid) {
-            bool asid_match = entries[i].global || entries[i].asid == asid;
-            if (entries[i].tag == tag && asid_match) {
-                return tlb_probe_from_cache_entry(&entries[i], vaddr, bus_access, cached, paddr, entry_number);
+    for (int i = 0; i < SOFTTLB_SIZE; i++) {
+        softtlb_entry_t* entry = &N64CP0.softtlb[i];
+        if (entry->load_tag) {
+            u64 vaddr = (entry->load_tag & ~SOFTTLB_TAG_VALID) << SOFTTLB_PAGE_SHIFT;
+            if (get_vpn(vaddr, tlb_entry->page_mask.raw) == entry_vpn) {
+                memset(entry, 0, sizeof(softtlb_entry_t));
             }
-        } else {
-            any_invalid = true;
         }
     }
+}
 
-    // Didn't find it in the cache, fall back to the slow path:
-    int entry_number_cache;
-    u32 paddr_cache;
-    bool dirty;
-
-    bool hit = tlb_probe_slow(base_address, bus_access, cached, &paddr_cache, &entry_number_cache, &dirty);
-
-    tlb_cache_entry_t* new_dest = NULL;
-    if (any_invalid) {
-        new_dest = N64CP0.tlb_cache[index];
+void softtlb_asid_updated() {
+    u8 asid = N64CP0.entry_hi.asid;
+    if (asid == N64CP0.softtlb_asid) {
+        return;
+    }
+    N64CP0.softtlb_asid = asid;
 
-        // Should be safe, since any_invalid is set to true, there will be one.
-        while (new_dest->valid) {
-            new_dest++;
+    for (int i = 0; i < SOFTTLB_SIZE; i++) {
+        softtlb_entry_t* entry = &N64CP0.softtlb[i];
+        if (!entry->global && entry->asid != asid) {
+            memset(entry, 0, sizeof(softtlb_entry_t));
         }
-    } else {
-        new_dest = &N64CP0.tlb_cache[index][rand() % TLB_CACHE_ASSOCIATIVITY];
     }
+}
 
-    memset(new_dest, 0, sizeof(tlb_cache_entry_t));
-    new_dest->valid = true;
-    new_dest->hit = hit;
-    new_dest->dirty = hit ? dirty : false;
-    new_dest->cached = *cached;
-
-    new_dest->entry_num = hit ? entry_number_cache : 0;
-    new_dest->tag = tag;
-    new_dest->base_address = paddr_cache;
-    new_dest->asid = asid;
-
-    new_dest->global = hit ? N64CP0.tlb[entry_number_cache].global : true; // set it as global if it's a miss, so we'll always find it
-
-    return tlb_probe_from_cache_entry(new_dest, vaddr, bus_access, cached, paddr, entry_number);
+void softtlb_flush() {
+    memset(N64CP0.softtlb, 0, sizeof(N64CP0.softtlb));
+    N64CP0.softtlb_asid = N64CP0.entry_hi.asid;
 }
 
 u32 read_word_rdramreg(u32 address) {
@@ -414,6 +416,7 @@ void n64_write_physical_dword(u32 address, u64 value) {
     }
     log_dword_write(address, value);
     invalidate_dynarec_page(address);
+    check_watchpoint(address, 8, true);
     switch (address) {
         case REGION_RDRAM:
             dword_to_byte_array((u8*) &n64sys.mem.rdram, DWORD_ADDRESS(address) - SREGION_RDRAM, value);
@@ -486,6 +489,8 @@ u64 n64_read_physical_dword(u32 address) {
     if (address & 0b111) {
         logfatal("Tried to load from unaligned DWORD");
     }
+    check_watchpoint(address, 8, false);
+    check_fast_forward_read(address);
     u64 result;
     switch (address) {
         case REGION_RDRAM:
@@ -550,6 +555,7 @@ void n64_write_physical_word(u32 address, u32 value) {
     }
     log_word_write(address, value);
     invalidate_dynarec_page(WORD_ADDRESS(address));
+    check_watchpoint(address, 4, true);
     switch (address) {
         case REGION_RDRAM:
             word_to_byte_array((u8*) &n64sys.mem.rdram, WORD_ADDRESS(address) - SREGION_RDRAM, value);
@@ -618,10 +624,11 @@ void n64_write_physical_word(u32 address, u32 value) {
     }
 }
 
-u32 n64_read_physical_word(u32 address) {
+u32 n64_fetch_physical_word(u32 address) {
     if (address & 0b11) {
         logfatal("Tried to load from unaligned WORD");
     }
+    check_fast_forward_read(address);
     u32 result;
     switch (address) {
         case REGION_RDRAM:
@@ -703,6 +710,11 @@ u32 n64_read_physical_word(u32 address) {
     return result;
 }
 
+u32 n64_read_physical_word(u32 address) {
+    check_watchpoint(address, 4, false);
+    return n64_fetch_physical_word(address);
+}
+
 // Handle the bus edge for 16 bit writes to PIF and SPMEM
 INLINE u32 bus_edge_case_half_pif_spmem(u32 address, u32 value) {
     // Write to address & ~3.
@@ -720,6 +732,7 @@ void n64_write_physical_half(u32 address, u32 value) {
     }
     log_half_write(address, value);
     invalidate_dynarec_page(HALF_ADDRESS(address));
+    check_watchpoint(address, 2, true);
     switch (address) {
         case REGION_RDRAM:
             half_to_byte_array((u8*) &n64sys.mem.rdram, HALF_ADDRESS(address) - SREGION_RDRAM, value);
@@ -795,6 +808,8 @@ u16 n64_read_physical_half(u32 address) {
     if (address & 0b1) {
         logfatal("Tried to load from unaligned HALF");
     }
+    check_watchpoint(address, 2, false);
+    check_fast_forward_read(address);
     u16 result;
     switch (address) {
         case REGION_RDRAM:
@@ -856,6 +871,7 @@ u16 n64_read_physical_half(u32 address) {
 void n64_write_physical_byte(u32 address, u32 value) {
     log_byte_write(address, value);
     invalidate_dynarec_page(BYTE_ADDRESS(address));
+    check_watchpoint(address, 1, true);
     switch (address) {
         case REGION_RDRAM:
             n64sys.mem.rdram[BYTE_ADDRESS(address)] = value;
@@ -917,6 +933,8 @@ void n64_write_physical_byte(u32 address, u32 value) {
 }
 
 u8 n64_read_physical_byte(u32 address) {
+    check_watchpoint(address, 1, false);
+    check_fast_forward_read(address);
     u8 result;
     switch (address) {
         case REGION_RDRAM:
@@ -176,6 +176,8 @@ u64 n64_read_physical_dword(u32 address);
 
 void n64_write_physical_word(u32 address, u32 value);
 u32 n64_read_physical_word(u32 address);
+// For instruction fetches and reading code to compile. Same as a word read, but doesn't trigger data watchpoints.
+u32 n64_fetch_physical_word(u32 address);
 
 void n64_write_physical_half(u32 address, u32 value);
 u16 n64_read_physical_half(u32 address);
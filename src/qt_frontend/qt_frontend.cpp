@@ -32,9 +32,7 @@ int main(int argc, char** argv) {
     bool debug = false;
 #ifdef N64_DEBUG_MODE
 #ifndef N64_WIN
-    char description[111];
-    snprintf(description, sizeof(description), "Enable debug mode. Starts halted and listens on port defined in dgb-n64.ini for connections. NOTE: implies -i!");
-    cflags_add_bool(flags, 'd', "debug", &debug, description);
+    cflags_add_bool(flags, 'd', "debug", &debug, "Enable debug mode. Starts halted and listens on port defined in dgb-n64.ini for connections.");
 #endif
 #endif
 
@@ -75,11 +73,6 @@ int main(int argc, char** argv) {
     if (log_get_verbosity() < LOG_VERBOSITY_WARN) {
         log_set_verbosity(LOG_VERBOSITY_WARN);
     }
-    // if debug mode is enabled, force the interpreter
-    if (debug && !interpreter) {
-        logwarn("Debug mode enabled, forcing the use of the interpreter!");
-        interpreter = true;
-    }
 #endif
 
     const char* rom_path = NULL;
@@ -0,0 +1,246 @@
+#include "fast_forward.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <log.h>
+
+u8* n64_fast_forward_pages = NULL;
+
+#define RDP_COMMAND_TRIANGLE_FIRST 0x08
+#define RDP_COMMAND_TRIANGLE_LAST 0x0F
+#define RDP_COMMAND_TEXTURE_RECTANGLE 0x24
+#define RDP_COMMAND_TEXTURE_RECTANGLE_FLIP 0x25
+#define RDP_COMMAND_SET_SCISSOR 0x2D
+#define RDP_COMMAND_SET_OTHER_MODES 0x2F
+#define RDP_COMMAND_LOAD_TLUT 0x30
+#define RDP_COMMAND_LOAD_BLOCK 0x33
+#define RDP_COMMAND_LOAD_TILE 0x34
+#define RDP_COMMAND_FILL_RECTANGLE 0x36
+#define RDP_COMMAND_SET_TEXTURE_IMAGE 0x3D
+#define RDP_COMMAND_SET_Z_IMAGE 0x3E
+#define RDP_COMMAND_SET_COLOR_IMAGE 0x3F
+
+typedef struct rdp_image {
+    bool set;
+    u32 address;
+    u32 width;
+    // 0: 4 bit, 1: 8 bit, 2: 16 bit, 3: 32 bit
+    u8 size;
+} rdp_image_t;
+
+static struct {
+    bool active;
+    // 0 if there's no limit
+    u32 frames_left;
+    u32 frames;
+    u64 dropped_draws;
+    u32 mismatches;
+
+    // Followed from the commands. Nothing is known about them until they're set, so draws go through until then.
+    rdp_image_t color_image;
+    rdp_image_t texture_image;
+    bool z_image_set;
+    u32 z_image;
+    bool z_update;
+    bool scissor_set;
+    u32 scissor_bottom;
+
+    // Worked out on the first draw after the images, the scissor or the pages change
+    bool targets_known;
+    bool drop_draws;
+} ff;
+
+// Bytes taken by pixels pixels of an image of this size
+INLINE u32 image_bytes(u32 pixels, u8 size) {
+    return (pixels << size) >> 1;
+}
+
+static void read_image(const u32* command, rdp_image_t* image) {
+    image->set = true;
+    image->address = command[1] & 0x3FFFFFF;
+    image->width = (command[0] & 0x3FF) + 1;
+    image->size = (command[0] >> 19) & 3;
+}
+
+INLINE u32 last_page(u32 start, u32 length) {
+    u32 end = start + length;
+    end = end > N64_RDRAM_SIZE ? N64_RDRAM_SIZE : end;
+    return (end - 1) >> FAST_FORWARD_PAGE_SHIFT;
+}
+
+static bool range_has(u32 start, u32 length, u8 flag) {
+    if (length == 0 || start >= N64_RDRAM_SIZE) {
+        return false;
+    }
+    for (u32 page = start >> FAST_FORWARD_PAGE_SHIFT; page <= last_page(start, length); page++) {
+        if (n64_fast_forward_pages[page] & flag) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void mark_range(u32 start, u32 length, u8 flag) {
+    if (length == 0 || start >= N64_RDRAM_SIZE) {
+        return;
+    }
+    for (u32 page = start >> FAST_FORWARD_PAGE_SHIFT; page <= last_page(start, length); page++) {
+        n64_fast_forward_pages[page] |= flag;
+    }
+}
+
+static bool drop_draw() {
+    if (!ff.targets_known) {
+        // The scissor is all there is to say how tall the images are. Z is the same width as color, always 16 bit.
+        u32 color_length = image_bytes(ff.color_image.width, ff.color_image.size) * ff.scissor_bottom;
+        u32 z_length = ff.z_update ? ff.color_image.width * 2 * ff.scissor_bottom : 0;
+
+        ff.targets_known = true;
+        // Without a scissor there's no telling which pages a draw covers, so it can't be dropped
+        ff.drop_draws = ff.color_image.set && ff.scissor_set && (ff.z_image_set || !ff.z_update)
+                && !range_has(ff.color_image.address, color_length, FAST_FORWARD_PAGE_READ_BACK)
+                && !range_has(ff.z_image, z_length, FAST_FORWARD_PAGE_READ_BACK);
+        if (ff.drop_draws) {
+            mark_range(ff.color_image.address, color_length, FAST_FORWARD_PAGE_SKIPPED);
+            mark_range(ff.z_image, z_length, FAST_FORWARD_PAGE_SKIPPED);
+        }
+    }
+    if (ff.drop_draws) {
+        ff.dropped_draws++;
+    }
+    return ff.drop_draws;
+}
+
+// Texture loads read RDRAM too, and can read back an image that was rendered to
+static void check_texture_load(u32 first_row, u32 last_row, u32 first_texel, u32 last_texel) {
+    if (!ff.texture_image.set || last_row < first_row || last_texel < first_texel) {
+        return;
+    }
+    u32 stride = image_bytes(ff.texture_image.width, ff.texture_image.size);
+    u32 start = ff.texture_image.address + first_row * stride + image_bytes(first_texel, ff.texture_image.size);
+    u32 end = ff.texture_image.address + last_row * stride + image_bytes(last_texel + 1, ff.texture_image.size);
+    if (start < N64_RDRAM_SIZE) {
+        check_fast_forward_read_range(start, (end > N64_RDRAM_SIZE ? N64_RDRAM_SIZE : end) - start);
+    }
+}
+
+bool fast_forward_rdp_command(const u32* command) {
+    u8 id = (command[0] >> 24) & 0x3F;
+    switch (id) {
+        case RDP_COMMAND_SET_COLOR_IMAGE:
+            read_image(command, &ff.color_image);
+            ff.targets_known = false;
+            return true;
+        case RDP_COMMAND_SET_Z_IMAGE:
+            ff.z_image_set = true;
+            ff.z_image = command[1] & 0x3FFFFFF;
+            ff.targets_known = false;
+            return true;
+        case RDP_COMMAND_SET_SCISSOR:
+            // 10.2 fixed point, rounded up to take in a partly covered last line
+            ff.scissor_set = true;
+            ff.scissor_bottom = ((command[1] & 0xFFF) + 3) >> 2;
+            ff.targets_known = false;
+            return true;
+        case RDP_COMMAND_SET_OTHER_MODES: {
+            bool z_update = (command[1] >> 5) & 1;
+            if (z_update != ff.z_update) {
+                ff.z_update = z_update;
+                ff.targets_known = false;
+            }
+            return true;
+        }
+        case RDP_COMMAND_SET_TEXTURE_IMAGE:
+            read_image(command, &ff.texture_image);
+            return true;
+        case RDP_COMMAND_LOAD_TLUT:
+        case RDP_COMMAND_LOAD_TILE:
+            // s and t are 10.2 fixed point
+            check_texture_load((command[0] & 0xFFF) >> 2, (command[1] & 0xFFF) >> 2,
+                               ((command[0] >> 12) & 0xFFF) >> 2, ((command[1] >> 12) & 0xFFF) >> 2);
+            return true;
+        case RDP_COMMAND_LOAD_BLOCK:
+            // One row of texels, counted in whole texels
+            check_texture_load(0, 0, (command[0] >> 12) & 0xFFF, (command[1] >> 12) & 0xFFF);
+            return true;
+        case RDP_COMMAND_TRIANGLE_FIRST ... RDP_COMMAND_TRIANGLE_LAST:
+        case RDP_COMMAND_TEXTURE_RECTANGLE:
+        case RDP_COMMAND_TEXTURE_RECTANGLE_FLIP:
+        case RDP_COMMAND_FILL_RECTANGLE:
+            return !drop_draw();
+        default:
+            return true;
+    }
+}
+
+void fast_forward_skipped_read(u32 physical_address) {
+    u32 page = physical_address >> FAST_FORWARD_PAGE_SHIFT;
+    // The run of skipped pages around the read is the image it's from, or a few of them next to each other
+    u32 first = page;
+    while (first > 0 && (n64_fast_forward_pages[first - 1] & FAST_FORWARD_PAGE_SKIPPED)) {
+        first--;
+    }
+    u32 last = page;
+    while (last + 1 < FAST_FORWARD_PAGES && (n64_fast_forward_pages[last + 1] & FAST_FORWARD_PAGE_SKIPPED)) {
+        last++;
+    }
+    for (u32 i = first; i <= last; i++) {
+        n64_fast_forward_pages[i] = FAST_FORWARD_PAGE_READ_BACK;
+    }
+    ff.targets_known = false;
+    ff.mismatches++;
+    logwarn("Fast forward: 0x%08X was read back after draws into it were dropped, drawing 0x%08X-0x%08X from now on",
+            physical_address, first << FAST_FORWARD_PAGE_SHIFT, ((last + 1) << FAST_FORWARD_PAGE_SHIFT) - 1);
+}
+
+void fast_forward_start(u32 frames) {
+    if (n64_fast_forward_pages == NULL) {
+        n64_fast_forward_pages = calloc(FAST_FORWARD_PAGES, 1);
+        if (n64_fast_forward_pages == NULL) {
+            logfatal("Failed to allocate fast forward page flags");
+        }
+    }
+    ff.active = true;
+    ff.frames_left = frames;
+    ff.frames = 0;
+    ff.dropped_draws = 0;
+    ff.mismatches = 0;
+    // Commands weren't followed before, wait for the game to set everything again
+    ff.color_image.set = false;
+    ff.texture_image.set = false;
+    ff.z_image_set = false;
+    ff.scissor_set = false;
+    ff.z_update = true;
+    ff.targets_known = false;
+    if (frames > 0) {
+        logalways("Fast forwarding %u frames", frames);
+    } else {
+        logalways("Fast forwarding");
+    }
+}
+
+void fast_forward_stop() {
+    if (!ff.active) {
+        return;
+    }
+    ff.active = false;
+    free(n64_fast_forward_pages);
+    n64_fast_forward_pages = NULL;
+    logalways("Fast forwarded %u frames, dropped %" PRIu64 " draws, %u images had to be drawn after all",
+              ff.frames, ff.dropped_draws, ff.mismatches);
+}
+
+bool fast_forward_active() {
+    return ff.active;
+}
+
+u32 fast_forward_frames_left() {
+    return ff.active ? ff.frames_left : 0;
+}
+
+void fast_forward_end_frame() {
+    ff.frames++;
+    if (ff.frames_left > 0 && --ff.frames_left == 0) {
+        fast_forward_stop();
+    }
+}
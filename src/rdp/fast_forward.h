@@ -0,0 +1,64 @@
+#ifndef N64_FAST_FORWARD_H
+#define N64_FAST_FORWARD_H
+
+// Fast forward runs the CPU and RSP flat out without showing anything, e.g. to play a movie up to a point worth looking at.
+//
+// Frames aren't scanned out or presented, and the RDP doesn't draw into the color and Z images either, only state and
+// texture loads still reach it. That's only safe while nothing reads those images back, so every RDRAM page a dropped draw
+// would have written is marked, and the CPU, RSP DMA and RDP texture loads are checked against the marks. The first read of
+// one is a mismatch: the game gets whatever was there before, and every image on those pages is drawn for real from then on.
+// Games that read their framebuffer every frame only miss it the first time, ones that only do it now and then (pause
+// screens grabbing the last frame, say) see one stale frame.
+
+#include <stdbool.h>
+#include <util.h>
+#include <mem/n64mem.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FAST_FORWARD_PAGE_SHIFT 12
+#define FAST_FORWARD_PAGES (N64_RDRAM_SIZE >> FAST_FORWARD_PAGE_SHIFT)
+// Draws into the page were dropped, it doesn't hold what the game thinks it does
+#define FAST_FORWARD_PAGE_SKIPPED 1
+// The game reads the page back, draws into it always happen
+#define FAST_FORWARD_PAGE_READ_BACK 2
+// One entry per page of RDRAM. NULL while not fast forwarding.
+extern u8* n64_fast_forward_pages;
+
+// frames is how many frames to fast forward for, 0 to keep going until fast_forward_stop
+void fast_forward_start(u32 frames);
+void fast_forward_stop();
+bool fast_forward_active();
+// Frames until fast forward stops by itself, 0 if it doesn't or isn't active
+u32 fast_forward_frames_left();
+// Call once per frame instead of presenting it
+void fast_forward_end_frame();
+// True if the RDP should run this command. Needs to see every command, in order, to follow the images and scissor.
+bool fast_forward_rdp_command(const u32* command);
+
+void fast_forward_skipped_read(u32 physical_address);
+
+INLINE void check_fast_forward_read(u32 physical_address) {
+    if (unlikely(n64_fast_forward_pages != NULL) && physical_address < N64_RDRAM_SIZE
+            && (n64_fast_forward_pages[physical_address >> FAST_FORWARD_PAGE_SHIFT] & FAST_FORWARD_PAGE_SKIPPED)) {
+        fast_forward_skipped_read(physical_address);
+    }
+}
+
+// For DMAs and anything else that reads a block at a time
+INLINE void check_fast_forward_read_range(u32 physical_address, u32 length) {
+    if (unlikely(n64_fast_forward_pages != NULL) && length > 0) {
+        u32 last = physical_address + length - 1;
+        for (u32 page = physical_address >> FAST_FORWARD_PAGE_SHIFT; page <= last >> FAST_FORWARD_PAGE_SHIFT; page++) {
+            check_fast_forward_read(page << FAST_FORWARD_PAGE_SHIFT);
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //N64_FAST_FORWARD_H
@@ -312,6 +312,10 @@ void prdp_update_screen() {
     command_processor->begin_frame_context();
 }
 
+void prdp_begin_frame() {
+    command_processor->begin_frame_context();
+}
+
 void prdp_update_screen_no_game() {
     update_screen(static_cast<Util::IntrusivePtr<Image>>(nullptr));
 }
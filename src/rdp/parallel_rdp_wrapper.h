@@ -30,6 +30,8 @@ extern "C" {
 #endif
     void prdp_init_internal_swapchain();
     void prdp_update_screen();
+    // What prdp_update_screen does once the frame's been scanned out, for frames that aren't
+    void prdp_begin_frame();
     void prdp_enqueue_command(int command_length, u32* buffer);
     void prdp_on_full_sync();
     void prdp_update_screen_no_game();
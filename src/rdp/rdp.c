@@ -11,21 +11,37 @@
 #endif
 #include <stdbool.h>
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "parallel_rdp_wrapper.h"
 #include "softrdp.h"
+#include "rdp_thread.h"
+#include "fast_forward.h"
 #include <log.h>
+#include <trace.h>
+#include <metrics.h>
 #include <frontend/render.h>
 #include <rsp.h>
 #include <frontend/frontend.h>
+#include <system/scheduler.h>
+
+#if defined(N64_HAVE_SSE)
+#include <tmmintrin.h>
+#elif defined(N64_USE_NEON)
+#include <arm_neon.h>
+#endif
 
 static void* plugin_handle = NULL;
 static u32 rdram_size_word = N64_RDRAM_SIZE; // GFX_INFO needs this to be sent as a uint32
 
-#define RDP_COMMAND_BUFFER_SIZE 0xFFFFF
-u32 rdp_command_buffer[RDP_COMMAND_BUFFER_SIZE];
+// Grows to fit the longest display list seen so far, plus the partial command left over from the previous one
+static u32* rdp_command_buffer = NULL;
+static size_t rdp_command_buffer_capacity = 0; // in words
 
-#define FROM_RDRAM(address) word_from_byte_array(n64sys.mem.rdram, WORD_ADDRESS(address))
-#define FROM_DMEM(address) be32toh(word_from_byte_array(N64RSP.sp_dmem, (address) & 0xFFF))
+// Not cycle accurate, the RDP is never emulated as taking any time to draw. This only needs to be far enough in the future that
+// the interrupt doesn't fire in the middle of the store that started the list.
+#define RDP_FULL_SYNC_DELAY 256
 
 
 static const int command_lengths[64] = {
@@ -116,6 +132,54 @@ u32 read_word_dpcreg(u32 address) {
     }
 }
 
+static void ensure_command_buffer_capacity(size_t words) {
+    if (words <= rdp_command_buffer_capacity) {
+        return;
+    }
+    size_t capacity = rdp_command_buffer_capacity ? rdp_command_buffer_capacity : 0x1000;
+    while (capacity < words) {
+        capacity *= 2;
+    }
+    rdp_command_buffer = realloc(rdp_command_buffer, capacity * sizeof(u32));
+    if (rdp_command_buffer == NULL) {
+        logfatal("Failed to grow the RDP command buffer to %zu words", capacity);
+    }
+    rdp_command_buffer_capacity = capacity;
+}
+
+// DMEM is stored big endian, so every word needs swapping on the way into the command buffer
+static void copy_dmem_words(u32* dst, u32 address, int words) {
+    while (words > 0) {
+        address &= 0xFFF;
+        // DMEM wraps, copy up to the end of it at a time
+        int chunk = (0x1000 - address) >> 2;
+        if (chunk > words) {
+            chunk = words;
+        }
+        const u8* src = &N64RSP.sp_dmem[address];
+        int i = 0;
+#ifndef N64_BIG_ENDIAN
+#if defined(N64_HAVE_SSE)
+        const __m128i byteswap = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+        for (; i + 4 <= chunk; i += 4) {
+            __m128i v = _mm_loadu_si128((const __m128i*)&src[i * 4]);
+            _mm_storeu_si128((__m128i*)&dst[i], _mm_shuffle_epi8(v, byteswap));
+        }
+#elif defined(N64_USE_NEON)
+        for (; i + 4 <= chunk; i += 4) {
+            vst1q_u8((u8*)&dst[i], vrev32q_u8(vld1q_u8(&src[i * 4])));
+        }
+#endif
+#endif
+        for (; i < chunk; i++) {
+            dst[i] = be32toh(word_from_byte_array((u8*)src, i * 4));
+        }
+        dst += chunk;
+        address += chunk * 4;
+        words -= chunk;
+    }
+}
+
 INLINE void rdp_enqueue_command(int command_length, u32* buffer) {
     switch (n64sys.video_type) {
         case UNKNOWN_VIDEO_TYPE:
@@ -128,7 +192,7 @@ INLINE void rdp_enqueue_command(int command_length, u32* buffer) {
     }
 }
 
-INLINE void rdp_on_full_sync() {
+INLINE void rdp_backend_full_sync() {
     switch (n64sys.video_type) {
         case UNKNOWN_VIDEO_TYPE:
             logfatal("RDP on full sync with video type UNKNOWN_VIDEO_TYPE");
@@ -136,18 +200,65 @@ INLINE void rdp_on_full_sync() {
         case QT_VULKAN_VIDEO_TYPE:
             prdp_on_full_sync(); break;
         case SOFTWARE_VIDEO_TYPE:
-            full_sync_softrdp();
+            softrdp_full_sync(&n64sys.softrdp_state);
             break;
     }
+}
+
+// Runs on the RDP thread when there is one, otherwise straight from process_rdp_list
+static void rdp_execute_command(int command_length, u32* buffer) {
+    if (TRACE_ENABLED(TRACE_EVENT_RDP_COMMAND)) {
+        trace_rdp_command_t traced;
+        traced.length = command_length;
+        memcpy(traced.words, buffer, command_length * sizeof(u32));
+        trace_emit(TRACE_EVENT_RDP_COMMAND, &traced, sizeof(u32) * (1 + command_length));
+    }
+    u8 command = (buffer[0] >> 24) & 0x3F;
+    // Don't need to process commands under 8
+    if (command >= 8) {
+        rdp_enqueue_command(command_length, buffer);
+    }
+    if (command == RDP_COMMAND_FULL_SYNC) {
+        rdp_backend_full_sync();
+    }
+}
+
+void rdp_start_thread() {
+    rdp_thread_start(rdp_execute_command);
+}
+
+void rdp_stop_thread() {
+    rdp_thread_stop();
+}
+
+// The backend has already been told about the full sync (or will be, in order, on the RDP thread).
+// The interrupt is raised from the scheduler, so it happens at the same emulated time whether or not the RDP has its own thread.
+INLINE void rdp_on_full_sync() {
+    // If another full sync is still pending, this one replaces it, there's only one DP interrupt to raise.
+    scheduler_remove_event(SCHEDULER_RDP_FULL_SYNC);
+    scheduler_enqueue_relative(RDP_FULL_SYNC_DELAY, SCHEDULER_RDP_FULL_SYNC);
+}
+
+void on_rdp_full_sync_complete() {
+    // Whatever the game does next can depend on everything before the full sync having been drawn
+    if (rdp_thread_running()) {
+        rdp_thread_wait_idle();
+    }
     n64sys.dpc.status.pipe_busy = false;
     n64sys.dpc.status.start_gclk = false;
     n64sys.dpc.status.cbuf_ready = false;
     interrupt_raise(INTERRUPT_DP);
 }
 
-void process_rdp_list() {
-    static int last_run_unprocessed_words = 0;
+void rdp_sync_rdram() {
+    if (rdp_thread_running()) {
+        rdp_thread_wait_idle();
+    }
+    // The thread is idle, so the backend can be synced from here
+    rdp_backend_full_sync();
+}
 
+void process_rdp_list() {
     n64_dpc_t* dpc = &n64sys.dpc;
 
     // tell the game to not touch RDP stuff while we work
@@ -165,31 +276,23 @@ void process_rdp_list() {
         return;
     }
 
-    if (display_list_length + (last_run_unprocessed_words * 4) > RDP_COMMAND_BUFFER_SIZE) {
-        logfatal("Got a command of display_list_length %d / 0x%X (with %d unprocessed words from last run) - this overflows our buffer of size %d / 0x%X!",
-                 display_list_length, display_list_length, last_run_unprocessed_words, RDP_COMMAND_BUFFER_SIZE, RDP_COMMAND_BUFFER_SIZE);
-    }
-
-    // read the commands into a buffer, 32 bits at a time.
-    // we need to read the whole thing into a buffer before sending each command to the RDP
-    // because commands have variable lengths
+    // read the whole list into a buffer before sending each command to the RDP, because commands have variable lengths
+    ensure_command_buffer_capacity(dpc->partial_command_words + (display_list_length >> 2));
+    memcpy(rdp_command_buffer, dpc->partial_command, dpc->partial_command_words * sizeof(u32));
+    u32* list_start = &rdp_command_buffer[dpc->partial_command_words];
     if (dpc->status.xbus_dmem_dma) {
-        for (int i = 0; i < display_list_length; i += 4) {
-            u32 command_word = FROM_DMEM(current + i);
-            rdp_command_buffer[last_run_unprocessed_words + (i >> 2)] = command_word;
-        }
+        copy_dmem_words(list_start, current, display_list_length >> 2);
     } else {
-        if (end > 0x7FFFFFF || current > 0x7FFFFFF) {
+        if (end > N64_RDRAM_SIZE) {
             logwarn("Not running RDP commands, wanted to read past end of RDRAM!");
             return;
         }
-        for (int i = 0; i < display_list_length; i += 4) {
-            u32 command_word = FROM_RDRAM(current + i);
-            rdp_command_buffer[last_run_unprocessed_words + (i >> 2)] = command_word;
-        }
+        // RDRAM is already stored as host endian words
+        memcpy(list_start, &n64sys.mem.rdram[WORD_ADDRESS(current)], display_list_length);
     }
 
-    int length_words = (display_list_length >> 2) + last_run_unprocessed_words;
+    const bool threaded = rdp_thread_running();
+    int length_words = (display_list_length >> 2) + dpc->partial_command_words;
     int buf_index = 0;
 
     bool processed_all = true;
@@ -199,30 +302,24 @@ void process_rdp_list() {
 
         int command_length = command_lengths[command];
 
-        // Check we actually have enough bytes left in the display list for this command, and save the remainder of the display list for the next run, if not.
-        if ((buf_index + command_length) * 4 > display_list_length + (last_run_unprocessed_words * 4)) {
-            // Copy remaining bytes back to the beginning of the display list, and save them for next run.
-            last_run_unprocessed_words = length_words - buf_index;
-
-            // Safe to allocate this on the stack because we'll only have a partial command left, and that _has_ to be pretty small.
-            u32 temp[last_run_unprocessed_words];
-            for (int i = 0; i < last_run_unprocessed_words; i++) {
-                temp[i] = rdp_command_buffer[buf_index + i];
-            }
-
-            for (int i = 0; i < last_run_unprocessed_words; i++) {
-                rdp_command_buffer[i] = temp[i];
-            }
+        // Check we actually have enough words left in the display list for this command, and save the remainder of the display list for the next run, if not.
+        if (buf_index + command_length > length_words) {
+            // Save the partial command for the next run
+            dpc->partial_command_words = length_words - buf_index;
+            memcpy(dpc->partial_command, &rdp_command_buffer[buf_index], dpc->partial_command_words * sizeof(u32));
 
             processed_all = false;
 
             break;
         }
 
-
-        // Don't need to process commands under 8
-        if (command >= 8) {
-            rdp_enqueue_command(command_length, &rdp_command_buffer[buf_index]);
+        // Fast forward drops draws into images nothing reads back
+        if (likely(!fast_forward_active()) || fast_forward_rdp_command(&rdp_command_buffer[buf_index])) {
+            if (threaded) {
+                rdp_thread_submit(command_length, &rdp_command_buffer[buf_index]);
+            } else {
+                rdp_execute_command(command_length, &rdp_command_buffer[buf_index]);
+            }
         }
 
         if (command == RDP_COMMAND_FULL_SYNC) {
@@ -232,8 +329,12 @@ void process_rdp_list() {
         buf_index += command_length;
     }
 
+    if (threaded) {
+        rdp_thread_publish();
+    }
+
     if (processed_all) {
-        last_run_unprocessed_words = 0;
+        dpc->partial_command_words = 0;
     }
 
     dpc->current = end;
@@ -253,9 +354,12 @@ void rdp_run_command() {
         switch (n64sys.video_type) {
             case VULKAN_VIDEO_TYPE:
             case QT_VULKAN_VIDEO_TYPE:
-            case SOFTWARE_VIDEO_TYPE:
+            case SOFTWARE_VIDEO_TYPE: {
+                u64 start = metric_timer_start();
                 process_rdp_list();
+                metric_timer_stop(HISTOGRAM_RDP_LIST, start);
                 break;
+            }
             default:
                 logfatal("Unknown video type");
         }
@@ -265,6 +369,20 @@ void rdp_run_command() {
 }
 
 void rdp_update_screen() {
+    if (fast_forward_active()) {
+        // Nothing gets shown, but the window still needs its events handled and parallel-RDP still needs to recycle
+        // its per frame resources
+        n64_poll_input();
+        if (n64sys.video_type == VULKAN_VIDEO_TYPE || n64sys.video_type == QT_VULKAN_VIDEO_TYPE) {
+            prdp_begin_frame();
+        }
+        fast_forward_end_frame();
+        return;
+    }
+    // Scanout reads the framebuffer, and parallel-RDP can't take VI registers while the RDP thread is submitting commands
+    if (rdp_thread_running()) {
+        rdp_thread_wait_idle();
+    }
     switch (n64sys.video_type) {
         case VULKAN_VIDEO_TYPE:
         case QT_VULKAN_VIDEO_TYPE:
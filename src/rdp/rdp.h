@@ -14,6 +14,12 @@ void rdp_update_screen();
 void rdp_status_reg_write(u32 value);
 void rdp_start_reg_write(u32 value);
 void rdp_end_reg_write(u32 value);
+// Move command processing onto its own thread. Call once the backend is initialized.
+void rdp_start_thread();
+void rdp_stop_thread();
+void on_rdp_full_sync_complete();
+// Waits until everything sent to the RDP so far has been drawn into RDRAM, as if it had ended with a full sync
+void rdp_sync_rdram();
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,153 @@
+#include "rdp_thread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <log.h>
+
+// In words. Each command is stored as its length followed by its words, and the longest command is 44 words.
+#define RDP_RING_SIZE (1 << 20)
+#define RDP_RING_MASK (RDP_RING_SIZE - 1)
+#define RDP_MAX_COMMAND_LENGTH 44
+
+struct rdp_ring {
+    std::vector<u32> words = std::vector<u32>(RDP_RING_SIZE);
+
+    // Only touched by the producer: the end of what's been written, which can be ahead of what's been published
+    u64 submitted = 0;
+    // Published by the producer, everything before it is ready to run
+    std::atomic<u64> head{0};
+    // Advanced by the consumer once a command has run
+    std::atomic<u64> tail{0};
+
+    // Each side sets its flag before parking, and the other side only takes the mutex to wake it when the flag is set
+    std::mutex mutex;
+    std::condition_variable work;
+    std::condition_variable progress;
+    std::atomic<bool> consumer_parked{false};
+    std::atomic<bool> producer_parked{false};
+    bool stop = false;
+
+    rdp_thread_handler_t handler = nullptr;
+    std::thread thread;
+};
+
+static rdp_ring* ring = nullptr;
+
+static void rdp_thread_main(rdp_ring* r) {
+    alignas(8) u32 command[RDP_MAX_COMMAND_LENGTH];
+    u64 tail = r->tail.load(std::memory_order_relaxed);
+
+    while (true) {
+        const u64 head = r->head.load(std::memory_order_acquire);
+        if (tail == head) {
+            std::unique_lock<std::mutex> lock(r->mutex);
+            r->consumer_parked = true;
+            r->work.wait(lock, [&] { return r->stop || r->head.load() != tail; });
+            r->consumer_parked = false;
+            if (r->head.load() == tail) {
+                // Stopped, and everything submitted has run
+                return;
+            }
+            continue;
+        }
+
+        while (tail != head) {
+            const int length = r->words[tail & RDP_RING_MASK];
+            for (int i = 0; i < length; i++) {
+                command[i] = r->words[(tail + 1 + i) & RDP_RING_MASK];
+            }
+            r->handler(length, command);
+
+            tail += length + 1;
+            r->tail.store(tail);
+            if (r->producer_parked.load()) {
+                std::lock_guard<std::mutex> lock(r->mutex);
+                r->progress.notify_one();
+            }
+        }
+    }
+}
+
+void rdp_thread_start(rdp_thread_handler_t handler) {
+    if (ring != nullptr) {
+        logwarn("RDP thread already running");
+        return;
+    }
+    ring = new rdp_ring;
+    ring->handler = handler;
+    ring->thread = std::thread(rdp_thread_main, ring);
+}
+
+void rdp_thread_stop() {
+    if (ring == nullptr) {
+        return;
+    }
+    rdp_thread_publish();
+    {
+        std::lock_guard<std::mutex> lock(ring->mutex);
+        ring->stop = true;
+    }
+    ring->work.notify_one();
+    ring->thread.join();
+    delete ring;
+    ring = nullptr;
+}
+
+bool rdp_thread_running() {
+    return ring != nullptr;
+}
+
+INLINE u64 rdp_ring_free(rdp_ring* r) {
+    return RDP_RING_SIZE - (r->submitted - r->tail.load(std::memory_order_acquire));
+}
+
+void rdp_thread_submit(int command_length, const u32* buffer) {
+    rdp_ring* r = ring;
+    const u64 needed = command_length + 1;
+
+    if (unlikely(rdp_ring_free(r) < needed)) {
+        // The RDP thread is a whole ring behind, let it catch up
+        rdp_thread_publish();
+        std::unique_lock<std::mutex> lock(r->mutex);
+        r->producer_parked = true;
+        r->progress.wait(lock, [&] { return rdp_ring_free(r) >= needed; });
+        r->producer_parked = false;
+    }
+
+    const u64 at = r->submitted;
+    r->words[at & RDP_RING_MASK] = command_length;
+    for (int i = 0; i < command_length; i++) {
+        r->words[(at + 1 + i) & RDP_RING_MASK] = buffer[i];
+    }
+    r->submitted += needed;
+}
+
+void rdp_thread_publish() {
+    rdp_ring* r = ring;
+    if (r->head.load(std::memory_order_relaxed) == r->submitted) {
+        return;
+    }
+    r->head.store(r->submitted);
+    if (r->consumer_parked.load()) {
+        std::lock_guard<std::mutex> lock(r->mutex);
+        r->work.notify_one();
+    }
+}
+
+void rdp_thread_wait_idle() {
+    rdp_ring* r = ring;
+    rdp_thread_publish();
+
+    const u64 target = r->submitted;
+    if (r->tail.load(std::memory_order_acquire) == target) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(r->mutex);
+    r->producer_parked = true;
+    r->progress.wait(lock, [&] { return r->tail.load() == target; });
+    r->producer_parked = false;
+}
@@ -0,0 +1,33 @@
+#ifndef N64_RDP_THREAD_H
+#define N64_RDP_THREAD_H
+
+// Runs RDP commands on a dedicated thread, fed through a single producer / single consumer ring.
+// The emulation thread is the only producer and the RDP thread the only consumer, so the ring itself needs no locks.
+// The mutex and condition variables are only used to park whichever side has nothing to do.
+
+#include <stdbool.h>
+#include <util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Called on the RDP thread for every command, in order
+typedef void (*rdp_thread_handler_t)(int command_length, u32* buffer);
+
+void rdp_thread_start(rdp_thread_handler_t handler);
+// Waits for everything already submitted to run, then joins the thread
+void rdp_thread_stop();
+bool rdp_thread_running();
+
+// Copies a command into the ring, waiting for space if it's full. The RDP thread doesn't see it until rdp_thread_publish
+void rdp_thread_submit(int command_length, const u32* buffer);
+void rdp_thread_publish();
+// Publishes, then waits until the RDP thread has run every command submitted so far
+void rdp_thread_wait_idle();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //N64_RDP_THREAD_H
@@ -1,18 +1,41 @@
 #include <cstdio>
 #include <log.h>
 #include <cstring>
+#include <climits>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 #include <util.h>
 #include <mem/mem_util.h>
+#include <metrics.h>
 #include "softrdp.h"
+#include "softrdp_span.h"
 
 #ifndef INLINE
 #define INLINE static inline __attribute__((always_inline))
 #endif
 
-#define EXEC_RDP_COMMAND(name) rdp_command_##name(rdp, command_length, buffer); break
-#define EXEC_RDP_COMMAND_TEMPLATE(name, tmpl) rdp_command_##name<tmpl>(rdp, command_length, buffer); break
+#define EXEC_RDP_COMMAND(name) rdp_command_##name(rdp, command_length, buffer); rdp->queue->state_dirty = true; break
 #define DEF_RDP_COMMAND(name) INLINE void rdp_command_##name(softrdp_state_t* rdp, int command_length, const uint64_t* buffer)
 
+// Draw commands are split in two: binning runs on the emulation thread when the command is enqueued and finds the scanlines it covers,
+// drawing runs later on any rasterizer thread and only touches the scanlines in [band_start, band_end).
+#define RECORD_RDP_COMMAND(name) rdp_bin_##name(rdp, buffer, &y_start, &y_end); softrdp_record(rdp, command, buffer, y_start, y_end); break
+#define DRAW_RDP_COMMAND(name) rdp_draw_##name(rdp, buffer, band_start, band_end); break
+#define DRAW_RDP_COMMAND_TEMPLATE(name, tmpl) rdp_draw_##name<tmpl>(rdp, buffer, band_start, band_end); break
+#define DEF_RDP_BIN_COMMAND(name) INLINE void rdp_bin_##name(softrdp_state_t* rdp, const uint64_t* buffer, int* y_start, int* y_end)
+#define DEF_RDP_DRAW_COMMAND(name) INLINE void rdp_draw_##name(softrdp_state_t* rdp, const uint64_t* buffer, int band_start, int band_end)
+
+// Scanlines per band is 1 << SOFTRDP_BAND_SHIFT. The last band also takes everything past the bottom of a 1024 line image.
+#define SOFTRDP_BAND_SHIFT 4
+#define SOFTRDP_NUM_BANDS (1024 >> SOFTRDP_BAND_SHIFT)
+// Flush early if a game submits this many draws without a full sync, to keep the snapshots from growing without bound
+#define SOFTRDP_MAX_PENDING_COMMANDS 0x4000
+#define SOFTRDP_MAX_DEFAULT_THREADS 8
+
 const int TEXEL_SIZE_4  = 0;
 const int TEXEL_SIZE_8  = 1;
 const int TEXEL_SIZE_16 = 2;
@@ -290,13 +313,6 @@ INLINE void get_zbuffer_coefficients(const uint64_t* buffer, z_coefficients_t* c
 
     coefficients->dzdy   = get_bits(buffer[1], 31, 16);
     coefficients->dzdy_f = get_bits(buffer[1], 15, 0);
-
-
-    logalways("Z coefficients: z: %d.%d, dzdx: %d.%d, dzde: %d.%d, dzdy: %d.%d",
-              coefficients->z, coefficients->z_f,
-              coefficients->dzdx, coefficients->dzdx_f,
-              coefficients->dzde, coefficients->dzde_f,
-              coefficients->dzdy, coefficients->dzdy_f);
 }
 
 INLINE void triangle_edgewalker(softrdp_state_t* rdp, const edge_coefficients_t* ec, spans_t* spans) {
@@ -326,8 +342,6 @@ INLINE void triangle_edgewalker(softrdp_state_t* rdp, const edge_coefficients_t*
     int ym = ec->ym / 4;
     int yl = ec->yl / 4;
 
-    logalways("Edgewalking triangle yh %d ym %d yl %d", yh, ym, yl);
-
     spans->start_y = yh;
 
     int span_index = 0;
@@ -483,7 +497,9 @@ uint32_t convert_32bpp_to_packed_16bpp(color_32bpp_t color) {
     return ((uint32_t)converted.raw << 16) | converted.raw;
 }
 
-INLINE uint16_t fill_for_addr(softrdp_state_t* rdp, uint32_t addr) {
+// Color written by fill and 1-cycle mode primitives. It's the same for every pixel of a primitive, so it's worked out once
+// and handed to the span kernels. For 16bpp images it holds the color for even columns in the upper half and odd columns in the lower.
+INLINE uint32_t fill_color_for_primitive(softrdp_state_t* rdp) {
     uint32_t color = 0;
     color_32bpp_t blender_color;
     switch (rdp->other_modes.cycle_type) {
@@ -509,15 +525,98 @@ INLINE uint16_t fill_for_addr(softrdp_state_t* rdp, uint32_t addr) {
             color = rdp->fill_color;
             break;
         default:
-            logfatal("fill_for_addr(): unknown cycle type %d", rdp->other_modes.cycle_type);
+            logfatal("fill_color_for_primitive(): unknown cycle type %d", rdp->other_modes.cycle_type);
+    }
+
+    return color;
+}
+
+// Draws are rasterized with a pipeline looked up from the mode words they were recorded with. Pipelines hold span functions
+// instantiated for the modes, so other_modes, the combiner and the blender are interpreted once per combination instead of per
+// primitive. Combinations without a specialization get the generic span functions, which interpret the state as they go.
+
+typedef void (*softrdp_fill_span_fn_t)(softrdp_state_t* rdp, u32 address, u32 bytes);
+
+struct softrdp_pipeline {
+    softrdp_fill_span_fn_t fill_span;
+};
+
+typedef struct softrdp_pipeline_key {
+    uint64_t other_modes;
+    uint64_t combine;
+    uint8_t color_image_size;
+
+    bool operator==(const softrdp_pipeline_key& other) const = default;
+} softrdp_pipeline_key_t;
+
+struct softrdp_pipeline_key_hash {
+    size_t operator()(const softrdp_pipeline_key_t& key) const {
+        uint64_t hash = key.other_modes * 0x9E3779B97F4A7C15ULL;
+        hash ^= (key.combine + key.color_image_size) * 0xC2B2AE3D27D4EB4FULL;
+        return hash ^ (hash >> 32);
+    }
+};
+
+template<int bytes_per_pixel>
+INLINE uint32_t pack_color(color_32bpp_t color) {
+    if constexpr (bytes_per_pixel == 2) {
+        return convert_32bpp_to_packed_16bpp(color);
+    } else {
+        return color.raw;
     }
+}
 
-    // Code below is optimized to remove the conditional.
-    // Essentially, the behavior is to use the upper bits of fill_color if we're on an even column,
-    // and the lower bits if we're on an odd column.
+void fill_span_generic(softrdp_state_t* rdp, u32 address, u32 bytes) {
+    softrdp_fill_span(rdp->rdram, address, bytes, fill_color_for_primitive(rdp));
+}
 
-    // return rdp->fill_color >> (addr % 4 == 0 ? 16 : 0);
-    return color >> (16 - ((addr % 4) * 8));
+// Fill mode writes the fill color as is, whatever the pixel size
+void fill_span_fill_mode(softrdp_state_t* rdp, u32 address, u32 bytes) {
+    softrdp_fill_span(rdp->rdram, address, bytes, rdp->fill_color);
+}
+
+// 1-cycle mode with the blender passing its first color input through
+template<blender_source_t source_1a, int bytes_per_pixel>
+void fill_span_1cycle(softrdp_state_t* rdp, u32 address, u32 bytes) {
+    color_32bpp_t color;
+    if constexpr (source_1a == BLENDER_BLEND_COLOR) {
+        color = rdp->blend_color;
+    } else {
+        // TODO: Output of color combiner
+        color.raw = 0xFFFFFFFF;
+    }
+    softrdp_fill_span(rdp->rdram, address, bytes, pack_color<bytes_per_pixel>(color));
+}
+
+template<int bytes_per_pixel>
+softrdp_fill_span_fn_t select_fill_span(const softrdp_state_t* rdp) {
+    const blender_config_t* config = &rdp->other_modes.blender_config[0];
+    // Only inputs blender() handles without bailing out
+    const bool passthrough = config->source_1b == BLENDER_PIXEL_ALPHA && config->source_2b == BLENDER_ONE_MINUS_ALPHA
+            && (config->source_2a == BLENDER_PIXEL_COLOR || config->source_2a == BLENDER_BLEND_COLOR);
+
+    switch (rdp->other_modes.cycle_type) {
+        case 0:
+            if (passthrough && config->source_1a == BLENDER_BLEND_COLOR) {
+                return fill_span_1cycle<BLENDER_BLEND_COLOR, bytes_per_pixel>;
+            } else if (passthrough && config->source_1a == BLENDER_PIXEL_COLOR) {
+                return fill_span_1cycle<BLENDER_PIXEL_COLOR, bytes_per_pixel>;
+            }
+            break;
+        case 3:
+            return fill_span_fill_mode;
+    }
+    return fill_span_generic;
+}
+
+softrdp_pipeline build_pipeline(const softrdp_state_t* rdp) {
+    softrdp_pipeline pipeline;
+    switch (rdp->color_image.size) {
+        case TEXEL_SIZE_16: pipeline.fill_span = select_fill_span<2>(rdp); break;
+        case TEXEL_SIZE_32: pipeline.fill_span = select_fill_span<4>(rdp); break;
+        default: pipeline.fill_span = fill_span_generic; break;
+    }
+    return pipeline;
 }
 
 INLINE void rdram_write16(softrdp_state_t* rdp, u32 address, u16 value) {
@@ -558,19 +657,25 @@ INLINE void tmem_write16(softrdp_state_t* rdp, u16 address, u16 value) {
     memcpy(&rdp->tmem[HALF_ADDRESS(address)], &value, sizeof(u16));
 }
 
-void softrdp_init(softrdp_state_t* state, uint8_t* rdramptr) {
-    state->rdram = rdramptr;
+DEF_RDP_BIN_COMMAND(fill_triangle) {
+    const auto* ec = reinterpret_cast<const edge_coefficients_t*>(buffer);
+    *y_start = ec->yh / 4;
+    *y_end = ec->yl / 4;
 }
 
-DEF_RDP_COMMAND(fill_triangle) {
+DEF_RDP_DRAW_COMMAND(fill_triangle) {
     const auto* ec = reinterpret_cast<const edge_coefficients_t*>(buffer);
 
-    static spans_t spans;
+    // Not static, every rasterizer thread walks its own copy
+    spans_t spans;
     triangle_edgewalker(rdp, ec, &spans);
 
     int bytes_per_pixel = get_bytes_per_pixel(rdp);
 
-    for (int i = 0; i < spans.num_spans; i++) {
+    int first_span = band_start > spans.start_y ? band_start - spans.start_y : 0;
+    int last_span = band_end - spans.start_y < spans.num_spans ? band_end - spans.start_y : spans.num_spans;
+
+    for (int i = first_span; i < last_span; i++) {
         int y = spans.start_y + i;
         span_t* s = &spans.spans[i];
 
@@ -579,10 +684,7 @@ DEF_RDP_COMMAND(fill_triangle) {
         int x_start = s->start < s->end ? s->start : s->end;
         int x_end = s->end > s->start ? s->end : s->start;
 
-        for (int x = x_start * bytes_per_pixel; x < x_end * bytes_per_pixel; x += 2) {
-            uint32_t addr = yofs + x;
-            rdram_write16(rdp, addr, fill_for_addr(rdp, addr));
-        }
+        rdp->pipeline->fill_span(rdp, yofs + x_start * bytes_per_pixel, (x_end - x_start) * bytes_per_pixel);
     }
 }
 
@@ -665,12 +767,24 @@ INLINE fixed_point_16<11, 5> process_st(fixed_point_16<11, 5> val, bool clamp_en
     return val;
 }
 
-template<bool flip>
-DEF_RDP_COMMAND(texture_rectangle) {
+DEF_RDP_BIN_COMMAND(texture_rectangle) {
     const auto* cmd = reinterpret_cast<const texture_rectangle_t*>(buffer);
     const auto* descriptor = &rdp->tiles[cmd->tile];
     unimplemented(rdp->color_image.size != descriptor->size, "texture rectangle: color image pixel size %d != descriptor pixel size %d", rdp->color_image.size, descriptor->size);
 
+    // TODO Coordinates are in a 10.2 fixed point format, just discard the decimal places
+    int yl = cmd->yl >> 2;
+    int yh = cmd->yh >> 2;
+
+    *y_start = yh;
+    *y_end = yl;
+}
+
+template<bool flip>
+DEF_RDP_DRAW_COMMAND(texture_rectangle) {
+    const auto* cmd = reinterpret_cast<const texture_rectangle_t*>(buffer);
+    const auto* descriptor = &rdp->tiles[cmd->tile];
+
     int tmem_base = descriptor->tmem_adrs * sizeof(u64); // tmem address in descriptor is in multiples of 64 bits
 
     // TODO Coordinates are in a 10.2 fixed point format, just discard the decimal places
@@ -679,9 +793,6 @@ DEF_RDP_COMMAND(texture_rectangle) {
 
     int xh = cmd->xh >> 2;
     int yh = cmd->yh >> 2;
-    logalways("Texture rectangle%s (%d, %d) (%d, %d) with tile %d starting at s,t %d.%d, %d.%d.", flip ? " flip" : "", xh, yh, xl, yl, cmd->tile, cmd->s.integer, cmd->s.frac, cmd->t.integer, cmd->t.frac);
-    logalways("dsdx: %s%d.%d", cmd->dsdx.integer < 0 ? "-" : "", cmd->dsdx.integer, cmd->dsdx.frac);
-    logalways("dtdy: %s%d.%d", cmd->dtdy.integer < 0 ? "-" : "", cmd->dtdy.integer, cmd->dtdy.frac);
 
     const auto orig_s = cmd->s;
     const auto orig_t = cmd->t;
@@ -702,10 +813,36 @@ DEF_RDP_COMMAND(texture_rectangle) {
 
     auto s = orig_s;
     auto t = orig_t;
+
+    // Step T up to the first line in this band one line at a time, each step rounds the same way it does when drawing
+    int y_start = yh > band_start ? yh : band_start;
+    int y_end = yl < band_end ? yl : band_end;
+    for (int y = yh; y < y_start; y++) {
+        t += dtdy;
+    }
+
+    // A copy mode rectangle that steps one texel per pixel without wrapping, clamping or mirroring S copies each line
+    // of TMEM straight into the framebuffer.
+    const bool copy_lines = !flip && rdp->other_modes.cycle_type == 2 && dsdx.raw == (1 << 10) && xl > xh
+            && descriptor->shift_s == 0 && descriptor->mask_s == 0 && !descriptor->cs && !descriptor->ms
+            && orig_s.integer >= 0 && orig_s.integer + (xl - xh) <= 1024;
+
     switch (descriptor->size) {
         case TEXEL_SIZE_16:
-            for (int y = yh; y < yl; y++) {
+            for (int y = y_start; y < y_end; y++) {
                 u32 screen_line = rdp->color_image.dram_addr + y * bytes_per_screen_line;
+                if (copy_lines) {
+                    const auto processed_t = process_st(t, descriptor->ct, descriptor->mt, descriptor->mask_t, descriptor->shift_t);
+                    const u32 tmem_xor = (processed_t.integer & 1) << 2;
+                    const u16 tmem_line = tmem_base + processed_t.integer * bytes_per_tile_line;
+                    const u32 src = tmem_line + orig_s.integer * 2;
+                    const u32 dst = screen_line + xh * bytes_per_pixel;
+                    if (!softrdp_copy_span16(rdp->rdram, dst, rdp->tmem, src, tmem_xor, xl - xh)) {
+                        softrdp_copy_span16_scalar(rdp->rdram, dst, rdp->tmem, src, tmem_xor, xl - xh);
+                    }
+                    t += dtdy;
+                    continue;
+                }
                 for (int x = xh; x < xl; x++) {
                     // TODO: for non-flipped rects, this can go in the body of the outer loop, before this inner loop
                     const auto processed_t = process_st(flip ? s : t, descriptor->ct, descriptor->mt, descriptor->mask_t, descriptor->shift_t);
@@ -726,7 +863,7 @@ DEF_RDP_COMMAND(texture_rectangle) {
             }
             break;
         case TEXEL_SIZE_32:
-            for (int y = yh; y < yl; y++) {
+            for (int y = y_start; y < y_end; y++) {
                 u32 screen_line = rdp->color_image.dram_addr + y * bytes_per_screen_line;
                 for (int x = xh; x < xl; x++) {
                     // TODO: for non-flipped rects, this can go in the body of the outer loop, before this inner loop
@@ -804,6 +941,7 @@ DEF_RDP_COMMAND(set_prim_depth) {
 }
 
 DEF_RDP_COMMAND(set_other_modes) {
+    rdp->other_modes_raw = buffer[0];
     rdp->other_modes.atomic_prim      = get_bit(buffer[0], 55);
     rdp->other_modes.cycle_type       = get_bits(buffer[0], 53, 52);
     rdp->other_modes.persp_tex_en     = get_bit(buffer[0], 51);
@@ -894,8 +1032,6 @@ DEF_RDP_COMMAND(load_block) {
         default:
             logfatal("Load block: unknown texel size: %d", rdp->texture_image.size);
     }
-
-    logalways("Load block: dxt: %d, sh: %d, tile: %d, tl: %d, sl: %d\n", cmd->dxt, cmd->sh, cmd->tile, cmd->tl, cmd->sl);
 }
 
 DEF_RDP_COMMAND(load_tile) {
@@ -920,7 +1056,6 @@ DEF_RDP_COMMAND(load_tile) {
 
     unimplemented(tmem_base != 0, "load_tile not to start of tmem");
 
-    int bytes_copied = 0;
     switch (rdp->texture_image.size) {
         case TEXEL_SIZE_4:
             logfatal("Load tile: texel size 4bpp");
@@ -992,8 +1127,6 @@ DEF_RDP_COMMAND(load_tile) {
         default:
             logfatal("Load tile: Unknown texel size: %d", rdp->texture_image.size);
     }
-
-    logalways("rdp_load_tile: copied %d bytes.", bytes_copied);
 }
 
 DEF_RDP_COMMAND(set_tile) {
@@ -1011,31 +1144,26 @@ DEF_RDP_COMMAND(set_tile) {
     rdp->tiles[tile_index].ms        = get_bit(buffer[0], 8);
     rdp->tiles[tile_index].mask_s    = get_bits(buffer[0], 7, 4);
     rdp->tiles[tile_index].shift_s   = get_bits(buffer[0], 3, 0);
+}
 
-    logalways("Set tile");
-    logalways("format:    %d", rdp->tiles[tile_index].format);
-    logalways("size:      %d", rdp->tiles[tile_index].size);
-    logalways("line:      %d", rdp->tiles[tile_index].line);
-    logalways("tmem_adrs: %d", rdp->tiles[tile_index].tmem_adrs);
-    logalways("palette:   %d", rdp->tiles[tile_index].palette);
-    logalways("ct:        %d", rdp->tiles[tile_index].ct);
-    logalways("mt:        %d", rdp->tiles[tile_index].mt);
-    logalways("mask_t:    %d", rdp->tiles[tile_index].mask_t);
-    logalways("shift_t:   %d", rdp->tiles[tile_index].shift_t);
-    logalways("cs:        %d", rdp->tiles[tile_index].cs);
-    logalways("ms:        %d", rdp->tiles[tile_index].ms);
-    logalways("mask_s:    %d", rdp->tiles[tile_index].mask_s);
-    logalways("shift_s:   %d", rdp->tiles[tile_index].shift_s);
-}
-
-DEF_RDP_COMMAND(fill_rectangle) {
+DEF_RDP_BIN_COMMAND(fill_rectangle) {
     // Coordinates are in a 10.2 fixed point format, just discard the decimal places
+    int yl = get_bits(buffer[0], 43, 32) >> 2;
+    int yh = get_bits(buffer[0], 11, 0) >> 2;
+
+    *y_start = yh;
+    *y_end = yl;
+}
+
+DEF_RDP_DRAW_COMMAND(fill_rectangle) {
     int xl = get_bits(buffer[0], 55, 44) >> 2;
     int yl = get_bits(buffer[0], 43, 32) >> 2;
 
     int xh = get_bits(buffer[0], 23, 12) >> 2;
     int yh = get_bits(buffer[0], 11, 0) >> 2;
-    logalways("Fill rectangle (%d, %d) (%d, %d) with color %08X", xh, yh, xl, yl, rdp->fill_color);
+
+    int y_start = yh > band_start ? yh : band_start;
+    int y_end = yl < band_end ? yl : band_end;
 
     int bytes_per_pixel = get_bytes_per_pixel(rdp);
 
@@ -1044,19 +1172,18 @@ DEF_RDP_COMMAND(fill_rectangle) {
 
     int stride = rdp->color_image.width * bytes_per_pixel;
 
-    for (int y = yh; y < yl; y++) {
+    if (x_end <= x_start) {
+        return;
+    }
+
+    for (int y = y_start; y < y_end; y++) {
         int yofs = y * stride;
-        for (int x = x_start; x < x_end; x += 2) {
-            uint32_t addr = rdp->color_image.dram_addr + yofs + x;
-            rdram_write16(rdp, addr, fill_for_addr(rdp, addr));
-        }
+        rdp->pipeline->fill_span(rdp, rdp->color_image.dram_addr + yofs + x_start, x_end - x_start);
     }
 }
 
 DEF_RDP_COMMAND(set_fill_color) {
     rdp->fill_color = get_bits(buffer[0], 31, 0);
-    logalways("Fill color cmd word: %016" PRIX64, buffer[0]);
-    logalways("Fill color: 0x%08X", rdp->fill_color);
 }
 
 DEF_RDP_COMMAND(set_fog_color) {
@@ -1068,8 +1195,6 @@ DEF_RDP_COMMAND(set_blend_color) {
     rdp->blend_color.g = get_bits(buffer[0], 23, 16);
     rdp->blend_color.b = get_bits(buffer[0], 15, 8);
     rdp->blend_color.a = get_bits(buffer[0], 7, 0);
-
-    logalways("Blend color: #%02X%02X%02X alpha %02X", rdp->blend_color.r, rdp->blend_color.g, rdp->blend_color.b, rdp->blend_color.a);
 }
 
 DEF_RDP_COMMAND(set_prim_color) {
@@ -1081,7 +1206,7 @@ DEF_RDP_COMMAND(set_env_color) {
 }
 
 DEF_RDP_COMMAND(set_combine) {
-    logalways("Set combine: %016" PRIX64, buffer[0]);
+    rdp->combine_raw = buffer[0];
     rdp->combine.sub_a_R_0 = get_bits(buffer[0], 55, 52);
     rdp->combine.mul_R_0   = get_bits(buffer[0], 51, 47);
     rdp->combine.sub_a_A_0 = get_bits(buffer[0], 46, 44);
@@ -1106,32 +1231,215 @@ DEF_RDP_COMMAND(set_texture_image) {
 
     rdp->texture_image.width     = get_bits(buffer[0], 41, 32) + 1;
     rdp->texture_image.dram_addr = get_bits(buffer[0], 25, 0);
-    logalways("Set texture image:");
-    logalways("format: %d", rdp->texture_image.format);
-    logalways("size: %d", rdp->texture_image.size);
-
-    logalways("width: %d", rdp->texture_image.width);
-    logalways("dram_addr: %08X", rdp->texture_image.dram_addr);
 }
 
 DEF_RDP_COMMAND(set_mask_image) {
     rdp->z_image = get_bits(buffer[0], 25, 0);
-    logalways("Setting Zbuffer image to 0x%08X", rdp->z_image);
 }
 
 DEF_RDP_COMMAND(set_color_image) {
-    logalways("Set color image %016" PRIX64 ":", buffer[0]);
     rdp->color_image.format    = get_bits(buffer[0], 55, 53);
     rdp->color_image.size      = get_bits(buffer[0], 52, 51);
     rdp->color_image.width     = get_bits(buffer[0], 41, 32) + 1;
     rdp->color_image.dram_addr = get_bits(buffer[0], 25, 0);
-    logalways("Format: %d", rdp->color_image.format);
-    logalways("Size: %d",   rdp->color_image.size);
-    logalways("Width: %d",  rdp->color_image.width);
-    logalways("DRAM addr: 0x%08X", rdp->color_image.dram_addr);
 }
 
 
+typedef struct softrdp_recorded_command {
+    rdp_command_t command;
+    // Index of the state the command was recorded with in softrdp_queue::snapshots
+    u32 snapshot;
+    // The longest command that's recorded is a fill triangle
+    uint64_t buffer[4];
+} softrdp_recorded_command_t;
+
+struct softrdp_queue {
+    // Copy of the RDP state as of each recorded draw. A new one is only taken when a command changed the state since the last draw.
+    std::vector<softrdp_state_t> snapshots;
+    bool state_dirty = true;
+
+    // Pipelines are only looked up and built on the emulation thread, and never removed, so the rasterizer threads can
+    // hold pointers to them
+    std::unordered_map<softrdp_pipeline_key_t, softrdp_pipeline, softrdp_pipeline_key_hash> pipelines;
+
+    std::vector<softrdp_recorded_command_t> commands;
+    // Indices into commands of every draw that touches each band, in submission order
+    std::vector<u32> bins[SOFTRDP_NUM_BANDS];
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable work_done;
+    u64 generation = 0;
+    int workers_busy = 0;
+    bool shutting_down = false;
+    std::atomic<int> next_band {0};
+};
+
+const softrdp_pipeline* softrdp_lookup_pipeline(softrdp_queue* queue, const softrdp_state_t* rdp) {
+    const softrdp_pipeline_key_t key = { rdp->other_modes_raw, rdp->combine_raw, rdp->color_image.size };
+    auto it = queue->pipelines.find(key);
+    if (it != queue->pipelines.end()) {
+        mark_metric(METRIC_SOFTRDP_PIPELINE_HIT);
+        return &it->second;
+    }
+    mark_metric(METRIC_SOFTRDP_PIPELINE_MISS);
+    return &queue->pipelines.emplace(key, build_pipeline(rdp)).first->second;
+}
+
+void softrdp_record(softrdp_state_t* rdp, rdp_command_t command, const uint64_t* buffer, int y_start, int y_end) {
+    softrdp_queue* queue = rdp->queue;
+    if (y_end <= y_start) {
+        return;
+    }
+
+    if (queue->state_dirty) {
+        queue->snapshots.push_back(*rdp);
+        queue->snapshots.back().pipeline = softrdp_lookup_pipeline(queue, rdp);
+        queue->state_dirty = false;
+    }
+
+    softrdp_recorded_command_t recorded;
+    recorded.command = command;
+    recorded.snapshot = queue->snapshots.size() - 1;
+    memcpy(recorded.buffer, buffer, sizeof(recorded.buffer));
+
+    u32 index = queue->commands.size();
+    queue->commands.push_back(recorded);
+
+    int first_band = y_start >> SOFTRDP_BAND_SHIFT;
+    int last_band = (y_end - 1) >> SOFTRDP_BAND_SHIFT;
+    if (first_band >= SOFTRDP_NUM_BANDS) first_band = SOFTRDP_NUM_BANDS - 1;
+    if (last_band >= SOFTRDP_NUM_BANDS) last_band = SOFTRDP_NUM_BANDS - 1;
+
+    for (int band = first_band; band <= last_band; band++) {
+        queue->bins[band].push_back(index);
+    }
+}
+
+void softrdp_rasterize_band(softrdp_queue* queue, int band) {
+    const int band_start = band << SOFTRDP_BAND_SHIFT;
+    const int band_end = band == SOFTRDP_NUM_BANDS - 1 ? INT_MAX : (band + 1) << SOFTRDP_BAND_SHIFT;
+
+    for (u32 index : queue->bins[band]) {
+        const softrdp_recorded_command_t* recorded = &queue->commands[index];
+        softrdp_state_t* rdp = &queue->snapshots[recorded->snapshot];
+        const uint64_t* buffer = recorded->buffer;
+        switch (recorded->command) {
+            case RDP_COMMAND_FILL_TRIANGLE:          DRAW_RDP_COMMAND(fill_triangle);
+            case RDP_COMMAND_TEXTURE_RECTANGLE:      DRAW_RDP_COMMAND_TEMPLATE(texture_rectangle, false);
+            case RDP_COMMAND_TEXTURE_RECTANGLE_FLIP: DRAW_RDP_COMMAND_TEMPLATE(texture_rectangle, true);
+            case RDP_COMMAND_FILL_RECTANGLE:         DRAW_RDP_COMMAND(fill_rectangle);
+            default: logfatal("Recorded a command that can't be drawn: %02X", recorded->command);
+        }
+    }
+}
+
+// Bands are handed out one at a time, so a thread that gets the busy part of the screen doesn't hold everyone else up
+void softrdp_rasterize_bands(softrdp_queue* queue) {
+    int band;
+    while ((band = queue->next_band.fetch_add(1, std::memory_order_relaxed)) < SOFTRDP_NUM_BANDS) {
+        if (!queue->bins[band].empty()) {
+            softrdp_rasterize_band(queue, band);
+        }
+    }
+}
+
+void softrdp_worker(softrdp_queue* queue) {
+    u64 seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queue->mutex);
+            queue->work_available.wait(lock, [&] { return queue->shutting_down || queue->generation != seen_generation; });
+            if (queue->shutting_down) {
+                return;
+            }
+            seen_generation = queue->generation;
+        }
+
+        softrdp_rasterize_bands(queue);
+
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (--queue->workers_busy == 0) {
+            queue->work_done.notify_one();
+        }
+    }
+}
+
+// Rasterize everything recorded so far and wait for it to land in RDRAM. The emulation thread rasterizes alongside the workers.
+void softrdp_flush(softrdp_state_t* rdp) {
+    softrdp_queue* queue = rdp->queue;
+    if (queue->commands.empty()) {
+        return;
+    }
+
+    queue->next_band = 0;
+    if (queue->workers.empty()) {
+        softrdp_rasterize_bands(queue);
+    } else {
+        {
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            queue->workers_busy = queue->workers.size();
+            queue->generation++;
+        }
+        queue->work_available.notify_all();
+
+        softrdp_rasterize_bands(queue);
+
+        std::unique_lock<std::mutex> lock(queue->mutex);
+        queue->work_done.wait(lock, [&] { return queue->workers_busy == 0; });
+    }
+
+    queue->commands.clear();
+    queue->snapshots.clear();
+    queue->state_dirty = true;
+    for (auto& bin : queue->bins) {
+        bin.clear();
+    }
+}
+
+void softrdp_stop_workers(softrdp_queue* queue) {
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->shutting_down = true;
+    }
+    queue->work_available.notify_all();
+    for (auto& worker : queue->workers) {
+        worker.join();
+    }
+    queue->workers.clear();
+    queue->shutting_down = false;
+}
+
+void softrdp_set_threads(softrdp_state_t* state, int threads) {
+    softrdp_queue* queue = state->queue;
+    softrdp_flush(state);
+    softrdp_stop_workers(queue);
+
+    queue->generation = 0;
+    for (int i = 1; i < threads; i++) {
+        queue->workers.emplace_back(softrdp_worker, queue);
+    }
+    logalways("Software RDP rasterizing on %d thread%s", threads > 1 ? threads : 1, threads > 1 ? "s" : "");
+}
+
+void softrdp_init(softrdp_state_t* state, uint8_t* rdramptr) {
+    state->rdram = rdramptr;
+    if (state->queue == nullptr) {
+        state->queue = new softrdp_queue;
+    }
+
+    int threads = std::thread::hardware_concurrency();
+    if (threads > SOFTRDP_MAX_DEFAULT_THREADS) {
+        threads = SOFTRDP_MAX_DEFAULT_THREADS;
+    }
+    softrdp_set_threads(state, threads);
+}
+
+void softrdp_full_sync(softrdp_state_t* rdp) {
+    softrdp_flush(rdp);
+}
+
 void softrdp_enqueue_command(softrdp_state_t* rdp, int command_length, uint64_t* buffer) {
     for (int i = 0; i < (command_length >> 1); i++) {
         uint64_t lo = (buffer[i] >>  0) & 0xFFFFFFFF;
@@ -1141,8 +1449,16 @@ void softrdp_enqueue_command(softrdp_state_t* rdp, int command_length, uint64_t*
 
     auto command = static_cast<rdp_command_t>(get_bits(buffer[0], 61, 56));
 
+    if (rdp->queue->commands.size() >= SOFTRDP_MAX_PENDING_COMMANDS) {
+        softrdp_flush(rdp);
+    }
+
+    // Draws are recorded and rasterized at the next flush, everything else changes the state right away.
+    // Loads read RDRAM the pending draws may still write to, and pending draws to the old color image could overlap rows
+    // of the new one that belong to another band, so both flush first.
+    int y_start, y_end;
     switch (command) {
-        case RDP_COMMAND_FILL_TRIANGLE:                  EXEC_RDP_COMMAND(fill_triangle);
+        case RDP_COMMAND_FILL_TRIANGLE:                  RECORD_RDP_COMMAND(fill_triangle);
         case RDP_COMMAND_FILL_ZBUFFER_TRIANGLE:          EXEC_RDP_COMMAND(fill_zbuffer_triangle);
         case RDP_COMMAND_TEXTURE_TRIANGLE:               EXEC_RDP_COMMAND(texture_triangle);
         case RDP_COMMAND_TEXTURE_ZBUFFER_TRIANGLE:       EXEC_RDP_COMMAND(texture_zbuffer_triangle);
@@ -1150,8 +1466,8 @@ void softrdp_enqueue_command(softrdp_state_t* rdp, int command_length, uint64_t*
         case RDP_COMMAND_SHADE_ZBUFFER_TRIANGLE:         EXEC_RDP_COMMAND(shade_zbuffer_triangle);
         case RDP_COMMAND_SHADE_TEXTURE_TRIANGLE:         EXEC_RDP_COMMAND(shade_texture_triangle);
         case RDP_COMMAND_SHADE_TEXTURE_ZBUFFER_TRIANGLE: EXEC_RDP_COMMAND(shade_texture_zbuffer_triangle);
-        case RDP_COMMAND_TEXTURE_RECTANGLE:              EXEC_RDP_COMMAND_TEMPLATE(texture_rectangle, false);
-        case RDP_COMMAND_TEXTURE_RECTANGLE_FLIP:         EXEC_RDP_COMMAND_TEMPLATE(texture_rectangle, true);
+        case RDP_COMMAND_TEXTURE_RECTANGLE:              RECORD_RDP_COMMAND(texture_rectangle);
+        case RDP_COMMAND_TEXTURE_RECTANGLE_FLIP:         RECORD_RDP_COMMAND(texture_rectangle);
         case RDP_COMMAND_SYNC_LOAD:                      EXEC_RDP_COMMAND(sync_load);
         case RDP_COMMAND_SYNC_PIPE:                      EXEC_RDP_COMMAND(sync_pipe);
         case RDP_COMMAND_SYNC_TILE:                      EXEC_RDP_COMMAND(sync_tile);
@@ -1162,12 +1478,12 @@ void softrdp_enqueue_command(softrdp_state_t* rdp, int command_length, uint64_t*
         case RDP_COMMAND_SET_SCISSOR:                    EXEC_RDP_COMMAND(set_scissor);
         case RDP_COMMAND_SET_PRIM_DEPTH:                 EXEC_RDP_COMMAND(set_prim_depth);
         case RDP_COMMAND_SET_OTHER_MODES:                EXEC_RDP_COMMAND(set_other_modes);
-        case RDP_COMMAND_LOAD_TLUT:                      EXEC_RDP_COMMAND(load_tlut);
+        case RDP_COMMAND_LOAD_TLUT:    softrdp_flush(rdp); EXEC_RDP_COMMAND(load_tlut);
         case RDP_COMMAND_SET_TILE_SIZE:                  EXEC_RDP_COMMAND(set_tile_size);
-        case RDP_COMMAND_LOAD_BLOCK:                     EXEC_RDP_COMMAND(load_block);
-        case RDP_COMMAND_LOAD_TILE:                      EXEC_RDP_COMMAND(load_tile);
+        case RDP_COMMAND_LOAD_BLOCK:   softrdp_flush(rdp); EXEC_RDP_COMMAND(load_block);
+        case RDP_COMMAND_LOAD_TILE:    softrdp_flush(rdp); EXEC_RDP_COMMAND(load_tile);
         case RDP_COMMAND_SET_TILE:                       EXEC_RDP_COMMAND(set_tile);
-        case RDP_COMMAND_FILL_RECTANGLE:                 EXEC_RDP_COMMAND(fill_rectangle);
+        case RDP_COMMAND_FILL_RECTANGLE:                 RECORD_RDP_COMMAND(fill_rectangle);
         case RDP_COMMAND_SET_FILL_COLOR:                 EXEC_RDP_COMMAND(set_fill_color);
         case RDP_COMMAND_SET_FOG_COLOR:                  EXEC_RDP_COMMAND(set_fog_color);
         case RDP_COMMAND_SET_BLEND_COLOR:                EXEC_RDP_COMMAND(set_blend_color);
@@ -1176,7 +1492,7 @@ void softrdp_enqueue_command(softrdp_state_t* rdp, int command_length, uint64_t*
         case RDP_COMMAND_SET_COMBINE:                    EXEC_RDP_COMMAND(set_combine);
         case RDP_COMMAND_SET_TEXTURE_IMAGE:              EXEC_RDP_COMMAND(set_texture_image);
         case RDP_COMMAND_SET_MASK_IMAGE:                 EXEC_RDP_COMMAND(set_mask_image);
-        case RDP_COMMAND_SET_COLOR_IMAGE:                EXEC_RDP_COMMAND(set_color_image);
+        case RDP_COMMAND_SET_COLOR_IMAGE: softrdp_flush(rdp); EXEC_RDP_COMMAND(set_color_image);
 
         default: logfatal("Unknown RDP command: %02X", command);
     }
@@ -67,8 +67,14 @@ typedef union color_16bpp {
     } PACKED;
 } color_16bpp_t;
 
+// Draw commands recorded since the last flush and the threads that rasterize them, defined in softrdp.cpp
+struct softrdp_queue;
+// Span functions specialized for one combination of modes, defined in softrdp.cpp
+struct softrdp_pipeline;
+
 typedef struct softrdp_state {
     uint8_t* rdram;
+    struct softrdp_queue* queue;
 
     struct {
         uint16_t xl;
@@ -135,6 +141,9 @@ typedef struct softrdp_state {
         bool dither_alpha_en;
         bool alpha_compare_en;
     } other_modes;
+    // Command words other_modes and combine were decoded from, used to look up the pipeline
+    uint64_t other_modes_raw;
+    uint64_t combine_raw;
 
     struct {
         uint8_t sub_a_R_0;
@@ -160,11 +169,17 @@ typedef struct softrdp_state {
     u8 tmem[0x1000];
 
     uint32_t z_image;
+
+    // Only set in the snapshots draws are recorded with
+    const struct softrdp_pipeline* pipeline;
 } softrdp_state_t;
 
 void softrdp_init(softrdp_state_t* state, uint8_t* rdramptr);
-#define full_sync_softrdp() do {} while(0)
+// Number of threads rasterizing, including the emulation thread. 1 rasterizes everything on the emulation thread.
+void softrdp_set_threads(softrdp_state_t* state, int threads);
 void softrdp_enqueue_command(softrdp_state_t* rdp, int command_length, uint64_t* buffer);
+// Waits until every recorded command has been written to RDRAM
+void softrdp_full_sync(softrdp_state_t* rdp);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,162 @@
+#ifndef N64_SOFTRDP_SPAN_H
+#define N64_SOFTRDP_SPAN_H
+
+// Span kernels for the software RDP.
+// RDRAM and TMEM are both stored as host endian 32 bit words, so a run of 16 bit pixels is a run of whole host words, apart
+// from a halfword at either end when the span isn't word aligned. The kernels write the words directly, 16 or 32 bytes at a time.
+// Each one has a scalar version that writes a halfword at a time, used for checking and benchmarking them.
+
+#include <string.h>
+#include <stdbool.h>
+#include <util.h>
+#include <mem/mem_util.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(N64_HAVE_SSE)
+#include <emmintrin.h>
+#elif defined(N64_USE_NEON)
+#include <arm_neon.h>
+#else
+typedef u32 softrdp_span_vec_t __attribute__((__vector_size__(16)));
+#endif
+
+#define SOFTRDP_TMEM_LOW_HALF_MASK 0x7FF
+
+INLINE void softrdp_write_half(u8* mem, u32 address, u16 value) {
+    memcpy(&mem[HALF_ADDRESS(address)], &value, sizeof(u16));
+}
+
+INLINE u16 softrdp_read_half(const u8* mem, u32 address) {
+    u16 value;
+    memcpy(&value, &mem[HALF_ADDRESS(address)], sizeof(u16));
+    return value;
+}
+
+// Fill [address, address + bytes) with a 32 bit pattern, a halfword at a time. Even columns (word aligned halfwords) get
+// the upper half of the pattern and odd columns the lower half, the same way the RDP writes the fill color.
+INLINE void softrdp_fill_span_scalar(u8* rdram, u32 address, u32 bytes, u32 pattern) {
+    for (u32 end = address + bytes; address < end; address += 2) {
+        softrdp_write_half(rdram, address, pattern >> (16 - ((address % 4) * 8)));
+    }
+}
+
+INLINE void softrdp_fill_span(u8* rdram, u32 address, u32 bytes, u32 pattern) {
+    const u32 end = address + bytes;
+    if ((address & 2) && address < end) {
+        softrdp_write_half(rdram, address, pattern & 0xFFFF);
+        address += 2;
+    }
+
+    // The pattern as a host word is already in RDRAM's layout
+    u8* dst = &rdram[WORD_ADDRESS(address)];
+    u32 words = (end - address) >> 2;
+    address += words << 2;
+
+#if defined(__AVX2__)
+    const __m256i pattern_256 = _mm256_set1_epi32((s32)pattern);
+    for (; words >= 8; words -= 8, dst += 32) {
+        _mm256_storeu_si256((__m256i*)dst, pattern_256);
+    }
+#endif
+
+#if defined(N64_HAVE_SSE)
+    const __m128i pattern_128 = _mm_set1_epi32((s32)pattern);
+    for (; words >= 4; words -= 4, dst += 16) {
+        _mm_storeu_si128((__m128i*)dst, pattern_128);
+    }
+#elif defined(N64_USE_NEON)
+    const uint32x4_t pattern_128 = vdupq_n_u32(pattern);
+    for (; words >= 4; words -= 4, dst += 16) {
+        vst1q_u8(dst, vreinterpretq_u8_u32(pattern_128));
+    }
+#else
+    const softrdp_span_vec_t pattern_128 = { pattern, pattern, pattern, pattern };
+    for (; words >= 4; words -= 4, dst += 16) {
+        memcpy(dst, &pattern_128, sizeof(pattern_128));
+    }
+#endif
+
+    for (; words > 0; words--, dst += 4) {
+        memcpy(dst, &pattern, sizeof(u32));
+    }
+
+    if (address < end) {
+        softrdp_write_half(rdram, address, pattern >> 16);
+    }
+}
+
+// Copy 16 bit texels from the low half of TMEM to RDRAM, a texel at a time.
+// src is the TMEM address of the first texel and tmem_xor the swizzle of the line it's on (4 on odd lines, 0 on even lines).
+INLINE void softrdp_copy_span16_scalar(u8* rdram, u32 dst, const u8* tmem, u32 src, u32 tmem_xor, int texels) {
+    for (int i = 0; i < texels; i++) {
+        u16 texel = softrdp_read_half(tmem, ((src + i * 2) & SOFTRDP_TMEM_LOW_HALF_MASK) ^ tmem_xor);
+        softrdp_write_half(rdram, dst + i * 2, texel);
+    }
+}
+
+// Same as softrdp_copy_span16_scalar, but copies whole words. Returns false without writing anything if the span can't be
+// copied that way, and the caller needs to fall back to the scalar version.
+INLINE bool softrdp_copy_span16(u8* rdram, u32 dst, const u8* tmem, u32 src, u32 tmem_xor, int texels) {
+    src &= SOFTRDP_TMEM_LOW_HALF_MASK;
+    // Texels only sit at the same position within a host word in TMEM and RDRAM if the addresses agree mod 4.
+    // Odd lines also swap the words of each dword, so there they have to agree mod 8.
+    const u32 chunk = tmem_xor ? 8 : 4;
+    if (((src ^ dst) & (chunk - 1)) != 0 || src + texels * 2 > SOFTRDP_TMEM_LOW_HALF_MASK + 1) {
+        return false;
+    }
+
+    int head = ((chunk - (dst & (chunk - 1))) & (chunk - 1)) >> 1;
+    if (head > texels) {
+        head = texels;
+    }
+    softrdp_copy_span16_scalar(rdram, dst, tmem, src, tmem_xor, head);
+    dst += head * 2;
+    src += head * 2;
+    texels -= head;
+
+    u8* out = &rdram[WORD_ADDRESS(dst)];
+    const u8* in = &tmem[src];
+    int chunks = (texels * 2) / chunk;
+    int bytes = chunks * chunk;
+
+    if (tmem_xor) {
+        int i = 0;
+#if defined(N64_HAVE_SSE)
+        for (; i + 16 <= bytes; i += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i*)&in[i]);
+            _mm_storeu_si128((__m128i*)&out[i], _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+#elif defined(N64_USE_NEON)
+        for (; i + 16 <= bytes; i += 16) {
+            uint32x4_t v = vreinterpretq_u32_u8(vld1q_u8(&in[i]));
+            vst1q_u8(&out[i], vreinterpretq_u8_u32(vrev64q_u32(v)));
+        }
+#endif
+        for (; i < bytes; i += 8) {
+            memcpy(&out[i], &in[i + 4], sizeof(u32));
+            memcpy(&out[i + 4], &in[i], sizeof(u32));
+        }
+    } else {
+        int i = 0;
+#if defined(N64_HAVE_SSE)
+        for (; i + 16 <= bytes; i += 16) {
+            _mm_storeu_si128((__m128i*)&out[i], _mm_loadu_si128((const __m128i*)&in[i]));
+        }
+#elif defined(N64_USE_NEON)
+        for (; i + 16 <= bytes; i += 16) {
+            vst1q_u8(&out[i], vld1q_u8(&in[i]));
+        }
+#endif
+        memcpy(&out[i], &in[i], bytes - i);
+    }
+
+    dst += bytes;
+    src += bytes;
+    texels -= bytes >> 1;
+    softrdp_copy_span16_scalar(rdram, dst, tmem, src, tmem_xor, texels);
+    return true;
+}
+
+#endif //N64_SOFTRDP_SPAN_H
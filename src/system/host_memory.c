@@ -0,0 +1,303 @@
+#ifdef __linux__
+// memfd_create
+#define _GNU_SOURCE
+#endif
+#include "host_memory.h"
+#include <log.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef N64_WIN
+#include <errno.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#include <windows.h>
+#include <memoryapi.h>
+#endif
+
+#define MAX_REGIONS 8
+
+typedef struct mapped_region {
+    host_memory_region_t region;
+    // Rounded up to a whole number of pages
+    size_t mapped_size;
+    // Second mapping of code regions, NULL if there isn't one
+    u8* writable;
+} mapped_region_t;
+
+static mapped_region_t regions[MAX_REGIONS];
+static int num_regions = 0;
+
+INLINE size_t round_up(size_t size, size_t alignment) {
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+#ifdef N64_WIN
+static u8* map_region(size_t size, bool executable, n64_huge_pages_t huge_pages, const char** backing) {
+    // Large pages on Windows need SeLockMemoryPrivilege, which nobody runs an emulator with
+    *backing = "normal pages";
+    return VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE, executable ? PAGE_EXECUTE_READWRITE : PAGE_READWRITE);
+}
+#else
+#ifdef __linux__
+// Transparent huge pages only go in 2 MiB aligned ranges, so this reserves extra and maps into an aligned part of it.
+// Anonymous memory if fd is -1.
+static u8* map_aligned(size_t size, int prot, int fd) {
+    u8* reservation = mmap(NULL, size + HUGE_PAGE_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (reservation == MAP_FAILED) {
+        return NULL;
+    }
+    u8* base = (u8*)round_up((uintptr_t)reservation, HUGE_PAGE_SIZE);
+    if (base != reservation) {
+        munmap(reservation, base - reservation);
+    }
+    munmap(base + size, (reservation + size + HUGE_PAGE_SIZE) - (base + size));
+
+    int flags = MAP_FIXED | (fd < 0 ? MAP_PRIVATE | MAP_ANONYMOUS : MAP_SHARED);
+    if (mmap(base, size, prot, flags, fd, 0) == MAP_FAILED) {
+        munmap(base, size);
+        return NULL;
+    }
+    return base;
+}
+
+static const char* madvise_huge_pages(u8* base, size_t size) {
+    if (madvise(base, size, MADV_HUGEPAGE) == 0) {
+        return "transparent huge pages";
+    }
+    logwarn("madvise(MADV_HUGEPAGE) failed: %s", strerror(errno));
+    return "normal pages";
+}
+
+// Maps a memfd once read/execute and once read/write
+static bool map_code_views(int fd, size_t size, bool aligned, u8** code, u8** writable) {
+    if (ftruncate(fd, size) != 0) {
+        return false;
+    }
+    if (aligned) {
+        *code = map_aligned(size, PROT_READ | PROT_EXEC, fd);
+        *writable = *code == NULL ? NULL : map_aligned(size, PROT_READ | PROT_WRITE, fd);
+    } else {
+        *code = mmap(NULL, size, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+        *code = *code == MAP_FAILED ? NULL : *code;
+        *writable = *code == NULL ? NULL : mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        *writable = *writable == MAP_FAILED ? NULL : *writable;
+    }
+    if (*code != NULL && *writable == NULL) {
+        munmap(*code, size);
+        *code = NULL;
+    }
+    return *code != NULL;
+}
+
+static u8* map_code_region(const char* name, size_t size, n64_huge_pages_t huge_pages, u8** writable, const char** backing) {
+    u8* code;
+    if (huge_pages == HUGE_PAGES_AUTO) {
+        int fd = memfd_create(name, MFD_CLOEXEC | MFD_HUGETLB);
+        // Both views stay valid after the fd is closed
+        bool mapped = fd >= 0 && map_code_views(fd, size, false, &code, writable);
+        if (fd >= 0) {
+            close(fd);
+        }
+        if (mapped) {
+            *backing = "hugetlbfs";
+            return code;
+        }
+        logdebug("No reserved huge pages for %s, falling back to transparent huge pages", name);
+    }
+
+    int fd = memfd_create(name, MFD_CLOEXEC);
+    if (fd < 0) {
+        logwarn("memfd_create failed (%s), %s will be mapped writable and executable at once", strerror(errno), name);
+        return NULL;
+    }
+    bool mapped = map_code_views(fd, size, huge_pages != HUGE_PAGES_OFF, &code, writable);
+    close(fd);
+    if (!mapped) {
+        logwarn("Failed to map %s twice, it will be mapped writable and executable at once", name);
+        return NULL;
+    }
+    if (huge_pages != HUGE_PAGES_OFF) {
+        // Shared memory only gets transparent huge pages if /sys/kernel/mm/transparent_hugepage/shmem_enabled allows it
+        *backing = madvise_huge_pages(code, size);
+        madvise_huge_pages(*writable, size);
+    } else {
+        *backing = "normal pages";
+    }
+    return code;
+}
+#endif
+
+static u8* map_region(size_t size, bool executable, n64_huge_pages_t huge_pages, const char** backing) {
+    int prot = PROT_READ | PROT_WRITE | (executable ? PROT_EXEC : 0);
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef __APPLE__
+    if (executable) {
+        flags |= MAP_JIT;
+    }
+#endif
+
+#ifdef __linux__
+    if (huge_pages == HUGE_PAGES_AUTO) {
+        u8* base = mmap(NULL, size, prot, flags | MAP_HUGETLB, -1, 0);
+        if (base != MAP_FAILED) {
+            *backing = "hugetlbfs";
+            return base;
+        }
+        logdebug("MAP_HUGETLB failed (%s), falling back to transparent huge pages", strerror(errno));
+    }
+
+    if (huge_pages != HUGE_PAGES_OFF) {
+        u8* base = map_aligned(size, prot, -1);
+        if (base == NULL) {
+            return NULL;
+        }
+        *backing = madvise_huge_pages(base, size);
+        return base;
+    }
+#endif
+
+    *backing = "normal pages";
+    u8* base = mmap(NULL, size, prot, flags, -1, 0);
+    return base == MAP_FAILED ? NULL : base;
+}
+#endif
+
+static void add_region(const char* name, u8* base, u8* writable, size_t size, size_t mapped_size, const char* backing) {
+    mapped_region_t* mapped = &regions[num_regions++];
+    mapped->region.name = name;
+    mapped->region.base = base;
+    mapped->region.size = size;
+    mapped->region.backing = backing;
+    mapped->mapped_size = mapped_size;
+    mapped->writable = writable;
+}
+
+INLINE size_t mapped_size_for(size_t size, n64_huge_pages_t huge_pages) {
+    return round_up(size, huge_pages == HUGE_PAGES_OFF ? 4096 : HUGE_PAGE_SIZE);
+}
+
+u8* host_alloc(const char* name, size_t size, bool executable, n64_huge_pages_t huge_pages) {
+    if (num_regions == MAX_REGIONS) {
+        logfatal("Too many host memory regions, raise MAX_REGIONS");
+    }
+    size_t mapped_size = mapped_size_for(size, huge_pages);
+    const char* backing;
+    u8* base = map_region(mapped_size, executable, huge_pages, &backing);
+    if (base == NULL) {
+        logfatal("Failed to allocate %zu bytes for %s", mapped_size, name);
+    }
+    add_region(name, base, NULL, size, mapped_size, backing);
+    return base;
+}
+
+u8* host_alloc_code(const char* name, size_t size, n64_huge_pages_t huge_pages, u8** writable) {
+#ifdef __linux__
+    if (num_regions == MAX_REGIONS) {
+        logfatal("Too many host memory regions, raise MAX_REGIONS");
+    }
+    size_t mapped_size = mapped_size_for(size, huge_pages);
+    const char* backing;
+    u8* dual_mapped = map_code_region(name, mapped_size, huge_pages, writable, &backing);
+    if (dual_mapped != NULL) {
+        add_region(name, dual_mapped, *writable, size, mapped_size, backing);
+        return dual_mapped;
+    }
+#endif
+    // macOS has MAP_JIT and toggles write protection per thread instead
+    u8* code = host_alloc(name, size, true, huge_pages);
+    *writable = code;
+    return code;
+}
+
+void host_free(u8* base) {
+    for (int i = 0; i < num_regions; i++) {
+        if (regions[i].region.base == base) {
+#ifdef N64_WIN
+            VirtualFree(base, 0, MEM_RELEASE);
+#else
+            munmap(base, regions[i].mapped_size);
+            if (regions[i].writable != NULL) {
+                munmap(regions[i].writable, regions[i].mapped_size);
+            }
+#endif
+            regions[i] = regions[--num_regions];
+            return;
+        }
+    }
+    logfatal("host_free of %p, which isn't a host memory region", base);
+}
+
+#ifdef __linux__
+static void add_huge_bytes(host_memory_usage_t* usage, int count, uintptr_t start, uintptr_t end, size_t bytes, size_t page_size) {
+    for (int i = 0; i < count; i++) {
+        uintptr_t region_start = (uintptr_t)usage[i].region.base;
+        uintptr_t region_end = region_start + usage[i].region.size;
+        if (start >= region_end || end <= region_start) {
+            continue;
+        }
+        if (bytes == 0) {
+            // All of the overlap
+            uintptr_t overlap_start = start > region_start ? start : region_start;
+            uintptr_t overlap_end = end < region_end ? end : region_end;
+            usage[i].huge_bytes += overlap_end - overlap_start;
+        } else {
+            usage[i].huge_bytes += bytes;
+        }
+        usage[i].page_size = page_size > usage[i].page_size ? page_size : usage[i].page_size;
+    }
+}
+
+// Adds up the huge pages in every mapping that overlaps each region. The kernel can merge neighbouring regions with the
+// same flags into one mapping, then they each get its whole count.
+static void read_smaps(host_memory_usage_t* usage, int count) {
+    FILE* f = fopen("/proc/self/smaps", "r");
+    if (f == NULL) {
+        return;
+    }
+    char line[512];
+    uintptr_t start = 0, end = 0;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        uintptr_t new_start, new_end;
+        size_t kb;
+        if (sscanf(line, "%" SCNxPTR "-%" SCNxPTR " ", &new_start, &new_end) == 2) {
+            start = new_start;
+            end = new_end;
+        } else if (sscanf(line, "KernelPageSize: %zu kB", &kb) == 1) {
+            // hugetlbfs, all of it's huge pages
+            if (kb > 4) {
+                add_huge_bytes(usage, count, start, end, 0, kb * 1024);
+            }
+        } else if (sscanf(line, "AnonHugePages: %zu kB", &kb) == 1 || sscanf(line, "ShmemPmdMapped: %zu kB", &kb) == 1) {
+            if (kb > 0) {
+                add_huge_bytes(usage, count, start, end, kb * 1024, HUGE_PAGE_SIZE);
+            }
+        }
+    }
+    fclose(f);
+}
+#endif
+
+int host_memory_usage(host_memory_usage_t* usage, int max_regions) {
+    int count = num_regions < max_regions ? num_regions : max_regions;
+    for (int i = 0; i < count; i++) {
+        usage[i].region = regions[i].region;
+        usage[i].page_size = 4096;
+        usage[i].huge_bytes = 0;
+    }
+#ifdef __linux__
+    read_smaps(usage, count);
+#endif
+    return count;
+}
+
+void host_memory_report() {
+    host_memory_usage_t usage[MAX_REGIONS];
+    int count = host_memory_usage(usage, MAX_REGIONS);
+    for (int i = 0; i < count; i++) {
+        loginfo("%s: %zu KiB with %s, %zu KiB in huge pages, largest page %zu KiB",
+                  usage[i].region.name, usage[i].region.size / 1024, usage[i].region.backing,
+                  usage[i].huge_bytes / 1024, usage[i].page_size / 1024);
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef N64_HOST_MEMORY_H
+#define N64_HOST_MEMORY_H
+
+// Allocates the big, hot regions (the system state with RDRAM in it, the CPU state with its TLB cache, the code caches and
+// the JIT's metadata) so they can be backed by 2 MiB pages. Guest loads all over RDRAM and JIT code jumping all over 32 MiB
+// of code cache miss the host's TLBs a lot less that way.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <util.h>
+
+#define HUGE_PAGE_SIZE (2 << 20)
+
+typedef enum n64_huge_pages {
+    HUGE_PAGES_OFF, // normal pages
+    HUGE_PAGES_TRANSPARENT, // ask for transparent huge pages with madvise
+    HUGE_PAGES_AUTO // MAP_HUGETLB if the host has huge pages reserved, transparent huge pages if it doesn't
+} n64_huge_pages_t;
+
+typedef struct host_memory_region {
+    const char* name;
+    u8* base;
+    size_t size;
+    // What the region was actually mapped with, the kernel can still back transparent huge pages with normal ones
+    const char* backing;
+} host_memory_region_t;
+
+// Never returns NULL. Zeroed, and aligned to HUGE_PAGE_SIZE when huge pages were asked for.
+u8* host_alloc(const char* name, size_t size, bool executable, n64_huge_pages_t huge_pages);
+// Code regions are mapped twice where the host allows it: code is written through *writable and run from the returned
+// mapping, so neither is ever writable and executable at once. Elsewhere *writable is the same, executable, mapping.
+u8* host_alloc_code(const char* name, size_t size, n64_huge_pages_t huge_pages, u8** writable);
+void host_free(u8* base);
+
+typedef struct host_memory_usage {
+    host_memory_region_t region;
+    // Largest page size anywhere in the region
+    size_t page_size;
+    // How much of the region is in huge pages right now. Transparent huge pages only show up here once they've been touched.
+    size_t huge_bytes;
+} host_memory_usage_t;
+
+// Returns how many regions were written to usage
+int host_memory_usage(host_memory_usage_t* usage, int max_regions);
+// Logs host_memory_usage for every region, at info verbosity
+void host_memory_report();
+
+#endif //N64_HOST_MEMORY_H
@@ -1,6 +1,6 @@
 #include "n64system.h"
 #include "scheduler.h"
-#include "mprotect_utils.h"
+#include "host_memory.h"
 #include "scheduler_utils.h"
 
 #include <frontend/http_api.h>
@@ -8,10 +8,13 @@
 
 #include <mem/n64bus.h>
 #include <frontend/render.h>
+#include <frontend/audio.h>
+#include <frontend/replay.h>
 #include <interface/vi.h>
 #include <interface/ai.h>
 #include <cpu/rsp.h>
 #include <cpu/dynarec/dynarec.h>
+#include <cpu/dynarec/v2/v2_compiler.h>
 #include <dynarec/rsp_dynarec.h>
 #include <util.h>
 #ifndef N64_WIN
@@ -23,6 +26,7 @@
 #include <memoryapi.h>
 #endif
 #include <mem/backup.h>
+#include <mem/backup_writer.h>
 #include <frontend/game_db.h>
 #include <metrics.h>
 #include <frontend/device.h>
@@ -30,6 +34,8 @@
 #include <interface/pi.h>
 #include <mem/pif.h>
 #include <timing.h>
+#include <trace.h>
+#include <settings.h>
 #ifdef __APPLE__
 #include <pthread.h>
 #endif
@@ -39,13 +45,11 @@ static bool should_quit = false;
 
 n64_system_t* n64sys_ptr;
 
-#ifndef __APPLE__
-static u8 codecache[CODECACHE_SIZE] __attribute__((aligned(4096)));
-static u8 rsp_codecache[RSP_CODECACHE_SIZE] __attribute__((aligned(4096)));
-#else
 static u8* codecache = NULL;
+static u8* codecache_writable = NULL;
+static u8* dynarec_metadata = NULL;
 static u8* rsp_codecache = NULL;
-#endif
+static u8* rsp_codecache_writable = NULL;
 
 
 bool n64_should_quit() {
@@ -64,36 +68,30 @@ void n64_load_rom(const char* rom_path) {
     }
 }
 
-void mprotect_codecache() {
-    #ifdef __APPLE__
-    codecache = (u8*)mmap(NULL, CODECACHE_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS | MAP_JIT,-1, 0);
-    rsp_codecache = (u8*)mmap(NULL, RSP_CODECACHE_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS | MAP_JIT,-1, 0);
-    #else
-    mprotect_rwx((u8*)&codecache, CODECACHE_SIZE, "codecache");
-    mprotect_rwx((u8*)&rsp_codecache, RSP_CODECACHE_SIZE, "codecache");
-    #endif
+void alloc_codecache() {
+    if (codecache == NULL) {
+        codecache = host_alloc_code("codecache", CODECACHE_SIZE, n64_settings.huge_pages, &codecache_writable);
+        dynarec_metadata = host_alloc("JIT metadata", DYNAREC_METADATA_SIZE, false, n64_settings.huge_pages);
+    }
+    if (rsp_codecache == NULL) {
+        rsp_codecache = host_alloc_code("RSP codecache", RSP_CODECACHE_SIZE, n64_settings.huge_pages, &rsp_codecache_writable);
+    }
 }
 
-#ifdef LOG_CPU_STATE
-FILE* log_file = NULL;
-#endif
-
 void init_n64system(const char* rom_path, bool enable_frontend, bool enable_debug, n64_video_type_t video_type, bool use_interpreter) {
     if (n64sys_ptr) {
         logwarn("n64sys already initialized");
     } else {
-        n64sys_ptr = malloc(sizeof(n64_system_t));
+        // RDRAM is in here
+        n64sys_ptr = (n64_system_t*)host_alloc("system", sizeof(n64_system_t), false, n64_settings.huge_pages);
     }
 
     if (n64cpu_ptr) {
         logwarn("n64cpu already initialized");
     } else {
-        n64cpu_ptr = malloc(sizeof(r4300i_t));
+        // The TLB cache is in here
+        n64cpu_ptr = (r4300i_t*)host_alloc("CPU", sizeof(r4300i_t), false, n64_settings.huge_pages);
     }
-#ifdef LOG_CPU_STATE
-    log_file = fopen("cpu_log.bin", "wb");
-    logalways("Opened log for writing");
-#endif
 
     memset(&n64sys, 0x00, sizeof(n64_system_t));
     memset(&N64CPU, 0x00, sizeof(N64CPU));
@@ -102,9 +100,10 @@ void init_n64system(const char* rom_path, bool enable_frontend, bool enable_debu
 
     n64sys.video_type = video_type;
 
-    mprotect_codecache();
-    n64_dynarec_init(codecache, CODECACHE_SIZE);
-    N64RSP.dynarec = rsp_dynarec_init(rsp_codecache, RSP_CODECACHE_SIZE);
+    alloc_codecache();
+    n64_dynarec_init(codecache, codecache_writable, CODECACHE_SIZE, dynarec_metadata, DYNAREC_METADATA_SIZE);
+    N64RSP.dynarec = rsp_dynarec_init(rsp_codecache, rsp_codecache_writable, RSP_CODECACHE_SIZE);
+    host_memory_report();
 
     if (enable_frontend) {
         render_init(video_type);
@@ -124,15 +123,7 @@ void init_n64system(const char* rom_path, bool enable_frontend, bool enable_debu
 }
 
 void reset_n64system() {
-    force_persist_backup();
-    if (n64sys.mem.save_data != NULL) {
-        free(n64sys.mem.save_data);
-        n64sys.mem.save_data = NULL;
-    }
-    if (n64sys.mem.mempak_data != NULL) {
-        free(n64sys.mem.mempak_data);
-        n64sys.mem.mempak_data = NULL;
-    }
+    close_backup(&n64sys.mem);
     N64CPU.branch = false;
     N64CPU.prev_branch = false;
     N64CPU.exception = false;
@@ -166,6 +157,7 @@ void reset_n64system() {
     N64CP0.error_epc  = 0xFFFFFFFFFFFFFFFF;
 
     N64CPU.fcr0.raw = 0xa00;
+    fcr31_updated(N64CPU.fcr31.raw);
 
     memset(n64sys.mem.rdram, 0, N64_RDRAM_SIZE);
     memset(N64RSP.sp_dmem, 0, SP_DMEM_SIZE);
@@ -192,10 +184,6 @@ INLINE int jit_system_step() {
 INLINE int interpreter_system_step_matchjit(const int cycles) {
     for (int i = 0; i < cycles; i++) {
         r4300i_step();
-#ifdef INSTANT_DMA
-        N64CPU.fcr31.flag = 0;
-        N64CPU.fcr31.cause = 0;
-#endif
     N64CP0.count++;
     N64CP0.count &= 0x1FFFFFFFF;
     }
@@ -203,33 +191,21 @@ INLINE int interpreter_system_step_matchjit(const int cycles) {
     return cycles;
 }
 
-#ifdef LOG_CPU_STATE
-void log_cpu_state() {
-    fwrite(&N64CPU.pc, sizeof(u64), 1, log_file);
-    fwrite(&N64CPU.gpr, sizeof(u64), 32, log_file);
-    fwrite(&N64CP0.cause.raw, sizeof(u32), 1, log_file);
-    //fwrite(&N64CP0.status.raw, sizeof(u32), 1, log_file);
-    fwrite(&n64sys.mi.intr.raw, sizeof(u32), 1, log_file);
-    //fwrite(&n64sys.mi.intr_mask.raw, sizeof(u32), 1, log_file);
+static void trace_cpu_state() {
+    trace_cpu_state_t state = { .pc = N64CPU.pc, .cp0_cause = N64CP0.cause.raw, .mi_intr = n64sys.mi.intr.raw };
+    memcpy(state.gpr, N64CPU.gpr, sizeof(state.gpr));
+    trace_emit(TRACE_EVENT_CPU_STATE, &state, sizeof(state));
 }
-#endif
 
 INLINE void interpreter_system_step() {
 #ifdef N64_DEBUG_MODE
     check_breakpoint(N64CPU.pc);
-    while (n64sys.debugger_state.broken) {
-#ifdef N64_WIN
-        Sleep(1);
-#else
-        usleep(1000);
-#endif
-        debugger_tick();
-    }
+    debugger_wait_while_broken();
 #endif
 
-#ifdef LOG_CPU_STATE
-    log_cpu_state();
-#endif
+    if (TRACE_ENABLED(TRACE_EVENT_CPU_STATE)) {
+        trace_cpu_state();
+    }
     r4300i_step();
 
     static int cpu_steps = 0;
@@ -265,10 +241,16 @@ void on_vi_halfline_complete(u64 time) {
             n64sys.vi.halfline = 0;
             n64sys.vi.field++;
             if (n64sys.video_type != UNKNOWN_VIDEO_TYPE) {
-                persist_backup();
                 ai_step(n64sys.vi.missing_cycles);
-                rdp_update_screen();
-                reset_all_metrics();
+                if (!n64sys.shadow) {
+                    persist_backup();
+                    replay_end_frame();
+                    rdp_update_screen();
+                    frame_limiter_wait();
+                    set_metric(METRIC_CODECACHE_USED, n64dynarec.codecache_used);
+                    metrics_end_frame();
+                    http_api_on_frame();
+                }
             }
         }
 
@@ -315,14 +297,15 @@ void handle_scheduler_event(scheduler_event_t* event) {
                 r4300i_handle_exception(N64CPU.pc, EXCEPTION_INTERRUPT, 0);
             }
             break;
+        case SCHEDULER_RDP_FULL_SYNC:
+            on_rdp_full_sync_complete();
+            break;
         default:
             logfatal("Unknown scheduler event type");
     }
 }
 
 int n64_system_step(bool dynarec, int steps) {
-    static int cpu_steps = 0;
-
     int taken;
     if (dynarec) {
         taken = jit_system_step();
@@ -331,21 +314,21 @@ int n64_system_step(bool dynarec, int steps) {
     }
     taken += pop_stalled_cycles();
 
-    cpu_steps += taken;
+    n64sys.rsp_cpu_steps += taken;
 
     scheduler_event_t event;
     if (scheduler_tick(taken, &event)) {
         handle_scheduler_event(&event);
 
-        ai_step(cpu_steps);
+        ai_step(n64sys.rsp_cpu_steps);
         if (!N64RSP.status.halt) {
             // 2 RSP steps per 3 CPU steps
-            N64RSP.steps += (cpu_steps / 3) * 2;
-            cpu_steps %= 3;
+            N64RSP.steps += (n64sys.rsp_cpu_steps / 3) * 2;
+            n64sys.rsp_cpu_steps %= 3;
             rsp_dynarec_run();
         } else {
             N64RSP.steps = 0;
-            cpu_steps = 0;
+            n64sys.rsp_cpu_steps = 0;
         }
     }
 
@@ -415,6 +398,12 @@ void n64_system_cleanup() {
     debugger_cleanup();
 #endif
 
+    rdp_stop_thread();
+    audio_cleanup();
+    trace_stop();
+    v2_stop_block_capture();
+    backup_writer_stop();
+
     free(n64sys.mem.rom.rom);
     n64sys.mem.rom.rom = NULL;
 
@@ -20,6 +20,8 @@ extern "C" {
 #define CODECACHE_SIZE (1 << 25)
 // 32MiB RSP codecache
 #define RSP_CODECACHE_SIZE (1 << 25)
+// 32MiB for the JIT's block lists, code masks and cached interpreter blocks
+#define DYNAREC_METADATA_SIZE (1 << 25)
 
 typedef enum n64_video_type {
     UNKNOWN_VIDEO_TYPE,
@@ -84,6 +86,9 @@ typedef union n64_dpc_status {
 
 ASSERTWORD(n64_dpc_status_t);
 
+// The longest RDP command, a shaded, textured, z buffered triangle
+#define RDP_MAX_COMMAND_WORDS 44
+
 typedef struct n64_dpc {
     u32 start;
     u32 end;
@@ -91,6 +96,9 @@ typedef struct n64_dpc {
     n64_dpc_status_t status;
     u32 clock;
     u32 tmem;
+    // A command cut off by the end of the last list, finished by the next one
+    u32 partial_command[RDP_MAX_COMMAND_WORDS];
+    int partial_command_words;
 } n64_dpc_t;
 
 typedef union axis_scale {
@@ -186,6 +194,11 @@ typedef struct n64_system {
     bool use_interpreter;
     char rom_path[PATH_MAX];
     unsigned target_fps;
+    // CPU steps n64_system_step has run that the RSP hasn't caught up with yet
+    int rsp_cpu_steps;
+    // Set on a second copy of the system run alongside this one by dynarec_compare. It emulates everything, but never
+    // presents frames or writes save files.
+    bool shadow;
 } n64_system_t;
 
 void init_n64system(const char* rom_path, bool enable_frontend, bool enable_debug, n64_video_type_t video_type, bool use_interpreter);
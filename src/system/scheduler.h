@@ -11,7 +11,8 @@ typedef enum scheduler_event_type {
     SCHEDULER_VI_HALFLINE,
     SCHEDULER_RESET_SYSTEM,
     SCHEDULER_COMPARE_INTERRUPT,
-    SCHEDULER_HANDLE_INTERRUPT
+    SCHEDULER_HANDLE_INTERRUPT,
+    SCHEDULER_RDP_FULL_SYNC
 } scheduler_event_type_t;
 
 typedef struct scheduler_event {
@@ -1,133 +1,128 @@
 /*
- * Compare the dynarec to the interpreter using IPC
+ * Compare the dynarec to the interpreter
  *
- * On MacOS, you must set the following kernel parameters.
- * By default, the maximum size of shared memory is 4MB.
+ * A second copy of the system runs on the interpreter in the same process. The dynarec runs a batch of blocks, recording
+ * how long each ran and a hash of the state it left behind: the CPU's registers and every page of RDRAM the block wrote.
+ * The interpreter then runs the same blocks and checks its own hash after each one, so the first block that disagrees
+ * is found without ever diffing whole states. Once a frame, all of RDRAM is compared too, to catch writes that don't
+ * go through the bus, like the RDP's.
  *
- * sudo sysctl -w kern.sysv.shmmax=67108864
- * sudo sysctl -w kern.sysv.shmall=16384
+ * Without checkpoints, every batch is one block, so on a mismatch both sides are still at the bad block and are diffed
+ * right away. With --checkpoint-frames, batches are longer, and both systems are saved every N frames. A mismatch is
+ * then replayed from the last checkpoint one block at a time to get the full diff, and a difference in RDRAM that no
+ * block's hash caught is bisected down to the first block it shows up after.
+ *
+ * Replays need the same inputs as the original run, so use a movie when checkpointing.
  */
 #include <mem/memory_logger.h>
 #include <stdio.h>
 #include <log.h>
 #include <system/n64system.h>
 #include <mem/pif.h>
-#include <rdp/parallel_rdp_wrapper.h>
-#include <imgui/imgui_ui.h>
 #include <frontend/frontend.h>
+#include <frontend/audio.h>
 #include <system/scheduler.h>
 #include <disassemble.h>
 #include <mem/n64bus.h>
 #include <cpu/dynarec/dynarec.h>
+#include <cpu/dynarec/rsp_dynarec.h>
 #include <rsp.h>
 #include <dynarec/v2/v2_compiler.h>
-#include <sys/shm.h>
-#include <sys/msg.h>
+#include <rdp/softrdp.h>
 #include <settings.h>
 #include <cflags.h>
+#include <timing.h>
 #include <frontend/tas_movie.h>
 
-// #define CHECK_RDRAM
 #define CHECK_PREV_STATE
 
-r4300i_t* n64cpu_interpreter_ptr;
-n64_system_t* n64sys_interpreter_ptr;
-
-int mq_jit_to_interp_id = -1;
-int mq_interp_to_jit_id = -1;
-
-int joybus_shmem_id = -1;
-int cpu_shmem_id = -1;
-int sys_shmem_id = -1;
-
-int cleanup_mq(int mq_id) {
-    if (mq_id == -1) {
-        return 0;
-    }
-
-    return msgctl(mq_id, IPC_RMID, 0);
+// Blocks the dynarec runs before the interpreter catches up, when checkpointing
+#define MAX_BATCH_BLOCKS 1024
+#define MEMPAK_SIZE 0x8000
+// RDRAM differences printed before giving up
+#define MAX_RDRAM_DIFFS 32
+
+// Everything that makes up one system's state. n64sys and N64CPU are pointers and are switched between the two sides,
+// but the RSP, the scheduler and a few others are globals, so only one side's can be live at a time. The other side's
+// are kept here.
+typedef struct compare_side {
+    n64_system_t* sys;
+    r4300i_t* cpu;
+    rsp_t rsp;
+    scheduler_t scheduler;
+    unsigned int extra_cycles;
+    u32 tas_movie_index;
+} compare_side_t;
+
+typedef struct checkpoint {
+    n64_system_t* sys;
+    r4300i_t cpu;
+    rsp_t rsp;
+    scheduler_t scheduler;
+    unsigned int extra_cycles;
+    u32 tas_movie_index;
+    u8* save_data;
+    u8* mempak_data;
+} checkpoint_t;
+
+typedef struct block_record {
+    u64 pc;
+    int steps;
+    u64 hash;
+} block_record_t;
+
+static compare_side_t jit_side;
+static compare_side_t interp_side;
+static compare_side_t* active_side = &jit_side;
+
+static checkpoint_t jit_checkpoint;
+static checkpoint_t interp_checkpoint;
+static int checkpoint_frames = 0;
+static bool have_checkpoint = false;
+
+static rdram_dirty_pages_t dirty_pages;
+static block_record_t batch[MAX_BATCH_BLOCKS];
+// Since the last checkpoint, or since booting if there isn't one
+static u64 blocks_run = 0;
+static u64 frames_run = 0;
+
+static void switch_to(compare_side_t* side) {
+    if (side == active_side) {
+        return;
+    }
+    active_side->rsp = n64rsp;
+    active_side->scheduler = n64scheduler;
+    active_side->extra_cycles = extra_cycles;
+    active_side->tas_movie_index = loaded_tas_movie_index;
+
+    n64rsp = side->rsp;
+    n64scheduler = side->scheduler;
+    extra_cycles = side->extra_cycles;
+    loaded_tas_movie_index = side->tas_movie_index;
+    n64sys_ptr = side->sys;
+    n64cpu_ptr = side->cpu;
+    // Both sides share the RSP's compiled code. Make it check that the blocks it picked still match this side's IMEM.
+    N64RSPDYNAREC->dirty = true;
+
+    active_side = side;
 }
 
-int cleanup_shmem(int shmem_id) {
-    if (shmem_id == -1) {
-        return 0;
-    }
-    return shmctl(shmem_id, IPC_RMID, 0);
-}
-
-void cleanup_resources() {
-    logalways("parent atexit: cleaning up IPC resources");
-    if (cleanup_mq(mq_jit_to_interp_id) == -1) {
-        perror("remove mq_jit_to_interp_id");
-    }
-
-    if (cleanup_mq(mq_interp_to_jit_id) == -1) {
-        perror("remove mq_interp_to_jit_id");
-    }
-
-    if (cleanup_shmem(joybus_shmem_id) == -1) {
-        perror("remove joybus_shmem_id");
-    }
-
-    if (cleanup_shmem(cpu_shmem_id) == -1) {
-        perror("remove cpu_shmem_id");
-    }
-
-    if (cleanup_shmem(sys_shmem_id) == -1) {
-        perror("remove sys_shmem_id");
-    }
-}
-
-struct num_cycles_msg {
-    long mtype;
-    int cycles;
-};
-
-void send_cycles(int id, int cycles) {
-    struct num_cycles_msg m;
-    m.mtype = 1;
-    m.cycles = cycles;
-    if (msgsnd(id, &m, sizeof(m.cycles), 0) == -1) {
-        perror("msgsnd");
-        exit(1);
-    }
-}
-
-int recv_cycles(int id) {
-    struct num_cycles_msg m;
-    if (msgrcv(id, &m, sizeof(m.cycles), 0, 0) == -1) {
-        perror("msgrcv");
-        exit(1);
-    }
-    return m.cycles;
-}
-
-int create_and_configure_mq(key_t key) {
-    int mq_id = msgget(key, IPC_CREAT | 0777);
-    if (mq_id == -1) {
-        perror("msgget");
-        exit(1);
-    }
-    struct msqid_ds mq_config;
-    if (msgctl(mq_id, IPC_STAT, &mq_config) == -1) {
-        perror("msgctl stat");
-        exit(1);
-    }
-    mq_config.msg_qbytes = sizeof(int) + 1;
-    if (msgctl(mq_id, IPC_SET, &mq_config) == -1) {
-        perror("msgctl set");
-        exit(1);
-    }
-
-    struct num_cycles_msg m;
-    while (msgrcv(mq_id, &m, sizeof(m.cycles), 0, IPC_NOWAIT) != -1) {
-        printf("Draining queue\n");
+// The state the active side was left in by the block it just ran, including every page of RDRAM the block wrote
+static u64 hash_block_result() {
+    u64 hash = r4300i_hash_state(&N64CPU);
+    for (int i = 0; i < dirty_pages.num_dirty; i++) {
+        u32 page = dirty_pages.pages[i];
+        const u64* words = (const u64*)&n64sys.mem.rdram[page << BLOCKCACHE_OUTER_SHIFT];
+        hash = hash_mix(hash, page);
+        for (int j = 0; j < BLOCKCACHE_PAGE_SIZE / (int)sizeof(u64); j++) {
+            hash = hash_mix(hash, words[j]);
+        }
+        dirty_pages.dirty[page] = false;
     }
-
-    return mq_id;
+    dirty_pages.num_dirty = 0;
+    return hash;
 }
 
-
 #ifdef CHECK_PREV_STATE
 r4300i_t prev_state;
 void save_prev_state() {
@@ -138,31 +133,9 @@ void save_prev_state() {
     prev_state.mult_lo = n64cpu_ptr->mult_lo;
     prev_state.mult_hi = n64cpu_ptr->mult_hi;
 
-    prev_state.cp0.index = n64cpu_ptr->cp0.index;
-    prev_state.cp0.random = n64cpu_ptr->cp0.random;
-    prev_state.cp0.entry_lo0.raw = n64cpu_ptr->cp0.entry_lo0.raw;
-    prev_state.cp0.entry_lo1.raw = n64cpu_ptr->cp0.entry_lo1.raw;
-    prev_state.cp0.context.raw = n64cpu_ptr->cp0.context.raw;
-    prev_state.cp0.page_mask.raw = n64cpu_ptr->cp0.page_mask.raw;
-    prev_state.cp0.wired = n64cpu_ptr->cp0.wired;
-    prev_state.cp0.bad_vaddr = n64cpu_ptr->cp0.bad_vaddr;
-    prev_state.cp0.count = n64cpu_ptr->cp0.count;
-    prev_state.cp0.entry_hi.raw = n64cpu_ptr->cp0.entry_hi.raw;
-    prev_state.cp0.compare = n64cpu_ptr->cp0.compare;
-    prev_state.cp0.status.raw = n64cpu_ptr->cp0.status.raw;
-    prev_state.cp0.cause.raw = n64cpu_ptr->cp0.cause.raw;
-    prev_state.cp0.EPC = n64cpu_ptr->cp0.EPC;
-    prev_state.cp0.PRId = n64cpu_ptr->cp0.PRId;
-    prev_state.cp0.config = n64cpu_ptr->cp0.config;
-    prev_state.cp0.lladdr = n64cpu_ptr->cp0.lladdr;
-    prev_state.cp0.watch_lo.raw = n64cpu_ptr->cp0.watch_lo.raw;
-    prev_state.cp0.watch_hi = n64cpu_ptr->cp0.watch_hi;
-    prev_state.cp0.x_context.raw = n64cpu_ptr->cp0.x_context.raw;
-    prev_state.cp0.parity_error = n64cpu_ptr->cp0.parity_error;
-    prev_state.cp0.cache_error = n64cpu_ptr->cp0.cache_error;
-    prev_state.cp0.tag_lo.raw = n64cpu_ptr->cp0.tag_lo.raw;
-    prev_state.cp0.tag_hi = n64cpu_ptr->cp0.tag_hi;
-    prev_state.cp0.error_epc = n64cpu_ptr->cp0.error_epc;
+#define SAVE_CP0(reg) prev_state.cp0.reg = n64cpu_ptr->cp0.reg;
+    R4300I_VISIBLE_CP0_REGISTERS(SAVE_CP0)
+#undef SAVE_CP0
 
     prev_state.llbit = n64cpu_ptr->llbit;
 
@@ -170,49 +143,8 @@ void save_prev_state() {
 }
 #endif
 
-bool compare() {
-    bool good = true;
-    good &= n64cpu_interpreter_ptr->pc == N64CPU.pc;
-    good &= memcmp(n64cpu_interpreter_ptr->gpr, n64cpu_ptr->gpr, sizeof(u64) * 32) == 0;
-    good &= memcmp(n64cpu_interpreter_ptr->f, n64cpu_ptr->f, sizeof(fgr_t) * 32) == 0;
-#ifdef CHECK_RDRAM
-    good &= memcmp(n64sys_interpreter_ptr->mem.rdram, n64sys.mem.rdram, N64_RDRAM_SIZE) == 0;
-#endif
-
-    good &= n64cpu_interpreter_ptr->mult_lo == n64cpu_ptr->mult_lo;
-    good &= n64cpu_interpreter_ptr->mult_hi == n64cpu_ptr->mult_hi;
-
-    good &= n64cpu_interpreter_ptr->cp0.index == n64cpu_ptr->cp0.index;
-    good &= n64cpu_interpreter_ptr->cp0.random == n64cpu_ptr->cp0.random;
-    good &= n64cpu_interpreter_ptr->cp0.entry_lo0.raw == n64cpu_ptr->cp0.entry_lo0.raw;
-    good &= n64cpu_interpreter_ptr->cp0.entry_lo1.raw == n64cpu_ptr->cp0.entry_lo1.raw;
-    good &= n64cpu_interpreter_ptr->cp0.context.raw == n64cpu_ptr->cp0.context.raw;
-    good &= n64cpu_interpreter_ptr->cp0.page_mask.raw == n64cpu_ptr->cp0.page_mask.raw;
-    good &= n64cpu_interpreter_ptr->cp0.wired == n64cpu_ptr->cp0.wired;
-    good &= n64cpu_interpreter_ptr->cp0.bad_vaddr == n64cpu_ptr->cp0.bad_vaddr;
-    good &= n64cpu_interpreter_ptr->cp0.count == n64cpu_ptr->cp0.count;
-    good &= n64cpu_interpreter_ptr->cp0.entry_hi.raw == n64cpu_ptr->cp0.entry_hi.raw;
-    good &= n64cpu_interpreter_ptr->cp0.compare == n64cpu_ptr->cp0.compare;
-    good &= n64cpu_interpreter_ptr->cp0.status.raw == n64cpu_ptr->cp0.status.raw;
-    good &= n64cpu_interpreter_ptr->cp0.cause.raw == n64cpu_ptr->cp0.cause.raw;
-    good &= n64cpu_interpreter_ptr->cp0.EPC == n64cpu_ptr->cp0.EPC;
-    good &= n64cpu_interpreter_ptr->cp0.PRId == n64cpu_ptr->cp0.PRId;
-    good &= n64cpu_interpreter_ptr->cp0.config == n64cpu_ptr->cp0.config;
-    good &= n64cpu_interpreter_ptr->cp0.lladdr == n64cpu_ptr->cp0.lladdr;
-    good &= n64cpu_interpreter_ptr->cp0.watch_lo.raw == n64cpu_ptr->cp0.watch_lo.raw;
-    good &= n64cpu_interpreter_ptr->cp0.watch_hi == n64cpu_ptr->cp0.watch_hi;
-    good &= n64cpu_interpreter_ptr->cp0.x_context.raw == n64cpu_ptr->cp0.x_context.raw;
-    good &= n64cpu_interpreter_ptr->cp0.parity_error == n64cpu_ptr->cp0.parity_error;
-    good &= n64cpu_interpreter_ptr->cp0.cache_error == n64cpu_ptr->cp0.cache_error;
-    good &= n64cpu_interpreter_ptr->cp0.tag_lo.raw == n64cpu_ptr->cp0.tag_lo.raw;
-    good &= n64cpu_interpreter_ptr->cp0.tag_hi == n64cpu_ptr->cp0.tag_hi;
-    good &= n64cpu_interpreter_ptr->cp0.error_epc == n64cpu_ptr->cp0.error_epc;
-
-    good &= n64cpu_interpreter_ptr->llbit == n64cpu_ptr->llbit;
-
-    good &= n64cpu_interpreter_ptr->fcr31.raw == n64cpu_ptr->fcr31.raw;
-
-    return good;
+bool compare_rdram() {
+    return memcmp(interp_side.sys->mem.rdram, jit_side.sys->mem.rdram, N64_RDRAM_SIZE) == 0;
 }
 
 void print_colorcoded_u64(const char* name, u64 expected, u64 actual) {
@@ -225,72 +157,64 @@ void print_colorcoded_u64(const char* name, u64 expected, u64 actual) {
     printf("%s" COLOR_END "\n", expected == actual ? COLOR_GREEN " OK!" : COLOR_RED " BAD!");
 }
 
+void print_rdram_diff() {
+    const u8* expected = interp_side.sys->mem.rdram;
+    const u8* actual = jit_side.sys->mem.rdram;
+    int shown = 0;
+    for (u32 i = 0; i < N64_RDRAM_SIZE && shown < MAX_RDRAM_DIFFS; i += 4) {
+        u32 expected_word, actual_word;
+        memcpy(&expected_word, &expected[i], sizeof(u32));
+        memcpy(&actual_word, &actual[i], sizeof(u32));
+        if (expected_word != actual_word) {
+            printf("RDRAM %08X expected %08X actual %08X\n", i, expected_word, actual_word);
+            shown++;
+        }
+    }
+    if (shown == MAX_RDRAM_DIFFS) {
+        printf("... more RDRAM differences not shown\n");
+    }
+}
+
 void print_state() {
+    const r4300i_t* interp = interp_side.cpu;
+    const r4300i_t* jit = jit_side.cpu;
     printf("            expected (interpreter)  actual (dynarec)\n");
-    print_colorcoded_u64("PC", n64cpu_interpreter_ptr->pc, N64CPU.pc);
+    print_colorcoded_u64("PC", interp->pc, jit->pc);
     printf("\n");
     for (int i = 0; i < 32; i++) {
-        print_colorcoded_u64(register_names[i], n64cpu_interpreter_ptr->gpr[i], N64CPU.gpr[i]);
+        print_colorcoded_u64(register_names[i], interp->gpr[i], jit->gpr[i]);
     }
 
     printf("\n");
 
-    print_colorcoded_u64("lo ", n64cpu_interpreter_ptr->mult_lo, N64CPU.mult_lo);
-    print_colorcoded_u64("hi ", n64cpu_interpreter_ptr->mult_hi, N64CPU.mult_hi);
+    print_colorcoded_u64("lo ", interp->mult_lo, jit->mult_lo);
+    print_colorcoded_u64("hi ", interp->mult_hi, jit->mult_hi);
 
     printf("\n");
 
     for (int i = 0; i < 32; i++) {
-        print_colorcoded_u64(cp1_register_names[i], n64cpu_interpreter_ptr->f[i].raw, N64CPU.f[i].raw);
+        print_colorcoded_u64(cp1_register_names[i], interp->f[i].raw, jit->f[i].raw);
     }
 
     printf("\n");
 
-    print_colorcoded_u64("cpu llbit", n64cpu_interpreter_ptr->llbit, N64CPU.llbit);
+    print_colorcoded_u64("cpu llbit", interp->llbit, jit->llbit);
     printf("\n");
 
-    print_colorcoded_u64("cp0 index", n64cpu_interpreter_ptr->cp0.index, N64CPU.cp0.index);
-    print_colorcoded_u64("cp0 random", n64cpu_interpreter_ptr->cp0.random, N64CPU.cp0.random);
-    print_colorcoded_u64("cp0 entry_lo0", n64cpu_interpreter_ptr->cp0.entry_lo0.raw, N64CPU.cp0.entry_lo0.raw);
-    print_colorcoded_u64("cp0 entry_lo1", n64cpu_interpreter_ptr->cp0.entry_lo1.raw, N64CPU.cp0.entry_lo1.raw);
-    print_colorcoded_u64("cp0 context", n64cpu_interpreter_ptr->cp0.context.raw, N64CPU.cp0.context.raw);
-    print_colorcoded_u64("cp0 page_mask", n64cpu_interpreter_ptr->cp0.page_mask.raw, N64CPU.cp0.page_mask.raw);
-    print_colorcoded_u64("cp0 wired", n64cpu_interpreter_ptr->cp0.wired, N64CPU.cp0.wired);
-    print_colorcoded_u64("cp0 bad_vaddr", n64cpu_interpreter_ptr->cp0.bad_vaddr, N64CPU.cp0.bad_vaddr);
-    print_colorcoded_u64("cp0 count", n64cpu_interpreter_ptr->cp0.count, N64CPU.cp0.count);
-    print_colorcoded_u64("cp0 entry_hi", n64cpu_interpreter_ptr->cp0.entry_hi.raw, N64CPU.cp0.entry_hi.raw);
-    print_colorcoded_u64("cp0 compare", n64cpu_interpreter_ptr->cp0.compare, N64CPU.cp0.compare);
-    print_colorcoded_u64("cp0 status", n64cpu_interpreter_ptr->cp0.status.raw, N64CPU.cp0.status.raw);
-    print_colorcoded_u64("cp0 cause", n64cpu_interpreter_ptr->cp0.cause.raw, N64CPU.cp0.cause.raw);
-    print_colorcoded_u64("cp0 EPC", n64cpu_interpreter_ptr->cp0.EPC, N64CPU.cp0.EPC);
-    print_colorcoded_u64("cp0 PRId", n64cpu_interpreter_ptr->cp0.PRId, N64CPU.cp0.PRId);
-    print_colorcoded_u64("cp0 config", n64cpu_interpreter_ptr->cp0.config, N64CPU.cp0.config);
-    print_colorcoded_u64("cp0 lladdr", n64cpu_interpreter_ptr->cp0.lladdr, N64CPU.cp0.lladdr);
-    print_colorcoded_u64("cp0 watch_lo", n64cpu_interpreter_ptr->cp0.watch_lo.raw, N64CPU.cp0.watch_lo.raw);
-    print_colorcoded_u64("cp0 watch_hi", n64cpu_interpreter_ptr->cp0.watch_hi, N64CPU.cp0.watch_hi);
-    print_colorcoded_u64("cp0 x_context", n64cpu_interpreter_ptr->cp0.x_context.raw, N64CPU.cp0.x_context.raw);
-    print_colorcoded_u64("cp0 parity_error", n64cpu_interpreter_ptr->cp0.parity_error, N64CPU.cp0.parity_error);
-    print_colorcoded_u64("cp0 cache_error", n64cpu_interpreter_ptr->cp0.cache_error, N64CPU.cp0.cache_error);
-    print_colorcoded_u64("cp0 tag_lo", n64cpu_interpreter_ptr->cp0.tag_lo.raw, N64CPU.cp0.tag_lo.raw);
-    print_colorcoded_u64("cp0 tag_hi", n64cpu_interpreter_ptr->cp0.tag_hi, N64CPU.cp0.tag_hi);
-    print_colorcoded_u64("cp0 error_epc", n64cpu_interpreter_ptr->cp0.error_epc, N64CPU.cp0.error_epc);
+#define PRINT_CP0(reg) print_colorcoded_u64("cp0 " #reg, interp->cp0.reg, jit->cp0.reg);
+    R4300I_VISIBLE_CP0_REGISTERS(PRINT_CP0)
+#undef PRINT_CP0
+    printf("\n");
+    print_colorcoded_u64("cp1 fcr31", interp->fcr31.raw, jit->fcr31.raw);
     printf("\n");
-    print_colorcoded_u64("cp1 fcr31", n64cpu_interpreter_ptr->fcr31.raw, N64CPU.fcr31.raw);
-
-#ifdef CHECK_RDRAM
-    for (int i = 0; i < N64_RDRAM_SIZE; i++) {
-        if (n64sys_interpreter_ptr->mem.rdram[i] != n64sys.mem.rdram[i]) {
-            printf("%08X: %02X %02X\n", i, n64sys_interpreter_ptr->mem.rdram[i], n64sys.mem.rdram[i]);
-        }
-    }
-#endif
 
+    print_rdram_diff();
 
 #ifdef CHECK_PREV_STATE
     printf("\n\n\n");
     printf("[[testcases]]\n");
     printf("initial_pc = \"0x%016" PRIX64 "\"\n", prev_state.pc);
-    printf("expected_pc = \"0x%016" PRIX64 "\"\n", n64cpu_interpreter_ptr->pc);
+    printf("expected_pc = \"0x%016" PRIX64 "\"\n", interp->pc);
     printf("\n");
 
     printf("code = [\n");
@@ -317,27 +241,24 @@ void print_state() {
 
     printf("expected_gprs = [\n");
     for (int i = 0; i < 32; i++) {
-        printf("    \"0x%016" PRIX64 "\", # r%d or %s\n", n64cpu_interpreter_ptr->gpr[i], i, register_names[i]);
+        printf("    \"0x%016" PRIX64 "\", # r%d or %s\n", interp->gpr[i], i, register_names[i]);
     }
     printf("]\n\n");
 
     printf("expected_fgrs = [\n");
     for (int i = 0; i < 32; i++) {
-        printf("    \"0x%016" PRIX64 "\",\n", n64cpu_interpreter_ptr->f[i].raw);
+        printf("    \"0x%016" PRIX64 "\",\n", interp->f[i].raw);
     }
     printf("]\n\n");
 
     printf("initial_fcr31 = 0x%08X\n\n", prev_state.fcr31.raw);
 
-    printf("expected_fcr31 = 0x%08X\n\n", n64cpu_interpreter_ptr->fcr31.raw);
+    printf("expected_fcr31 = 0x%08X\n\n", interp->fcr31.raw);
 
     printf("initial_cp0_status = 0x%08X\n", prev_state.cp0.status.raw);
     printf("initial_cp0_error_epc = \"0x%016" PRIX64 "\"\n", prev_state.cp0.error_epc);
     printf("initial_cp0_epc = \"0x%016" PRIX64 "\"\n", prev_state.cp0.EPC);
 
-    // set_pc_dword_r4300i(N64CPU.cp0.error_epc);
-    // set_pc_dword_r4300i(N64CPU.cp0.EPC);
-
     #ifdef LOG_MEMORY_ACCESSES // in n64bus.h
     memory_access_t memory_access;
     while (pop_memory_access(&memory_access, MEMORY_ACCESS_SIZE_BYTE, BUS_LOAD)) {
@@ -372,49 +293,23 @@ void print_state() {
 #endif
 }
 
-void run_compare_parent() {
-    u64 start_pc = 0;
-    int steps = 0;
-    do {
-        #ifdef CHECK_PREV_STATE
-        save_prev_state();
-        #endif
-        #ifdef LOG_MEMORY_ACCESSES // in n64bus.h
-        clear_memory_logger();
-        #endif
-        start_pc = N64CPU.pc;
-        // Step jit
-        steps = n64_system_step(true, -1);
-
-        // Step interpreter
-        send_cycles(mq_jit_to_interp_id, steps);
-        // Wait for interpreter to be done
-        int interpreter_steps = recv_cycles(mq_interp_to_jit_id);
-        if (interpreter_steps != steps) {
-            logalways("Interpreter ran for a different amount of time than the JIT! interpreter: %d JIT: %d\n", interpreter_steps, steps);
-            n64_request_quit();
-        }
-    } while (compare() && !n64_should_quit());
-    send_cycles(mq_jit_to_interp_id, -1); // End the child process
-    if (n64_should_quit()) {
-        logalways("User requested quit, not doing a final compare");
-        exit(0);
-    }
-    printf("Found a difference at pc: %016" PRIX64 ", ran for %d steps\n", start_pc, steps);
+void print_difference(u64 block, u64 start_pc, int steps) {
+    switch_to(&jit_side);
+    printf("Found a difference in block %" PRIu64 " at pc: %016" PRIX64 ", ran for %d steps\n", block, start_pc, steps);
     if (steps == 0) {
         logwarn("!!! WARNING: RAN FOR 0 STEPS !!!");
     }
     printf("MIPS code:\n");
     u32 physical = 0;
-    n64_dynarec_block_t* block = NULL;
+    n64_dynarec_block_t* block_info = NULL;
     bool cached;
     bool resolved = resolve_virtual_address(start_pc, BUS_LOAD, &cached, &physical);
     if (resolved) {
-         block = &n64dynarec.blockcache[BLOCKCACHE_OUTER_INDEX(physical)][BLOCKCACHE_INNER_INDEX(physical)];
+        block_info = &n64dynarec.blockcache[BLOCKCACHE_OUTER_INDEX(physical)][BLOCKCACHE_INNER_INDEX(physical)];
         if (physical >= N64_RDRAM_SIZE) {
             printf("outside of RDAM, can't disassemble (TODO)\n");
         } else {
-            print_multi_guest(start_pc, &n64sys.mem.rdram[physical], block->guest_size);
+            print_multi_guest(start_pc, &n64sys.mem.rdram[physical], block_info->guest_size);
         }
     } else {
         printf("TLB miss PC, guest code unavailable\n");
@@ -431,39 +326,273 @@ void run_compare_parent() {
     // TODO: Rewrite to print the host code through the Rust JIT so we get comments
     // printf("Host code:\n");
     // if (resolved) {
-    //     print_multi_host((uintptr_t)block->run, (u8*)block->run, block->host_size);
+    //     print_multi_host((uintptr_t)block_info->run, (u8*)block_info->run, block_info->host_size);
     // } else {
     //     printf("TLB miss PC, host code unavailable\n");
     // }
     print_state();
 }
 
-void run_compare_child() {
-    while (true) {
-        int cycles = recv_cycles(mq_jit_to_interp_id);
-        if (cycles < 0) {
-            logfatal("Child process done.");
+// Runs up to max_blocks on the dynarec, stopping early at the end of a frame, then the same blocks on the interpreter.
+// Returns how many blocks matched. If that's fewer than ran, the interpreter has stopped just after the first bad one,
+// which is batch[result].
+static int run_batch(int max_blocks, int* ran, bool* frame_ended) {
+    switch_to(&jit_side);
+    *ran = 0;
+    *frame_ended = false;
+    while (*ran < max_blocks && !n64_should_quit()) {
+        if (*ran == 0) {
+#ifdef CHECK_PREV_STATE
+            save_prev_state();
+#endif
+#ifdef LOG_MEMORY_ACCESSES // in n64bus.h
+            clear_memory_logger();
+#endif
+        }
+        int halfline = n64sys.vi.halfline;
+        block_record_t* record = &batch[(*ran)++];
+        record->pc = N64CPU.pc;
+        record->steps = n64_system_step(true, -1);
+        record->hash = hash_block_result();
+        // Input changes at the end of a frame. Don't let the dynarec run ahead of the interpreter past one.
+        if (n64sys.vi.halfline < halfline) {
+            *frame_ended = true;
+            break;
+        }
+    }
+
+    switch_to(&interp_side);
+    for (int i = 0; i < *ran; i++) {
+        int steps = n64_system_step(false, batch[i].steps);
+        u64 hash = hash_block_result();
+        if (steps != batch[i].steps) {
+            logalways("Interpreter ran for a different amount of time than the JIT! interpreter: %d JIT: %d", steps, batch[i].steps);
+            return i;
+        }
+        if (hash != batch[i].hash) {
+            return i;
+        }
+        blocks_run++;
+    }
+    return *ran;
+}
+
+static void copy_buffer(u8** dest, const u8* src, size_t size) {
+    if (src == NULL) {
+        return;
+    }
+    if (*dest == NULL) {
+        *dest = malloc(size);
+    }
+    memcpy(*dest, src, size);
+}
+
+static void checkpoint_save(checkpoint_t* checkpoint, compare_side_t* side) {
+    switch_to(side);
+    // Draws still waiting to be rasterized can't be saved, so finish them now. Both sides do this at the same point in
+    // every run, including replays from this checkpoint, so it doesn't cause a difference.
+    softrdp_full_sync(&n64sys.softrdp_state);
+    if (checkpoint->sys == NULL) {
+        checkpoint->sys = malloc(sizeof(n64_system_t));
+    }
+    memcpy(checkpoint->sys, n64sys_ptr, sizeof(n64_system_t));
+    checkpoint->cpu = N64CPU;
+    checkpoint->rsp = N64RSP;
+    checkpoint->scheduler = n64scheduler;
+    checkpoint->extra_cycles = extra_cycles;
+    checkpoint->tas_movie_index = loaded_tas_movie_index;
+    copy_buffer(&checkpoint->save_data, n64sys.mem.save_data, n64sys.mem.save_size);
+    copy_buffer(&checkpoint->mempak_data, n64sys.mem.mempak_data, MEMPAK_SIZE);
+}
+
+static void checkpoint_restore(const checkpoint_t* checkpoint, compare_side_t* side) {
+    switch_to(side);
+    // Throws away the draws since the checkpoint, RDRAM is about to be overwritten anyway
+    softrdp_full_sync(&n64sys.softrdp_state);
+
+    // Buffers the system owns are kept, only their contents are restored
+    u8* rdp_rdram = n64sys.softrdp_state.rdram;
+    struct softrdp_queue* rdp_queue = n64sys.softrdp_state.queue;
+    u8* save_data = n64sys.mem.save_data;
+    u8* mempak_data = n64sys.mem.mempak_data;
+
+    memcpy(n64sys_ptr, checkpoint->sys, sizeof(n64_system_t));
+    n64sys.softrdp_state.rdram = rdp_rdram;
+    n64sys.softrdp_state.queue = rdp_queue;
+    n64sys.mem.save_data = save_data;
+    n64sys.mem.mempak_data = mempak_data;
+    copy_buffer(&n64sys.mem.save_data, checkpoint->save_data, n64sys.mem.save_size);
+    copy_buffer(&n64sys.mem.mempak_data, checkpoint->mempak_data, MEMPAK_SIZE);
+
+    N64CPU = checkpoint->cpu;
+    fcr31_updated(N64CPU.fcr31.raw);
+    N64RSP = checkpoint->rsp;
+    N64RSPDYNAREC->dirty = true;
+    n64scheduler = checkpoint->scheduler;
+    extra_cycles = checkpoint->extra_cycles;
+    loaded_tas_movie_index = checkpoint->tas_movie_index;
+}
+
+static void take_checkpoint() {
+    checkpoint_save(&jit_checkpoint, &jit_side);
+    checkpoint_save(&interp_checkpoint, &interp_side);
+    have_checkpoint = true;
+    blocks_run = 0;
+    frames_run = 0;
+}
+
+static void restore_checkpoint() {
+    checkpoint_restore(&jit_checkpoint, &jit_side);
+    checkpoint_restore(&interp_checkpoint, &interp_side);
+    // Code compiled since the checkpoint may not match what's in RDRAM now
+    invalidate_dynarec_all_pages();
+    dirty_pages.num_dirty = 0;
+    memset(dirty_pages.dirty, 0, sizeof(dirty_pages.dirty));
+    blocks_run = 0;
+    frames_run = 0;
+}
+
+// Restores the last checkpoint and runs until target blocks after it have been checked. Returns false if a block
+// before that didn't match, leaving blocks_run at the bad block.
+static bool replay_to(u64 target) {
+    restore_checkpoint();
+    while (blocks_run < target) {
+        u64 remaining = target - blocks_run;
+        int ran;
+        bool frame_ended;
+        int matched = run_batch(remaining < MAX_BATCH_BLOCKS ? (int)remaining : MAX_BATCH_BLOCKS, &ran, &frame_ended);
+        if (matched < ran) {
+            return false;
+        }
+        if (n64_should_quit()) {
+            logfatal("Quit during a replay");
+        }
+    }
+    return true;
+}
+
+// Both sides are at the start of the block, runs it and prints everything that's different after it
+static void report_next_block() {
+    u64 block = blocks_run;
+    int ran;
+    bool frame_ended;
+    run_batch(1, &ran, &frame_ended);
+    print_difference(block, batch[0].pc, batch[0].steps);
+}
+
+static void on_block_mismatch() {
+    u64 bad_block = blocks_run;
+    if (!have_checkpoint) {
+        // Every batch is a single block, so both sides have just run it
+        print_difference(bad_block, batch[0].pc, batch[0].steps);
+        return;
+    }
+    logalways("Block %" PRIu64 " after the last checkpoint didn't match, replaying it one block at a time", bad_block);
+    if (!replay_to(bad_block)) {
+        logwarn("Replay found a difference earlier than the original run, at block %" PRIu64 ". Is the input the same?", blocks_run);
+        bad_block = blocks_run;
+        replay_to(bad_block);
+    }
+    report_next_block();
+}
+
+// Every block since the checkpoint matched, but RDRAM didn't, so something wrote it outside of the bus. Finds the first
+// block it's different after.
+static void on_rdram_mismatch() {
+    if (!have_checkpoint) {
+        logalways("RDRAM is different at the end of a frame, but every block matched. Use --checkpoint-frames to find where it happened");
+        print_difference(blocks_run, N64CPU.pc, 0);
+        return;
+    }
+
+    // The checkpoint is known to match, and the current state known not to
+    u64 good = 0;
+    u64 bad = blocks_run;
+    logalways("RDRAM is different at the end of a frame, bisecting the %" PRIu64 " blocks since the last checkpoint", bad);
+    while (bad - good > 1) {
+        u64 middle = good + (bad - good) / 2;
+        if (!replay_to(middle)) {
+            logwarn("Replay found a difference the original run didn't, at block %" PRIu64 ". Is the input the same?", blocks_run);
+            bad = blocks_run + 1;
+            good = blocks_run;
+            break;
+        }
+        if (compare_rdram()) {
+            good = middle;
+        } else {
+            bad = middle;
+        }
+    }
+    replay_to(good);
+    report_next_block();
+}
+
+static void run_compare() {
+    // One block at a time unless a mismatch can be replayed from a checkpoint
+    const int batch_blocks = checkpoint_frames > 0 ? MAX_BATCH_BLOCKS : 1;
+    if (checkpoint_frames > 0) {
+        take_checkpoint();
+    }
+
+    while (!n64_should_quit()) {
+        int ran;
+        bool frame_ended;
+        int matched = run_batch(batch_blocks, &ran, &frame_ended);
+        if (matched < ran) {
+            on_block_mismatch();
+            return;
+        }
+        if (frame_ended) {
+            frames_run++;
+            if (!compare_rdram()) {
+                on_rdram_mismatch();
+                return;
+            }
+            if (checkpoint_frames > 0 && frames_run >= checkpoint_frames) {
+                take_checkpoint();
+            }
         }
-        int taken = n64_system_step(false, cycles);
-        send_cycles(mq_interp_to_jit_id, taken);
     }
+    logalways("User requested quit, not doing a final compare");
+}
+
+static void create_interpreter_side() {
+    jit_side.sys = n64sys_ptr;
+    jit_side.cpu = n64cpu_ptr;
+
+    interp_side.sys = malloc(sizeof(n64_system_t));
+    memcpy(interp_side.sys, n64sys_ptr, sizeof(n64_system_t));
+    interp_side.cpu = malloc(sizeof(r4300i_t));
+    memcpy(interp_side.cpu, n64cpu_ptr, sizeof(r4300i_t));
+    interp_side.rsp = n64rsp;
+    interp_side.scheduler = n64scheduler;
+    interp_side.extra_cycles = extra_cycles;
+    interp_side.tas_movie_index = loaded_tas_movie_index;
+
+    n64_system_t* sys = interp_side.sys;
+    sys->shadow = true;
+    sys->mem.save_data = NULL;
+    sys->mem.mempak_data = NULL;
+    copy_buffer(&sys->mem.save_data, n64sys.mem.save_data, n64sys.mem.save_size);
+    copy_buffer(&sys->mem.mempak_data, n64sys.mem.mempak_data, MEMPAK_SIZE);
+    // Its own RDP, drawing into its own RDRAM
+    sys->softrdp_state.queue = NULL;
+    softrdp_init(&sys->softrdp_state, (u8*)&sys->mem.rdram);
+
+    active_side = &jit_side;
 }
 
 void usage(cflags_t* flags) {
     cflags_print_usage(flags,
                        "[OPTION]... [ROM FILE]",
-                       "dynarec-compare, compare the jit to the interpreter using IPC",
+                       "dynarec-compare, compare the jit to the interpreter",
                        "");
 }
 
-#define KEY_CPU_SHMEM 1
-#define KEY_MQ_JIT_TO_INTERP 2
-#define KEY_MQ_INTERP_TO_JIT 3
-#define KEY_JOYBUS_SHMEM 4
-#define KEY_SYS_SHMEM 5
-
 int main(int argc, char** argv) {
     v2_set_idle_loop_detection_enabled(false);
+    // Compare every block as compiled code, not through the cached interpreter
+    dynarec_set_cached_interpreter_threshold(0);
     n64_settings_init();
     log_set_verbosity(LOG_VERBOSITY_WARN);
 #ifndef INSTANT_DMA
@@ -475,8 +604,7 @@ int main(int argc, char** argv) {
     const char* tas_movie_path = NULL;
     cflags_add_string(flags, 'm', "movie", &tas_movie_path, "Load movie (Mupen64Plus .m64 format)");
 
-    bool software_mode = false;
-    cflags_add_bool(flags, 's', "software", &software_mode, "Use the soft RDP");
+    cflags_add_int(flags, 'c', "checkpoint-frames", &checkpoint_frames, "Save both systems every N frames, so differences can be replayed and bisected. Use with a movie");
 
     cflags_parse(flags, argc, argv);
 
@@ -487,76 +615,14 @@ int main(int argc, char** argv) {
     }
     const char* rom_path = flags->argv[0];
 
-    key_t cpu_shmem_key = ftok(argv[0], KEY_CPU_SHMEM);
-    key_t joybus_shmem_key = ftok(argv[0], KEY_JOYBUS_SHMEM);
-    key_t sys_shmem_key = ftok(argv[0], KEY_SYS_SHMEM);
-
-    key_t mq_jit_to_interp_key = ftok(argv[0], KEY_MQ_JIT_TO_INTERP);
-    mq_jit_to_interp_id = create_and_configure_mq(mq_jit_to_interp_key);
-    key_t mq_interp_to_jit_key = ftok(argv[0], KEY_MQ_INTERP_TO_JIT);
-    mq_interp_to_jit_id = create_and_configure_mq(mq_interp_to_jit_key);
-
-    cpu_shmem_id = shmget(cpu_shmem_key, sizeof(r4300i_t), IPC_CREAT | 0777);
-    if (cpu_shmem_id == -1) {
-        perror("shmget cpu_shmem_id");
-#ifdef __APPLE__
-        printf("Did you set the sysctl parameters for shared memory? (see comment in dynarec_compare.c)\n");
-#endif
-        exit(1);
-    }
-    n64cpu_interpreter_ptr = shmat(cpu_shmem_id, NULL, 0);
-    if (n64cpu_interpreter_ptr == (void*)-1) {
-        perror("shmat cpu_shmem_id");
-        exit(1);
+    if (checkpoint_frames > 0 && tas_movie_path == NULL) {
+        logwarn("Checkpointing without a movie, replays will only match the original run if there's no input");
     }
 
-    sys_shmem_id = shmget(sys_shmem_key, sizeof(n64_system_t), IPC_CREAT | 0777);
-    if (sys_shmem_id == -1) {
-        perror("shmget sys_shmem_id");
-        exit(1);
-    }
-    n64sys_interpreter_ptr = shmat(sys_shmem_id, NULL, 0);
-    if (n64sys_interpreter_ptr == (void*)-1) {
-        perror("shmat sys_shmem_id");
-        exit(1);
-    }
-
-    joybus_shmem_id = shmget(joybus_shmem_key, sizeof(n64_joybus_device_t) * 6, IPC_CREAT | 0777);
-    if (joybus_shmem_id == -1) {
-        perror("shmget joybus_shmem_id");
-        exit(1);
-    }
-    n64_joybus_device_t* joybus_override = shmat(joybus_shmem_id, NULL, 0);
-    if (joybus_override == (void*)-1) {
-        perror("shmat joybus_shmem_id");
-        exit(1);
-    }
-    memset(joybus_override, 0, sizeof(n64_joybus_device_t) * 6);
-    override_joybus_devices_ptr(joybus_override);
-
-    srand(0); // Deterministic random, before forking
-    pid_t pid = fork();
-    bool is_child = pid == 0;
-
-    if (is_child) {
-        n64cpu_ptr = n64cpu_interpreter_ptr;
-        n64sys_ptr = n64sys_interpreter_ptr;
-    } else {
-        int res = atexit(cleanup_resources);
-        if (res) {
-            perror("atexit");
-        }
-    }
-
-    if (software_mode) {
-        init_n64system(rom_path, true, false, SOFTWARE_VIDEO_TYPE, false);
-        softrdp_init(&n64sys.softrdp_state, (u8 *) &n64sys.mem.rdram);
-    } else {
-        init_n64system(rom_path, true, false, VULKAN_VIDEO_TYPE, false);
-        prdp_init_internal_swapchain();
-        load_imgui_ui();
-        register_imgui_event_handler(imgui_handle_event);
-    }
+    // The shadow system needs an RDP of its own, which only the software one can do
+    audio_select_sink(AUDIO_SINK_NULL, NULL);
+    init_n64system(rom_path, true, false, SOFTWARE_VIDEO_TYPE, false);
+    softrdp_init(&n64sys.softrdp_state, (u8 *) &n64sys.mem.rdram);
 
     if (tas_movie_path != NULL) {
         load_tas_movie(tas_movie_path);
@@ -575,14 +641,16 @@ int main(int argc, char** argv) {
 
     logalways("ROM booted to %016" PRIX64 ", beginning comparison", start_comparing_at);
 
-    if (is_child) {
-        run_compare_child();
-    } else {
 #ifdef LOG_MEMORY_ACCESSES // in n64bus.h
-        init_memory_logger();
+    init_memory_logger();
 #endif
-        N64CPU.prev_branch = false;
-        N64CPU.branch = false;
-        run_compare_parent();
-    }
+    N64CPU.prev_branch = false;
+    N64CPU.branch = false;
+    // Running twice, the frame limiter would only get in the way
+    n64sys.target_fps = 0;
+
+    create_interpreter_side();
+    rdram_dirty_pages = &dirty_pages;
+    run_compare();
+    cflags_free(flags);
 }
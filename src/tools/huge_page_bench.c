@@ -0,0 +1,232 @@
+/*
+ * Measure what huge pages do for TLB misses.
+ *
+ * Runs a ROM headless on the JIT once per huge page mode, each in its own process so every run gets freshly allocated
+ * memory, and reports the host's TLB misses from perf counters next to the page sizes each region actually ended up with.
+ * perf counters need perf_event_paranoid <= 2, without them only the time is reported.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <linux/perf_event.h>
+#include <cflags.h>
+#include <log.h>
+#include <settings.h>
+#include <system/n64system.h>
+#include <system/host_memory.h>
+#include <mem/pif.h>
+
+#define MAX_REGIONS 8
+
+typedef enum bench_counter {
+    COUNTER_CYCLES,
+    COUNTER_INSTRUCTIONS,
+    COUNTER_DTLB_MISSES,
+    COUNTER_ITLB_MISSES,
+    NUM_COUNTERS
+} bench_counter_t;
+
+static const char* counter_names[NUM_COUNTERS] = {
+    "host cycles",
+    "host instructions",
+    "dTLB load misses",
+    "iTLB load misses",
+};
+
+typedef struct bench_result {
+    bool ok;
+    double seconds;
+    u64 guest_cycles;
+    bool counter_valid[NUM_COUNTERS];
+    u64 counters[NUM_COUNTERS];
+    int num_regions;
+    host_memory_usage_t regions[MAX_REGIONS];
+} bench_result_t;
+
+void usage(cflags_t* flags) {
+    cflags_print_usage(flags,
+                       "[OPTION]... FILE",
+                       "n64 huge page benchmark",
+                       "https://github.com/Dillonb/n64");
+}
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int open_counter(bench_counter_t counter) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    switch (counter) {
+        case COUNTER_CYCLES:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case COUNTER_INSTRUCTIONS:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case COUNTER_DTLB_MISSES:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case COUNTER_ITLB_MISSES:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_ITLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        default:
+            logfatal("Unknown counter %d", counter);
+    }
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void run(const char* rom_path, const char* pif_rom_path, n64_huge_pages_t huge_pages, u64 warmup, u64 target, bench_result_t* result) {
+    n64_settings.huge_pages = huge_pages;
+    init_n64system(rom_path, false, false, UNKNOWN_VIDEO_TYPE, false);
+    if (pif_rom_path) {
+        load_pif_rom(pif_rom_path);
+    }
+    pif_rom_execute();
+
+    for (u64 cycles = 0; cycles < warmup;) {
+        cycles += n64_system_step(true, 1);
+    }
+
+    int fds[NUM_COUNTERS];
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        fds[i] = open_counter(i);
+        if (fds[i] >= 0) {
+            ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    double start = now_seconds();
+    u64 cycles = 0;
+    while (cycles < target) {
+        cycles += n64_system_step(true, 1);
+    }
+    result->seconds = now_seconds() - start;
+    result->guest_cycles = cycles;
+
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        if (fds[i] >= 0) {
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            result->counter_valid[i] = read(fds[i], &result->counters[i], sizeof(u64)) == sizeof(u64);
+            close(fds[i]);
+        }
+    }
+
+    result->num_regions = host_memory_usage(result->regions, MAX_REGIONS);
+    result->ok = true;
+}
+
+// Runs in a child process, so the allocations from one mode don't stick around for the next
+static bool run_in_child(const char* rom_path, const char* pif_rom_path, n64_huge_pages_t huge_pages, u64 warmup, u64 target, bench_result_t* result) {
+    int pipe_fds[2];
+    if (pipe(pipe_fds) != 0) {
+        logfatal("Failed to create a pipe");
+    }
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        logfatal("Failed to fork");
+    }
+    if (pid == 0) {
+        close(pipe_fds[0]);
+        bench_result_t child_result;
+        memset(&child_result, 0, sizeof(child_result));
+        run(rom_path, pif_rom_path, huge_pages, warmup, target, &child_result);
+        if (write(pipe_fds[1], &child_result, sizeof(child_result)) != sizeof(child_result)) {
+            _exit(1);
+        }
+        _exit(0);
+    }
+
+    close(pipe_fds[1]);
+    memset(result, 0, sizeof(*result));
+    size_t received = 0;
+    while (received < sizeof(*result)) {
+        ssize_t n = read(pipe_fds[0], (u8*)result + received, sizeof(*result) - received);
+        if (n <= 0) {
+            break;
+        }
+        received += n;
+    }
+    close(pipe_fds[0]);
+    int status;
+    waitpid(pid, &status, 0);
+    return received == sizeof(*result) && result->ok;
+}
+
+static void print_result(n64_huge_pages_t huge_pages, const bench_result_t* result) {
+    printf("huge_pages=%s: %" PRIu64 " guest cycles in %.3f seconds\n",
+           huge_pages_to_str(huge_pages), result->guest_cycles, result->seconds);
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        if (result->counter_valid[i]) {
+            printf("  %-18s %14" PRIu64 "  %8.3f per thousand guest cycles\n",
+                   counter_names[i], result->counters[i], (double)result->counters[i] * 1000.0 / (double)result->guest_cycles);
+        } else {
+            printf("  %-18s %14s\n", counter_names[i], "unavailable");
+        }
+    }
+    for (int i = 0; i < result->num_regions; i++) {
+        const host_memory_usage_t* region = &result->regions[i];
+        printf("  %-14s %8zu KiB with %-22s %8zu KiB in huge pages, largest page %zu KiB\n",
+               region->region.name, region->region.size / 1024, region->region.backing,
+               region->huge_bytes / 1024, region->page_size / 1024);
+    }
+}
+
+int main(int argc, char** argv) {
+    cflags_t* flags = cflags_init();
+    cflags_flag_t * verbose = cflags_add_bool(flags, 'v', "verbose", NULL, "enables verbose output, repeat up to 4 times for more verbosity");
+
+    const char* pif_rom_path = NULL;
+    cflags_add_string(flags, 'p', "pif", &pif_rom_path, "Load PIF ROM");
+
+    int millions = 500;
+    cflags_add_int(flags, 'n', "cycles", &millions, "Number of guest cycles to measure, in millions (default 500)");
+
+    int warmup_millions = 100;
+    cflags_add_int(flags, 'w', "warmup", &warmup_millions, "Number of guest cycles to run before measuring, so most code is already compiled, in millions (default 100)");
+
+    const char* mode = NULL;
+    cflags_add_string(flags, 'm', "mode", &mode, "Only run with this huge page mode: off, transparent or auto (default: all of them)");
+
+    cflags_parse(flags, argc, argv);
+
+    n64_huge_pages_t only_mode;
+    if (flags->argc != 1 || millions <= 0 || warmup_millions < 0 || (mode != NULL && !str_to_huge_pages(mode, &only_mode))) {
+        usage(flags);
+        return 1;
+    }
+
+    log_set_verbosity(verbose->count);
+
+    n64_huge_pages_t modes[] = { HUGE_PAGES_OFF, HUGE_PAGES_TRANSPARENT, HUGE_PAGES_AUTO };
+    bool failed = false;
+    for (int i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+        if (mode != NULL && modes[i] != only_mode) {
+            continue;
+        }
+        bench_result_t result;
+        if (run_in_child(flags->argv[0], pif_rom_path, modes[i], (u64)warmup_millions * 1000000, (u64)millions * 1000000, &result)) {
+            print_result(modes[i], &result);
+        } else {
+            printf("huge_pages=%s: run failed\n", huge_pages_to_str(modes[i]));
+            failed = true;
+        }
+    }
+    return failed ? 1 : 0;
+}
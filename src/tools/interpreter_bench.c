@@ -0,0 +1,76 @@
+/*
+ * Measure raw r4300i interpreter throughput.
+ *
+ * Runs a ROM headless on the interpreter for a fixed number of instructions and reports MIPS.
+ * Useful for comparing interpreter dispatch changes without the frontend or the JIT in the way.
+ */
+#include <stdio.h>
+#include <time.h>
+#include <cflags.h>
+#include <log.h>
+#include <system/n64system.h>
+#include <mem/pif.h>
+
+void usage(cflags_t* flags) {
+    cflags_print_usage(flags,
+                       "[OPTION]... FILE",
+                       "n64 interpreter benchmark",
+                       "https://github.com/Dillonb/n64");
+}
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char** argv) {
+    cflags_t* flags = cflags_init();
+    cflags_flag_t * verbose = cflags_add_bool(flags, 'v', "verbose", NULL, "enables verbose output, repeat up to 4 times for more verbosity");
+
+    const char* pif_rom_path = NULL;
+    cflags_add_string(flags, 'p', "pif", &pif_rom_path, "Load PIF ROM");
+
+    int millions = 100;
+    cflags_add_int(flags, 'n', "instructions", &millions, "Number of instructions to run, in millions (default 100)");
+
+    int warmup_millions = 10;
+    cflags_add_int(flags, 'w', "warmup", &warmup_millions, "Number of instructions to run before timing starts, in millions (default 10)");
+
+    int chunk = 1;
+    cflags_add_int(flags, 'c', "chunk", &chunk, "Instructions per system step (default 1, the same as the normal interpreter loop)");
+
+    cflags_parse(flags, argc, argv);
+
+    if (flags->argc != 1 || millions <= 0 || warmup_millions < 0 || chunk <= 0) {
+        usage(flags);
+        return 1;
+    }
+
+    log_set_verbosity(verbose->count);
+
+    init_n64system(flags->argv[0], false, false, UNKNOWN_VIDEO_TYPE, true);
+
+    if (pif_rom_path) {
+        load_pif_rom(pif_rom_path);
+    }
+    pif_rom_execute();
+
+    u64 warmup = (u64)warmup_millions * 1000000;
+    for (u64 executed = 0; executed < warmup; executed += chunk) {
+        n64_system_step(false, chunk);
+    }
+
+    u64 target = (u64)millions * 1000000;
+    u64 executed = 0;
+    double start = now_seconds();
+    while (executed < target) {
+        n64_system_step(false, chunk);
+        executed += chunk;
+    }
+    double elapsed = now_seconds() - start;
+
+    logalways("Executed %" PRIu64 " instructions in %.3f seconds: %.2f MIPS", executed, elapsed, (double)executed / elapsed / 1e6);
+
+    n64_system_cleanup();
+}
@@ -0,0 +1,190 @@
+/*
+ * Measure how long the JIT takes to compile blocks.
+ *
+ * Replays a block corpus written by the emulator's --capture-blocks flag through the compiler, without running or
+ * installing anything, and reports compile time percentiles, generated code size and IR size. Useful for comparing
+ * compiler changes against the same set of real blocks.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cflags.h>
+#include <log.h>
+#include <system/n64system.h>
+#include <cpu/dynarec/dynarec.h>
+#include <cpu/dynarec/block_corpus.h>
+#include "jit_rs.h"
+
+typedef struct corpus_block {
+    block_corpus_record_t record;
+    u32* code;
+} corpus_block_t;
+
+typedef struct block_sample {
+    u64 frontend_ns;
+    u64 backend_ns;
+} block_sample_t;
+
+void usage(cflags_t* flags) {
+    cflags_print_usage(flags,
+                       "[OPTION]... CORPUS",
+                       "n64 JIT compile time benchmark",
+                       "https://github.com/Dillonb/n64");
+}
+
+static corpus_block_t* load_corpus(const char* path, int* num_blocks) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        logdie("Unable to open %s", path);
+    }
+
+    block_corpus_header_t header;
+    if (fread(&header, sizeof(header), 1, f) != 1 || memcmp(header.magic, BLOCK_CORPUS_MAGIC, sizeof(header.magic)) != 0) {
+        logdie("%s is not a block corpus", path);
+    }
+    if (header.version != BLOCK_CORPUS_VERSION) {
+        logdie("%s is block corpus version %u, expected %u", path, header.version, BLOCK_CORPUS_VERSION);
+    }
+    logalways("Loading blocks captured from %.20s", header.image_name);
+
+    int capacity = 1024;
+    int count = 0;
+    corpus_block_t* blocks = malloc(capacity * sizeof(corpus_block_t));
+
+    block_corpus_record_t record;
+    while (fread(&record, sizeof(record), 1, f) == 1) {
+        if (count == capacity) {
+            capacity *= 2;
+            blocks = realloc(blocks, capacity * sizeof(corpus_block_t));
+        }
+        blocks[count].record = record;
+        blocks[count].code = malloc(record.num_instructions * sizeof(u32));
+        if (fread(blocks[count].code, sizeof(u32), record.num_instructions, f) != record.num_instructions) {
+            logdie("%s is truncated after %d blocks", path, count);
+        }
+        count++;
+    }
+    fclose(f);
+
+    *num_blocks = count;
+    return blocks;
+}
+
+static void compile_block(corpus_block_t* block, JitCompileStats* stats) {
+    // The state the compiler looks at when deciding what code to emit
+    memcpy(N64CPU.gpr, block->record.gpr, sizeof(N64CPU.gpr));
+    N64CP0.status.raw = block->record.cp0_status;
+    N64CPU.fcr31.raw = block->record.fcr31;
+    n64dynarec.sysconfig.raw = block->record.sysconfig;
+
+    rs_jit_compile_block_for_benchmark(block->code, block->record.num_instructions,
+                                       block->record.virtual_address, block->record.physical_address,
+                                       n64cpu_ptr, stats);
+}
+
+static int compare_u64(const void* a, const void* b) {
+    u64 x = *(const u64*)a;
+    u64 y = *(const u64*)b;
+    return (x > y) - (x < y);
+}
+
+static void print_percentiles(const char* name, u64* values, int count) {
+    qsort(values, count, sizeof(u64), compare_u64);
+    logalways("%-9s p50 %8.2f us  p90 %8.2f us  p99 %8.2f us  max %8.2f us",
+              name,
+              values[count * 50 / 100] / 1000.0,
+              values[count * 90 / 100] / 1000.0,
+              values[count * 99 / 100] / 1000.0,
+              values[count - 1] / 1000.0);
+}
+
+int main(int argc, char** argv) {
+    cflags_t* flags = cflags_init();
+    cflags_flag_t * verbose = cflags_add_bool(flags, 'v', "verbose", NULL, "enables verbose output, repeat up to 4 times for more verbosity");
+
+    int iterations = 5;
+    cflags_add_int(flags, 'n', "iterations", &iterations, "Number of times to compile every block, the fastest time for each block is kept (default 5)");
+
+    int warmup = 1;
+    cflags_add_int(flags, 'w', "warmup", &warmup, "Number of untimed passes over the corpus before timing starts (default 1)");
+
+    cflags_parse(flags, argc, argv);
+
+    if (flags->argc != 1 || iterations <= 0 || warmup < 0) {
+        usage(flags);
+        return 1;
+    }
+
+    log_set_verbosity(verbose->count);
+
+    int num_blocks;
+    corpus_block_t* blocks = load_corpus(flags->argv[0], &num_blocks);
+    if (num_blocks == 0) {
+        logdie("No blocks in %s", flags->argv[0]);
+    }
+
+    // No ROM needed, only a CPU for the compiler to look at
+    init_n64system(NULL, false, false, UNKNOWN_VIDEO_TYPE, false);
+
+    JitCompileStats stats;
+    for (int pass = 0; pass < warmup; pass++) {
+        for (int i = 0; i < num_blocks; i++) {
+            compile_block(&blocks[i], &stats);
+        }
+    }
+
+    // Keep each block's fastest run, the slower ones are mostly noise from the rest of the system
+    block_sample_t* best = malloc(num_blocks * sizeof(block_sample_t));
+    u64 guest_instructions = 0;
+    u64 host_bytes = 0;
+    u64 ir_lines = 0;
+    u64 max_ir_lines = 0;
+    for (int i = 0; i < num_blocks; i++) {
+        best[i].frontend_ns = UINT64_MAX;
+        best[i].backend_ns = UINT64_MAX;
+        for (int pass = 0; pass < iterations; pass++) {
+            compile_block(&blocks[i], &stats);
+            if (stats.frontend_ns + stats.backend_ns < best[i].frontend_ns + best[i].backend_ns) {
+                best[i].frontend_ns = stats.frontend_ns;
+                best[i].backend_ns = stats.backend_ns;
+            }
+        }
+        // Code generation is deterministic, so the last pass is as good as any for sizes
+        guest_instructions += blocks[i].record.num_instructions;
+        host_bytes += stats.host_bytes;
+        ir_lines += stats.ir_lines;
+        if (stats.ir_lines > max_ir_lines) {
+            max_ir_lines = stats.ir_lines;
+        }
+    }
+
+    u64* frontend = malloc(num_blocks * sizeof(u64));
+    u64* backend = malloc(num_blocks * sizeof(u64));
+    u64* total = malloc(num_blocks * sizeof(u64));
+    u64 total_ns = 0;
+    for (int i = 0; i < num_blocks; i++) {
+        frontend[i] = best[i].frontend_ns;
+        backend[i] = best[i].backend_ns;
+        total[i] = best[i].frontend_ns + best[i].backend_ns;
+        total_ns += total[i];
+    }
+
+    logalways("%d blocks, %" PRIu64 " guest instructions, %.3f ms total compile time",
+              num_blocks, guest_instructions, total_ns / 1e6);
+    print_percentiles("frontend", frontend, num_blocks);
+    print_percentiles("backend", backend, num_blocks);
+    print_percentiles("total", total, num_blocks);
+    logalways("%.2f ns per guest instruction", (double)total_ns / guest_instructions);
+    logalways("%.2f host bytes per guest instruction", (double)host_bytes / guest_instructions);
+    logalways("IR lines per block: mean %.1f, max %" PRIu64, (double)ir_lines / num_blocks, max_ir_lines);
+
+    free(frontend);
+    free(backend);
+    free(total);
+    free(best);
+    for (int i = 0; i < num_blocks; i++) {
+        free(blocks[i].code);
+    }
+    free(blocks);
+    n64_system_cleanup();
+}
@@ -0,0 +1,140 @@
+/*
+ * Measure the software RDP span kernels against their scalar versions.
+ *
+ * Each kernel draws the same set of spans with both versions, checks they wrote the same thing, and reports Mpixels/s.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <cflags.h>
+#include <log.h>
+#include <rdp/softrdp_span.h>
+
+#define BENCH_RDRAM_SIZE (8 * 1024 * 1024)
+#define BENCH_TMEM_SIZE 0x1000
+#define NUM_SPANS 1024
+
+typedef struct bench_span {
+    u32 dst;
+    u32 src;
+    u32 tmem_xor;
+    int pixels;
+} bench_span_t;
+
+typedef void (*span_kernel_t)(u8* rdram, const u8* tmem, const bench_span_t* span, int bytes_per_pixel);
+
+static u8 rdram_kernel[BENCH_RDRAM_SIZE];
+static u8 rdram_scalar[BENCH_RDRAM_SIZE];
+static u8 tmem[BENCH_TMEM_SIZE];
+static bench_span_t spans[NUM_SPANS];
+
+void usage(cflags_t* flags) {
+    cflags_print_usage(flags,
+                       "[OPTION]...",
+                       "software RDP span kernel benchmark",
+                       "https://github.com/Dillonb/n64");
+}
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void fill_kernel(u8* rdram, const u8* unused, const bench_span_t* span, int bytes_per_pixel) {
+    softrdp_fill_span(rdram, span->dst, span->pixels * bytes_per_pixel, 0xF801F801);
+}
+
+static void fill_scalar(u8* rdram, const u8* unused, const bench_span_t* span, int bytes_per_pixel) {
+    softrdp_fill_span_scalar(rdram, span->dst, span->pixels * bytes_per_pixel, 0xF801F801);
+}
+
+static void copy_kernel(u8* rdram, const u8* tmem, const bench_span_t* span, int bytes_per_pixel) {
+    if (!softrdp_copy_span16(rdram, span->dst, tmem, span->src, span->tmem_xor, span->pixels)) {
+        softrdp_copy_span16_scalar(rdram, span->dst, tmem, span->src, span->tmem_xor, span->pixels);
+    }
+}
+
+static void copy_scalar(u8* rdram, const u8* tmem, const bench_span_t* span, int bytes_per_pixel) {
+    softrdp_copy_span16_scalar(rdram, span->dst, tmem, span->src, span->tmem_xor, span->pixels);
+}
+
+// Spans the width of a framebuffer line, starting on any pixel. Copies read a TMEM line the same alignment as the destination,
+// the way a copy mode rectangle of a texture loaded at the same x offset would.
+static void generate_spans(int max_pixels, int bytes_per_pixel, bool copy) {
+    for (int i = 0; i < NUM_SPANS; i++) {
+        bench_span_t* span = &spans[i];
+        span->pixels = 1 + rand() % max_pixels;
+        int x = rand() % 16;
+        int y = rand() % 240;
+        span->dst = 0x100000 + (y * 640 + x) * bytes_per_pixel;
+        span->tmem_xor = copy ? (rand() & 1) << 2 : 0;
+        span->src = (x * bytes_per_pixel) & 7;
+        if (span->src + span->pixels * 2 > 0x800) {
+            span->pixels = (0x800 - span->src) / 2;
+        }
+    }
+}
+
+static double time_kernel(span_kernel_t kernel, u8* rdram, int bytes_per_pixel, int iterations, u64* pixels) {
+    *pixels = 0;
+    double start = now_seconds();
+    for (int iteration = 0; iteration < iterations; iteration++) {
+        for (int i = 0; i < NUM_SPANS; i++) {
+            kernel(rdram, tmem, &spans[i], bytes_per_pixel);
+            *pixels += spans[i].pixels;
+        }
+    }
+    return now_seconds() - start;
+}
+
+static bool bench(const char* name, span_kernel_t kernel, span_kernel_t scalar, int bytes_per_pixel, int iterations) {
+    memset(rdram_kernel, 0, BENCH_RDRAM_SIZE);
+    memset(rdram_scalar, 0, BENCH_RDRAM_SIZE);
+
+    u64 pixels;
+    double scalar_time = time_kernel(scalar, rdram_scalar, bytes_per_pixel, iterations, &pixels);
+    double kernel_time = time_kernel(kernel, rdram_kernel, bytes_per_pixel, iterations, &pixels);
+
+    bool matches = memcmp(rdram_kernel, rdram_scalar, BENCH_RDRAM_SIZE) == 0;
+    double scalar_mpix = (double)pixels / scalar_time / 1e6;
+    double kernel_mpix = (double)pixels / kernel_time / 1e6;
+    logalways("%-12s scalar: %9.1f Mpixels/s kernel: %9.1f Mpixels/s (%.1fx)%s",
+              name, scalar_mpix, kernel_mpix, kernel_mpix / scalar_mpix, matches ? "" : " OUTPUT DIFFERS");
+    return matches;
+}
+
+int main(int argc, char** argv) {
+    cflags_t* flags = cflags_init();
+
+    int iterations = 2000;
+    cflags_add_int(flags, 'n', "iterations", &iterations, "Number of times to draw each set of spans (default 2000)");
+
+    int max_pixels = 320;
+    cflags_add_int(flags, 'w', "width", &max_pixels, "Maximum span width in pixels (default 320)");
+
+    cflags_parse(flags, argc, argv);
+
+    if (flags->argc != 0 || iterations <= 0 || max_pixels <= 0 || max_pixels > 640) {
+        usage(flags);
+        return 1;
+    }
+
+    srand(0x64);
+    for (int i = 0; i < BENCH_TMEM_SIZE; i++) {
+        tmem[i] = rand();
+    }
+
+    bool matches = true;
+
+    generate_spans(max_pixels, 2, false);
+    matches &= bench("fill 16bpp", fill_kernel, fill_scalar, 2, iterations);
+
+    generate_spans(max_pixels, 4, false);
+    matches &= bench("fill 32bpp", fill_kernel, fill_scalar, 4, iterations);
+
+    generate_spans(max_pixels, 2, true);
+    matches &= bench("copy 16bpp", copy_kernel, copy_scalar, 2, iterations);
+
+    return matches ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+/*
+ * Decode a binary trace written with --trace.
+ *
+ * Prints every record as text, optionally only some events. With -c, instead replays the ROM on the interpreter and checks
+ * it against the trace's cpu_state events one instruction at a time, stopping at the first difference.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cflags.h>
+#include <log.h>
+#include <trace.h>
+#include <system/n64system.h>
+#include <mem/pif.h>
+#include <r4300i.h>
+
+void usage(cflags_t* flags) {
+    cflags_print_usage(flags,
+                       "[OPTION]... FILE",
+                       "n64 trace decoder",
+                       "https://github.com/Dillonb/n64");
+}
+
+typedef struct trace_reader {
+    FILE* fp;
+    trace_file_header_t header;
+    // Left in the current chunk
+    u32 chunk_remaining;
+    u32 thread;
+} trace_reader_t;
+
+typedef struct trace_record {
+    u32 thread;
+    trace_record_header_t header;
+    u8 payload[512];
+} trace_record_t;
+
+static void read_exactly(trace_reader_t* reader, void* buf, size_t size) {
+    if (fread(buf, 1, size, reader->fp) != size) {
+        logfatal("Trace file is truncated");
+    }
+}
+
+static void open_trace(trace_reader_t* reader, const char* path) {
+    reader->fp = fopen(path, "rb");
+    if (reader->fp == NULL) {
+        logfatal("Failed to open %s", path);
+    }
+    read_exactly(reader, &reader->header, sizeof(reader->header));
+    if (memcmp(reader->header.magic, TRACE_FILE_MAGIC, sizeof(reader->header.magic)) != 0) {
+        logfatal("%s is not a trace file", path);
+    }
+    if (reader->header.version != TRACE_FILE_VERSION) {
+        logfatal("%s is trace version %u, this decoder only reads version %d", path, reader->header.version, TRACE_FILE_VERSION);
+    }
+    reader->chunk_remaining = 0;
+}
+
+// Returns false at the end of the file
+static bool next_record(trace_reader_t* reader, trace_record_t* record) {
+    while (reader->chunk_remaining == 0) {
+        trace_chunk_header_t chunk;
+        if (fread(&chunk, sizeof(chunk), 1, reader->fp) != 1) {
+            return false;
+        }
+        if (chunk.dropped > 0) {
+            printf("[thread %u] %" PRIu64 " events dropped\n", chunk.thread, chunk.dropped);
+        }
+        reader->chunk_remaining = chunk.bytes;
+        reader->thread = chunk.thread;
+    }
+
+    read_exactly(reader, &record->header, sizeof(record->header));
+    if (record->header.size > sizeof(record->payload) || sizeof(record->header) + record->header.size > reader->chunk_remaining) {
+        logfatal("Corrupt trace record: event %u, size %u", record->header.event, record->header.size);
+    }
+    read_exactly(reader, record->payload, record->header.size);
+    record->thread = reader->thread;
+    reader->chunk_remaining -= sizeof(record->header) + record->header.size;
+    return true;
+}
+
+static void print_gprs(const u64* gpr) {
+    for (int i = 0; i < 32; i++) {
+        printf("%s%016" PRIX64, i == 0 ? "" : " ", gpr[i]);
+    }
+}
+
+static void print_record(const trace_reader_t* reader, const trace_record_t* record) {
+    double us = (double)record->header.timestamp * 1e6 / (double)reader->header.ticks_per_second;
+    printf("[thread %u] %16.3fus %-15s ", record->thread, us, trace_event_name(record->header.event));
+
+    switch (record->header.event) {
+        case TRACE_EVENT_CPU_STATE: {
+            const trace_cpu_state_t* state = (const trace_cpu_state_t*)record->payload;
+            printf("pc %016" PRIX64 " cause %08X mi_intr %08X ", state->pc, state->cp0_cause, state->mi_intr);
+            print_gprs(state->gpr);
+            break;
+        }
+        case TRACE_EVENT_JIT_SYNC_POINT: {
+            const trace_jit_sync_point_t* sync = (const trace_jit_sync_point_t*)record->payload;
+            printf("taken %d pc %08X ", sync->taken, (u32)sync->pc);
+            print_gprs(sync->gpr);
+            break;
+        }
+        case TRACE_EVENT_BLOCK_COMPILED: {
+            const trace_block_compiled_t* block = (const trace_block_compiled_t*)record->payload;
+            printf("vaddr %016" PRIX64 " paddr %08X guest size %u", block->virtual_address, block->physical_address, block->guest_size);
+            break;
+        }
+        case TRACE_EVENT_IDLE_LOOP: {
+            const trace_idle_loop_t* idle = (const trace_idle_loop_t*)record->payload;
+            printf("vaddr %016" PRIX64, idle->virtual_address);
+            break;
+        }
+        case TRACE_EVENT_RDP_COMMAND: {
+            const trace_rdp_command_t* command = (const trace_rdp_command_t*)record->payload;
+            printf("command %02X:", (command->words[0] >> 24) & 0x3F);
+            for (u32 i = 0; i < command->length && i < TRACE_RDP_COMMAND_MAX_WORDS; i++) {
+                printf(" %08X", command->words[i]);
+            }
+            break;
+        }
+        default:
+            printf("%u bytes", record->header.size);
+            break;
+    }
+    printf("\n");
+}
+
+// Steps the interpreter once per cpu_state event and compares the state before each instruction
+static void check_cpu_state(trace_reader_t* reader) {
+    trace_record_t record;
+    u64 instruction = 0;
+    while (next_record(reader, &record)) {
+        if (record.header.event != TRACE_EVENT_CPU_STATE) {
+            continue;
+        }
+        const trace_cpu_state_t* expected = (const trace_cpu_state_t*)record.payload;
+        instruction++;
+
+        bool bad = false;
+        if (expected->pc != N64CPU.pc) {
+            logalways("PC is wrong: expected %016" PRIX64 " but was %016" PRIX64, expected->pc, N64CPU.pc);
+            bad = true;
+        }
+        for (int i = 0; i < 32; i++) {
+            if (expected->gpr[i] != N64CPU.gpr[i]) {
+                logalways("r%d is wrong: expected %016" PRIX64 " but was %016" PRIX64, i, expected->gpr[i], N64CPU.gpr[i]);
+                bad = true;
+            }
+        }
+        if (expected->cp0_cause != N64CP0.cause.raw) {
+            cp0_cause_t cause = { .raw = expected->cp0_cause };
+            logalways("CP0 Cause is wrong: expected %08X but was %08X", expected->cp0_cause, N64CP0.cause.raw);
+            if (cause.exception_code != N64CP0.cause.exception_code) logalways("expected exception_code: %d actual: %d", cause.exception_code, N64CP0.cause.exception_code);
+            if (cause.interrupt_pending != N64CP0.cause.interrupt_pending) logalways("expected interrupt_pending: %02X actual: %02X", cause.interrupt_pending, N64CP0.cause.interrupt_pending);
+            if (cause.coprocessor_error != N64CP0.cause.coprocessor_error) logalways("expected coprocessor_error: %d actual: %d", cause.coprocessor_error, N64CP0.cause.coprocessor_error);
+            if (cause.branch_delay != N64CP0.cause.branch_delay) logalways("expected branch_delay: %d actual: %d", cause.branch_delay, N64CP0.cause.branch_delay);
+            bad = true;
+        }
+        if (expected->mi_intr != n64sys.mi.intr.raw) {
+            // Reported, but interrupts are allowed to be raised a little early or late
+            logalways("MI intr is different: expected %08X but was %08X", expected->mi_intr, n64sys.mi.intr.raw);
+        }
+        if (bad) {
+            logfatal("Found a difference at instruction %" PRIu64 "!", instruction);
+        }
+        n64_system_step(false, 1);
+    }
+    logalways("No differences in %" PRIu64 " instructions", instruction);
+}
+
+int main(int argc, char** argv) {
+    cflags_t* flags = cflags_init();
+    cflags_flag_t * verbose = cflags_add_bool(flags, 'v', "verbose", NULL, "enables verbose output, repeat up to 4 times for more verbosity");
+
+    const char* events = NULL;
+    cflags_add_string(flags, 'e', "events", &events, "Comma separated events to print, default all");
+
+    const char* check_rom = NULL;
+    cflags_add_string(flags, 'c', "check", &check_rom, "Run this ROM on the interpreter and check it against the trace's cpu_state events");
+
+    const char* pif_rom_path = NULL;
+    cflags_add_string(flags, 'p', "pif", &pif_rom_path, "Load PIF ROM, with -c");
+
+    cflags_parse(flags, argc, argv);
+
+    if (flags->argc != 1) {
+        usage(flags);
+        return 1;
+    }
+
+    u64 event_mask = ~0ULL;
+    if (events != NULL && !trace_parse_event_list(events, &event_mask)) {
+        usage(flags);
+        return 1;
+    }
+
+    log_set_verbosity(verbose->count);
+
+    trace_reader_t reader;
+    open_trace(&reader, flags->argv[0]);
+
+    if (check_rom) {
+        init_n64system(check_rom, false, false, UNKNOWN_VIDEO_TYPE, true);
+        if (pif_rom_path) {
+            load_pif_rom(pif_rom_path);
+        }
+        pif_rom_execute();
+        check_cpu_state(&reader);
+        n64_system_cleanup();
+    } else {
+        trace_record_t record;
+        while (next_record(&reader, &record)) {
+            if (record.header.event < 64 && (event_mask & TRACE_EVENT_MASK(record.header.event))) {
+                print_record(&reader, &record);
+            }
+        }
+    }
+
+    fclose(reader.fp);
+    cflags_free(flags);
+    return 0;
+}
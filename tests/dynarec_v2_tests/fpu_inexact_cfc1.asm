@@ -0,0 +1,18 @@
+arch n64.cpu
+endian msb
+
+include "regs.inc"
+
+origin $00000000
+base $80000000
+
+//; 1.0 + 2^-24 rounds back to 1.0, which raises inexact. CFC1 right after has to see the sticky flag.
+lui t0, $3F80
+dd $44880000 //; mtc1 t0, f0
+lui t1, $3380
+dd $44890800 //; mtc1 t1, f1
+dd $46010080 //; add.s f2, f0, f1
+dd $444AF800 //; cfc1 t2, fcr31
+end:
+beq r0, r0, end
+nop
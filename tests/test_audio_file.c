@@ -0,0 +1,96 @@
+#include <stdlib.h>
+#include <string.h>
+#include <frontend/audio_file.h>
+#include "unit.h"
+
+// Writes frames through the WAV and raw sinks and reads the files back.
+
+#define FRAMES 3000
+#define SILENCE 100
+
+static u32 frames[FRAMES];
+
+static u8* read_file(const char* path, long* size) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        *size = 0;
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    u8* data = malloc(*size);
+    if (fread(data, 1, *size, f) != (size_t)*size) {
+        *size = 0;
+    }
+    fclose(f);
+    return data;
+}
+
+static u32 le32(const u8* data) {
+    return data[0] | data[1] << 8 | data[2] << 16 | (u32)data[3] << 24;
+}
+
+static u16 le16(const u8* data) {
+    return data[0] | data[1] << 8;
+}
+
+// Samples are left then right, each little endian
+static int count_sample_mismatches(const u8* samples) {
+    int mismatches = 0;
+    for (int i = 0; i < FRAMES; i++) {
+        mismatches += le16(&samples[i * 4]) != frames[i] >> 16;
+        mismatches += le16(&samples[i * 4 + 2]) != (frames[i] & 0xFFFF);
+    }
+    for (int i = FRAMES * 4; i < (FRAMES + SILENCE) * 4; i++) {
+        mismatches += samples[i] != 0;
+    }
+    return mismatches;
+}
+
+static void write_test_file(const char* path, bool wav) {
+    ASSERT_TRUE(audio_file_open(path, wav), "opens %s", path);
+    audio_file_set_sample_rate(32000);
+    // Split at an odd point, bigger than the sink's internal chunk
+    audio_file_write_frames(frames, 1234);
+    audio_file_write_frames(&frames[1234], FRAMES - 1234);
+    audio_file_write_silence(SILENCE);
+    audio_file_close();
+}
+
+int main(int argc, char** argv) {
+    srand(0x64);
+    for (int i = 0; i < FRAMES; i++) {
+        frames[i] = (u32)rand() << 16 ^ rand();
+    }
+
+    const char* wav_path = "test_audio_file.wav";
+    write_test_file(wav_path, true);
+    long size;
+    u8* wav = read_file(wav_path, &size);
+    ASSERT_EQ(size, 44 + (FRAMES + SILENCE) * 4, "WAV file size");
+    if (size == 44 + (FRAMES + SILENCE) * 4) {
+        ASSERT_TRUE(memcmp(wav, "RIFF", 4) == 0 && memcmp(&wav[8], "WAVEfmt ", 8) == 0, "WAV header tags");
+        ASSERT_EQ(le32(&wav[4]), size - 8, "RIFF chunk size");
+        ASSERT_EQ(le16(&wav[22]), 2, "WAV channels");
+        ASSERT_EQ(le32(&wav[24]), 32000, "WAV sample rate");
+        ASSERT_EQ(le32(&wav[28]), 32000 * 4, "WAV byte rate");
+        ASSERT_EQ(le16(&wav[34]), 16, "WAV bits per sample");
+        ASSERT_EQ(le32(&wav[40]), (FRAMES + SILENCE) * 4, "WAV data size");
+        ASSERT_EQ(count_sample_mismatches(&wav[44]), 0, "WAV samples match the frames");
+    }
+    free(wav);
+    remove(wav_path);
+
+    const char* raw_path = "test_audio_file.raw";
+    write_test_file(raw_path, false);
+    u8* raw = read_file(raw_path, &size);
+    ASSERT_EQ(size, (FRAMES + SILENCE) * 4, "raw file size");
+    if (size == (FRAMES + SILENCE) * 4) {
+        ASSERT_EQ(count_sample_mismatches(raw), 0, "raw samples match the frames");
+    }
+    free(raw);
+    remove(raw_path);
+
+    return tests_failed != 0;
+}
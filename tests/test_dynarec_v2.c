@@ -59,7 +59,55 @@ void test_branch_likely(bool jit) {
     logalways("[PASSED ] Branch likely test with %s", jit ? "dynarec" : "interpreter");
 }
 
+void init_fpu_test(const char* path) {
+    init_n64system(NULL, false, false, UNKNOWN_VIDEO_TYPE, false);
+    N64CP0.status.cu1 = true;
+    cp0_status_updated();
+    N64CPU.fcr31.raw = 0;
+    fcr31_updated(N64CPU.fcr31.raw);
+    set_pc_word_r4300i(0x80000000);
+
+    load_code(path);
+}
+
+void test_fpu_inexact_cfc1(bool jit) {
+    logalways("[RUNNING] FPU inexact flag test with %s", jit ? "dynarec" : "interpreter");
+    init_fpu_test("dynarec_v2_tests/fpu_inexact_cfc1.bin");
+
+    if (jit) {
+        n64_system_step(true, -1);
+    } else {
+        // Up to and including the CFC1
+        for (int i = 0; i < 6; i++) {
+            n64_system_step(false, 1);
+        }
+    }
+
+    // The sticky inexact flag, and no others
+    assert_eq_u64("cfc1 fcr31 flags", (u64)0x04, N64CPU.gpr[MIPS_REG_T2] & 0x7C);
+    assert_eq_u64("fcr31 flags", (u64)0x04, (u64)(N64CPU.fcr31.raw & 0x7C));
+    logalways("[PASSED ] FPU inexact flag test with %s", jit ? "dynarec" : "interpreter");
+}
+
+// The same check dynarec_compare makes: one block on the dynarec, as many steps on the interpreter, and the CPU states hash the same
+void test_fpu_inexact_block_compare() {
+    logalways("[RUNNING] FPU inexact block compare test");
+    init_fpu_test("dynarec_v2_tests/fpu_inexact_block.bin");
+    int steps = n64_system_step(true, -1);
+    u64 jit_hash = r4300i_hash_state(&N64CPU);
+    u32 jit_fcr31 = N64CPU.fcr31.raw;
+
+    init_fpu_test("dynarec_v2_tests/fpu_inexact_block.bin");
+    n64_system_step(false, steps);
+    assert_eq_u64("fcr31", (u64)jit_fcr31, (u64)N64CPU.fcr31.raw);
+    assert_eq_u64("CPU state hash", jit_hash, r4300i_hash_state(&N64CPU));
+    logalways("[PASSED ] FPU inexact block compare test");
+}
+
 int main(int argc, char** argv) {
     test_branch_likely(false);
     test_branch_likely(true);
+    test_fpu_inexact_cfc1(false);
+    test_fpu_inexact_cfc1(true);
+    test_fpu_inexact_block_compare();
 }
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include <rdp/fast_forward.h>
+#include "unit.h"
+
+// Feeds fast forward RDP commands and reads, and checks which draws it drops and when it gives up on dropping them.
+
+#define COLOR_IMAGE 0x100000
+#define OTHER_COLOR_IMAGE 0x200000
+#define Z_IMAGE 0x300000
+#define WIDTH 320
+#define HEIGHT 240
+// 16 bit
+#define IMAGE_BYTES (WIDTH * HEIGHT * 2)
+
+static bool command(u32 w0, u32 w1) {
+    u32 words[2] = { w0, w1 };
+    return fast_forward_rdp_command(words);
+}
+
+static void set_color_image(u32 address) {
+    // 16 bit RGBA
+    command((0x3F << 24) | (2 << 19) | (WIDTH - 1), address);
+}
+
+static void set_texture_image(u32 address) {
+    command((0x3D << 24) | (2 << 19) | (WIDTH - 1), address);
+}
+
+static void set_scissor(u32 height) {
+    command(0x2D << 24, (WIDTH << 2) << 12 | (height << 2));
+}
+
+static void set_z_update(bool z_update) {
+    command(0x2F << 24, z_update ? 1 << 5 : 0);
+}
+
+static bool fill_rectangle() {
+    return command(0x36 << 24, 0);
+}
+
+static bool z_buffered_triangle() {
+    return command(0x09 << 24, 0);
+}
+
+static void load_tile(u32 first_row, u32 last_row) {
+    command((0x34 << 24) | (first_row << 2), (7 << 24) | (((WIDTH - 1) << 2) << 12) | (last_row << 2));
+}
+
+static u8 page_flags(u32 address) {
+    return n64_fast_forward_pages[address >> FAST_FORWARD_PAGE_SHIFT];
+}
+
+static void test_drops_and_falls_back() {
+    fast_forward_start(0);
+    ASSERT_TRUE(fill_rectangle(), "Draws go through before the game sets a color image");
+
+    set_color_image(COLOR_IMAGE);
+    set_scissor(HEIGHT);
+    set_z_update(false);
+    ASSERT_FALSE(fill_rectangle(), "Draws into a color image are dropped");
+    ASSERT_EQ(page_flags(COLOR_IMAGE), FAST_FORWARD_PAGE_SKIPPED, "First page of the color image is marked");
+    ASSERT_EQ(page_flags(COLOR_IMAGE + IMAGE_BYTES - 1), FAST_FORWARD_PAGE_SKIPPED, "Last page of the color image is marked");
+    ASSERT_EQ(page_flags(COLOR_IMAGE + IMAGE_BYTES + 0x1000), 0, "Page past the color image isn't marked");
+
+    check_fast_forward_read(COLOR_IMAGE + 0x2000);
+    ASSERT_EQ(page_flags(COLOR_IMAGE), FAST_FORWARD_PAGE_READ_BACK, "Reading the color image marks all of it read back");
+    ASSERT_EQ(page_flags(COLOR_IMAGE + IMAGE_BYTES - 1), FAST_FORWARD_PAGE_READ_BACK, "Reading the color image marks its last page read back");
+    ASSERT_TRUE(fill_rectangle(), "Draws into a color image that was read back go through");
+
+    set_color_image(OTHER_COLOR_IMAGE);
+    ASSERT_FALSE(fill_rectangle(), "Draws into another color image are still dropped");
+    set_color_image(COLOR_IMAGE);
+    ASSERT_TRUE(fill_rectangle(), "Switching back to the color image that was read back draws again");
+
+    fast_forward_stop();
+    ASSERT_TRUE(n64_fast_forward_pages == NULL, "Stopping frees the page flags");
+}
+
+static void test_texture_loads() {
+    fast_forward_start(0);
+    set_color_image(OTHER_COLOR_IMAGE);
+    set_scissor(HEIGHT);
+    set_z_update(false);
+    ASSERT_FALSE(fill_rectangle(), "Draws into a color image are dropped");
+
+    set_texture_image(OTHER_COLOR_IMAGE);
+    load_tile(HEIGHT - 4, HEIGHT - 1);
+    ASSERT_EQ(page_flags(OTHER_COLOR_IMAGE), FAST_FORWARD_PAGE_READ_BACK, "Loading a texture from the color image marks it read back");
+    ASSERT_TRUE(fill_rectangle(), "Draws into a color image used as a texture go through");
+    fast_forward_stop();
+}
+
+static void test_z_image() {
+    fast_forward_start(0);
+    set_color_image(COLOR_IMAGE);
+    set_scissor(HEIGHT);
+    set_z_update(true);
+    ASSERT_TRUE(z_buffered_triangle(), "Draws updating Z go through before the game sets a Z image");
+
+    command(0x3E << 24, Z_IMAGE);
+    ASSERT_FALSE(z_buffered_triangle(), "Draws updating Z are dropped once there's a Z image");
+    ASSERT_EQ(page_flags(Z_IMAGE), FAST_FORWARD_PAGE_SKIPPED, "Z image is marked");
+
+    check_fast_forward_read_range(Z_IMAGE + 0x800, 0x1000);
+    ASSERT_EQ(page_flags(Z_IMAGE), FAST_FORWARD_PAGE_READ_BACK, "DMA from the Z image marks it read back");
+    ASSERT_TRUE(z_buffered_triangle(), "Draws updating a Z image that was read back go through");
+    fast_forward_stop();
+}
+
+static void test_no_scissor() {
+    fast_forward_start(0);
+    set_color_image(COLOR_IMAGE);
+    set_z_update(false);
+    ASSERT_TRUE(fill_rectangle(), "Draws go through before the game sets a scissor");
+    ASSERT_EQ(page_flags(COLOR_IMAGE), 0, "Nothing is marked without a scissor");
+
+    set_scissor(HEIGHT);
+    ASSERT_FALSE(fill_rectangle(), "Draws are dropped once there's a scissor");
+    ASSERT_EQ(page_flags(COLOR_IMAGE), FAST_FORWARD_PAGE_SKIPPED, "Color image is marked once there's a scissor");
+    fast_forward_stop();
+
+    fast_forward_start(0);
+    set_color_image(COLOR_IMAGE);
+    set_z_update(false);
+    ASSERT_TRUE(fill_rectangle(), "The scissor from before fast forward started doesn't count");
+    fast_forward_stop();
+}
+
+static void test_frame_limit() {
+    fast_forward_start(2);
+    fast_forward_end_frame();
+    ASSERT_TRUE(fast_forward_active(), "Still fast forwarding after one of two frames");
+    fast_forward_end_frame();
+    ASSERT_FALSE(fast_forward_active(), "Fast forward stops after two of two frames");
+    ASSERT_TRUE(n64_fast_forward_pages == NULL, "Page flags are freed once the frames run out");
+}
+
+int main(int argc, char** argv) {
+    test_drops_and_falls_back();
+    test_texture_loads();
+    test_z_image();
+    test_no_scissor();
+    test_frame_limit();
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,65 @@
+#include <metrics.h>
+#include "unit.h"
+
+// Histogram bucketing and quantiles, and how counters and gauges move into the totals and history when a frame ends.
+
+int main(int argc, char** argv) {
+    // Every bucket's lower bound lands in that bucket, and the buckets cover every value without gaps
+    bool contiguous = true;
+    for (int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        u64 lower = histogram_bucket_lower_bound(bucket);
+        if (histogram_bucket(lower) != bucket) {
+            contiguous = false;
+        }
+        if (bucket + 1 < HISTOGRAM_BUCKETS && histogram_bucket(histogram_bucket_lower_bound(bucket + 1) - 1) != bucket) {
+            contiguous = false;
+        }
+    }
+    ASSERT_TRUE(contiguous, "histogram buckets are contiguous");
+    ASSERT_EQ(histogram_bucket(HISTOGRAM_SUB_BUCKETS - 1), HISTOGRAM_SUB_BUCKETS - 1, "small values are exact");
+    ASSERT_EQ(histogram_bucket(~0ull), HISTOGRAM_BUCKETS - 1, "huge values go in the last bucket");
+
+    for (u64 i = 1; i <= 1000; i++) {
+        record_histogram(HISTOGRAM_FRAME_TIME, i * 1000);
+    }
+    metric_histogram_t histogram;
+    metrics_get_histogram(HISTOGRAM_FRAME_TIME, &histogram);
+    ASSERT_EQ(histogram.count, 1000, "histogram count");
+    ASSERT_EQ(histogram.sum, 500500000, "histogram sum");
+    ASSERT_EQ(histogram.max, 1000000, "histogram max");
+    u64 p50 = histogram_quantile(&histogram, 0.5);
+    ASSERT_TRUE(p50 >= 500000 && p50 <= 500000 + 500000 / HISTOGRAM_SUB_BUCKETS, "p50 within a bucket of the real value (%llu)", (unsigned long long)p50);
+    ASSERT_EQ(histogram_quantile(&histogram, 1.0), 1000000, "p100 is the max");
+
+    mark_metric_multiple(METRIC_RSP_STEPS, 10);
+    set_metric(METRIC_CODECACHE_USED, 1234);
+    metrics_end_frame();
+    ASSERT_EQ(get_metric(METRIC_RSP_STEPS), 0, "counters are reset at the end of a frame");
+    ASSERT_EQ(get_metric(METRIC_CODECACHE_USED), 1234, "gauges keep their value");
+
+    mark_metric_multiple(METRIC_RSP_STEPS, 5);
+    set_metric(METRIC_CODECACHE_USED, 4321);
+    metrics_end_frame();
+
+    u64 totals[NUM_METRICS];
+    metrics_get_totals(totals);
+    ASSERT_EQ(totals[METRIC_RSP_STEPS], 15, "counter totals add up every frame");
+    ASSERT_EQ(totals[METRIC_CODECACHE_USED], 4321, "gauge totals are the last value");
+
+    frame_metrics_t frames[METRICS_HISTORY_FRAMES];
+    ASSERT_EQ(metrics_get_history(frames, METRICS_HISTORY_FRAMES), 2, "two frames of history");
+    ASSERT_EQ(frames[0].values[METRIC_RSP_STEPS], 10, "first frame is oldest");
+    ASSERT_EQ(frames[1].values[METRIC_RSP_STEPS], 5, "second frame");
+    ASSERT_EQ(frames[1].frame, 1, "frame numbers");
+
+    for (int i = 0; i < METRICS_HISTORY_FRAMES + 10; i++) {
+        mark_metric_multiple(METRIC_RSP_STEPS, i);
+        metrics_end_frame();
+    }
+    ASSERT_EQ(metrics_get_history(frames, 3), 3, "history can be limited");
+    ASSERT_EQ(frames[2].values[METRIC_RSP_STEPS], METRICS_HISTORY_FRAMES + 9, "limited history is the most recent frames");
+    ASSERT_EQ(metrics_get_history(frames, METRICS_HISTORY_FRAMES), METRICS_HISTORY_FRAMES, "history is capped");
+    ASSERT_EQ(frames[0].frame, 12, "oldest frames are dropped first");
+
+    return tests_failed != 0;
+}
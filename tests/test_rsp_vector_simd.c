@@ -0,0 +1,184 @@
+#include <string.h>
+#include <stdlib.h>
+#include <system/n64system.h>
+#include <cpu/rsp.h>
+#include <cpu/rsp_vector_instructions.h>
+#include <cpu/rsp_vector_reference.h>
+#include "unit.h"
+
+// Runs every vector instruction with a SIMD implementation against its scalar reference on random inputs
+// and compares the complete vector unit state afterwards.
+
+#define ITERATIONS 20000
+
+typedef void (*vector_instr_t)(mips_instruction_t);
+
+typedef struct vector_instr_pair {
+    const char* name;
+    vector_instr_t simd;
+    vector_instr_t reference;
+} vector_instr_pair_t;
+
+#define PAIR(name) { #name, rsp_vec_##name, rsp_vec_##name##_reference }
+
+static const vector_instr_pair_t pairs[] = {
+        PAIR(vabs), PAIR(vadd), PAIR(vaddc), PAIR(vand), PAIR(vch), PAIR(vcl), PAIR(vcr), PAIR(veq),
+        PAIR(vge), PAIR(vlt), PAIR(vmacf), PAIR(vmacu), PAIR(vmadh), PAIR(vmadl), PAIR(vmadm), PAIR(vmadn),
+        PAIR(vmrg), PAIR(vmudh), PAIR(vmudl), PAIR(vmudm), PAIR(vmudn), PAIR(vmulf), PAIR(vmulu), PAIR(vnand),
+        PAIR(vne), PAIR(vnor), PAIR(vnxor), PAIR(vor), PAIR(vsub), PAIR(vsubc), PAIR(vxor), PAIR(vzero),
+};
+
+typedef struct vector_unit_state {
+    vu_reg_t vu_regs[32];
+    vu_reg_t acc_h, acc_m, acc_l;
+    vu_reg_t vco_l, vco_h, vcc_l, vcc_h, vce;
+} vector_unit_state_t;
+
+static void save_state(vector_unit_state_t* state) {
+    memcpy(state->vu_regs, N64RSP.vu_regs, sizeof(state->vu_regs));
+    state->acc_h = N64RSP.acc.h;
+    state->acc_m = N64RSP.acc.m;
+    state->acc_l = N64RSP.acc.l;
+    state->vco_l = N64RSP.vco.l;
+    state->vco_h = N64RSP.vco.h;
+    state->vcc_l = N64RSP.vcc.l;
+    state->vcc_h = N64RSP.vcc.h;
+    state->vce = N64RSP.vce;
+}
+
+static void restore_state(const vector_unit_state_t* state) {
+    memcpy(N64RSP.vu_regs, state->vu_regs, sizeof(state->vu_regs));
+    N64RSP.acc.h = state->acc_h;
+    N64RSP.acc.m = state->acc_m;
+    N64RSP.acc.l = state->acc_l;
+    N64RSP.vco.l = state->vco_l;
+    N64RSP.vco.h = state->vco_h;
+    N64RSP.vcc.l = state->vcc_l;
+    N64RSP.vcc.h = state->vcc_h;
+    N64RSP.vce = state->vce;
+}
+
+// Biased towards the values where saturation and sign handling go wrong
+static u16 random_element() {
+    static const u16 edge_cases[] = { 0x0000, 0x0001, 0x7FFF, 0x8000, 0x8001, 0xFFFF, 0xFFFE };
+    if (rand() % 4 == 0) {
+        return edge_cases[rand() % (sizeof(edge_cases) / sizeof(edge_cases[0]))];
+    }
+    return rand() & 0xFFFF;
+}
+
+static void randomize_reg(vu_reg_t* reg) {
+    for (int i = 0; i < 8; i++) {
+        reg->elements[i] = random_element();
+    }
+}
+
+static void randomize_flags(vu_reg_t* reg) {
+    for (int i = 0; i < 8; i++) {
+        reg->elements[i] = (rand() & 1) ? 0xFFFF : 0x0000;
+    }
+}
+
+static void randomize_state() {
+    for (int i = 0; i < 32; i++) {
+        randomize_reg(&N64RSP.vu_regs[i]);
+    }
+    randomize_reg(&N64RSP.acc.h);
+    randomize_reg(&N64RSP.acc.m);
+    randomize_reg(&N64RSP.acc.l);
+    randomize_flags(&N64RSP.vco.l);
+    randomize_flags(&N64RSP.vco.h);
+    randomize_flags(&N64RSP.vcc.l);
+    randomize_flags(&N64RSP.vcc.h);
+    randomize_flags(&N64RSP.vce);
+}
+
+static bool compare_reg(const char* instr, const char* name, const vu_reg_t* simd, const vu_reg_t* reference) {
+    if (memcmp(simd, reference, sizeof(vu_reg_t)) == 0) {
+        return true;
+    }
+    printf("%s: %s differs\n", instr, name);
+    printf("Expected: ");
+    for (int i = 0; i < 8; i++) {
+        printf("%04X ", reference->elements[i]);
+    }
+    printf("\nActual:   ");
+    for (int i = 0; i < 8; i++) {
+        printf("%04X ", simd->elements[i]);
+    }
+    printf("\n");
+    return false;
+}
+
+static bool compare_state(const char* instr, const vector_unit_state_t* simd, const vector_unit_state_t* reference) {
+    bool matches = true;
+    for (int i = 0; i < 32; i++) {
+        char name[8];
+        snprintf(name, sizeof(name), "v%d", i);
+        matches &= compare_reg(instr, name, &simd->vu_regs[i], &reference->vu_regs[i]);
+    }
+    matches &= compare_reg(instr, "acc.h", &simd->acc_h, &reference->acc_h);
+    matches &= compare_reg(instr, "acc.m", &simd->acc_m, &reference->acc_m);
+    matches &= compare_reg(instr, "acc.l", &simd->acc_l, &reference->acc_l);
+    matches &= compare_reg(instr, "vco.l", &simd->vco_l, &reference->vco_l);
+    matches &= compare_reg(instr, "vco.h", &simd->vco_h, &reference->vco_h);
+    matches &= compare_reg(instr, "vcc.l", &simd->vcc_l, &reference->vcc_l);
+    matches &= compare_reg(instr, "vcc.h", &simd->vcc_h, &reference->vcc_h);
+    matches &= compare_reg(instr, "vce", &simd->vce, &reference->vce);
+    return matches;
+}
+
+int main(int argc, char** argv) {
+    init_n64system(NULL, false, false, UNKNOWN_VIDEO_TYPE, false);
+    srand(0x64);
+
+    // Element selectors first, they're shared by every instruction
+    int vte_mismatches = 0;
+    for (int iteration = 0; iteration < ITERATIONS; iteration++) {
+        vu_reg_t vt;
+        randomize_reg(&vt);
+        for (int e = 0; e < 16; e++) {
+            vu_reg_t simd = ext_get_vte(&vt, e);
+            vu_reg_t reference = get_vte_reference(&vt, e);
+            if (memcmp(&simd, &reference, sizeof(vu_reg_t)) != 0) {
+                vte_mismatches++;
+            }
+        }
+    }
+    ASSERT_EQ(vte_mismatches, 0, "element selectors match the reference");
+
+    for (int p = 0; p < sizeof(pairs) / sizeof(pairs[0]); p++) {
+        int mismatches = 0;
+        for (int iteration = 0; iteration < ITERATIONS; iteration++) {
+            randomize_state();
+
+            mips_instruction_t instr;
+            instr.raw = 0;
+            instr.cp2_vec.vs = rand() % 32;
+            instr.cp2_vec.vt = rand() % 32;
+            instr.cp2_vec.vd = rand() % 32;
+            instr.cp2_vec.e = rand() % 16;
+
+            vector_unit_state_t initial, simd, reference;
+            save_state(&initial);
+
+            pairs[p].simd(instr);
+            save_state(&simd);
+
+            restore_state(&initial);
+            pairs[p].reference(instr);
+            save_state(&reference);
+
+            if (!compare_state(pairs[p].name, &simd, &reference)) {
+                printf("vs: v%d vt: v%d vd: v%d e: %d\n", instr.cp2_vec.vs, instr.cp2_vec.vt, instr.cp2_vec.vd, instr.cp2_vec.e);
+                // Don't flood the output, one failing case is enough to debug with
+                if (++mismatches >= 4) {
+                    break;
+                }
+            }
+        }
+        ASSERT_EQ(mismatches, 0, "%s matches the reference", pairs[p].name);
+    }
+
+    return tests_failed != 0;
+}
@@ -0,0 +1,93 @@
+#include <stdlib.h>
+#include <string.h>
+#include <trace.h>
+#include "unit.h"
+
+// Traces more events than fit in a ring between writer passes, then reads the file back and checks every record.
+
+#define EVENTS 200000
+#define TRACE_PATH "test_trace.bin"
+
+int main(int argc, char** argv) {
+    ASSERT_TRUE(trace_start(TRACE_PATH, TRACE_EVENT_MASK(TRACE_EVENT_IDLE_LOOP) | TRACE_EVENT_MASK(TRACE_EVENT_RDP_COMMAND), true), "trace starts");
+    for (u64 i = 0; i < EVENTS; i++) {
+        TRACE(TRACE_EVENT_IDLE_LOOP, trace_idle_loop_t, i);
+        if (i % 1000 == 0) {
+            // Variable length, only the used words are stored
+            trace_rdp_command_t command = { .length = 2 + (i / 1000) % 40 };
+            for (u32 w = 0; w < command.length; w++) {
+                command.words[w] = (u32)i + w;
+            }
+            trace_emit(TRACE_EVENT_RDP_COMMAND, &command, sizeof(u32) * (1 + command.length));
+        }
+        // Not enabled, so never written
+        TRACE(TRACE_EVENT_BLOCK_COMPILED, trace_block_compiled_t, i, 0, 0);
+    }
+    trace_stop();
+    ASSERT_EQ(n64_trace_mask, 0, "mask is cleared when tracing stops");
+    // Ignored while not tracing
+    TRACE(TRACE_EVENT_IDLE_LOOP, trace_idle_loop_t, 0);
+
+    FILE* fp = fopen(TRACE_PATH, "rb");
+    ASSERT_TRUE(fp != NULL, "trace file exists");
+    if (fp == NULL) {
+        return 1;
+    }
+
+    trace_file_header_t header;
+    ASSERT_EQ(fread(&header, sizeof(header), 1, fp), 1, "read file header");
+    ASSERT_TRUE(memcmp(header.magic, TRACE_FILE_MAGIC, 8) == 0, "file magic");
+    ASSERT_EQ(header.version, TRACE_FILE_VERSION, "file version");
+    ASSERT_TRUE(header.ticks_per_second > 0, "ticks per second is set");
+
+    u64 next_idle = 0;
+    u64 next_command = 0;
+    u64 dropped = 0;
+    int bad_records = 0;
+    u64 last_timestamp = 0;
+    trace_chunk_header_t chunk;
+    while (fread(&chunk, sizeof(chunk), 1, fp) == 1) {
+        dropped += chunk.dropped;
+        u8* bytes = malloc(chunk.bytes);
+        if (fread(bytes, 1, chunk.bytes, fp) != chunk.bytes) {
+            bad_records++;
+            free(bytes);
+            break;
+        }
+        for (u32 offset = 0; offset < chunk.bytes;) {
+            trace_record_header_t record;
+            memcpy(&record, &bytes[offset], sizeof(record));
+            const u8* payload = &bytes[offset + sizeof(record)];
+            offset += sizeof(record) + record.size;
+
+            bad_records += record.timestamp < last_timestamp;
+            last_timestamp = record.timestamp;
+            if (record.event == TRACE_EVENT_IDLE_LOOP) {
+                trace_idle_loop_t idle;
+                memcpy(&idle, payload, sizeof(idle));
+                bad_records += record.size != sizeof(idle) || idle.virtual_address != next_idle;
+                next_idle++;
+            } else if (record.event == TRACE_EVENT_RDP_COMMAND) {
+                trace_rdp_command_t command;
+                memcpy(&command, payload, record.size);
+                bad_records += command.length != 2 + (next_command / 1000) % 40 || record.size != sizeof(u32) * (1 + command.length);
+                for (u32 w = 0; w < command.length && w < TRACE_RDP_COMMAND_MAX_WORDS; w++) {
+                    bad_records += command.words[w] != (u32)next_command + w;
+                }
+                next_command += 1000;
+            } else {
+                bad_records++;
+            }
+        }
+        free(bytes);
+    }
+    fclose(fp);
+    remove(TRACE_PATH);
+
+    ASSERT_EQ(dropped, 0, "lossless tracing drops nothing");
+    ASSERT_EQ(next_idle, EVENTS, "every idle loop event was written");
+    ASSERT_EQ(next_command, EVENTS, "every RDP command event was written");
+    ASSERT_EQ(bad_records, 0, "every record is intact and in order");
+
+    return tests_failed != 0;
+}
@@ -0,0 +1,149 @@
+#include <stdlib.h>
+#include <string.h>
+#include <system/n64system.h>
+#include <mem/mem_util.h>
+#include <interface/vi_capture.h>
+#include "unit.h"
+
+// Captures framebuffers with awkward widths, strides and origins, and checks every pixel against a straightforward conversion.
+
+#define WIDTH 37
+#define HEIGHT 20
+#define STRIDE 40
+
+static void write_byte(u32 address, u8 value) {
+    n64sys.mem.rdram[BYTE_ADDRESS(address & (N64_RDRAM_SIZE - 1))] = value;
+}
+
+static void setup_vi(int type, u32 origin) {
+    n64sys.vi.status.type = type;
+    n64sys.vi.vi_origin = origin;
+    n64sys.vi.vi_width = STRIDE;
+    // 74 pixels wide at half scale, 20 lines at full scale
+    n64sys.vi.hstart.start = 100;
+    n64sys.vi.hstart.end = 100 + WIDTH * 2;
+    n64sys.vi.xscale.scale = 0x200;
+    n64sys.vi.vstart.start = 30;
+    n64sys.vi.vstart.end = 30 + HEIGHT * 2;
+    n64sys.vi.yscale.scale = 0x400;
+}
+
+static u8 expand(int value) {
+    return (value << 3) | (value >> 2);
+}
+
+static void test_16bit(u32 origin) {
+    setup_vi(VI_TYPE_16BIT, origin);
+
+    static u16 pixels[HEIGHT][WIDTH];
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            pixels[y][x] = rand();
+            u32 address = origin + (y * STRIDE + x) * 2;
+            write_byte(address, pixels[y][x] >> 8);
+            write_byte(address + 1, pixels[y][x] & 0xFF);
+        }
+    }
+
+    vi_capture_t capture = {0};
+    ASSERT_TRUE(vi_capture_frame(&capture, true), "16 bit capture at 0x%X succeeds", origin);
+    ASSERT_EQ(capture.width, WIDTH, "16 bit capture width");
+    ASSERT_EQ(capture.height, HEIGHT, "16 bit capture height");
+
+    int mismatches = 0;
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            const u8* out = &capture.rgba[(y * WIDTH + x) * 4];
+            u16 pixel = pixels[y][x];
+            if (out[0] != expand((pixel >> 11) & 0x1F) || out[1] != expand((pixel >> 6) & 0x1F)
+                    || out[2] != expand((pixel >> 1) & 0x1F) || out[3] != 0xFF) {
+                mismatches++;
+            }
+        }
+    }
+    ASSERT_EQ(mismatches, 0, "16 bit capture at 0x%X matches every pixel", origin);
+
+    // Converting into a destination with padding between the rows gives the same rows, and leaves the padding alone
+    const int pitch = WIDTH * 4 + 12;
+    static u8 padded[HEIGHT * (WIDTH * 4 + 12)];
+    memset(padded, 0xAA, sizeof(padded));
+    u64 padded_hash = vi_capture_convert(padded, pitch, WIDTH, HEIGHT, true);
+    int row_mismatches = 0;
+    int padding_overwritten = 0;
+    for (int y = 0; y < HEIGHT; y++) {
+        row_mismatches += memcmp(&padded[y * pitch], &capture.rgba[y * WIDTH * 4], WIDTH * 4) != 0;
+        for (int i = WIDTH * 4; i < pitch; i++) {
+            padding_overwritten += padded[y * pitch + i] != 0xAA;
+        }
+    }
+    ASSERT_EQ(row_mismatches, 0, "16 bit conversion with a pitch matches the capture");
+    ASSERT_EQ(padding_overwritten, 0, "16 bit conversion with a pitch leaves the padding alone");
+    ASSERT_EQ(padded_hash, capture.hash, "16 bit conversion with a pitch has the same hash");
+
+    u64 hash = capture.hash;
+    vi_capture_frame(&capture, true);
+    ASSERT_EQ(capture.hash, hash, "16 bit capture hash is stable");
+
+    write_byte(origin + ((HEIGHT - 1) * STRIDE + WIDTH - 1) * 2, (pixels[HEIGHT - 1][WIDTH - 1] >> 8) ^ 0x80);
+    vi_capture_frame(&capture, true);
+    ASSERT_TRUE(capture.hash != hash, "16 bit capture hash changes with the last pixel");
+
+    vi_capture_free(&capture);
+}
+
+static void test_32bit(u32 origin) {
+    setup_vi(VI_TYPE_32BIT, origin);
+
+    static u32 pixels[HEIGHT][WIDTH];
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            pixels[y][x] = (u32)rand() << 16 ^ rand();
+            u32 address = origin + (y * STRIDE + x) * 4;
+            for (int i = 0; i < 4; i++) {
+                write_byte(address + i, pixels[y][x] >> (24 - i * 8));
+            }
+        }
+    }
+
+    vi_capture_t capture = {0};
+    ASSERT_TRUE(vi_capture_frame(&capture, true), "32 bit capture at 0x%X succeeds", origin);
+
+    int mismatches = 0;
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            const u8* out = &capture.rgba[(y * WIDTH + x) * 4];
+            u32 pixel = pixels[y][x];
+            if (out[0] != (pixel >> 24) || out[1] != ((pixel >> 16) & 0xFF) || out[2] != ((pixel >> 8) & 0xFF) || out[3] != 0xFF) {
+                mismatches++;
+            }
+        }
+    }
+    ASSERT_EQ(mismatches, 0, "32 bit capture at 0x%X matches every pixel", origin);
+
+    // The alpha byte isn't captured, so it doesn't change the hash
+    u64 hash = capture.hash;
+    write_byte(origin + 3, (pixels[0][0] & 0xFF) ^ 0xFF);
+    vi_capture_frame(&capture, true);
+    ASSERT_EQ(capture.hash, hash, "32 bit capture hash ignores coverage");
+
+    vi_capture_free(&capture);
+}
+
+int main(int argc, char** argv) {
+    init_n64system(NULL, false, false, UNKNOWN_VIDEO_TYPE, false);
+    srand(0x64);
+
+    test_16bit(0x100000);
+    test_16bit(0x100002);
+    // Wraps around the end of RDRAM
+    test_16bit(N64_RDRAM_SIZE - STRIDE * 2 * 3);
+
+    test_32bit(0x200000);
+    test_32bit(N64_RDRAM_SIZE - STRIDE * 4 * 3);
+
+    n64sys.vi.status.type = VI_TYPE_BLANK;
+    vi_capture_t capture = {0};
+    ASSERT_FALSE(vi_capture_frame(&capture, false), "blank VI doesn't capture");
+
+    return tests_failed != 0;
+}